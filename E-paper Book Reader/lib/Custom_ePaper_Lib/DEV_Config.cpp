@@ -28,6 +28,28 @@
 #
 ******************************************************************************/
 #include "DEV_Config.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef ARDUINO
+#if EPD_SPI_BACKEND == EPD_SPI_BACKEND_HW
+#include <driver/spi_master.h>
+#include <esp_heap_caps.h>
+
+static spi_device_handle_t SPI_Handle = NULL;
+static UBYTE *SPI_DMA_Buffer[2] = {NULL, NULL};
+
+//Burst of DEV_SPI_Write_Start(), DMA straight from the caller's buffer
+static spi_transaction_t SPI_Async_T[EPD_SPI_QUEUE];
+static const UBYTE *SPI_Async_Data = NULL;
+static UDOUBLE SPI_Async_Len = 0;
+static UBYTE SPI_Async_Inflight = 0, SPI_Async_Next = 0;
+#endif
+
+static UBYTE SPI_Backend = EPD_SPI_BACKEND;
+static UBYTE SPI_Async_Active = 0;
+
+static void Arduino_SPI_Write_Wait(void);
 
 void GPIO_Config(void)
 {
@@ -51,6 +73,130 @@ void GPIO_Mode(UWORD GPIO_Pin, UWORD Mode)
 		pinMode(GPIO_Pin , OUTPUT);
 	}
 }
+
+static void Arduino_Digital_Write(UWORD Pin, UBYTE Value)
+{
+    if(SPI_Async_Active && (Pin == EPD_DC_PIN || Pin == EPD_CS_PIN))
+        Arduino_SPI_Write_Wait();
+    digitalWrite(Pin, Value == 0? LOW:HIGH);
+}
+
+static UBYTE Arduino_Digital_Read(UWORD Pin)
+{
+    return digitalRead(Pin);
+}
+
+static void Arduino_Delay_ms(UDOUBLE xms)
+{
+    delay(xms);
+}
+
+static UDOUBLE Arduino_Millis(void)
+{
+    return millis();
+}
+
+static UDOUBLE Arduino_Micros(void)
+{
+    return micros();
+}
+
+/******************************************************************************
+function:	Hardware SPI bring-up and tear-down
+Info:
+    The Waveshare ESP32 driver board wires the panel to "unusual" pins, so the
+    HSPI peripheral is routed to EPD_SCK_PIN/EPD_MOSI_PIN through the GPIO
+    matrix. CS stays a plain GPIO driven by the panel drivers, which lets a
+    whole plane go out under one CS assertion. MOSI doubles as the read line
+    (3-wire, half duplex), exactly like the bit-bang path.
+******************************************************************************/
+#if EPD_SPI_BACKEND == EPD_SPI_BACKEND_HW
+static UBYTE SPI_HW_Begin(void)
+{
+    spi_bus_config_t bus;
+    memset(&bus, 0, sizeof(bus));
+    bus.mosi_io_num = EPD_MOSI_PIN;
+    bus.miso_io_num = -1;
+    bus.sclk_io_num = EPD_SCK_PIN;
+    bus.quadwp_io_num = -1;
+    bus.quadhd_io_num = -1;
+    bus.max_transfer_sz = EPD_SPI_DMA_CHUNK;
+    if(spi_bus_initialize(SPI2_HOST, &bus, SPI_DMA_CH_AUTO) != ESP_OK) {
+        printf("SPI bus init failed\r\n");
+        return 1;
+    }
+
+    spi_device_interface_config_t dev;
+    memset(&dev, 0, sizeof(dev));
+    dev.mode = 0;
+    dev.clock_speed_hz = EPD_SPI_CLOCK_HZ;
+    dev.spics_io_num = -1;
+    dev.flags = SPI_DEVICE_3WIRE | SPI_DEVICE_HALFDUPLEX;
+    dev.queue_size = EPD_SPI_QUEUE;
+    if(spi_bus_add_device(SPI2_HOST, &dev, &SPI_Handle) != ESP_OK) {
+        printf("SPI device add failed\r\n");
+        spi_bus_free(SPI2_HOST);
+        return 1;
+    }
+
+    //Two bounce buffers in DMA capable RAM, one is filled while the other is on the wire
+    for(int i = 0; i < 2; i++) {
+        if(SPI_DMA_Buffer[i] == NULL)
+            SPI_DMA_Buffer[i] = (UBYTE *)heap_caps_malloc(EPD_SPI_DMA_CHUNK, MALLOC_CAP_DMA);
+        if(SPI_DMA_Buffer[i] == NULL) {
+            printf("Failed to apply for SPI DMA memory...\r\n");
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void SPI_HW_End(void)
+{
+    if(SPI_Handle != NULL) {
+        spi_bus_remove_device(SPI_Handle);
+        spi_bus_free(SPI2_HOST);
+        SPI_Handle = NULL;
+    }
+}
+#endif
+
+/******************************************************************************
+function:	Select the SPI backend at runtime
+parameter:
+    backend : EPD_SPI_BACKEND_BITBANG or EPD_SPI_BACKEND_HW
+Info:
+    Only needed to compare the backends, the build time default is
+    already active after DEV_Module_Init().
+******************************************************************************/
+void DEV_SPI_SetBackend(UBYTE backend)
+{
+#if EPD_SPI_BACKEND == EPD_SPI_BACKEND_HW
+    if(backend == EPD_SPI_BACKEND_HW) {
+        if(SPI_Handle == NULL && SPI_HW_Begin() != 0) {
+            SPI_HW_End();
+            backend = EPD_SPI_BACKEND_BITBANG;
+        }
+    } else {
+        SPI_HW_End();
+    }
+#else
+    backend = EPD_SPI_BACKEND_BITBANG;
+#endif
+    if(backend == EPD_SPI_BACKEND_BITBANG) {
+        //pinMode() hands the pins back from the SPI peripheral to the GPIO matrix
+        pinMode(EPD_SCK_PIN, OUTPUT);
+        pinMode(EPD_MOSI_PIN, OUTPUT);
+        digitalWrite(EPD_SCK_PIN, LOW);
+    }
+    SPI_Backend = backend;
+}
+
+UBYTE DEV_SPI_GetBackend(void)
+{
+    return SPI_Backend;
+}
+
 /******************************************************************************
 function:	Module Initialize, the BCM2835 library and initialize the pins, SPI protocol
 parameter:
@@ -65,10 +211,7 @@ UBYTE DEV_Module_Init(void)
 	Serial.begin(115200);
 
 	// spi
-	// SPI.setDataMode(SPI_MODE0);
-	// SPI.setBitOrder(MSBFIRST);
-	// SPI.setClockDivider(SPI_CLOCK_DIV4);
-	// SPI.begin();
+	DEV_SPI_SetBackend(EPD_SPI_BACKEND);
 
 	return 0;
 }
@@ -77,11 +220,8 @@ UBYTE DEV_Module_Init(void)
 function:
 			SPI read and write
 ******************************************************************************/
-void DEV_SPI_WriteByte(UBYTE data)
+static void SPI_BitBang_Shift(UBYTE data)
 {
-    //SPI.beginTransaction(spi_settings);
-    digitalWrite(EPD_CS_PIN, GPIO_PIN_RESET);
-
     for (int i = 0; i < 8; i++)
     {
         if ((data & 0x80) == 0) digitalWrite(EPD_MOSI_PIN, GPIO_PIN_RESET); 
@@ -91,15 +231,44 @@ void DEV_SPI_WriteByte(UBYTE data)
         digitalWrite(EPD_SCK_PIN, GPIO_PIN_SET);     
         digitalWrite(EPD_SCK_PIN, GPIO_PIN_RESET);
     }
+}
 
-    //SPI.transfer(data);
+static void Arduino_SPI_WriteByte(UBYTE data)
+{
+    if(SPI_Async_Active)
+        Arduino_SPI_Write_Wait();
+    digitalWrite(EPD_CS_PIN, GPIO_PIN_RESET);
+#if EPD_SPI_BACKEND == EPD_SPI_BACKEND_HW
+    if(SPI_Backend == EPD_SPI_BACKEND_HW) {
+        spi_transaction_t t;
+        memset(&t, 0, sizeof(t));
+        t.flags = SPI_TRANS_USE_TXDATA;
+        t.length = 8;
+        t.tx_data[0] = data;
+        spi_device_polling_transmit(SPI_Handle, &t);
+    } else
+#endif
+    SPI_BitBang_Shift(data);
     digitalWrite(EPD_CS_PIN, GPIO_PIN_SET);
-    //SPI.endTransaction();	
 }
 
-UBYTE DEV_SPI_ReadByte()
+static UBYTE Arduino_SPI_ReadByte(void)
 {
     UBYTE j=0xff;
+    if(SPI_Async_Active)
+        Arduino_SPI_Write_Wait();
+#if EPD_SPI_BACKEND == EPD_SPI_BACKEND_HW
+    if(SPI_Backend == EPD_SPI_BACKEND_HW) {
+        spi_transaction_t t;
+        memset(&t, 0, sizeof(t));
+        t.flags = SPI_TRANS_USE_RXDATA;
+        t.rxlength = 8;
+        digitalWrite(EPD_CS_PIN, GPIO_PIN_RESET);
+        spi_device_polling_transmit(SPI_Handle, &t);
+        digitalWrite(EPD_CS_PIN, GPIO_PIN_SET);
+        return t.rx_data[0];
+    }
+#endif
     GPIO_Mode(EPD_MOSI_PIN, 0);
     digitalWrite(EPD_CS_PIN, GPIO_PIN_RESET);
     for (int i = 0; i < 8; i++)
@@ -116,8 +285,401 @@ UBYTE DEV_SPI_ReadByte()
     return j;
 }
 
-void DEV_SPI_Write_nByte(UBYTE *pData, UDOUBLE len)
+/******************************************************************************
+function:	Write a burst of bytes
+parameter:
+    pData : data to send, may live in flash
+    len   : number of bytes
+Info:
+    CS is held low for the whole burst. On the hardware backend the data is
+    copied into the two DMA bounce buffers in EPD_SPI_DMA_CHUNK pieces; while
+    one chunk is clocked out the next one is prepared, so the bus never idles
+    between chunks.
+******************************************************************************/
+static void Arduino_SPI_Write_nByte(const UBYTE *pData, UDOUBLE len)
+{
+    if(SPI_Async_Active)
+        Arduino_SPI_Write_Wait();
+    digitalWrite(EPD_CS_PIN, GPIO_PIN_RESET);
+#if EPD_SPI_BACKEND == EPD_SPI_BACKEND_HW
+    if(SPI_Backend == EPD_SPI_BACKEND_HW) {
+        spi_transaction_t t[2];
+        spi_transaction_t *done;
+        UBYTE inflight = 0, buf = 0;
+        while(len > 0) {
+            UDOUBLE n = len > EPD_SPI_DMA_CHUNK ? EPD_SPI_DMA_CHUNK : len;
+            if(inflight == 2) {
+                spi_device_get_trans_result(SPI_Handle, &done, portMAX_DELAY);
+                inflight--;
+            }
+            memcpy(SPI_DMA_Buffer[buf], pData, n);
+            memset(&t[buf], 0, sizeof(spi_transaction_t));
+            t[buf].length = n * 8;
+            t[buf].tx_buffer = SPI_DMA_Buffer[buf];
+            spi_device_queue_trans(SPI_Handle, &t[buf], portMAX_DELAY);
+            inflight++;
+            buf ^= 1;
+            pData += n;
+            len -= n;
+        }
+        while(inflight--)
+            spi_device_get_trans_result(SPI_Handle, &done, portMAX_DELAY);
+    } else
+#endif
+    {
+        for (UDOUBLE i = 0; i < len; i++)
+            SPI_BitBang_Shift(pData[i]);
+    }
+    digitalWrite(EPD_CS_PIN, GPIO_PIN_SET);
+}
+
+/******************************************************************************
+function:	Start a burst that goes out while the caller does something else
+parameter:
+    pData : data to send, untouched until Arduino_SPI_Write_Wait() returns
+    len   : number of bytes
+Info:
+    On the hardware backend up to EPD_SPI_QUEUE DMA transactions are queued
+    straight from pData, no bounce copy, and the call returns at once. Keep
+    pData in internal RAM, the SPI driver copies anything else. CS stays
+    low until the wait. The bit-bang backend sends the burst right here.
+    Any other SPI or DC / CS access waits for the burst first.
+******************************************************************************/
+#if EPD_SPI_BACKEND == EPD_SPI_BACKEND_HW
+static void SPI_Async_Queue(void)
+{
+    while(SPI_Async_Len > 0 && SPI_Async_Inflight < EPD_SPI_QUEUE) {
+        UDOUBLE n = SPI_Async_Len > EPD_SPI_DMA_CHUNK ? EPD_SPI_DMA_CHUNK : SPI_Async_Len;
+        spi_transaction_t *t = &SPI_Async_T[SPI_Async_Next];
+        memset(t, 0, sizeof(spi_transaction_t));
+        t->length = n * 8;
+        t->tx_buffer = SPI_Async_Data;
+        spi_device_queue_trans(SPI_Handle, t, portMAX_DELAY);
+        SPI_Async_Next = (SPI_Async_Next + 1) % EPD_SPI_QUEUE;
+        SPI_Async_Inflight++;
+        SPI_Async_Data += n;
+        SPI_Async_Len -= n;
+    }
+}
+#endif
+
+static void Arduino_SPI_Write_Start(const UBYTE *pData, UDOUBLE len)
+{
+#if EPD_SPI_BACKEND == EPD_SPI_BACKEND_HW
+    if(SPI_Async_Active)
+        Arduino_SPI_Write_Wait();
+    if(SPI_Backend == EPD_SPI_BACKEND_HW) {
+        digitalWrite(EPD_CS_PIN, GPIO_PIN_RESET);
+        SPI_Async_Data = pData;
+        SPI_Async_Len = len;
+        SPI_Async_Active = 1;
+        SPI_Async_Queue();
+        return;
+    }
+#endif
+    Arduino_SPI_Write_nByte(pData, len);
+}
+
+//Waits for the burst of Arduino_SPI_Write_Start(), queues what did not fit
+static void Arduino_SPI_Write_Wait(void)
+{
+#if EPD_SPI_BACKEND == EPD_SPI_BACKEND_HW
+    spi_transaction_t *done;
+    if(!SPI_Async_Active)
+        return;
+    SPI_Async_Active = 0;
+    while(SPI_Async_Inflight > 0) {
+        spi_device_get_trans_result(SPI_Handle, &done, portMAX_DELAY);
+        SPI_Async_Inflight--;
+        SPI_Async_Queue();
+    }
+    digitalWrite(EPD_CS_PIN, GPIO_PIN_SET);
+#endif
+}
+
+const DEV_HAL DEV_HAL_Arduino = {
+    Arduino_Digital_Write,
+    Arduino_Digital_Read,
+    Arduino_SPI_WriteByte,
+    Arduino_SPI_ReadByte,
+    Arduino_SPI_Write_nByte,
+    Arduino_Delay_ms,
+    Arduino_Millis,
+    Arduino_Micros,
+    Arduino_SPI_Write_Start,
+    Arduino_SPI_Write_Wait,
+};
+
+const DEV_HAL *DEV_HAL_Active = &DEV_HAL_Arduino;
+
+/******************************************************************************
+function:	Transfer throughput benchmark
+parameter:
+    len : bytes per run, e.g. one 5.83" plane is 38880
+Info:
+    Sends the same burst through every available backend and prints the time
+    and throughput of each. Run it after DEV_Module_Init() and before the
+    panel is initialised: without a preceding command the controller drops
+    the data bytes.
+******************************************************************************/
+void DEV_SPI_Benchmark(UDOUBLE len)
+{
+    UBYTE saved = SPI_Backend;
+    UDOUBLE size = len > 16384 ? 16384 : len;
+    UBYTE *pattern = (UBYTE *)malloc(size);
+    if(pattern == NULL) {
+        printf("Failed to apply for benchmark memory...\r\n");
+        return;
+    }
+    for(UDOUBLE i = 0; i < size; i++)
+        pattern[i] = (UBYTE)i;
+
+    digitalWrite(EPD_DC_PIN, GPIO_PIN_SET);
+    for(UBYTE backend = EPD_SPI_BACKEND_BITBANG; backend <= EPD_SPI_BACKEND_HW; backend++) {
+        DEV_SPI_SetBackend(backend);
+        if(SPI_Backend != backend)
+            continue;
+
+        UDOUBLE start = micros();
+        UDOUBLE sent = 0;
+        while(sent < len) {
+            UDOUBLE n = len - sent > size ? size : len - sent;
+            Arduino_SPI_Write_nByte(pattern, n);
+            sent += n;
+        }
+        UDOUBLE burst = micros() - start;
+
+        start = micros();
+        for(sent = 0; sent < len; sent++)
+            Arduino_SPI_WriteByte(pattern[sent % size]);
+        UDOUBLE single = micros() - start;
+
+        printf("SPI %s: %lu bytes, burst %lu us (%lu KB/s), per byte %lu us (%lu KB/s)\r\n",
+               backend == EPD_SPI_BACKEND_HW ? "hw+dma" : "bitbang", (unsigned long)len,
+               (unsigned long)burst, (unsigned long)(burst ? (uint64_t)len * 1000 / burst : 0),
+               (unsigned long)single, (unsigned long)(single ? (uint64_t)len * 1000 / single : 0));
+    }
+    DEV_SPI_SetBackend(saved);
+    free(pattern);
+}
+#endif
+
+/******************************************************************************
+function:	Swap the hardware backend
+parameter:
+    hal : backend to use from now on, e.g. &DEV_HAL_Arduino or &DEV_HAL_Host
+******************************************************************************/
+void DEV_HAL_Set(const DEV_HAL *hal)
+{
+    DEV_HAL_Active = hal;
+}
+
+/******************************************************************************
+function:
+			SPI read and write through the active backend
+******************************************************************************/
+void DEV_SPI_WriteByte(UBYTE data)
+{
+    DEV_HAL_Active->SPI_WriteByte(data);
+}
+
+UBYTE DEV_SPI_ReadByte()
+{
+    return DEV_HAL_Active->SPI_ReadByte();
+}
+
+void DEV_SPI_Write_nByte(const UBYTE *pData, UDOUBLE len)
+{
+    DEV_HAL_Active->SPI_Write_nByte(pData, len);
+}
+
+/******************************************************************************
+function:	Start a burst in the background, DEV_SPI_Write_Wait() ends it
+parameter:
+    pData : data to send, left untouched until DEV_SPI_Write_Wait()
+    len   : number of bytes
+Info:
+    One burst at a time. A backend without background transfers sends it
+    at once and the wait returns immediately.
+******************************************************************************/
+void DEV_SPI_Write_Start(const UBYTE *pData, UDOUBLE len)
+{
+    if(DEV_HAL_Active->SPI_Write_Start != NULL)
+        DEV_HAL_Active->SPI_Write_Start(pData, len);
+    else
+        DEV_HAL_Active->SPI_Write_nByte(pData, len);
+}
+
+void DEV_SPI_Write_Wait(void)
+{
+    if(DEV_HAL_Active->SPI_Write_Wait != NULL)
+        DEV_HAL_Active->SPI_Write_Wait();
+}
+
+/******************************************************************************
+function:	BUSY wait
+Info:
+    One wait can be outstanding at a time. DEV_Busy_Async() arms it and
+    returns at once, DEV_Busy_Poll() / DEV_Busy_Await() finish it: they detach
+    the interrupt, add the wait to the statistics and run the callback, always
+    in task context. On ESP32 an edge interrupt on EPD_BUSY_PIN wakes the
+    awaiting task (or the task set with DEV_Busy_NotifyTask()), so nothing
+    polls the pin or the SPI bus during the refresh.
+******************************************************************************/
+static DEV_BUSY_STAT Busy_Stat = {0, 0, 0, 0, 0};
+static volatile UBYTE Busy_Pending = 0;
+static UBYTE Busy_Idle_Level, Busy_Result = 0;
+static UDOUBLE Busy_Start, Busy_Timeout;
+static DEV_BUSY_CALLBACK Busy_Callback = NULL;
+static void *Busy_Arg = NULL;
+
+#ifdef ESP32
+static TaskHandle_t Busy_Notify = NULL;
+static volatile TaskHandle_t Busy_Task = NULL;
+static UBYTE Busy_Irq = 0;
+
+static void IRAM_ATTR Busy_ISR(void)
+{
+    BaseType_t woken = pdFALSE;
+    if(Busy_Task != NULL)
+        vTaskNotifyGiveFromISR(Busy_Task, &woken);
+    if(woken)
+        portYIELD_FROM_ISR();
+}
+
+void DEV_Busy_NotifyTask(TaskHandle_t task)
+{
+    Busy_Notify = task;
+}
+#endif
+
+/******************************************************************************
+function:	Start waiting for the BUSY pin to reach its idle level
+parameter:
+    idle_level : level of EPD_BUSY_PIN when the controller is ready, it is 1
+                 on the UC81xx family and 0 on the SSD16xx family
+    timeout_ms : give up after this many ms, 0 waits forever
+    callback   : called once when the wait ends, may be NULL
+    arg        : passed to callback
+Info:
+    A wait that is still outstanding is finished first.
+******************************************************************************/
+void DEV_Busy_Async(UBYTE idle_level, UDOUBLE timeout_ms, DEV_BUSY_CALLBACK callback, void *arg)
+{
+    if(Busy_Pending)
+        DEV_Busy_Await();
+
+    Busy_Idle_Level = idle_level;
+    Busy_Timeout = timeout_ms;
+    Busy_Callback = callback;
+    Busy_Arg = arg;
+    Busy_Start = DEV_Millis();
+    Busy_Pending = 1;
+#ifdef ESP32
+    Busy_Irq = (DEV_HAL_Active == &DEV_HAL_Arduino);
+    if(Busy_Irq) {
+        Busy_Task = Busy_Notify;
+        attachInterrupt(digitalPinToInterrupt(EPD_BUSY_PIN), Busy_ISR, idle_level ? RISING : FALLING);
+    }
+#endif
+}
+
+/******************************************************************************
+function:	Check an outstanding BUSY wait without blocking
+Info:
+    Returns 1 when nothing is outstanding any more, 0 while the panel is
+    still busy.
+******************************************************************************/
+UBYTE DEV_Busy_Poll(void)
+{
+    if(!Busy_Pending)
+        return 1;
+
+    UBYTE timeout = 0;
+    UDOUBLE elapsed = DEV_Millis() - Busy_Start;
+    if(DEV_Digital_Read(EPD_BUSY_PIN) != Busy_Idle_Level) {
+        if(Busy_Timeout == 0 || elapsed < Busy_Timeout)
+            return 0;
+        timeout = 1;
+    }
+
+#ifdef ESP32
+    if(Busy_Irq)
+        detachInterrupt(digitalPinToInterrupt(EPD_BUSY_PIN));
+    Busy_Task = NULL;
+#endif
+    Busy_Stat.Count++;
+    Busy_Stat.Last_ms = elapsed;
+    Busy_Stat.Total_ms += elapsed;
+    if(elapsed > Busy_Stat.Max_ms)
+        Busy_Stat.Max_ms = elapsed;
+    if(timeout) {
+        Busy_Stat.Timeouts++;
+        printf("e-Paper busy timeout after %lu ms\r\n", (unsigned long)elapsed);
+    }
+    Busy_Result = timeout;
+    Busy_Pending = 0;
+
+    if(Busy_Callback != NULL) {
+        DEV_BUSY_CALLBACK callback = Busy_Callback;
+        Busy_Callback = NULL;
+        callback(Busy_Arg, timeout);
+    }
+    return 1;
+}
+
+UBYTE DEV_Busy_Pending(void)
+{
+    return Busy_Pending;
+}
+
+/******************************************************************************
+function:	Block until the outstanding BUSY wait ends
+Info:
+    Returns 0 once the panel is idle, 1 on timeout.
+******************************************************************************/
+UBYTE DEV_Busy_Await(void)
+{
+#ifdef ESP32
+    //Take over the notification before sampling the pin, an edge in between
+    //only leaves a pending notification behind and costs one extra loop
+    ulTaskNotifyTake(pdTRUE, 0);
+    Busy_Task = xTaskGetCurrentTaskHandle();
+#endif
+    while(!DEV_Busy_Poll()) {
+#ifdef ESP32
+        if(Busy_Irq) {
+            UDOUBLE elapsed = DEV_Millis() - Busy_Start;
+            ulTaskNotifyTake(pdTRUE, Busy_Timeout == 0 ? portMAX_DELAY :
+                             pdMS_TO_TICKS(elapsed < Busy_Timeout ? Busy_Timeout - elapsed : 1));
+            continue;
+        }
+#endif
+        DEV_Delay_ms(1);
+    }
+    return Busy_Result;
+}
+
+/******************************************************************************
+function:	Wait for the BUSY pin to reach its idle level
+parameter:
+    idle_level : see DEV_Busy_Async()
+    timeout_ms : give up after this many ms, 0 waits forever
+Info:
+    Returns 0 once the panel is idle, 1 on timeout.
+******************************************************************************/
+UBYTE DEV_Wait_Busy(UBYTE idle_level, UDOUBLE timeout_ms)
+{
+    DEV_Busy_Async(idle_level, timeout_ms, NULL, NULL);
+    return DEV_Busy_Await();
+}
+
+void DEV_Busy_GetStat(DEV_BUSY_STAT *stat)
+{
+    *stat = Busy_Stat;
+}
+
+void DEV_Busy_ClearStat(void)
 {
-    for (int i = 0; i < len; i++)
-        DEV_SPI_WriteByte(pData[i]);
+    memset(&Busy_Stat, 0, sizeof(Busy_Stat));
 }
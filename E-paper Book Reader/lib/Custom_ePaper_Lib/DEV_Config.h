@@ -30,7 +30,9 @@
 #ifndef _DEV_CONFIG_H_
 #define _DEV_CONFIG_H_
 
+#ifdef ARDUINO
 #include <Arduino.h>
+#endif
 #include <stdint.h>
 #include <stdio.h>
 
@@ -54,22 +56,112 @@
 #define GPIO_PIN_SET   1
 #define GPIO_PIN_RESET 0
 
+/**
+ * SPI backend
+ *   EPD_SPI_BACKEND_BITBANG : software SPI on EPD_SCK_PIN / EPD_MOSI_PIN (fallback)
+ *   EPD_SPI_BACKEND_HW      : ESP32 HSPI peripheral, bursts are moved by DMA
+ * Select with -DEPD_SPI_BACKEND=... in build_flags, the default is hardware SPI.
+**/
+#define EPD_SPI_BACKEND_BITBANG 0
+#define EPD_SPI_BACKEND_HW      1
+
+#ifndef EPD_SPI_BACKEND
+#define EPD_SPI_BACKEND EPD_SPI_BACKEND_HW
+#endif
+#if EPD_SPI_BACKEND == EPD_SPI_BACKEND_HW && !defined(ESP32)
+#undef  EPD_SPI_BACKEND
+#define EPD_SPI_BACKEND EPD_SPI_BACKEND_BITBANG
+#endif
+
+#ifndef EPD_SPI_CLOCK_HZ
+#define EPD_SPI_CLOCK_HZ 10000000
+#endif
+#define EPD_SPI_DMA_CHUNK 4092  //largest single DMA transaction
+#ifndef EPD_SPI_QUEUE
+#define EPD_SPI_QUEUE 6         //DMA transactions DEV_SPI_Write_Start() queues ahead
+#endif
+
+/**
+ * BUSY wait
+ *   EPD_BUSY_TIMEOUT_MS : give up on a BUSY wait after this long, 0 waits forever
+ * On ESP32 the waiting task blocks on a BUSY pin edge interrupt, so the core
+ * idles (or light sleeps) for the whole refresh instead of polling the pin.
+ * DEV_Busy_Async() starts a wait without blocking, DEV_Busy_Poll() or
+ * DEV_Busy_Await() finish it.
+**/
+#ifndef EPD_BUSY_TIMEOUT_MS
+#define EPD_BUSY_TIMEOUT_MS 60000
+#endif
+
+typedef struct {
+    UDOUBLE Count;      //completed waits
+    UDOUBLE Timeouts;   //waits that hit the timeout
+    UDOUBLE Last_ms;
+    UDOUBLE Max_ms;
+    UDOUBLE Total_ms;
+} DEV_BUSY_STAT;
+
+//Runs in task context when an asynchronous BUSY wait ends, timeout is 1 if it gave up
+typedef void (*DEV_BUSY_CALLBACK)(void *arg, UBYTE timeout);
+
+/**
+ * Hardware abstraction
+ *   Drivers and GUI_Paint only reach the hardware through the active DEV_HAL.
+ *   The default is the Arduino backend in DEV_Config.cpp on the target and
+ *   the simulated panel of DEV_Host.h in a host build; DEV_HAL_Set() swaps it.
+**/
+typedef struct {
+    void    (*Digital_Write)(UWORD Pin, UBYTE Value);
+    UBYTE   (*Digital_Read)(UWORD Pin);
+    void    (*SPI_WriteByte)(UBYTE Data);
+    UBYTE   (*SPI_ReadByte)(void);
+    void    (*SPI_Write_nByte)(const UBYTE *pData, UDOUBLE Len);   //CS held for the whole burst
+    void    (*Delay_ms)(UDOUBLE xms);
+    UDOUBLE (*Millis)(void);
+    UDOUBLE (*Micros)(void);
+    void    (*SPI_Write_Start)(const UBYTE *pData, UDOUBLE Len);   //burst in the background, NULL: none
+    void    (*SPI_Write_Wait)(void);
+} DEV_HAL;
+
+extern const DEV_HAL *DEV_HAL_Active;
+
 /**
  * GPIO read and write
 **/
-#define DEV_Digital_Write(_pin, _value) digitalWrite(_pin, _value == 0? LOW:HIGH)
-#define DEV_Digital_Read(_pin) digitalRead(_pin)
+#define DEV_Digital_Write(_pin, _value) DEV_HAL_Active->Digital_Write(_pin, _value)
+#define DEV_Digital_Read(_pin) DEV_HAL_Active->Digital_Read(_pin)
 
 /**
- * delay x ms
+ * delay x ms, time since start
 **/
-#define DEV_Delay_ms(__xms) delay(__xms)
+#define DEV_Delay_ms(__xms) DEV_HAL_Active->Delay_ms(__xms)
+#define DEV_Millis() DEV_HAL_Active->Millis()
+#define DEV_Micros() DEV_HAL_Active->Micros()
 
 /*------------------------------------------------------------------------------------------------------*/
 UBYTE DEV_Module_Init(void);
-void GPIO_Mode(UWORD GPIO_Pin, UWORD Mode);
+void DEV_HAL_Set(const DEV_HAL *hal);
 void DEV_SPI_WriteByte(UBYTE data);
 UBYTE DEV_SPI_ReadByte();
-void DEV_SPI_Write_nByte(UBYTE *pData, UDOUBLE len);
+void DEV_SPI_Write_nByte(const UBYTE *pData, UDOUBLE len);
+void DEV_SPI_Write_Start(const UBYTE *pData, UDOUBLE len);
+void DEV_SPI_Write_Wait(void);
+#ifdef ARDUINO
+extern const DEV_HAL DEV_HAL_Arduino;
+void GPIO_Mode(UWORD GPIO_Pin, UWORD Mode);
+void DEV_SPI_SetBackend(UBYTE backend);
+UBYTE DEV_SPI_GetBackend(void);
+void DEV_SPI_Benchmark(UDOUBLE len);
+#endif
+UBYTE DEV_Wait_Busy(UBYTE idle_level, UDOUBLE timeout_ms);
+void DEV_Busy_Async(UBYTE idle_level, UDOUBLE timeout_ms, DEV_BUSY_CALLBACK callback, void *arg);
+UBYTE DEV_Busy_Poll(void);
+UBYTE DEV_Busy_Await(void);
+UBYTE DEV_Busy_Pending(void);
+#ifdef ESP32
+void DEV_Busy_NotifyTask(TaskHandle_t task);
+#endif
+void DEV_Busy_GetStat(DEV_BUSY_STAT *stat);
+void DEV_Busy_ClearStat(void);
 
 #endif
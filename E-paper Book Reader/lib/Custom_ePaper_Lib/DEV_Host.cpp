@@ -0,0 +1,302 @@
+/*****************************************************************************
+* | File      	:   DEV_Host.cpp
+* | Function    :   Simulated panel backend for host builds
+* | Info        :
+*----------------
+* |	This version:   V1.0
+* | Date        :   2026-10-17
+* | Info        :
+******************************************************************************/
+#include "DEV_Host.h"
+
+#ifndef ARDUINO
+#include <stdlib.h>
+#include <string.h>
+
+static uint64_t Host_Clock_ns = 0;
+static uint64_t Host_Busy_Until_ns = 0;
+static uint64_t Host_SPI_ns = 0;
+static UBYTE Host_Busy_Level = 0;           //UC81xx: BUSY low while busy
+static UBYTE Host_DC = 0;
+static UBYTE Host_Last_Cmd = 0;
+static UDOUBLE Host_SPI_Hz = EPD_SPI_CLOCK_HZ;
+static UDOUBLE Host_Busy_Time[256];
+static UBYTE Host_Busy_Time_Init = 0;
+
+static UBYTE Host_Record_On = 1;
+static DEV_HOST_BYTE *Host_Stream = NULL;
+static UDOUBLE Host_Stream_Len = 0, Host_Stream_Size = 0;
+
+static DEV_HOST_STAT Host_Stat;
+
+static const UBYTE *Host_Async_Data = NULL;     //burst of Host_SPI_Write_Start(), not sent yet
+static UDOUBLE Host_Async_Len = 0;
+
+static void Host_SPI_Write_Wait(void);
+
+static void Host_Busy_Time_Default(void)
+{
+    memset(Host_Busy_Time, 0, sizeof(Host_Busy_Time));
+    Host_Busy_Time[0x12] = EPD_HOST_REFRESH_MS;     //UC81xx display refresh
+    Host_Busy_Time[0x20] = EPD_HOST_REFRESH_MS;     //SSD16xx master activation
+    Host_Busy_Time[0x04] = EPD_HOST_POWER_MS;       //power on
+    Host_Busy_Time[0x02] = EPD_HOST_POWER_MS;       //power off
+    Host_Busy_Time_Init = 1;
+}
+
+static void Host_Put(UBYTE value)
+{
+    if(Host_DC == 0) {
+        Host_Stat.Commands++;
+        Host_Last_Cmd = value;
+        if(!Host_Busy_Time_Init)
+            Host_Busy_Time_Default();
+        if(Host_Busy_Time[value] != 0) {
+            Host_Busy_Until_ns = Host_Clock_ns + (uint64_t)Host_Busy_Time[value] * 1000000;
+            Host_Stat.Busy_ms += Host_Busy_Time[value];
+        }
+    } else {
+        Host_Stat.Data_Bytes++;
+        Host_Stat.Cmd_Data[Host_Last_Cmd]++;
+    }
+
+    if(!Host_Record_On)
+        return;
+    if(Host_Stream_Len == Host_Stream_Size) {
+        UDOUBLE size = Host_Stream_Size ? Host_Stream_Size * 2 : 4096;
+        DEV_HOST_BYTE *p = (DEV_HOST_BYTE *)realloc(Host_Stream, size * sizeof(DEV_HOST_BYTE));
+        if(p == NULL) {
+            printf("Failed to apply for host stream memory...\r\n");
+            Host_Record_On = 0;
+            return;
+        }
+        Host_Stream = p;
+        Host_Stream_Size = size;
+    }
+    Host_Stream[Host_Stream_Len].DC = Host_DC;
+    Host_Stream[Host_Stream_Len].Value = value;
+    Host_Stream_Len++;
+}
+
+static void Host_SPI_Time(UDOUBLE len)
+{
+    uint64_t ns = (uint64_t)len * 8 * 1000000000 / Host_SPI_Hz;
+    Host_Clock_ns += ns;
+    Host_SPI_ns += ns;
+    Host_Stat.SPI_us = (UDOUBLE)(Host_SPI_ns / 1000);
+}
+
+static void Host_Digital_Write(UWORD Pin, UBYTE Value)
+{
+    if(Pin == EPD_DC_PIN || Pin == EPD_CS_PIN)
+        Host_SPI_Write_Wait();
+    Host_Stat.Pin_Writes++;
+    if(Pin == EPD_DC_PIN)
+        Host_DC = Value ? 1 : 0;
+}
+
+static UBYTE Host_Digital_Read(UWORD Pin)
+{
+    if(Pin != EPD_BUSY_PIN)
+        return 0;
+    if(Host_Clock_ns < Host_Busy_Until_ns)
+        return Host_Busy_Level;
+    return !Host_Busy_Level;
+}
+
+static void Host_SPI_WriteByte(UBYTE Data)
+{
+    Host_SPI_Write_Wait();
+    Host_Stat.Single_Writes++;
+    Host_SPI_Time(1);
+    Host_Put(Data);
+}
+
+static UBYTE Host_SPI_ReadByte(void)
+{
+    Host_SPI_Write_Wait();
+    Host_SPI_Time(1);
+    return 0xff;
+}
+
+static void Host_SPI_Write_nByte(const UBYTE *pData, UDOUBLE Len)
+{
+    Host_SPI_Write_Wait();
+    Host_Stat.Bursts++;
+    Host_SPI_Time(Len);
+    for(UDOUBLE i = 0; i < Len; i++)
+        Host_Put(pData[i]);
+}
+
+/******************************************************************************
+function:	Background burst
+Info:
+    The bytes are taken at the wait, not at the start, so a caller that
+    reuses the buffer too early sends the wrong data here as it would
+    through DMA on the target.
+******************************************************************************/
+static void Host_SPI_Write_Wait(void)
+{
+    const UBYTE *pData = Host_Async_Data;
+    if(pData == NULL)
+        return;
+    Host_Async_Data = NULL;
+    Host_SPI_Write_nByte(pData, Host_Async_Len);
+}
+
+static void Host_SPI_Write_Start(const UBYTE *pData, UDOUBLE Len)
+{
+    Host_SPI_Write_Wait();
+    Host_Async_Data = pData;
+    Host_Async_Len = Len;
+}
+
+static void Host_Delay_ms(UDOUBLE xms)
+{
+    Host_Clock_ns += (uint64_t)xms * 1000000;
+    Host_Stat.Delay_ms += xms;
+}
+
+static UDOUBLE Host_Millis(void)
+{
+    return (UDOUBLE)(Host_Clock_ns / 1000000);
+}
+
+static UDOUBLE Host_Micros(void)
+{
+    return (UDOUBLE)(Host_Clock_ns / 1000);
+}
+
+const DEV_HAL DEV_HAL_Host = {
+    Host_Digital_Write,
+    Host_Digital_Read,
+    Host_SPI_WriteByte,
+    Host_SPI_ReadByte,
+    Host_SPI_Write_nByte,
+    Host_Delay_ms,
+    Host_Millis,
+    Host_Micros,
+    Host_SPI_Write_Start,
+    Host_SPI_Write_Wait,
+};
+
+const DEV_HAL *DEV_HAL_Active = &DEV_HAL_Host;
+
+/******************************************************************************
+function:	Module Initialize, starts a fresh recording
+parameter:
+Info:
+******************************************************************************/
+UBYTE DEV_Module_Init(void)
+{
+    DEV_Host_Reset();
+    return 0;
+}
+
+/******************************************************************************
+function:	Drop the recorded stream and statistics, the BUSY setup is kept
+******************************************************************************/
+void DEV_Host_Reset(void)
+{
+    memset(&Host_Stat, 0, sizeof(Host_Stat));
+    Host_Stream_Len = 0;
+    Host_SPI_ns = 0;
+    Host_Busy_Until_ns = Host_Clock_ns;
+    Host_DC = 0;
+    Host_Last_Cmd = 0;
+    Host_Async_Data = NULL;
+}
+
+/******************************************************************************
+function:	BUSY simulation
+parameter:
+    level : level of EPD_BUSY_PIN while busy, 0 for UC81xx, 1 for SSD16xx
+    cmd   : command that asserts BUSY
+    ms    : how long it stays asserted, 0 to never assert it
+Info:
+    By default 0x12 and 0x20 assert BUSY for EPD_HOST_REFRESH_MS and 0x04 /
+    0x02 for EPD_HOST_POWER_MS. On SSD16xx panels 0x12 is only a software
+    reset, set it to a few ms there.
+******************************************************************************/
+void DEV_Host_SetBusyLevel(UBYTE level)
+{
+    Host_Busy_Level = level ? 1 : 0;
+}
+
+void DEV_Host_SetBusyTime(UBYTE cmd, UDOUBLE ms)
+{
+    if(!Host_Busy_Time_Init)
+        Host_Busy_Time_Default();
+    Host_Busy_Time[cmd] = ms;
+}
+
+void DEV_Host_SetSPIClock(UDOUBLE hz)
+{
+    if(hz != 0)
+        Host_SPI_Hz = hz;
+}
+
+/******************************************************************************
+function:	Recorded command / data stream
+parameter:
+    enable : 0 only keeps the counters, e.g. for long benchmarks
+    len    : receives the number of recorded bytes
+******************************************************************************/
+void DEV_Host_Record(UBYTE enable)
+{
+    Host_Record_On = enable;
+}
+
+const DEV_HOST_BYTE *DEV_Host_GetStream(UDOUBLE *len)
+{
+    *len = Host_Stream_Len;
+    return Host_Stream;
+}
+
+void DEV_Host_GetStat(DEV_HOST_STAT *stat)
+{
+    *stat = Host_Stat;
+}
+
+/******************************************************************************
+function:	Print the counters of the current recording
+parameter:
+    name : label for the line, e.g. the function that was measured
+******************************************************************************/
+void DEV_Host_PrintStat(const char *name)
+{
+    printf("%-28s cmd:%6lu data:%8lu bursts:%6lu single:%7lu pins:%8lu "
+           "spi:%7lu us busy:%6lu ms delay:%6lu ms\r\n", name,
+           (unsigned long)Host_Stat.Commands, (unsigned long)Host_Stat.Data_Bytes,
+           (unsigned long)Host_Stat.Bursts, (unsigned long)Host_Stat.Single_Writes,
+           (unsigned long)Host_Stat.Pin_Writes, (unsigned long)Host_Stat.SPI_us,
+           (unsigned long)Host_Stat.Busy_ms, (unsigned long)Host_Stat.Delay_ms);
+}
+
+/******************************************************************************
+function:	Write the recorded stream as one line per command
+parameter:
+    fp : output, e.g. stdout
+Info:
+    Each line holds the command, the number of data bytes that followed it
+    and the first few of them.
+******************************************************************************/
+void DEV_Host_Dump(FILE *fp)
+{
+    UDOUBLE i = 0;
+    while(i < Host_Stream_Len) {
+        UDOUBLE n = 0;
+        if(Host_Stream[i].DC == 0)
+            fprintf(fp, "C %02X", Host_Stream[i++].Value);
+        else
+            fprintf(fp, "C --");
+        while(i + n < Host_Stream_Len && Host_Stream[i + n].DC == 1)
+            n++;
+        fprintf(fp, " D %6lu:", (unsigned long)n);
+        for(UDOUBLE k = 0; k < n && k < 8; k++)
+            fprintf(fp, " %02X", Host_Stream[i + k].Value);
+        fprintf(fp, n > 8 ? " ...\n" : "\n");
+        i += n;
+    }
+}
+#endif
@@ -0,0 +1,62 @@
+/*****************************************************************************
+* | File      	:   DEV_Host.h
+* | Function    :   Simulated panel backend for host builds
+* | Info        :
+*   Replaces the Arduino backend when the library is built without ARDUINO.
+*   Nothing is driven: every command and data byte is recorded together with
+*   the DC level, time is simulated (delays and SPI transfers advance a
+*   virtual clock) and BUSY is asserted for a configurable time after the
+*   commands that start a refresh or a power transition.
+*----------------
+* |	This version:   V1.0
+* | Date        :   2026-10-17
+* | Info        :
+******************************************************************************/
+#ifndef _DEV_HOST_H_
+#define _DEV_HOST_H_
+
+#include "DEV_Config.h"
+
+#ifndef ARDUINO
+
+#ifndef EPD_HOST_REFRESH_MS
+#define EPD_HOST_REFRESH_MS 3000    //simulated BUSY time of a full refresh
+#endif
+#ifndef EPD_HOST_POWER_MS
+#define EPD_HOST_POWER_MS   100     //simulated BUSY time of power on / off
+#endif
+
+/**
+ * One recorded byte
+**/
+typedef struct {
+    UBYTE DC;       //0: command, 1: data
+    UBYTE Value;
+} DEV_HOST_BYTE;
+
+typedef struct {
+    UDOUBLE Commands;
+    UDOUBLE Data_Bytes;
+    UDOUBLE Single_Writes;      //DEV_SPI_WriteByte calls
+    UDOUBLE Bursts;             //DEV_SPI_Write_nByte calls
+    UDOUBLE Pin_Writes;
+    UDOUBLE Busy_ms;            //simulated time with BUSY asserted
+    UDOUBLE Delay_ms;           //simulated time spent in DEV_Delay_ms
+    UDOUBLE SPI_us;             //simulated time on the SPI bus
+    UDOUBLE Cmd_Data[256];      //data bytes sent after each command
+} DEV_HOST_STAT;
+
+extern const DEV_HAL DEV_HAL_Host;
+
+void DEV_Host_Reset(void);
+void DEV_Host_SetBusyLevel(UBYTE level);
+void DEV_Host_SetBusyTime(UBYTE cmd, UDOUBLE ms);
+void DEV_Host_SetSPIClock(UDOUBLE hz);
+void DEV_Host_Record(UBYTE enable);
+const DEV_HOST_BYTE *DEV_Host_GetStream(UDOUBLE *len);
+void DEV_Host_GetStat(DEV_HOST_STAT *stat);
+void DEV_Host_PrintStat(const char *name);
+void DEV_Host_Dump(FILE *fp);
+
+#endif
+#endif
@@ -2,6 +2,14 @@
 #define __EPD_H_ 
 
 #include "utility/Debug.h"
+
+/**
+ * Build with e.g. -DEPD_PANEL_HEADER='"utility/EPD_5in83b_V2.h"' to pull in
+ * only the panel in use, otherwise every panel header is included.
+**/
+#ifdef EPD_PANEL_HEADER
+#include EPD_PANEL_HEADER
+#else
 #include "utility/EPD_1in02.h"
 #include "utility/EPD_1in54.h"
 #include "utility/EPD_1in54_V2.h"
@@ -63,5 +71,9 @@
 #include "utility/EPD_7in5b_HD.h"
 #include "utility/EPD_13in3b.h"
 #include "utility/EPD_13in3k.h"
+#endif
+#include "utility/EPD_Model.h"
+#include "utility/EPD_Power.h"
+#include "utility/EPD_Shadow.h"
 
 #endif
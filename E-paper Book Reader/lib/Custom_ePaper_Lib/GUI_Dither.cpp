@@ -0,0 +1,231 @@
+/*****************************************************************************
+* | File      	:	GUI_Dither.cpp
+* | Function    :   Dither 8 bit gray images row by row
+* | Info        :
+*----------------
+* |	This version:   V1.0
+* | Date        :   2026-10-17
+* | Info        :
+******************************************************************************/
+#include "GUI_Dither.h"
+#include "utility/Debug.h"
+#include <string.h>
+
+//Thresholds 0..63 of the 8x8 Bayer matrix
+static const UBYTE Dither_Bayer[8][8] = {
+    { 0, 32,  8, 40,  2, 34, 10, 42},
+    {48, 16, 56, 24, 50, 18, 58, 26},
+    {12, 44,  4, 36, 14, 46,  6, 38},
+    {60, 28, 52, 20, 62, 30, 54, 22},
+    { 3, 35, 11, 43,  1, 33,  9, 41},
+    {51, 19, 59, 27, 49, 17, 57, 25},
+    {15, 47,  7, 39, 13, 45,  5, 37},
+    {63, 31, 55, 23, 61, 29, 53, 21},
+};
+
+/******************************************************************************
+function :	Set up dithering of an image
+parameter:
+    Width  : pixels per row
+    Levels : 2 for 1 bit, 4 for 4 gray
+    Kernel : DITHER_ORDERED or DITHER_DIFFUSE
+    Error  : Width + 2 entries for DITHER_DIFFUSE, NULL for DITHER_ORDERED
+******************************************************************************/
+void Dither_Init(DITHER *Dither, UWORD Width, UBYTE Levels, DITHER_KERNEL Kernel, int16_t *Error)
+{
+    memset(Dither, 0, sizeof(DITHER));
+    Dither->Width = Width;
+    Dither->Levels = (Levels == 4)? 4 : 2;
+    Dither->Kernel = Kernel;
+    Dither->Error = Error;
+    if(Kernel == DITHER_DIFFUSE && Error == NULL) {
+        Debug("Dither_Init no error row, dithering ordered\r\n");
+        Dither->Kernel = DITHER_ORDERED;
+    }
+    Dither_Reset(Dither);
+}
+
+/******************************************************************************
+function :	Start again from the top row
+parameter:
+******************************************************************************/
+void Dither_Reset(DITHER *Dither)
+{
+    Dither->Y = 0;
+    if(Dither->Error != NULL)
+        memset(Dither->Error, 0, (Dither->Width + 2) * sizeof(int16_t));
+}
+
+/******************************************************************************
+function :	Dither the next row
+parameter:
+    Row : Width gray values in, Width levels out
+Info:
+    Fixed point, 16 steps per gray value. Error diffusion runs left to
+    right and right to left on alternate rows, and carries 7/16 of the
+    error to the next pixel of the row, 3/16, 5/16 and 1/16 to the row
+    below: the part for the row below goes into the error row in place of
+    the entries this row has already used.
+******************************************************************************/
+void Dither_Row(DITHER *Dither, UBYTE *Row)
+{
+    UWORD Width = Dither->Width, i;
+    int Max = Dither->Levels - 1;
+    int x, v, e, L, Dir, Carry, Below;
+    int16_t *Error;
+
+    if(Dither->Kernel == DITHER_ORDERED) {
+        const UBYTE *T = Dither_Bayer[Dither->Y % 8];
+        for(i = 0; i < Width; i++) {
+            L = ((UDOUBLE)Row[i] * Max * 128 + (2 * T[i % 8] + 1) * 255) / (255 * 128);
+            Row[i] = L;
+        }
+        Dither->Y++;
+        return;
+    }
+
+    Error = Dither->Error + 1;     //Error[-1] and Error[Width] take what falls off the row
+    Dir = (Dither->Y & 1)? -1 : 1;
+    x = (Dir > 0)? 0 : Width - 1;
+    Carry = 0;
+    Below = 0;
+    for(i = 0; i < Width; i++, x += Dir) {
+        v = Row[x] * 16 + Error[x] + Carry;
+        L = (v <= 0)? 0 : (v >= 255 * 16)? Max : (v * Max + 255 * 8) / (255 * 16);
+        e = v - L * (255 * 16) / Max;
+        Carry = e * 7 / 16;
+        Error[x - Dir] += e * 3 / 16;
+        Error[x] = Below + e * 5 / 16;
+        Below = e / 16;
+        Row[x] = L;
+    }
+    Dither->Y++;
+}
+
+/******************************************************************************
+function :	Pack a row of levels as Paint_SetScale(2) or (4) does
+parameter:
+    Level  : Width levels
+    Levels : 2: 1 bit per pixel, 4: 2 bits per pixel
+    Out    : (Width + 7) / 8 or (Width + 3) / 4 bytes
+******************************************************************************/
+void Dither_Pack(const UBYTE *Level, UWORD Width, UBYTE Levels, UBYTE *Out)
+{
+    UBYTE Bits = (Levels == 4)? 2 : 1, PPB = 8 / Bits, Byte = 0;
+    UWORD x;
+
+    for(x = 0; x < Width; x++) {
+        Byte = (Byte << Bits) | Level[x];
+        if(x % PPB == PPB - 1)
+            *Out++ = Byte;
+    }
+    if(x % PPB != 0)
+        *Out = Byte << (Bits * (PPB - x % PPB));
+}
+
+/******************************************************************************
+function :	One bit plane of a row of levels
+parameter:
+    Level  : Width levels
+    Map    : plane bits of the 4 gray levels, e.g. EPD_7IN5_V2_GRAY,
+             NULL: the level itself, 1 white
+    Plane  : 0 or 1
+    Out    : (Width + 7) / 8 bytes
+Info:
+    2 levels are black and white of the map.
+******************************************************************************/
+void Dither_PackPlane(const UBYTE *Level, UWORD Width, UBYTE Levels, const UBYTE *Map, UBYTE Plane, UBYTE *Out)
+{
+    UBYTE Bit[4], Byte = 0, L;
+    UWORD x;
+
+    for(L = 0; L < Levels; L++)
+        Bit[L] = (Map != NULL)? (Map[L * 3 / (Levels - 1)] >> Plane) & 0x01 : (L * 2 >= Levels);
+    for(x = 0; x < Width; x++) {
+        Byte = (Byte << 1) | Bit[Level[x] % Levels];
+        if(x % 8 == 7)
+            *Out++ = Byte;
+    }
+    if(x % 8 != 0)
+        *Out = Byte << (8 - x % 8);
+}
+
+/******************************************************************************
+function :	Where the rows of the image come from
+parameter:
+    Source : reads a row
+    arg    : passed to Source
+    Row    : Width bytes, the row being dithered
+    Map    : plane bits of the 4 gray levels for Dither_RenderBand(), NULL: 1 bit
+******************************************************************************/
+void Dither_SetSource(DITHER *Dither, DITHER_SOURCE Source, void *arg, UBYTE *Row, const UBYTE *Map)
+{
+    Dither->Source = Source;
+    Dither->arg = arg;
+    Dither->Row = Row;
+    Dither->Map = Map;
+}
+
+//Next row of the image, dithered, rows before Y of a restarted diffusion are dithered again
+static UBYTE Dither_Next(DITHER *Dither, UWORD Y)
+{
+    if(Dither->Source == NULL || Dither->Row == NULL) {
+        Debug("Dither no source\r\n");
+        return 0;
+    }
+    if(Dither->Kernel == DITHER_ORDERED)
+        Dither->Y = Y;
+    else if(Y < Dither->Y)
+        Dither_Reset(Dither);
+    while(Dither->Y < Y) {
+        Dither->Source(Dither->arg, Dither->Y, Dither->Row);
+        Dither_Row(Dither, Dither->Row);
+    }
+    Dither->Source(Dither->arg, Y, Dither->Row);
+    Dither_Row(Dither, Dither->Row);
+    return 1;
+}
+
+/******************************************************************************
+function :	Draw the image into a picture
+parameter:
+    Xstart, Ystart : top left in the picture
+    Height         : rows of the image
+Info:
+    Row by row through Paint_DrawGrayRow(), one row of the image in RAM.
+******************************************************************************/
+void Dither_Paint(DITHER *Dither, PAINT *Ctx, UWORD Xstart, UWORD Ystart, UWORD Height)
+{
+    for(UWORD y = 0; y < Height; y++) {
+        if(!Dither_Next(Dither, y))
+            return;
+        Paint_DrawGrayRow(Ctx, Xstart, Ystart + y, Dither->Row, Dither->Width, Dither->Levels);
+    }
+}
+
+/******************************************************************************
+function :	Render rows of the image, for the panels that stream their
+            planes band by band
+parameter:
+    arg    : DITHER *, Width the panel width
+    Plane  : 0, or the plane of Map
+    Ystart : first row
+    Rows   : rows in the band
+    Band   : Rows * (Width + 7) / 8 bytes
+Info:
+    Fits EPD_13IN3K_Display_Bands() and the other EPD_BAND_RENDER users.
+    Bands come top down, a second plane restarts the diffusion from the
+    top and gets the same pixels.
+******************************************************************************/
+void Dither_RenderBand(void *arg, UBYTE Plane, UWORD Ystart, UWORD Rows, UBYTE *Band)
+{
+    DITHER *Dither = (DITHER *)arg;
+    UWORD Line = (Dither->Width + 7) / 8;
+
+    for(UWORD y = 0; y < Rows; y++) {
+        if(!Dither_Next(Dither, Ystart + y))
+            return;
+        Dither_PackPlane(Dither->Row, Dither->Width, Dither->Levels, Dither->Map, Plane,
+                         Band + (UDOUBLE)y * Line);
+    }
+}
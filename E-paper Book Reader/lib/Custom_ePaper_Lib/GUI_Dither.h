@@ -0,0 +1,61 @@
+/*****************************************************************************
+* | File      	:	GUI_Dither.h
+* | Function    :   Dither 8 bit gray images row by row
+* | Info        :
+*   An image is read a row at a time, e.g. decoded from a file, and
+*   dithered to the 2 or 4 levels of the panel as it is drawn or sent, the
+*   full image is never in RAM. Error diffusion keeps one row of error:
+*       static int16_t Error[EPD_13IN3K_WIDTH + 2];
+*       static UBYTE Row[EPD_13IN3K_WIDTH];
+*       static UBYTE Band[EPD_13IN3K_WIDTH / 8 * 16];
+*       DITHER Dither;
+*       Dither_Init(&Dither, EPD_13IN3K_WIDTH, 2, DITHER_DIFFUSE, Error);
+*       Dither_SetSource(&Dither, Cover_Row, File, Row, NULL);
+*       EPD_13IN3K_Display_Bands(Band, sizeof(Band), Dither_RenderBand, &Dither);
+*   or into a picture, any scale 2 or 4, planar gray too:
+*       Dither_Paint(&Dither, &Page, 0, 0, EPD_13IN3K_HEIGHT);
+*   Gray values are 0 black .. 255 white, levels 0 black .. Levels - 1 white.
+*----------------
+* |	This version:   V1.0
+* | Date        :   2026-10-17
+* | Info        :
+******************************************************************************/
+#ifndef __GUI_DITHER_H
+#define __GUI_DITHER_H
+
+#include "DEV_Config.h"
+#include "GUI_Paint.h"
+
+typedef enum {
+    DITHER_ORDERED = 0,     //8x8 Bayer matrix, no state, rows in any order
+    DITHER_DIFFUSE,         //Floyd-Steinberg, serpentine, rows in order
+} DITHER_KERNEL;
+
+/**
+ * Reads row Y of the image, Width gray values
+**/
+typedef void (*DITHER_SOURCE)(void *arg, UWORD Y, UBYTE *Row);
+
+typedef struct {
+    UWORD Width;
+    UBYTE Levels;           //2 or 4
+    UBYTE Kernel;           //DITHER_KERNEL
+    int16_t *Error;         //Width + 2 entries, DITHER_DIFFUSE only
+    UWORD Y;                //row dithered next
+    DITHER_SOURCE Source;   //see Dither_SetSource()
+    void *arg;
+    UBYTE *Row;             //Width bytes
+    const UBYTE *Map;       //plane bits of the 4 levels, NULL: 1 bit
+} DITHER;
+
+void Dither_Init(DITHER *Dither, UWORD Width, UBYTE Levels, DITHER_KERNEL Kernel, int16_t *Error);
+void Dither_Reset(DITHER *Dither);
+void Dither_Row(DITHER *Dither, UBYTE *Row);
+void Dither_Pack(const UBYTE *Level, UWORD Width, UBYTE Levels, UBYTE *Out);
+void Dither_PackPlane(const UBYTE *Level, UWORD Width, UBYTE Levels, const UBYTE *Map, UBYTE Plane, UBYTE *Out);
+
+void Dither_SetSource(DITHER *Dither, DITHER_SOURCE Source, void *arg, UBYTE *Row, const UBYTE *Map);
+void Dither_Paint(DITHER *Dither, PAINT *Ctx, UWORD Xstart, UWORD Ystart, UWORD Height);
+void Dither_RenderBand(void *arg, UBYTE Plane, UWORD Ystart, UWORD Rows, UBYTE *Band);
+
+#endif
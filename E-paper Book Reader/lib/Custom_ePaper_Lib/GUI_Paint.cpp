@@ -8,10 +8,33 @@
 *   Achieve display characters: Display a single character, string, number
 *   Achieve time display: adaptive size display time minutes and seconds
 *----------------
-* |	This version:   V3.2
-* | Date        :   2020-07-23
+* |	This version:   V3.3
+* | Date        :   2026-10-17
 * | Info        :
 * -----------------------------------------------------------------------------
+* V3.3(2026-10-17):
+* 1. Change: Paint_Clear(), Paint_ClearWindows()
+*			Fill whole bytes with memset instead of pixel by pixel
+* 2. Change: Paint_DrawRectangle(), Paint_DrawCircle() filled,
+*			horizontal / vertical solid Paint_DrawLine(), Paint_DrawPoint()
+*			Go through the same span fill, for all scales
+* 3. Fix: fills no longer write one pixel past the right / bottom edge
+* 4. Add: Paint_Pixel()
+*			Pixel writer specialized on rotate, mirror and scale, picked once
+*			per draw call by Paint_SetPixel(), points, lines and text
+* 5. Change: Paint_DrawChar()
+*			Blit glyphs row by row with masks at ROTATE_0 / ROTATE_180,
+*			used by Paint_DrawString_EN(), Paint_DrawNum(), Paint_DrawTime()
+*			and at ROTATE_90 / ROTATE_270 from the pre-rotated font tables
+* 6. Add: Paint_GetDirty(), Paint_ClearDirty()
+*			Drawing records the changed areas, for partial window uploads
+* 7. Add: the drawing functions with a PAINT *Ctx first
+*			Draw on any number of pictures, the old forms use the global Paint
+* 8. Add: Paint_Record(), Paint_Replay(), Paint_SetBand(), Paint_RenderBand()
+*			Record a picture as a display list and render it band by band
+* 9. Add: Paint_SetGrayPlanes()
+*			4 gray drawn straight into the two bit planes of the controller
+*
 * V3.2(2020-07-23):
 * 1. Change: Paint_SetScale(UBYTE scale)
 *			Add scale 7 for 5.65f e-Parper
@@ -78,6 +101,7 @@
 #include "GUI_Paint.h"
 #include "DEV_Config.h"
 #include "utility/Debug.h"
+#include "utility/EPD_Common.h"
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h> //memset()
@@ -85,6 +109,65 @@
 
 PAINT Paint;
 
+/******************************************************************************
+function: Display list items
+Info:
+    Each item is a PAINT_ITEM followed by the text of a string, padded to 4
+    bytes. Ystart / Yend are the image memory rows the item can touch, a
+    replay into a band skips items that miss it. Items are copied in and
+    out with memcpy, the list buffer needs no alignment.
+******************************************************************************/
+enum {
+    PAINT_OP_CLEAR = 0,
+    PAINT_OP_CLEAR_WINDOWS,
+    PAINT_OP_PIXEL,
+    PAINT_OP_POINT,
+    PAINT_OP_LINE,
+    PAINT_OP_RECTANGLE,
+    PAINT_OP_CIRCLE,
+    PAINT_OP_CHAR,
+    PAINT_OP_STRING_EN,
+    PAINT_OP_STRING_CN,
+    PAINT_OP_STRING_GRAY,
+    PAINT_OP_BITMAP,
+    PAINT_OP_IMAGE,
+    PAINT_OP_ROTATE,
+    PAINT_OP_MIRROR,
+    PAINT_OP_SCALE,
+};
+
+typedef struct {
+    UWORD Size;         //bytes of the item and its text
+    UBYTE Op;
+    UBYTE Dot;          //DOT_PIXEL
+    UBYTE Style;        //DOT_STYLE, LINE_STYLE or DRAW_FILL
+    UWORD Ystart;
+    UWORD Yend;
+    UWORD X0, Y0, X1, Y1;
+    UWORD Color, Color2;
+    const void *Ptr;    //font or image data
+} PAINT_ITEM;
+
+static PAINT_ITEM Paint_Item(UBYTE Op, UWORD X0, UWORD Y0, UWORD X1, UWORD Y1, UWORD Color, UWORD Color2)
+{
+    PAINT_ITEM Item;
+    memset(&Item, 0, sizeof(PAINT_ITEM));
+    Item.Op = Op;
+    Item.X0 = X0;
+    Item.Y0 = Y0;
+    Item.X1 = X1;
+    Item.Y1 = Y1;
+    Item.Color = Color;
+    Item.Color2 = Color2;
+    return Item;
+}
+
+static void Paint_DirtyMemory(PAINT *Ctx, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend);
+static void Paint_Dirty(PAINT *Ctx, int Xstart, int Ystart, int Xend, int Yend);
+static void Paint_ListRect(PAINT *Ctx, PAINT_ITEM *Item, int Xstart, int Ystart, int Xend, int Yend,
+                           const char *Text);
+static void Paint_ListState(PAINT *Ctx, UBYTE Op, UWORD Value);
+
 /******************************************************************************
 function: Create Image
 parameter:
@@ -93,29 +176,34 @@ parameter:
     Height  :   The height of the picture
     Color   :   Whether the picture is inverted
 ******************************************************************************/
-void Paint_NewImage(UBYTE *image, UWORD Width, UWORD Height, UWORD Rotate, UWORD Color)
+void Paint_NewImage(PAINT *Ctx, UBYTE *image, UWORD Width, UWORD Height, UWORD Rotate, UWORD Color)
 {
-    Paint.Image = NULL;
-    Paint.Image = image;
+    Ctx->Image = NULL;
+    Ctx->Image = image;
 
-    Paint.WidthMemory = Width;
-    Paint.HeightMemory = Height;
-    Paint.Color = Color;    
-    Paint.Scale = 2;
-    Paint.WidthByte = (Width % 8 == 0)? (Width / 8 ): (Width / 8 + 1);
-    Paint.HeightByte = Height;    
+    Ctx->WidthMemory = Width;
+    Ctx->HeightMemory = Height;
+    Ctx->Color = Color;    
+    Ctx->Scale = 2;
+    Ctx->WidthByte = (Width % 8 == 0)? (Width / 8 ): (Width / 8 + 1);
+    Ctx->HeightByte = Height;    
 //    printf("WidthByte = %d, HeightByte = %d\r\n", Paint.WidthByte, Paint.HeightByte);
 //    printf(" EPD_WIDTH / 8 = %d\r\n",  122 / 8);
    
-    Paint.Rotate = Rotate;
-    Paint.Mirror = MIRROR_NONE;
+    Ctx->Rotate = Rotate;
+    Ctx->Mirror = MIRROR_NONE;
+    Ctx->DirtyCount = 0;
+    Paint_DirtyMemory(Ctx, 0, 0, Width - 1, Height - 1);
+    Ctx->YOffset = 0;
+    Ctx->List = NULL;
+    Ctx->Gray = NULL;
     
     if(Rotate == ROTATE_0 || Rotate == ROTATE_180) {
-        Paint.Width = Width;
-        Paint.Height = Height;
+        Ctx->Width = Width;
+        Ctx->Height = Height;
     } else {
-        Paint.Width = Height;
-        Paint.Height = Width;
+        Ctx->Width = Height;
+        Ctx->Height = Width;
     }
 }
 
@@ -124,9 +212,9 @@ function: Select Image
 parameter:
     image : Pointer to the image cache
 ******************************************************************************/
-void Paint_SelectImage(UBYTE *image)
+void Paint_SelectImage(PAINT *Ctx, UBYTE *image)
 {
-    Paint.Image = image;
+    Ctx->Image = image;
 }
 
 /******************************************************************************
@@ -134,11 +222,13 @@ function: Select Image Rotate
 parameter:
     Rotate : 0,90,180,270
 ******************************************************************************/
-void Paint_SetRotate(UWORD Rotate)
+void Paint_SetRotate(PAINT *Ctx, UWORD Rotate)
 {
     if(Rotate == ROTATE_0 || Rotate == ROTATE_90 || Rotate == ROTATE_180 || Rotate == ROTATE_270) {
         // Debug("Set image Rotate %d\r\n", Rotate);
-        Paint.Rotate = Rotate;
+        Ctx->Rotate = Rotate;
+        if(Ctx->List != NULL)
+            Paint_ListState(Ctx, PAINT_OP_ROTATE, Rotate);
     } else {
         Debug("rotate = 0, 90, 180, 270\r\n");
     }
@@ -149,37 +239,210 @@ function:	Select Image mirror
 parameter:
     mirror   :Not mirror,Horizontal mirror,Vertical mirror,Origin mirror
 ******************************************************************************/
-void Paint_SetMirroring(UBYTE mirror)
+void Paint_SetMirroring(PAINT *Ctx, UBYTE mirror)
 {
     if(mirror == MIRROR_NONE || mirror == MIRROR_HORIZONTAL || 
         mirror == MIRROR_VERTICAL || mirror == MIRROR_ORIGIN) {
         // Debug("mirror image x:%s, y:%s\r\n",(mirror & 0x01)? "mirror":"none", ((mirror >> 1) & 0x01)? "mirror":"none");
-        Paint.Mirror = mirror;
+        Ctx->Mirror = mirror;
+        if(Ctx->List != NULL)
+            Paint_ListState(Ctx, PAINT_OP_MIRROR, mirror);
     } else {
         Debug("mirror should be MIRROR_NONE, MIRROR_HORIZONTAL, \
         MIRROR_VERTICAL or MIRROR_ORIGIN\r\n");
     }    
 }
 
-void Paint_SetScale(UBYTE scale)
+void Paint_SetScale(PAINT *Ctx, UBYTE scale)
 {
     if(scale == 2){
-        Paint.Scale = scale;
-        Paint.WidthByte = (Paint.WidthMemory % 8 == 0)? (Paint.WidthMemory / 8 ): (Paint.WidthMemory / 8 + 1);
+        Ctx->Scale = scale;
+        Ctx->WidthByte = (Ctx->WidthMemory % 8 == 0)? (Ctx->WidthMemory / 8 ): (Ctx->WidthMemory / 8 + 1);
     }
 	else if(scale == 4) {
-        Paint.Scale = scale;
-        Paint.WidthByte = (Paint.WidthMemory % 4 == 0)? (Paint.WidthMemory / 4 ): (Paint.WidthMemory / 4 + 1);
+        Ctx->Scale = scale;
+        Ctx->WidthByte = (Ctx->WidthMemory % 4 == 0)? (Ctx->WidthMemory / 4 ): (Ctx->WidthMemory / 4 + 1);
     }
 	else if(scale == 7) {//Only applicable with 5in65 e-Paper
-		Paint.Scale = 7;
-		Paint.WidthByte = (Paint.WidthMemory % 2 == 0)? (Paint.WidthMemory / 2 ): (Paint.WidthMemory / 2 + 1);
+		Ctx->Scale = 7;
+		Ctx->WidthByte = (Ctx->WidthMemory % 2 == 0)? (Ctx->WidthMemory / 2 ): (Ctx->WidthMemory / 2 + 1);
 	}
 	else {
         Debug("Set Scale Input parameter error\r\n");
         Debug("Scale Only support: 2 4 7\r\n");
+        return;
+    }
+    Ctx->Gray = NULL;
+    if(Ctx->List != NULL)
+        Paint_ListState(Ctx, PAINT_OP_SCALE, scale);
+}
+
+/******************************************************************************
+function: Draw 4 gray into the two bit planes the controller takes
+parameter:
+    Map : plane bits of each gray level, bit 0: plane 0, bit 1: plane 1,
+          the _GRAY of the driver, e.g. EPD_7IN5_V2_GRAY
+Info:
+    The colors are those of Paint_SetScale(4). The image holds plane 0 at
+    1 bit per pixel, WidthByte * HeightByte bytes, then plane 1: as much as
+    a packed 4 gray image, and the driver sends both planes as they are,
+    e.g. EPD_7IN5_V2_Display_4Gray_Planes(). Paint_DrawBitMap() takes a
+    packed 4 gray image, Paint_DrawImage() a 1 bit image. Paint_SetScale()
+    goes back to packed pixels. Not for display lists.
+******************************************************************************/
+void Paint_SetGrayPlanes(PAINT *Ctx, const UBYTE *Map)
+{
+    Ctx->Scale = 4;
+    Ctx->WidthByte = (Ctx->WidthMemory % 8 == 0)? (Ctx->WidthMemory / 8 ): (Ctx->WidthMemory / 8 + 1);
+    Ctx->Gray = Map;
+}
+
+/******************************************************************************
+function: Draw white, black and red straight into the two planes of a 3
+          color panel
+parameter:
+    Map : plane bits of each color, bit 0: black plane, bit 1: red plane,
+          the _COLOR of the driver, e.g. EPD_5IN83B_V2_COLOR
+Info:
+    Each primitive takes WHITE, BLACK or COLOR_RED and writes both planes in
+    one pass, in the polarity of the controller, so the driver sends them as
+    they are, e.g. EPD_5IN83B_V2_Display_Planes(). The image holds the black
+    plane at 1 bit per pixel, WidthByte * HeightByte bytes, then the red
+    plane. Gray text and gray rows come out black and white, see
+    Paint_DrawString_Gray(). Paint_DrawBitMap() takes 2 bits per pixel,
+    each the Color % 4 of a color. Paint_SetScale() goes back to a single
+    plane. Not for display lists.
+******************************************************************************/
+void Paint_SetColorPlanes(PAINT *Ctx, const UBYTE *Map)
+{
+    Paint_SetGrayPlanes(Ctx, Map);
+    Ctx->Scale = 3;
+}
+
+/******************************************************************************
+function: Planes of the image, 2 for planar gray and 3 color, and the bytes of each
+******************************************************************************/
+static UBYTE Paint_Planes(PAINT *Ctx)
+{
+    return (Ctx->Gray != NULL)? 2 : 1;
+}
+
+static UDOUBLE Paint_PlaneSize(PAINT *Ctx)
+{
+    return (UDOUBLE)Ctx->WidthByte * Ctx->HeightByte;
+}
+/******************************************************************************
+function: Draw Pixels, one variant per rotate x mirror x bits per pixel
+parameter:
+    Xpoint : At point X
+    Ypoint : At point Y
+    Color  : Painted colors
+Info:
+    Rotate, Mirror and Bits are constants here, so the mapping folds into
+    straight address arithmetic. Pick the variant with Paint_Pixel() once
+    per draw call and call it for every pixel. Bits 0 is planar gray or 3
+    color, a bit in each plane.
+******************************************************************************/
+template<UWORD Rotate, UBYTE Mirror, UBYTE Bits>
+static void Paint_PixelT(PAINT *Ctx, UWORD Xpoint, UWORD Ypoint, UWORD Color)
+{
+    UWORD X, Y;
+    UBYTE Shift, Mask, Value;
+    UDOUBLE Addr;
+    UBYTE Code;
+
+    if(Xpoint >= Ctx->Width || Ypoint >= Ctx->Height)
+        return;
+
+    if(Rotate == 0) {
+        X = Xpoint;
+        Y = Ypoint;
+    } else if(Rotate == 90) {
+        X = Ctx->WidthMemory - Ypoint - 1;
+        Y = Xpoint;
+    } else if(Rotate == 180) {
+        X = Ctx->WidthMemory - Xpoint - 1;
+        Y = Ctx->HeightMemory - Ypoint - 1;
+    } else {
+        X = Ypoint;
+        Y = Ctx->HeightMemory - Xpoint - 1;
+    }
+    if(Mirror & MIRROR_HORIZONTAL)
+        X = Ctx->WidthMemory - X - 1;
+    if(Mirror & MIRROR_VERTICAL)
+        Y = Ctx->HeightMemory - Y - 1;
+    //Paint_SetRotate() keeps Width / Height, they can be stale for 90 / 270
+    if(X >= Ctx->WidthMemory || Y >= Ctx->HeightMemory)
+        return;
+    //A band holds the rows YOffset .. YOffset + HeightByte - 1
+    Y -= Ctx->YOffset;
+    if(Y >= Ctx->HeightByte)
+        return;
+
+    if(Bits == 0) {
+        Code = Ctx->Gray[Color % 4];
+        Addr = X / 8 + (UDOUBLE)Y * Ctx->WidthByte;
+        Mask = 0x80 >> (X % 8);
+        Ctx->Image[Addr] = (Code & 0x01)? Ctx->Image[Addr] | Mask : Ctx->Image[Addr] & ~Mask;
+        Addr += Paint_PlaneSize(Ctx);
+        Ctx->Image[Addr] = (Code & 0x02)? Ctx->Image[Addr] | Mask : Ctx->Image[Addr] & ~Mask;
+        return;
     }
+
+    if(Bits == 1)
+        Value = (Color == BLACK)? 0 : 1;
+    else if(Bits == 2)
+        Value = Color % 4;      //Guaranteed color scale is 4  --- 0~3
+    else
+        Value = Color & 0x0F;
+
+    Addr = (UDOUBLE)X * Bits / 8 + (UDOUBLE)Y * Ctx->WidthByte;
+    Shift = 8 - Bits - (X * Bits) % 8;
+    Mask = ((1 << Bits) - 1) << Shift;
+    Ctx->Image[Addr] = (Ctx->Image[Addr] & ~Mask) | (Value << Shift);
+}
+
+static void Paint_PixelNone(PAINT *, UWORD, UWORD, UWORD) {}
+
+#define PAINT_PIXEL_BITS(_rotate, _mirror) \
+    { Paint_PixelT<_rotate, _mirror, 1>, Paint_PixelT<_rotate, _mirror, 2>, Paint_PixelT<_rotate, _mirror, 4>, \
+      Paint_PixelT<_rotate, _mirror, 0> }
+#define PAINT_PIXEL_MIRROR(_rotate) \
+    { PAINT_PIXEL_BITS(_rotate, MIRROR_NONE), PAINT_PIXEL_BITS(_rotate, MIRROR_HORIZONTAL), \
+      PAINT_PIXEL_BITS(_rotate, MIRROR_VERTICAL), PAINT_PIXEL_BITS(_rotate, MIRROR_ORIGIN) }
+
+static const PAINT_PIXEL Paint_Pixel_Table[4][4][4] = {
+    PAINT_PIXEL_MIRROR(ROTATE_0),
+    PAINT_PIXEL_MIRROR(ROTATE_90),
+    PAINT_PIXEL_MIRROR(ROTATE_180),
+    PAINT_PIXEL_MIRROR(ROTATE_270),
+};
+
+/******************************************************************************
+function: Pixel writer for the current rotate, mirror and scale
+parameter:
+Info:
+    Never NULL, an invalid setting gets a writer that draws nothing.
+******************************************************************************/
+PAINT_PIXEL Paint_Pixel(PAINT *Ctx)
+{
+    UBYTE Bits;
+    if(Ctx->Gray != NULL)
+        Bits = 3;
+    else if(Ctx->Scale == 2)
+        Bits = 0;
+    else if(Ctx->Scale == 4)
+        Bits = 1;
+    else if(Ctx->Scale == 7 || Ctx->Scale == 16)
+        Bits = 2;
+    else
+        return Paint_PixelNone;
+
+    if(Ctx->Rotate % 90 != 0 || Ctx->Rotate > ROTATE_270 || Ctx->Mirror > MIRROR_ORIGIN)
+        return Paint_PixelNone;
+    return Paint_Pixel_Table[Ctx->Rotate / 90][Ctx->Mirror][Bits];
 }
+
 /******************************************************************************
 function: Draw Pixels
 parameter:
@@ -187,77 +450,494 @@ parameter:
     Ypoint : At point Y
     Color  : Painted colors
 ******************************************************************************/
-void Paint_SetPixel(UWORD Xpoint, UWORD Ypoint, UWORD Color)
+void Paint_SetPixel(PAINT *Ctx, UWORD Xpoint, UWORD Ypoint, UWORD Color)
 {
-    if(Xpoint > Paint.Width || Ypoint > Paint.Height){
+    if(Xpoint >= Ctx->Width || Ypoint >= Ctx->Height){
         Debug("Exceeding display boundaries\r\n");
         return;
-    }      
-    UWORD X, Y;
-    switch(Paint.Rotate) {
+    }
+    if(Ctx->List != NULL) {
+        PAINT_ITEM Item = Paint_Item(PAINT_OP_PIXEL, Xpoint, Ypoint, 0, 0, Color, 0);
+        Paint_ListRect(Ctx, &Item, Xpoint, Ypoint, Xpoint, Ypoint, NULL);
+        return;
+    }
+    Paint_Dirty(Ctx, Xpoint, Ypoint, Xpoint, Ypoint);
+    Paint_Pixel(Ctx)(Ctx, Xpoint, Ypoint, Color);
+}
+
+/******************************************************************************
+function: Bits per pixel of the current scale, 0 for an unknown scale
+Info:
+    1 for planar gray and 3 color, per plane.
+******************************************************************************/
+static UBYTE Paint_Bits(PAINT *Ctx)
+{
+    if(Ctx->Gray != NULL || Ctx->Scale == 2)
+        return 1;
+    else if(Ctx->Scale == 4)
+        return 2;
+    else if(Ctx->Scale == 7 || Ctx->Scale == 16)
+        return 4;
+    return 0;
+}
+
+/******************************************************************************
+function: A byte of pixels all in one color, as Paint_SetPixel() packs it
+parameter:
+    Color : Painted colors
+    Plane : plane of a planar gray or 3 color image, 0 otherwise
+******************************************************************************/
+static UBYTE Paint_FillByte(PAINT *Ctx, UWORD Color, UBYTE Plane)
+{
+    if(Ctx->Gray != NULL)
+        return ((Ctx->Gray[Color % 4] >> Plane) & 0x01)? 0xFF : 0x00;
+    else if(Ctx->Scale == 2)
+        return (Color == BLACK)? 0x00 : 0xFF;
+    else if(Ctx->Scale == 4)
+        return (Color % 4) * 0x55;
+    return (Color & 0x0F) * 0x11;
+}
+
+/******************************************************************************
+function: Map a rectangle from picture to image memory coordinates
+parameter:
+    Xstart : x starting point, in / out
+    Ystart : Y starting point, in / out
+    Xend   : x end point, inclusive, in / out
+    Yend   : y end point, inclusive, in / out
+Info:
+    Clipped to the picture and the image, rotated and mirrored like
+    Paint_SetPixel. Returns 0 when nothing is left.
+******************************************************************************/
+static UBYTE Paint_MapRect(PAINT *Ctx, int *Xstart, int *Ystart, int *Xend, int *Yend)
+{
+    int X0, Y0, X1, Y1, t;
+
+    if(*Xstart < 0) *Xstart = 0;
+    if(*Ystart < 0) *Ystart = 0;
+    if(*Xend > Ctx->Width - 1) *Xend = Ctx->Width - 1;
+    if(*Yend > Ctx->Height - 1) *Yend = Ctx->Height - 1;
+    if(*Xstart > *Xend || *Ystart > *Yend)
+        return 0;
+
+    switch(Ctx->Rotate) {
     case 0:
-        X = Xpoint;
-        Y = Ypoint;  
+        X0 = *Xstart;
+        X1 = *Xend;
+        Y0 = *Ystart;
+        Y1 = *Yend;
         break;
     case 90:
-        X = Paint.WidthMemory - Ypoint - 1;
-        Y = Xpoint;
+        X0 = Ctx->WidthMemory - *Yend - 1;
+        X1 = Ctx->WidthMemory - *Ystart - 1;
+        Y0 = *Xstart;
+        Y1 = *Xend;
         break;
     case 180:
-        X = Paint.WidthMemory - Xpoint - 1;
-        Y = Paint.HeightMemory - Ypoint - 1;
+        X0 = Ctx->WidthMemory - *Xend - 1;
+        X1 = Ctx->WidthMemory - *Xstart - 1;
+        Y0 = Ctx->HeightMemory - *Yend - 1;
+        Y1 = Ctx->HeightMemory - *Ystart - 1;
         break;
     case 270:
-        X = Ypoint;
-        Y = Paint.HeightMemory - Xpoint - 1;
+        X0 = *Ystart;
+        X1 = *Yend;
+        Y0 = Ctx->HeightMemory - *Xend - 1;
+        Y1 = Ctx->HeightMemory - *Xstart - 1;
         break;
     default:
-        return;
+        return 0;
     }
-    
-    switch(Paint.Mirror) {
-    case MIRROR_NONE:
-        break;
-    case MIRROR_HORIZONTAL:
-        X = Paint.WidthMemory - X - 1;
-        break;
-    case MIRROR_VERTICAL:
-        Y = Paint.HeightMemory - Y - 1;
-        break;
-    case MIRROR_ORIGIN:
-        X = Paint.WidthMemory - X - 1;
-        Y = Paint.HeightMemory - Y - 1;
-        break;
-    default:
+
+    if(Ctx->Mirror == MIRROR_HORIZONTAL || Ctx->Mirror == MIRROR_ORIGIN) {
+        t = X0;
+        X0 = Ctx->WidthMemory - X1 - 1;
+        X1 = Ctx->WidthMemory - t - 1;
+    }
+    if(Ctx->Mirror == MIRROR_VERTICAL || Ctx->Mirror == MIRROR_ORIGIN) {
+        t = Y0;
+        Y0 = Ctx->HeightMemory - Y1 - 1;
+        Y1 = Ctx->HeightMemory - t - 1;
+    }
+
+    if(X0 < 0) X0 = 0;
+    if(Y0 < 0) Y0 = 0;
+    if(X1 > Ctx->WidthMemory - 1) X1 = Ctx->WidthMemory - 1;
+    if(Y1 > Ctx->HeightMemory - 1) Y1 = Ctx->HeightMemory - 1;
+    if(X0 > X1 || Y0 > Y1)
+        return 0;
+
+    *Xstart = X0;
+    *Ystart = Y0;
+    *Xend = X1;
+    *Yend = Y1;
+    return 1;
+}
+
+static UDOUBLE Paint_RectArea(const PAINT_RECT *Rect)
+{
+    return (UDOUBLE)(Rect->Xend - Rect->Xstart) * (Rect->Yend - Rect->Ystart);
+}
+
+/******************************************************************************
+function: Add a rectangle to a set of rectangles
+parameter:
+    Set   : the set
+    Count : number of rectangles in the set, in / out
+    Max   : size of the set, at least 1
+    Rect  : rectangle to add
+Info:
+    A rectangle is merged with one it nearly covers together, i.e. whose
+    bounding box wastes at most a quarter of their area. When the set is
+    full, the merge that wastes the least is done anyway.
+******************************************************************************/
+static void Paint_RectAdd(PAINT_RECT *Set, UBYTE *Count, UBYTE Max, PAINT_RECT Rect)
+{
+    PAINT_RECT Union;
+    UDOUBLE Sum, Waste, Best_Waste = 0;
+    UBYTE i, Best;
+
+    for(;;) {
+        Best = 0xFF;
+        for(i = 0; i < *Count; i++) {
+            if(Set[i].Xstart <= Rect.Xstart && Set[i].Ystart <= Rect.Ystart &&
+               Set[i].Xend >= Rect.Xend && Set[i].Yend >= Rect.Yend)
+                return;     //already covered
+            Union.Xstart = (Set[i].Xstart < Rect.Xstart)? Set[i].Xstart : Rect.Xstart;
+            Union.Ystart = (Set[i].Ystart < Rect.Ystart)? Set[i].Ystart : Rect.Ystart;
+            Union.Xend = (Set[i].Xend > Rect.Xend)? Set[i].Xend : Rect.Xend;
+            Union.Yend = (Set[i].Yend > Rect.Yend)? Set[i].Yend : Rect.Yend;
+            Sum = Paint_RectArea(&Set[i]) + Paint_RectArea(&Rect);
+            Waste = (Paint_RectArea(&Union) > Sum)? Paint_RectArea(&Union) - Sum : 0;
+            if(Waste <= Sum / 4 || *Count >= Max) {
+                if(Best == 0xFF || Waste < Best_Waste) {
+                    Best = i;
+                    Best_Waste = Waste;
+                }
+            }
+        }
+        if(Best == 0xFF)
+            break;
+
+        //take the merged one out and try again, it may now cover others
+        Union = Set[Best];
+        Rect.Xstart = (Union.Xstart < Rect.Xstart)? Union.Xstart : Rect.Xstart;
+        Rect.Ystart = (Union.Ystart < Rect.Ystart)? Union.Ystart : Rect.Ystart;
+        Rect.Xend = (Union.Xend > Rect.Xend)? Union.Xend : Rect.Xend;
+        Rect.Yend = (Union.Yend > Rect.Yend)? Union.Yend : Rect.Yend;
+        Set[Best] = Set[--(*Count)];
+    }
+    Set[(*Count)++] = Rect;
+}
+
+/******************************************************************************
+function: Mark an area of the image memory as changed
+parameter:
+    Xstart : x starting point, memory coordinates
+    Ystart : Y starting point, memory coordinates
+    Xend   : x end point, inclusive
+    Yend   : y end point, inclusive
+******************************************************************************/
+static void Paint_DirtyMemory(PAINT *Ctx, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
+{
+    PAINT_RECT Rect = {Xstart, Ystart, (UWORD)(Xend + 1), (UWORD)(Yend + 1)};
+    Paint_RectAdd(Ctx->Dirty, &Ctx->DirtyCount, PAINT_DIRTY_MAX, Rect);
+}
+
+/******************************************************************************
+function: Mark an area of the picture as changed
+parameter:
+    Xstart : x starting point
+    Ystart : Y starting point
+    Xend   : x end point, inclusive
+    Yend   : y end point, inclusive
+******************************************************************************/
+static void Paint_Dirty(PAINT *Ctx, int Xstart, int Ystart, int Xend, int Yend)
+{
+    if(Paint_MapRect(Ctx, &Xstart, &Ystart, &Xend, &Yend))
+        Paint_DirtyMemory(Ctx, Xstart, Ystart, Xend, Yend);
+}
+
+/******************************************************************************
+function: Changed areas since the last Paint_ClearDirty()
+parameter:
+    Rect  : receives the rectangles, image memory coordinates, end exclusive
+    Max   : size of Rect, the areas are merged down to this many
+    Align : x granularity of the panel window in pixels, e.g. 8, 1: none
+Info:
+    Returns the number of rectangles. Aligned rectangles can reach into
+    the padding bits at the end of an image row.
+******************************************************************************/
+UBYTE Paint_GetDirty(PAINT *Ctx, PAINT_RECT *Rect, UBYTE Max, UWORD Align)
+{
+    UBYTE i, Count = 0;
+    if(Max == 0)
+        return 0;
+    if(Align == 0)
+        Align = 1;
+    for(i = 0; i < Ctx->DirtyCount; i++) {
+        PAINT_RECT r = Ctx->Dirty[i];
+        r.Xstart = r.Xstart / Align * Align;
+        r.Xend = (r.Xend + Align - 1) / Align * Align;
+        Paint_RectAdd(Rect, &Count, Max, r);
+    }
+    return Count;
+}
+
+/******************************************************************************
+function: Forget the changed areas, call it once the panel shows the image
+******************************************************************************/
+void Paint_ClearDirty(PAINT *Ctx)
+{
+    Ctx->DirtyCount = 0;
+}
+
+/******************************************************************************
+function: Fill a rectangle of the image memory
+parameter:
+    Xstart : x starting point, memory coordinates
+    Ystart : Y starting point, memory coordinates
+    Xend   : x end point, inclusive
+    Yend   : y end point, inclusive
+    Color  : Painted colors
+Info:
+    Each row is one span: the partial bytes at both ends are masked, the
+    whole bytes in between are a memset. Rows covering the full WidthByte
+    are filled with a single memset. Planar gray fills both planes.
+******************************************************************************/
+static void Paint_FillMemory(PAINT *Ctx, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color)
+{
+    UBYTE Bits = Paint_Bits(Ctx), Fill, Head, Tail, Plane;
+    UWORD First, Last, Y;
+    UBYTE *Image;
+
+    if(Bits == 0)
+        return;
+    Paint_DirtyMemory(Ctx, Xstart, Ystart, Xend, Yend);
+
+    //Only the rows of the band
+    if(Yend < Ctx->YOffset || Ystart >= Ctx->YOffset + Ctx->HeightByte)
         return;
+    if(Ystart < Ctx->YOffset)
+        Ystart = Ctx->YOffset;
+    if(Yend >= Ctx->YOffset + Ctx->HeightByte)
+        Yend = Ctx->YOffset + Ctx->HeightByte - 1;
+    Ystart -= Ctx->YOffset;
+    Yend -= Ctx->YOffset;
+
+    First = ((UDOUBLE)Xstart * Bits) / 8;
+    Last = ((UDOUBLE)Xend * Bits) / 8;
+    Head = 0xFF >> ((Xstart * Bits) % 8);
+    Tail = 0xFF << (8 - (Xend * Bits) % 8 - Bits);
+    if(First == Last)
+        Head &= Tail;
+
+    for(Plane = 0; Plane < Paint_Planes(Ctx); Plane++) {
+        Fill = Paint_FillByte(Ctx, Color, Plane);
+        Image = Ctx->Image + Plane * Paint_PlaneSize(Ctx);
+        if(Head == 0xFF && Tail == 0xFF && First == 0 && Last == Ctx->WidthByte - 1) {
+            memset(Image + (UDOUBLE)Ystart * Ctx->WidthByte, Fill,
+                   (UDOUBLE)(Yend - Ystart + 1) * Ctx->WidthByte);
+            continue;
+        }
+
+        for(Y = Ystart; Y <= Yend; Y++) {
+            UBYTE *Row = Image + (UDOUBLE)Y * Ctx->WidthByte;
+            Row[First] = (Row[First] & ~Head) | (Fill & Head);
+            if(First == Last)
+                continue;
+            if(Last - First > 1)
+                memset(Row + First + 1, Fill, Last - First - 1);
+            Row[Last] = (Row[Last] & ~Tail) | (Fill & Tail);
+        }
     }
+}
 
-    if(X > Paint.WidthMemory || Y > Paint.HeightMemory){
-        Debug("Exceeding display boundaries\r\n");
+/******************************************************************************
+function: Fill a rectangle in picture coordinates
+parameter:
+    Xstart : x starting point
+    Ystart : Y starting point
+    Xend   : x end point, inclusive
+    Yend   : y end point, inclusive
+    Color  : Painted colors
+Info:
+    Clipped to the picture, then rotated and mirrored like Paint_SetPixel.
+    A rectangle stays a rectangle under both, so it is one memory fill.
+******************************************************************************/
+static void Paint_FillRect(PAINT *Ctx, int Xstart, int Ystart, int Xend, int Yend, UWORD Color)
+{
+    if(Paint_MapRect(Ctx, &Xstart, &Ystart, &Xend, &Yend))
+        Paint_FillMemory(Ctx, Xstart, Ystart, Xend, Yend, Color);
+}
+
+/******************************************************************************
+function: Fill the area of a run of DOT_STYLE_DFT points
+parameter:
+    Xstart    : x of the first point
+    Ystart    : y of the first point
+    Xend      : x of the last point, inclusive
+    Yend      : y of the last point, inclusive
+    Color     : Painted colors
+    Dot_Pixel : point size
+Info:
+    Same pixels as Paint_DrawPoint(X, Y, Color, Dot_Pixel, DOT_FILL_AROUND)
+    for every point of the rectangle. A point closer than Dot_Pixel to the
+    top edge is dropped as a whole there, so it is here.
+******************************************************************************/
+static void Paint_FillDots(PAINT *Ctx, int Xstart, int Ystart, int Xend, int Yend, UWORD Color, DOT_PIXEL Dot_Pixel)
+{
+    if(Ystart < Dot_Pixel)
+        Ystart = Dot_Pixel;
+    if(Ystart > Yend)
+        return;
+    Paint_FillRect(Ctx, Xstart - Dot_Pixel, Ystart - Dot_Pixel,
+                   Xend + Dot_Pixel - 2, Yend + Dot_Pixel - 2, Color);
+}
+
+/******************************************************************************
+function: Append an item to the display list of the picture
+parameter:
+    Item : item, Ystart / Yend set
+    Text : string stored after the item, NULL: none
+Info:
+    Once an item does not fit the list stops taking items, a replay of it
+    never draws a later item without the earlier ones.
+******************************************************************************/
+static void Paint_ListPut(PAINT *Ctx, PAINT_ITEM *Item, const char *Text)
+{
+    PAINT_LIST *List = Ctx->List;
+    UDOUBLE Len = (Text != NULL)? strlen(Text) + 1 : 0;
+    UDOUBLE Size = (sizeof(PAINT_ITEM) + Len + 3) & ~(UDOUBLE)3;
+
+    if(List->Overflow)
+        return;
+    if(Size > 0xFFFF || List->Used + Size > List->Size) {
+        Debug("Paint display list full\r\n");
+        List->Overflow = 1;
         return;
     }
-    
-    if(Paint.Scale == 2){
-        UDOUBLE Addr = X / 8 + Y * Paint.WidthByte;
-        UBYTE Rdata = Paint.Image[Addr];
-        if(Color == BLACK)
-            Paint.Image[Addr] = Rdata & ~(0x80 >> (X % 8));
-        else
-            Paint.Image[Addr] = Rdata | (0x80 >> (X % 8));
-    }else if(Paint.Scale == 4){
-        UDOUBLE Addr = X / 4 + Y * Paint.WidthByte;
-        Color = Color % 4;//Guaranteed color scale is 4  --- 0~3
-        UBYTE Rdata = Paint.Image[Addr];
-        
-        Rdata = Rdata & (~(0xC0 >> ((X % 4)*2)));
-        Paint.Image[Addr] = Rdata | ((Color << 6) >> ((X % 4)*2));
-    }else if(Paint.Scale == 7 || Paint.Scale == 16){
-		UDOUBLE Addr = X / 2  + Y * Paint.WidthByte;
-		UBYTE Rdata = Paint.Image[Addr];
-		Rdata = Rdata & (~(0xF0 >> ((X % 2)*4)));//Clear first, then set value
-		Paint.Image[Addr] = Rdata | ((Color << 4) >> ((X % 2)*4));
-		// printf("Add =  %d ,data = %d\r\n",Addr,Rdata);	
+    Item->Size = Size;
+    memcpy(List->Data + List->Used, Item, sizeof(PAINT_ITEM));
+    if(Len != 0)
+        memcpy(List->Data + List->Used + sizeof(PAINT_ITEM), Text, Len);
+    List->Used += Size;
+}
+
+/******************************************************************************
+function: Append an item that draws inside a rectangle of the picture
+parameter:
+    Xstart : x starting point
+    Ystart : Y starting point
+    Xend   : x end point, inclusive
+    Yend   : y end point, inclusive
+    Text   : string stored after the item, NULL: none
+Info:
+    An item entirely off the picture draws nothing and is not stored.
+******************************************************************************/
+static void Paint_ListRect(PAINT *Ctx, PAINT_ITEM *Item, int Xstart, int Ystart, int Xend, int Yend,
+                           const char *Text)
+{
+    if(!Paint_MapRect(Ctx, &Xstart, &Ystart, &Xend, &Yend))
+        return;
+    Item->Ystart = Ystart;
+    Item->Yend = Yend;
+    Paint_ListPut(Ctx, Item, Text);
+}
+
+//Items that draw anywhere and picture state changes, replayed into every band
+static void Paint_ListAll(PAINT *Ctx, PAINT_ITEM *Item)
+{
+    Item->Ystart = 0;
+    Item->Yend = 0xFFFF;
+    Paint_ListPut(Ctx, Item, NULL);
+}
+
+static void Paint_ListState(PAINT *Ctx, UBYTE Op, UWORD Value)
+{
+    PAINT_ITEM Item = Paint_Item(Op, Value, 0, 0, 0, 0, 0);
+    Paint_ListAll(Ctx, &Item);
+}
+
+/******************************************************************************
+function: Append an English string
+parameter:
+    Item    : the string item, X0 / Y0 where it starts, Ptr the font
+    pString : the string
+    Width   : character width of the font
+    Height  : character height of the font
+Info:
+    Walks the string like Paint_DrawString_EN() to find the rows it covers.
+******************************************************************************/
+static void Paint_ListString(PAINT *Ctx, PAINT_ITEM *Item, const char *pString, UWORD Width, UWORD Height)
+{
+    int Xpoint = Item->X0, Ypoint = Item->Y0, Xend = -1, Yend = -1;
+    const char *p;
+
+    for (p = pString; *p != '\0'; p++, Xpoint += Width) {
+        if ((Xpoint + Width) > Ctx->Width) {
+            Xpoint = Item->X0;
+            Ypoint += Height;
+        }
+        if ((Ypoint + Height) > Ctx->Height) {
+            Xpoint = Item->X0;
+            Ypoint = Item->Y0;
+        }
+        if (Xpoint + Width - 1 > Xend)
+            Xend = Xpoint + Width - 1;
+        if (Ypoint + Height - 1 > Yend)
+            Yend = Ypoint + Height - 1;
     }
+    if (Xend >= 0)
+        Paint_ListRect(Ctx, Item, Item->X0, Item->Y0, Xend, Yend, pString);
+}
+
+/******************************************************************************
+function: Start or stop recording a picture
+parameter:
+    List : display list to fill, NULL: stop, draw into the image again
+    Data : buffer for the items
+    Size : size of Data in bytes
+Info:
+    While recording the drawing functions store what they were called with
+    instead of drawing, the picture needs no image. Rotate, mirror and scale
+    changes apply to the picture and are recorded too. A list that ran out
+    of room has Overflow set.
+******************************************************************************/
+void Paint_Record(PAINT *Ctx, PAINT_LIST *List, UBYTE *Data, UDOUBLE Size)
+{
+    Ctx->List = List;
+    if(List == NULL)
+        return;
+    List->Data = Data;
+    List->Size = Size;
+    List->Used = 0;
+    List->Overflow = 0;
+    List->Rotate = Ctx->Rotate;
+    List->Mirror = Ctx->Mirror;
+    List->Scale = Ctx->Scale;
+}
+
+/******************************************************************************
+function: Draw into a band of the image
+parameter:
+    image  : buffer for the band, Rows * WidthByte bytes
+    Ystart : first image memory row of the band
+    Rows   : rows in the band
+Info:
+    The picture keeps its size, only the rows Ystart .. Ystart + Rows - 1
+    are written, to image. Paint_SetBand(Ctx, image, 0, Height) goes back
+    to a full image.
+******************************************************************************/
+void Paint_SetBand(PAINT *Ctx, UBYTE *image, UWORD Ystart, UWORD Rows)
+{
+    if(Ystart >= Ctx->HeightMemory)
+        Rows = 0;
+    else if(Rows > Ctx->HeightMemory - Ystart)
+        Rows = Ctx->HeightMemory - Ystart;
+    Ctx->Image = image;
+    Ctx->YOffset = Ystart;
+    Ctx->HeightByte = Rows;
 }
 
 /******************************************************************************
@@ -265,30 +945,33 @@ function: Clear the color of the picture
 parameter:
     Color : Painted colors
 ******************************************************************************/
-void Paint_Clear(UWORD Color)
+void Paint_Clear(PAINT *Ctx, UWORD Color)
 {
-    if(Paint.Scale == 2) {
-		for (UWORD Y = 0; Y < Paint.HeightByte; Y++) {
-			for (UWORD X = 0; X < Paint.WidthByte; X++ ) {//8 pixel =  1 byte
-				UDOUBLE Addr = X + Y*Paint.WidthByte;
-				Paint.Image[Addr] = Color;
-			}
-		}
-    }else if(Paint.Scale == 4) {
-        for (UWORD Y = 0; Y < Paint.HeightByte; Y++) {
-            for (UWORD X = 0; X < Paint.WidthByte; X++ ) {
-                UDOUBLE Addr = X + Y*Paint.WidthByte;
-                Paint.Image[Addr] = (Color<<6)|(Color<<4)|(Color<<2)|Color;
-            }
-        }
-    }else if(Paint.Scale == 7 || Paint.Scale == 16) {
-		for (UWORD Y = 0; Y < Paint.HeightByte; Y++) {
-			for (UWORD X = 0; X < Paint.WidthByte; X++ ) {
-				UDOUBLE Addr = X + Y*Paint.WidthByte;
-				Paint.Image[Addr] = (Color<<4)|Color;
-			}
-		}		
-	}
+    UBYTE Fill;
+    if(Ctx->List != NULL) {
+        PAINT_ITEM Item = Paint_Item(PAINT_OP_CLEAR, 0, 0, 0, 0, Color, 0);
+        Paint_ListAll(Ctx, &Item);
+        return;
+    }
+    if(Ctx->Gray != NULL) {
+        memset(Ctx->Image, Paint_FillByte(Ctx, Color, 0), Paint_PlaneSize(Ctx));
+        memset(Ctx->Image + Paint_PlaneSize(Ctx), Paint_FillByte(Ctx, Color, 1), Paint_PlaneSize(Ctx));
+        Paint_DirtyMemory(Ctx, 0, 0, Ctx->WidthMemory - 1, Ctx->HeightMemory - 1);
+        return;
+    }
+    if(Ctx->Scale == 2) {
+        Fill = Color;
+    }else if(Ctx->Scale == 4) {
+        Color = Color % 4;
+        Fill = (Color<<6)|(Color<<4)|(Color<<2)|Color;
+    }else if(Ctx->Scale == 7 || Ctx->Scale == 16) {
+        Color = Color & 0x0F;
+        Fill = (Color<<4)|Color;
+    }else {
+        return;
+    }
+    memset(Ctx->Image, Fill, (UDOUBLE)Ctx->WidthByte * Ctx->HeightByte);
+    Paint_DirtyMemory(Ctx, 0, 0, Ctx->WidthMemory - 1, Ctx->HeightMemory - 1);
 }
 
 /******************************************************************************
@@ -300,14 +983,14 @@ parameter:
     Yend   : y end point
     Color  : Painted colors
 ******************************************************************************/
-void Paint_ClearWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color)
+void Paint_ClearWindows(PAINT *Ctx, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color)
 {
-    UWORD X, Y;
-    for (Y = Ystart; Y < Yend; Y++) {
-        for (X = Xstart; X < Xend; X++) {//8 pixel =  1 byte
-            Paint_SetPixel(X, Y, Color);
-        }
+    if(Ctx->List != NULL) {
+        PAINT_ITEM Item = Paint_Item(PAINT_OP_CLEAR_WINDOWS, Xstart, Ystart, Xend, Yend, Color, 0);
+        Paint_ListRect(Ctx, &Item, Xstart, Ystart, (int)Xend - 1, (int)Yend - 1, NULL);
+        return;
     }
+    Paint_FillRect(Ctx, Xstart, Ystart, (int)Xend - 1, (int)Yend - 1, Color);
 }
 
 /******************************************************************************
@@ -319,30 +1002,34 @@ parameter:
     Dot_Pixel	: point size
     Dot_Style	: point Style
 ******************************************************************************/
-void Paint_DrawPoint(UWORD Xpoint, UWORD Ypoint, UWORD Color,
+void Paint_DrawPoint(PAINT *Ctx, UWORD Xpoint, UWORD Ypoint, UWORD Color,
                      DOT_PIXEL Dot_Pixel, DOT_STYLE Dot_Style)
 {
-    if (Xpoint > Paint.Width || Ypoint > Paint.Height) {
+    if (Xpoint > Ctx->Width || Ypoint > Ctx->Height) {
         Debug("Paint_DrawPoint Input exceeds the normal display range\r\n");
         return;
     }
+    if (Ctx->List != NULL) {
+        PAINT_ITEM Item = Paint_Item(PAINT_OP_POINT, Xpoint, Ypoint, 0, 0, Color, 0);
+        Item.Dot = Dot_Pixel;
+        Item.Style = Dot_Style;
+        Paint_ListRect(Ctx, &Item, Xpoint - Dot_Pixel, Ypoint - Dot_Pixel,
+                       Xpoint + Dot_Pixel, Ypoint + Dot_Pixel, NULL);
+        return;
+    }
 
-    int16_t XDir_Num , YDir_Num;
-    if (Dot_Style == DOT_FILL_AROUND) {
-        for (XDir_Num = 0; XDir_Num < 2 * Dot_Pixel - 1; XDir_Num++) {
-            for (YDir_Num = 0; YDir_Num < 2 * Dot_Pixel - 1; YDir_Num++) {
-                if(Xpoint + XDir_Num - Dot_Pixel < 0 || Ypoint + YDir_Num - Dot_Pixel < 0)
-                    break;
-                // printf("x = %d, y = %d\r\n", Xpoint + XDir_Num - Dot_Pixel, Ypoint + YDir_Num - Dot_Pixel);
-                Paint_SetPixel(Xpoint + XDir_Num - Dot_Pixel, Ypoint + YDir_Num - Dot_Pixel, Color);
-            }
-        }
-    } else {
-        for (XDir_Num = 0; XDir_Num <  Dot_Pixel; XDir_Num++) {
-            for (YDir_Num = 0; YDir_Num <  Dot_Pixel; YDir_Num++) {
-                Paint_SetPixel(Xpoint + XDir_Num - 1, Ypoint + YDir_Num - 1, Color);
-            }
-        }
+    if (Dot_Pixel != DOT_PIXEL_1X1) {
+        if (Dot_Style == DOT_FILL_AROUND)
+            Paint_FillDots(Ctx, Xpoint, Ypoint, Xpoint, Ypoint, Color, Dot_Pixel);
+        else
+            Paint_FillRect(Ctx, Xpoint - 1, Ypoint - 1, Xpoint + Dot_Pixel - 2, Ypoint + Dot_Pixel - 2, Color);
+        return;
+    }
+
+    //Both styles put a 1x1 point one up and left
+    if (Xpoint > 0 && Ypoint > 0) {
+        Paint_Dirty(Ctx, Xpoint - 1, Ypoint - 1, Xpoint - 1, Ypoint - 1);
+        Paint_Pixel(Ctx)(Ctx, Xpoint - 1, Ypoint - 1, Color);
     }
 }
 
@@ -357,14 +1044,29 @@ parameter:
     Line_width : Line width
     Line_Style: Solid and dotted lines
 ******************************************************************************/
-void Paint_DrawLine(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
+void Paint_DrawLine(PAINT *Ctx, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
                     UWORD Color, DOT_PIXEL Line_width, LINE_STYLE Line_Style)
 {
-    if (Xstart > Paint.Width || Ystart > Paint.Height ||
-        Xend > Paint.Width || Yend > Paint.Height) {
+    if (Xstart > Ctx->Width || Ystart > Ctx->Height ||
+        Xend > Ctx->Width || Yend > Ctx->Height) {
         Debug("Paint_DrawLine Input exceeds the normal display range\r\n");
         return;
     }
+    if (Ctx->List != NULL) {
+        PAINT_ITEM Item = Paint_Item(PAINT_OP_LINE, Xstart, Ystart, Xend, Yend, Color, 0);
+        Item.Dot = Line_width;
+        Item.Style = Line_Style;
+        Paint_ListRect(Ctx, &Item, (Xstart < Xend ? Xstart : Xend) - Line_width, (Ystart < Yend ? Ystart : Yend) - Line_width,
+                       (Xstart < Xend ? Xend : Xstart) + Line_width, (Ystart < Yend ? Yend : Ystart) + Line_width, NULL);
+        return;
+    }
+
+    //Horizontal and vertical solid lines are one fill
+    if (Line_Style == LINE_STYLE_SOLID && (Xstart == Xend || Ystart == Yend)) {
+        Paint_FillDots(Ctx, Xstart < Xend ? Xstart : Xend, Ystart < Yend ? Ystart : Yend,
+                       Xstart < Xend ? Xend : Xstart, Ystart < Yend ? Yend : Ystart, Color, Line_width);
+        return;
+    }
 
     UWORD Xpoint = Xstart;
     UWORD Ypoint = Ystart;
@@ -378,16 +1080,25 @@ void Paint_DrawLine(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
     //Cumulative error
     int Esp = dx + dy;
     char Dotted_Len = 0;
+    PAINT_PIXEL SetPixel = Paint_Pixel(Ctx);
+    Paint_Dirty(Ctx, (Xstart < Xend ? Xstart : Xend) - Line_width, (Ystart < Yend ? Ystart : Yend) - Line_width,
+                (Xstart < Xend ? Xend : Xstart) + Line_width - 2, (Ystart < Yend ? Yend : Ystart) + Line_width - 2);
 
     for (;;) {
         Dotted_Len++;
         //Painted dotted line, 2 point is really virtual
         if (Line_Style == LINE_STYLE_DOTTED && Dotted_Len % 3 == 0) {
             //Debug("LINE_DOTTED\r\n");
-            Paint_DrawPoint(Xpoint, Ypoint, IMAGE_BACKGROUND, Line_width, DOT_STYLE_DFT);
+            if (Line_width != DOT_PIXEL_1X1)
+                Paint_DrawPoint(Ctx, Xpoint, Ypoint, IMAGE_BACKGROUND, Line_width, DOT_STYLE_DFT);
+            else if (Xpoint > 0 && Ypoint > 0)
+                SetPixel(Ctx, Xpoint - 1, Ypoint - 1, IMAGE_BACKGROUND);
             Dotted_Len = 0;
         } else {
-            Paint_DrawPoint(Xpoint, Ypoint, Color, Line_width, DOT_STYLE_DFT);
+            if (Line_width != DOT_PIXEL_1X1)
+                Paint_DrawPoint(Ctx, Xpoint, Ypoint, Color, Line_width, DOT_STYLE_DFT);
+            else if (Xpoint > 0 && Ypoint > 0)
+                SetPixel(Ctx, Xpoint - 1, Ypoint - 1, Color);
         }
         if (2 * Esp >= dy) {
             if (Xpoint == Xend)
@@ -415,25 +1126,33 @@ parameter:
     Line_width: Line width
     Draw_Fill : Whether to fill the inside of the rectangle
 ******************************************************************************/
-void Paint_DrawRectangle(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
+void Paint_DrawRectangle(PAINT *Ctx, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
                          UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill)
 {
-    if (Xstart > Paint.Width || Ystart > Paint.Height ||
-        Xend > Paint.Width || Yend > Paint.Height) {
+    if (Xstart > Ctx->Width || Ystart > Ctx->Height ||
+        Xend > Ctx->Width || Yend > Ctx->Height) {
         Debug("Input exceeds the normal display range\r\n");
         return;
     }
+    if (Ctx->List != NULL) {
+        PAINT_ITEM Item = Paint_Item(PAINT_OP_RECTANGLE, Xstart, Ystart, Xend, Yend, Color, 0);
+        Item.Dot = Line_width;
+        Item.Style = Draw_Fill;
+        Paint_ListRect(Ctx, &Item, (Xstart < Xend ? Xstart : Xend) - Line_width, (Ystart < Yend ? Ystart : Yend) - Line_width,
+                       (Xstart < Xend ? Xend : Xstart) + Line_width, (Ystart < Yend ? Yend : Ystart) + Line_width, NULL);
+        return;
+    }
 
     if (Draw_Fill) {
-        UWORD Ypoint;
-        for(Ypoint = Ystart; Ypoint < Yend; Ypoint++) {
-            Paint_DrawLine(Xstart, Ypoint, Xend, Ypoint, Color , Line_width, LINE_STYLE_SOLID);
-        }
+        //Same area as one solid line per row from Ystart to Yend - 1
+        if (Ystart < Yend)
+            Paint_FillDots(Ctx, Xstart < Xend ? Xstart : Xend, Ystart,
+                           Xstart < Xend ? Xend : Xstart, Yend - 1, Color, Line_width);
     } else {
-        Paint_DrawLine(Xstart, Ystart, Xend, Ystart, Color, Line_width, LINE_STYLE_SOLID);
-        Paint_DrawLine(Xstart, Ystart, Xstart, Yend, Color, Line_width, LINE_STYLE_SOLID);
-        Paint_DrawLine(Xend, Yend, Xend, Ystart, Color, Line_width, LINE_STYLE_SOLID);
-        Paint_DrawLine(Xend, Yend, Xstart, Yend, Color, Line_width, LINE_STYLE_SOLID);
+        Paint_DrawLine(Ctx, Xstart, Ystart, Xend, Ystart, Color, Line_width, LINE_STYLE_SOLID);
+        Paint_DrawLine(Ctx, Xstart, Ystart, Xstart, Yend, Color, Line_width, LINE_STYLE_SOLID);
+        Paint_DrawLine(Ctx, Xend, Yend, Xend, Ystart, Color, Line_width, LINE_STYLE_SOLID);
+        Paint_DrawLine(Ctx, Xend, Yend, Xstart, Yend, Color, Line_width, LINE_STYLE_SOLID);
     }
 }
 
@@ -448,13 +1167,21 @@ parameter:
     Line_width: Line width
     Draw_Fill : Whether to fill the inside of the Circle
 ******************************************************************************/
-void Paint_DrawCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius,
+void Paint_DrawCircle(PAINT *Ctx, UWORD X_Center, UWORD Y_Center, UWORD Radius,
                       UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill)
 {
-    if (X_Center > Paint.Width || Y_Center >= Paint.Height) {
+    if (X_Center > Ctx->Width || Y_Center >= Ctx->Height) {
         Debug("Paint_DrawCircle Input exceeds the normal display range\r\n");
         return;
     }
+    if (Ctx->List != NULL) {
+        PAINT_ITEM Item = Paint_Item(PAINT_OP_CIRCLE, X_Center, Y_Center, Radius, 0, Color, 0);
+        Item.Dot = Line_width;
+        Item.Style = Draw_Fill;
+        Paint_ListRect(Ctx, &Item, X_Center - Radius - Line_width, Y_Center - Radius - Line_width,
+                       X_Center + Radius + Line_width, Y_Center + Radius + Line_width, NULL);
+        return;
+    }
 
     //Draw a circle from(0, R) as a starting point
     int16_t XCurrent, YCurrent;
@@ -464,19 +1191,17 @@ void Paint_DrawCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius,
     //Cumulative error,judge the next point of the logo
     int16_t Esp = 3 - (Radius << 1 );
 
-    int16_t sCountY;
+    //One changed area for the whole circle, points are drawn one up and left
+    Paint_Dirty(Ctx, X_Center - Radius - Line_width, Y_Center - Radius - Line_width,
+                X_Center + Radius + Line_width - 2, Y_Center + Radius + Line_width - 2);
+
     if (Draw_Fill == DRAW_FILL_FULL) {
+        //The 8 octants as row spans, a point is drawn one up and left (DOT_STYLE_DFT)
         while (XCurrent <= YCurrent ) { //Realistic circles
-            for (sCountY = XCurrent; sCountY <= YCurrent; sCountY ++ ) {
-                Paint_DrawPoint(X_Center + XCurrent, Y_Center + sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//1
-                Paint_DrawPoint(X_Center - XCurrent, Y_Center + sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//2
-                Paint_DrawPoint(X_Center - sCountY, Y_Center + XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//3
-                Paint_DrawPoint(X_Center - sCountY, Y_Center - XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//4
-                Paint_DrawPoint(X_Center - XCurrent, Y_Center - sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//5
-                Paint_DrawPoint(X_Center + XCurrent, Y_Center - sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//6
-                Paint_DrawPoint(X_Center + sCountY, Y_Center - XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//7
-                Paint_DrawPoint(X_Center + sCountY, Y_Center + XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);
-            }
+            Paint_FillRect(Ctx, X_Center - YCurrent - 1, Y_Center + XCurrent - 1, X_Center + YCurrent - 1, Y_Center + XCurrent - 1, Color);
+            Paint_FillRect(Ctx, X_Center - YCurrent - 1, Y_Center - XCurrent - 1, X_Center + YCurrent - 1, Y_Center - XCurrent - 1, Color);
+            Paint_FillRect(Ctx, X_Center - XCurrent - 1, Y_Center + YCurrent - 1, X_Center + XCurrent - 1, Y_Center + YCurrent - 1, Color);
+            Paint_FillRect(Ctx, X_Center - XCurrent - 1, Y_Center - YCurrent - 1, X_Center + XCurrent - 1, Y_Center - YCurrent - 1, Color);
             if (Esp < 0 )
                 Esp += 4 * XCurrent + 6;
             else {
@@ -487,14 +1212,14 @@ void Paint_DrawCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius,
         }
     } else { //Draw a hollow circle
         while (XCurrent <= YCurrent ) {
-            Paint_DrawPoint(X_Center + XCurrent, Y_Center + YCurrent, Color, Line_width, DOT_STYLE_DFT);//1
-            Paint_DrawPoint(X_Center - XCurrent, Y_Center + YCurrent, Color, Line_width, DOT_STYLE_DFT);//2
-            Paint_DrawPoint(X_Center - YCurrent, Y_Center + XCurrent, Color, Line_width, DOT_STYLE_DFT);//3
-            Paint_DrawPoint(X_Center - YCurrent, Y_Center - XCurrent, Color, Line_width, DOT_STYLE_DFT);//4
-            Paint_DrawPoint(X_Center - XCurrent, Y_Center - YCurrent, Color, Line_width, DOT_STYLE_DFT);//5
-            Paint_DrawPoint(X_Center + XCurrent, Y_Center - YCurrent, Color, Line_width, DOT_STYLE_DFT);//6
-            Paint_DrawPoint(X_Center + YCurrent, Y_Center - XCurrent, Color, Line_width, DOT_STYLE_DFT);//7
-            Paint_DrawPoint(X_Center + YCurrent, Y_Center + XCurrent, Color, Line_width, DOT_STYLE_DFT);//0
+            Paint_DrawPoint(Ctx, X_Center + XCurrent, Y_Center + YCurrent, Color, Line_width, DOT_STYLE_DFT);//1
+            Paint_DrawPoint(Ctx, X_Center - XCurrent, Y_Center + YCurrent, Color, Line_width, DOT_STYLE_DFT);//2
+            Paint_DrawPoint(Ctx, X_Center - YCurrent, Y_Center + XCurrent, Color, Line_width, DOT_STYLE_DFT);//3
+            Paint_DrawPoint(Ctx, X_Center - YCurrent, Y_Center - XCurrent, Color, Line_width, DOT_STYLE_DFT);//4
+            Paint_DrawPoint(Ctx, X_Center - XCurrent, Y_Center - YCurrent, Color, Line_width, DOT_STYLE_DFT);//5
+            Paint_DrawPoint(Ctx, X_Center + XCurrent, Y_Center - YCurrent, Color, Line_width, DOT_STYLE_DFT);//6
+            Paint_DrawPoint(Ctx, X_Center + YCurrent, Y_Center - XCurrent, Color, Line_width, DOT_STYLE_DFT);//7
+            Paint_DrawPoint(Ctx, X_Center + YCurrent, Y_Center + XCurrent, Color, Line_width, DOT_STYLE_DFT);//0
 
             if (Esp < 0 )
                 Esp += 4 * XCurrent + 6;
@@ -507,6 +1232,150 @@ void Paint_DrawCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius,
     }
 }
 
+/******************************************************************************
+function: Reverse the bits of a glyph row
+******************************************************************************/
+static uint32_t Paint_Reverse(uint32_t v)
+{
+    v = ((v >> 1) & 0x55555555) | ((v & 0x55555555) << 1);
+    v = ((v >> 2) & 0x33333333) | ((v & 0x33333333) << 2);
+    v = ((v >> 4) & 0x0F0F0F0F) | ((v & 0x0F0F0F0F) << 4);
+    v = ((v >> 8) & 0x00FF00FF) | ((v & 0x00FF00FF) << 8);
+    return (v >> 16) | (v << 16);
+}
+
+//glyph bits of one image byte -> pixel mask, 2 bpp: 4 bits, 4 bpp: 2 bits
+static const UBYTE Paint_Expand2[16] = {
+    0x00, 0x03, 0x0C, 0x0F, 0x30, 0x33, 0x3C, 0x3F,
+    0xC0, 0xC3, 0xCC, 0xCF, 0xF0, 0xF3, 0xFC, 0xFF,
+};
+static const UBYTE Paint_Expand4[4] = {0x00, 0x0F, 0xF0, 0xFF};
+
+#define PAINT_BLIT_WIDTH 24     //widest glyph the blitter takes
+
+/******************************************************************************
+function: Blit a glyph row by row into the image memory
+parameter:
+    Xpoint           : X coordinate
+    Ypoint           : Y coordinate
+    Acsii_Char       : To display the English characters
+    Font             : A structure pointer that displays a character size
+    Color_Foreground : color of the set bits
+    Color_Background : color of the clear bits, FONT_BACKGROUND: left as is
+Info:
+    Whole glyph rows are shifted onto the image bytes and merged with
+    masks, for all scales. At ROTATE_0 / ROTATE_180 a glyph row is an image
+    row, at ROTATE_90 / ROTATE_270 the rows come from the pre-rotated table
+    of the font, see Font_Rotated(). Takes glyphs up to PAINT_BLIT_WIDTH
+    wide (high when rotated). Returns 0 when the glyph has to be drawn
+    pixel by pixel instead.
+******************************************************************************/
+static UBYTE Paint_BlitGlyph(PAINT *Ctx, UWORD Xpoint, UWORD Ypoint, const char Acsii_Char, sFONT* Font,
+                             UWORD Color_Foreground, UWORD Color_Background)
+{
+    UBYTE Bits = Paint_Bits(Ctx), PPB, Turn, FlipX, FlipY, Fore[2], Back[2], Opaque, Plane;
+    UWORD Glyph_Bits, Glyph_Rows, Start, Start_Row, Width, Height;
+    UWORD Line, Cols, Rows, Page, X, Y, Shift, Bytes, k;
+    UDOUBLE Plane_Size = Paint_PlaneSize(Ctx);
+    const unsigned char *ptr;
+    uint32_t Area, Glyph;
+
+    if (Bits == 0 || Ctx->Rotate % 90 != 0 || Ctx->Rotate > ROTATE_270)
+        return 0;
+
+    //Image rows run along x at 0 / 180 and along y at 90 / 270
+    Turn = (Ctx->Rotate == ROTATE_90 || Ctx->Rotate == ROTATE_270);
+    if (!Turn) {
+        Glyph_Bits = Font->Width;
+        Glyph_Rows = Font->Height;
+        Start = Xpoint;
+        Start_Row = Ypoint;
+        Width = Ctx->Width;
+        Height = Ctx->Height;
+        ptr = Font->table;
+        FlipX = (Ctx->Rotate == ROTATE_180);
+        FlipY = (Ctx->Rotate == ROTATE_180);
+    } else {
+        Glyph_Bits = Font->Height;
+        Glyph_Rows = Font->Width;
+        Start = Ypoint;
+        Start_Row = Xpoint;
+        Width = Ctx->Height;
+        Height = Ctx->Width;
+        ptr = Font_Rotated(Font);
+        FlipX = (Ctx->Rotate == ROTATE_90);
+        FlipY = (Ctx->Rotate == ROTATE_270);
+    }
+    if (ptr == NULL || Glyph_Bits > PAINT_BLIT_WIDTH)
+        return 0;
+    FlipX ^= (Ctx->Mirror & MIRROR_HORIZONTAL)? 1 : 0;
+    FlipY ^= (Ctx->Mirror & MIRROR_VERTICAL)? 1 : 0;
+    Line = Glyph_Bits / 8 + (Glyph_Bits % 8 ? 1 : 0);
+    ptr += (uint32_t)(Acsii_Char - ' ') * Glyph_Rows * Line;
+
+    //clip to the picture and the image, the glyph only runs off to the right and bottom
+    if (Width > Ctx->WidthMemory)
+        Width = Ctx->WidthMemory;
+    if (Height > Ctx->HeightMemory)
+        Height = Ctx->HeightMemory;
+    if (Start >= Width || Start_Row >= Height)
+        return 1;
+    Cols = (Start + Glyph_Bits > Width)? Width - Start : Glyph_Bits;
+    Rows = (Start_Row + Glyph_Rows > Height)? Height - Start_Row : Glyph_Rows;
+
+    //leftmost image pixel of the glyph
+    X = FlipX? Ctx->WidthMemory - Start - Cols : Start;
+
+    PPB = 8 / Bits;
+    Shift = X % PPB;
+    Bytes = (Shift + Cols + PPB - 1) / PPB;
+    Area = (0xFFFFFFFF << (32 - Cols)) >> Shift;
+    for (Plane = 0; Plane < Paint_Planes(Ctx); Plane++) {
+        Fore[Plane] = Paint_FillByte(Ctx, Color_Foreground, Plane);
+        Back[Plane] = Paint_FillByte(Ctx, Color_Background, Plane);
+    }
+    Opaque = (FONT_BACKGROUND != Color_Background);
+    Y = FlipY? Ctx->HeightMemory - Start_Row - Rows : Start_Row;
+    Paint_DirtyMemory(Ctx, X, Y, X + Cols - 1, Y + Rows - 1);
+
+    for (Page = 0; Page < Rows; Page++, ptr += Line) {
+        Glyph = (uint32_t)ptr[0] << 24;
+        if (Line > 1)
+            Glyph |= (uint32_t)ptr[1] << 16;
+        if (Line > 2)
+            Glyph |= (uint32_t)ptr[2] << 8;
+        Glyph &= 0xFFFFFFFF << (32 - Cols);
+        if (FlipX)
+            Glyph = Paint_Reverse(Glyph) << (32 - Cols);
+        Glyph >>= Shift;
+
+        Y = FlipY? Ctx->HeightMemory - (Start_Row + Page) - 1 : Start_Row + Page;
+        Y -= Ctx->YOffset;
+        if (Y >= Ctx->HeightByte)
+            continue;       //outside the band
+        UBYTE *Row = Ctx->Image + (UDOUBLE)Y * Ctx->WidthByte + X / PPB;
+
+        for (k = 0; k < Bytes; k++) {
+            UBYTE a = ((Area << (k * PPB)) >> (32 - PPB)) & ((1 << PPB) - 1);
+            UBYTE m = ((Glyph << (k * PPB)) >> (32 - PPB)) & ((1 << PPB) - 1);
+            if (Bits == 2) {
+                a = Paint_Expand2[a];
+                m = Paint_Expand2[m];
+            } else if (Bits == 4) {
+                a = Paint_Expand4[a];
+                m = Paint_Expand4[m];
+            }
+            if (!Opaque)
+                a = m;
+            for (Plane = 0; Plane < Paint_Planes(Ctx); Plane++) {
+                UBYTE *p = Row + k + Plane * Plane_Size;
+                *p = (*p & ~a) | (Fore[Plane] & m) | (Back[Plane] & a & ~m);
+            }
+        }
+    }
+    return 1;
+}
+
 /******************************************************************************
 function: Show English characters
 parameter:
@@ -517,33 +1386,46 @@ parameter:
     Color_Foreground : Select the foreground color
     Color_Background : Select the background color
 ******************************************************************************/
-void Paint_DrawChar(UWORD Xpoint, UWORD Ypoint, const char Acsii_Char,
+void Paint_DrawChar(PAINT *Ctx, UWORD Xpoint, UWORD Ypoint, const char Acsii_Char,
                     sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
 {
     UWORD Page, Column;
 
-    if (Xpoint > Paint.Width || Ypoint > Paint.Height) {
+    if (Xpoint > Ctx->Width || Ypoint > Ctx->Height) {
         Debug("Paint_DrawChar Input exceeds the normal display range\r\n");
         return;
     }
+    if (Ctx->List != NULL) {
+        PAINT_ITEM Item = Paint_Item(PAINT_OP_CHAR, Xpoint, Ypoint, (UBYTE)Acsii_Char, 0,
+                                     Color_Foreground, Color_Background);
+        Item.Ptr = Font;
+        Paint_ListRect(Ctx, &Item, Xpoint, Ypoint, Xpoint + Font->Width - 1, Ypoint + Font->Height - 1, NULL);
+        return;
+    }
+
+    if (Paint_BlitGlyph(Ctx, Xpoint, Ypoint, Acsii_Char, Font, Color_Foreground, Color_Background))
+        return;
 
     uint32_t Char_Offset = (Acsii_Char - ' ') * Font->Height * (Font->Width / 8 + (Font->Width % 8 ? 1 : 0));
     const unsigned char *ptr = &Font->table[Char_Offset];
 
+    PAINT_PIXEL SetPixel = Paint_Pixel(Ctx);
+    Paint_Dirty(Ctx, Xpoint, Ypoint, Xpoint + Font->Width - 1, Ypoint + Font->Height - 1);
+
     for (Page = 0; Page < Font->Height; Page ++ ) {
         for (Column = 0; Column < Font->Width; Column ++ ) {
 
             //To determine whether the font background color and screen background color is consistent
             if (FONT_BACKGROUND == Color_Background) { //this process is to speed up the scan
                 if (*ptr & (0x80 >> (Column % 8)))
-                    Paint_SetPixel(Xpoint + Column, Ypoint + Page, Color_Foreground);
+                    SetPixel(Ctx, Xpoint + Column, Ypoint + Page, Color_Foreground);
                     // Paint_DrawPoint(Xpoint + Column, Ypoint + Page, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
             } else {
                 if (*ptr & (0x80 >> (Column % 8))) {
-                    Paint_SetPixel(Xpoint + Column, Ypoint + Page, Color_Foreground);
+                    SetPixel(Ctx, Xpoint + Column, Ypoint + Page, Color_Foreground);
                     // Paint_DrawPoint(Xpoint + Column, Ypoint + Page, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
                 } else {
-                    Paint_SetPixel(Xpoint + Column, Ypoint + Page, Color_Background);
+                    SetPixel(Ctx, Xpoint + Column, Ypoint + Page, Color_Background);
                     // Paint_DrawPoint(Xpoint + Column, Ypoint + Page, Color_Background, DOT_PIXEL_DFT, DOT_STYLE_DFT);
                 }
             }
@@ -566,30 +1448,36 @@ parameter:
     Color_Foreground : Select the foreground color
     Color_Background : Select the background color
 ******************************************************************************/
-void Paint_DrawString_EN(UWORD Xstart, UWORD Ystart, const char * pString,
+void Paint_DrawString_EN(PAINT *Ctx, UWORD Xstart, UWORD Ystart, const char * pString,
                          sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
 {
     UWORD Xpoint = Xstart;
     UWORD Ypoint = Ystart;
 
-    if (Xstart > Paint.Width || Ystart > Paint.Height) {
+    if (Xstart > Ctx->Width || Ystart > Ctx->Height) {
         Debug("Paint_DrawString_EN Input exceeds the normal display range\r\n");
         return;
     }
+    if (Ctx->List != NULL) {
+        PAINT_ITEM Item = Paint_Item(PAINT_OP_STRING_EN, Xstart, Ystart, 0, 0, Color_Foreground, Color_Background);
+        Item.Ptr = Font;
+        Paint_ListString(Ctx, &Item, pString, Font->Width, Font->Height);
+        return;
+    }
 
     while (* pString != '\0') {
         //if X direction filled , reposition to(Xstart,Ypoint),Ypoint is Y direction plus the Height of the character
-        if ((Xpoint + Font->Width ) > Paint.Width ) {
+        if ((Xpoint + Font->Width ) > Ctx->Width ) {
             Xpoint = Xstart;
             Ypoint += Font->Height;
         }
 
         // If the Y direction is full, reposition to(Xstart, Ystart)
-        if ((Ypoint  + Font->Height ) > Paint.Height ) {
+        if ((Ypoint  + Font->Height ) > Ctx->Height ) {
             Xpoint = Xstart;
             Ypoint = Ystart;
         }
-        Paint_DrawChar(Xpoint, Ypoint, * pString, Font, Color_Background, Color_Foreground);
+        Paint_DrawChar(Ctx, Xpoint, Ypoint, * pString, Font, Color_Background, Color_Foreground);
 
         //The next character of the address
         pString ++;
@@ -600,6 +1488,219 @@ void Paint_DrawString_EN(UWORD Xstart, UWORD Ystart, const char * pString,
 }
 
 
+#define PAINT_GRAY_WIDTH 16     //widest gray glyph the blitter takes
+
+/**
+ * Ink of a gray string: the color of each coverage, and per coverage byte
+ * of a glyph row what it writes, see Paint_GrayInk()
+**/
+typedef struct {
+    UWORD Level[4];
+    UWORD Lut[256];
+} PAINT_GRAY_INK;
+
+/******************************************************************************
+function: Colors of a gray string
+parameter:
+    Ink    : color of full coverage
+    Paper  : color of no coverage
+    Opaque : write the pixels without coverage too
+Info:
+    At 4 gray the coverage steps evenly from Paper to Ink, at the other
+    scales a pixel is Ink from half coverage on. For the blitter the Lut
+    takes a coverage byte (4 pixels) to, packed, the 4 pixels in the low
+    byte and their mask in the high byte, planar, the 4 bits of plane 0 in
+    bits 0-3, of plane 1 in bits 4-7 and their mask in bits 8-11.
+******************************************************************************/
+static void Paint_GrayInk(PAINT *Ctx, UWORD Ink, UWORD Paper, UBYTE Opaque, PAINT_GRAY_INK *Gray)
+{
+    UWORD b;
+    UBYTE c, k, Level;
+
+    for (c = 0; c < 4; c++) {
+        if (Ctx->Scale == 4)
+            Gray->Level[c] = ((Paper % 4) * (3 - c) + (Ink % 4) * c + 1) / 3;
+        else
+            Gray->Level[c] = (c >= 2)? Ink : Paper;
+    }
+    if (Ctx->Scale != 4)
+        return;
+
+    for (b = 0; b < 256; b++) {
+        UWORD Entry = 0;
+        for (k = 0; k < 4; k++) {
+            c = (b >> (6 - 2 * k)) & 0x03;
+            Level = Gray->Level[c];
+            if (Ctx->Gray == NULL) {
+                Entry |= Level << (6 - 2 * k);
+                if (Opaque || c != 0)
+                    Entry |= 0x0300 << (6 - 2 * k);
+            } else {
+                Entry |= (Ctx->Gray[Level] & 0x01) << (3 - k);
+                Entry |= ((Ctx->Gray[Level] >> 1) & 0x01) << (7 - k);
+                if (Opaque || c != 0)
+                    Entry |= 0x0100 << (3 - k);
+            }
+        }
+        Gray->Lut[b] = Entry;
+    }
+}
+
+/******************************************************************************
+function: Blit a gray glyph row by row into a 4 gray image
+parameter:
+    Xpoint : X coordinate
+    Ypoint : Y coordinate
+    ptr    : the glyph in the table of the font
+    Font   : gray font
+    Gray   : ink from Paint_GrayInk()
+Info:
+    Each coverage byte of a glyph row goes through the Lut once, the row is
+    then shifted onto the image bytes and merged with its mask, packed or
+    into both planes. ROTATE_0 without mirroring only, returns 0 when the
+    glyph has to be drawn pixel by pixel instead.
+******************************************************************************/
+static UBYTE Paint_BlitGray(PAINT *Ctx, UWORD Xpoint, UWORD Ypoint, const UBYTE *ptr, sFONT_GRAY *Font,
+                            const PAINT_GRAY_INK *Gray)
+{
+    UWORD Line = (Font->Width + 3) / 4, Width, Height, Cols, Rows, Page, Shift, Bytes, Y, k;
+    UDOUBLE Plane_Size = Paint_PlaneSize(Ctx);
+
+    if (Ctx->Scale != 4 || Ctx->Rotate != ROTATE_0 || Ctx->Mirror != MIRROR_NONE
+        || Font->Width > PAINT_GRAY_WIDTH)
+        return 0;
+
+    Width = (Ctx->Width > Ctx->WidthMemory)? Ctx->WidthMemory : Ctx->Width;
+    Height = (Ctx->Height > Ctx->HeightMemory)? Ctx->HeightMemory : Ctx->Height;
+    if (Xpoint >= Width || Ypoint >= Height)
+        return 1;
+    Cols = (Xpoint + Font->Width > Width)? Width - Xpoint : Font->Width;
+    Rows = (Ypoint + Font->Height > Height)? Height - Ypoint : Font->Height;
+    Paint_DirtyMemory(Ctx, Xpoint, Ypoint, Xpoint + Cols - 1, Ypoint + Rows - 1);
+
+    for (Page = 0; Page < Rows; Page++, ptr += Line) {
+        Y = Ypoint + Page - Ctx->YOffset;
+        if (Y >= Ctx->HeightByte)
+            continue;       //outside the band
+
+        if (Ctx->Gray == NULL) {
+            //2 bits per pixel, at most 16 pixels and 3 of shift
+            uint64_t Value = 0, Mask = 0;
+            for (k = 0; k < Line; k++) {
+                Value |= (uint64_t)(Gray->Lut[ptr[k]] & 0xFF) << (56 - 8 * k);
+                Mask |= (uint64_t)(Gray->Lut[ptr[k]] >> 8) << (56 - 8 * k);
+            }
+            Mask &= ~(uint64_t)0 << (64 - 2 * Cols);
+            Shift = Xpoint % 4;
+            Value >>= 2 * Shift;
+            Mask >>= 2 * Shift;
+            Bytes = (Shift + Cols + 3) / 4;
+            UBYTE *p = Ctx->Image + (UDOUBLE)Y * Ctx->WidthByte + Xpoint / 4;
+            for (k = 0; k < Bytes; k++) {
+                UBYTE m = Mask >> (56 - 8 * k);
+                p[k] = (p[k] & ~m) | ((UBYTE)(Value >> (56 - 8 * k)) & m);
+            }
+        } else {
+            //a bit per pixel in each plane
+            uint32_t Plane0 = 0, Plane1 = 0, Mask = 0;
+            for (k = 0; k < Line; k++) {
+                UWORD Entry = Gray->Lut[ptr[k]];
+                Plane0 |= (uint32_t)(Entry & 0x0F) << (28 - 4 * k);
+                Plane1 |= (uint32_t)((Entry >> 4) & 0x0F) << (28 - 4 * k);
+                Mask |= (uint32_t)((Entry >> 8) & 0x0F) << (28 - 4 * k);
+            }
+            Mask &= 0xFFFFFFFF << (32 - Cols);
+            Shift = Xpoint % 8;
+            Plane0 >>= Shift;
+            Plane1 >>= Shift;
+            Mask >>= Shift;
+            Bytes = (Shift + Cols + 7) / 8;
+            UBYTE *p = Ctx->Image + (UDOUBLE)Y * Ctx->WidthByte + Xpoint / 8;
+            for (k = 0; k < Bytes; k++) {
+                UBYTE m = Mask >> (24 - 8 * k);
+                p[k] = (p[k] & ~m) | ((UBYTE)(Plane0 >> (24 - 8 * k)) & m);
+                p[k + Plane_Size] = (p[k + Plane_Size] & ~m) | ((UBYTE)(Plane1 >> (24 - 8 * k)) & m);
+            }
+        }
+    }
+    return 1;
+}
+
+/******************************************************************************
+function:	Display a string in a gray font, anti-aliased at 4 gray
+parameter:
+    Xstart           ：X coordinate
+    Ystart           ：Y coordinate
+    pString          ：The first address of the English string to be displayed
+    Font             ：A gray font, e.g. Font12Gray
+    Color_Foreground : Select the foreground color
+    Color_Background : Select the background color
+Info:
+    Takes the colors like Paint_DrawString_EN(): the glyphs are drawn in
+    Color_Background, the cells filled with Color_Foreground, or left as
+    they are when it is FONT_BACKGROUND. The edges of the glyphs get the
+    grays in between, so draw on a Paint_SetScale(4) or
+    Paint_SetGrayPlanes() picture; at the other scales the glyphs come out
+    1 bit. Wraps like Paint_DrawString_EN(). Whole rows are blitted at
+    ROTATE_0 without mirroring, about the cost of 1 bit text, pixel by
+    pixel otherwise.
+******************************************************************************/
+void Paint_DrawString_Gray(PAINT *Ctx, UWORD Xstart, UWORD Ystart, const char * pString,
+                           sFONT_GRAY* Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    UWORD Xpoint = Xstart, Ypoint = Ystart, Page, Column;
+    UWORD Line = (Font->Width + 3) / 4;
+    UBYTE Opaque = (FONT_BACKGROUND != Color_Foreground), Min;
+    PAINT_GRAY_INK Gray;
+    const UBYTE *Table, *ptr;
+
+    if (Xstart > Ctx->Width || Ystart > Ctx->Height) {
+        Debug("Paint_DrawString_Gray Input exceeds the normal display range\r\n");
+        return;
+    }
+    if (Ctx->List != NULL) {
+        PAINT_ITEM Item = Paint_Item(PAINT_OP_STRING_GRAY, Xstart, Ystart, 0, 0, Color_Foreground, Color_Background);
+        Item.Ptr = Font;
+        Paint_ListString(Ctx, &Item, pString, Font->Width, Font->Height);
+        return;
+    }
+    Table = Font_GrayTable(Font);
+    if (Table == NULL) {
+        Debug("Paint_DrawString_Gray no memory for the font\r\n");
+        return;
+    }
+    Paint_GrayInk(Ctx, Color_Background, Color_Foreground, Opaque, &Gray);
+    PAINT_PIXEL SetPixel = Paint_Pixel(Ctx);
+    //least coverage drawn pixel by pixel, a transparent cell keeps what Paper would write
+    Min = Opaque? 0 : (Ctx->Scale == 4)? 1 : 2;
+
+    while (* pString != '\0') {
+        if ((Xpoint + Font->Width ) > Ctx->Width ) {
+            Xpoint = Xstart;
+            Ypoint += Font->Height;
+        }
+        if ((Ypoint  + Font->Height ) > Ctx->Height ) {
+            Xpoint = Xstart;
+            Ypoint = Ystart;
+        }
+        if (* pString >= ' ' && * pString <= '~') {
+            ptr = Table + (uint32_t)(* pString - ' ') * Font->Height * Line;
+            if (!Paint_BlitGray(Ctx, Xpoint, Ypoint, ptr, Font, &Gray)) {
+                Paint_Dirty(Ctx, Xpoint, Ypoint, Xpoint + Font->Width - 1, Ypoint + Font->Height - 1);
+                for (Page = 0; Page < Font->Height; Page++) {
+                    for (Column = 0; Column < Font->Width; Column++) {
+                        UBYTE c = (ptr[Page * Line + Column / 4] >> (6 - 2 * (Column % 4))) & 0x03;
+                        if (c >= Min)
+                            SetPixel(Ctx, Xpoint + Column, Ypoint + Page, Gray.Level[c]);
+                    }
+                }
+            }
+        }
+        pString ++;
+        Xpoint += Font->Width;
+    }
+}
+
 /******************************************************************************
 function: Display the string
 parameter:
@@ -611,12 +1712,20 @@ parameter:
     Color_Foreground : Select the foreground color
     Color_Background : Select the background color
 ******************************************************************************/
-void Paint_DrawString_CN(UWORD Xstart, UWORD Ystart, const char * pString, cFONT* font,
+void Paint_DrawString_CN(PAINT *Ctx, UWORD Xstart, UWORD Ystart, const char * pString, cFONT* font,
                         UWORD Color_Foreground, UWORD Color_Background)
 {
     const char* p_text = pString;
     int x = Xstart, y = Ystart;
     int i, j,Num;
+    PAINT_PIXEL SetPixel = Paint_Pixel(Ctx);
+
+    if (Ctx->List != NULL) {
+        PAINT_ITEM Item = Paint_Item(PAINT_OP_STRING_CN, Xstart, Ystart, 0, 0, Color_Foreground, Color_Background);
+        Item.Ptr = font;
+        Paint_ListRect(Ctx, &Item, Xstart, Ystart, Ctx->Width - 1, Ystart + font->Height - 1, pString);
+        return;
+    }
 
     /* Send the string character by character on EPD */
     while (*p_text != 0) {
@@ -624,20 +1733,21 @@ void Paint_DrawString_CN(UWORD Xstart, UWORD Ystart, const char * pString, cFONT
             for(Num = 0; Num < font->size; Num++) {
                 if(*p_text== font->table[Num].index[0]) {
                     const char* ptr = &font->table[Num].matrix[0];
+                    Paint_Dirty(Ctx, x, y, x + font->Width - 1, y + font->Height - 1);
 
                     for (j = 0; j < font->Height; j++) {
                         for (i = 0; i < font->Width; i++) {
                             if (FONT_BACKGROUND == Color_Background) { //this process is to speed up the scan
                                 if (*ptr & (0x80 >> (i % 8))) {
-                                    Paint_SetPixel(x + i, y + j, Color_Foreground);
+                                    SetPixel(Ctx, x + i, y + j, Color_Foreground);
                                     // Paint_DrawPoint(x + i, y + j, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
                                 }
                             } else {
                                 if (*ptr & (0x80 >> (i % 8))) {
-                                    Paint_SetPixel(x + i, y + j, Color_Foreground);
+                                    SetPixel(Ctx, x + i, y + j, Color_Foreground);
                                     // Paint_DrawPoint(x + i, y + j, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
                                 } else {
-                                    Paint_SetPixel(x + i, y + j, Color_Background);
+                                    SetPixel(Ctx, x + i, y + j, Color_Background);
                                     // Paint_DrawPoint(x + i, y + j, Color_Background, DOT_PIXEL_DFT, DOT_STYLE_DFT);
                                 }
                             }
@@ -662,20 +1772,21 @@ void Paint_DrawString_CN(UWORD Xstart, UWORD Ystart, const char * pString, cFONT
                     (*(p_text + 1) == font->table[Num].index[1]) && \
                     (*(p_text + 2) == font->table[Num].index[2])) {
                     const char* ptr = &font->table[Num].matrix[0];
+                    Paint_Dirty(Ctx, x, y, x + font->Width - 1, y + font->Height - 1);
 
                     for (j = 0; j < font->Height; j++) {
                         for (i = 0; i < font->Width; i++) {
                             if (FONT_BACKGROUND == Color_Background) { //this process is to speed up the scan
                                 if (*ptr & (0x80 >> (i % 8))) {
-                                    Paint_SetPixel(x + i, y + j, Color_Foreground);
+                                    SetPixel(Ctx, x + i, y + j, Color_Foreground);
                                     // Paint_DrawPoint(x + i, y + j, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
                                 }
                             } else {
                                 if (*ptr & (0x80 >> (i % 8))) {
-                                    Paint_SetPixel(x + i, y + j, Color_Foreground);
+                                    SetPixel(Ctx, x + i, y + j, Color_Foreground);
                                     // Paint_DrawPoint(x + i, y + j, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
                                 } else {
-                                    Paint_SetPixel(x + i, y + j, Color_Background);
+                                    SetPixel(Ctx, x + i, y + j, Color_Background);
                                     // Paint_DrawPoint(x + i, y + j, Color_Background, DOT_PIXEL_DFT, DOT_STYLE_DFT);
                                 }
                             }
@@ -709,7 +1820,7 @@ parameter:
     Color_Background : Select the background color
 ******************************************************************************/
 #define  ARRAY_LEN 255
-void Paint_DrawNum(UWORD Xpoint, UWORD Ypoint, int32_t Nummber,
+void Paint_DrawNum(PAINT *Ctx, UWORD Xpoint, UWORD Ypoint, int32_t Nummber,
                    sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
 {
 
@@ -717,7 +1828,7 @@ void Paint_DrawNum(UWORD Xpoint, UWORD Ypoint, int32_t Nummber,
     uint8_t Str_Array[ARRAY_LEN] = {0}, Num_Array[ARRAY_LEN] = {0};
     uint8_t *pStr = Str_Array;
 
-    if (Xpoint > Paint.Width || Ypoint > Paint.Height) {
+    if (Xpoint > Ctx->Width || Ypoint > Ctx->Height) {
         Debug("Paint_DisNum Input exceeds the normal display range\r\n");
         return;
     }
@@ -737,7 +1848,7 @@ void Paint_DrawNum(UWORD Xpoint, UWORD Ypoint, int32_t Nummber,
     }
 
     //show
-    Paint_DrawString_EN(Xpoint, Ypoint, (const char*)pStr, Font, Color_Background, Color_Foreground);
+    Paint_DrawString_EN(Ctx, Xpoint, Ypoint, (const char*)pStr, Font, Color_Background, Color_Foreground);
 }
 
 /******************************************************************************
@@ -750,7 +1861,7 @@ parameter:
     Color_Foreground : Select the foreground color
     Color_Background : Select the background color
 ******************************************************************************/
-void Paint_DrawTime(UWORD Xstart, UWORD Ystart, PAINT_TIME *pTime, sFONT* Font,
+void Paint_DrawTime(PAINT *Ctx, UWORD Xstart, UWORD Ystart, PAINT_TIME *pTime, sFONT* Font,
                     UWORD Color_Foreground, UWORD Color_Background)
 {
     uint8_t value[10] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9'};
@@ -758,14 +1869,14 @@ void Paint_DrawTime(UWORD Xstart, UWORD Ystart, PAINT_TIME *pTime, sFONT* Font,
     UWORD Dx = Font->Width;
 
     //Write data into the cache
-    Paint_DrawChar(Xstart                           , Ystart, value[pTime->Hour / 10], Font, Color_Background, Color_Foreground);
-    Paint_DrawChar(Xstart + Dx                      , Ystart, value[pTime->Hour % 10], Font, Color_Background, Color_Foreground);
-    Paint_DrawChar(Xstart + Dx  + Dx / 4 + Dx / 2   , Ystart, ':'                    , Font, Color_Background, Color_Foreground);
-    Paint_DrawChar(Xstart + Dx * 2 + Dx / 2         , Ystart, value[pTime->Min / 10] , Font, Color_Background, Color_Foreground);
-    Paint_DrawChar(Xstart + Dx * 3 + Dx / 2         , Ystart, value[pTime->Min % 10] , Font, Color_Background, Color_Foreground);
-    Paint_DrawChar(Xstart + Dx * 4 + Dx / 2 - Dx / 4, Ystart, ':'                    , Font, Color_Background, Color_Foreground);
-    Paint_DrawChar(Xstart + Dx * 5                  , Ystart, value[pTime->Sec / 10] , Font, Color_Background, Color_Foreground);
-    Paint_DrawChar(Xstart + Dx * 6                  , Ystart, value[pTime->Sec % 10] , Font, Color_Background, Color_Foreground);
+    Paint_DrawChar(Ctx, Xstart                           , Ystart, value[pTime->Hour / 10], Font, Color_Background, Color_Foreground);
+    Paint_DrawChar(Ctx, Xstart + Dx                      , Ystart, value[pTime->Hour % 10], Font, Color_Background, Color_Foreground);
+    Paint_DrawChar(Ctx, Xstart + Dx  + Dx / 4 + Dx / 2   , Ystart, ':'                    , Font, Color_Background, Color_Foreground);
+    Paint_DrawChar(Ctx, Xstart + Dx * 2 + Dx / 2         , Ystart, value[pTime->Min / 10] , Font, Color_Background, Color_Foreground);
+    Paint_DrawChar(Ctx, Xstart + Dx * 3 + Dx / 2         , Ystart, value[pTime->Min % 10] , Font, Color_Background, Color_Foreground);
+    Paint_DrawChar(Ctx, Xstart + Dx * 4 + Dx / 2 - Dx / 4, Ystart, ':'                    , Font, Color_Background, Color_Foreground);
+    Paint_DrawChar(Ctx, Xstart + Dx * 5                  , Ystart, value[pTime->Sec / 10] , Font, Color_Background, Color_Foreground);
+    Paint_DrawChar(Ctx, Xstart + Dx * 6                  , Ystart, value[pTime->Sec % 10] , Font, Color_Background, Color_Foreground);
 }
 
 /******************************************************************************
@@ -775,18 +1886,43 @@ parameter:
 info:
     Use a computer to convert the image into a corresponding array,
     and then embed the array directly into Imagedata.cpp as a .c file.
+    A planar gray picture takes a packed 4 gray array and splits it into
+    its planes.
 ******************************************************************************/
-void Paint_DrawBitMap(const unsigned char* image_buffer)
+void Paint_DrawBitMap(PAINT *Ctx, const unsigned char* image_buffer)
 {
     UWORD x, y;
     UDOUBLE Addr = 0;
+    UBYTE Lut[2][256];
 
-    for (y = 0; y < Paint.HeightByte; y++) {
-        for (x = 0; x < Paint.WidthByte; x++) {//8 pixel =  1 byte
-            Addr = x + y * Paint.WidthByte;
-            Paint.Image[Addr] = (unsigned char)image_buffer[Addr];
+    if (Ctx->List != NULL) {
+        PAINT_ITEM Item = Paint_Item(PAINT_OP_BITMAP, 0, 0, 0, 0, 0, 0);
+        Item.Ptr = image_buffer;
+        Paint_ListAll(Ctx, &Item);
+        return;
+    }
+    if (Ctx->Gray != NULL) {
+        UWORD Packed = (Ctx->WidthMemory % 4 == 0)? (Ctx->WidthMemory / 4 ): (Ctx->WidthMemory / 4 + 1);
+        EPD_Common_GrayLut(Ctx->Gray, 0, Lut[0]);
+        EPD_Common_GrayLut(Ctx->Gray, 1, Lut[1]);
+        image_buffer += (UDOUBLE)Ctx->YOffset * Packed;
+        for (y = 0; y < Ctx->HeightByte; y++) {
+            Addr = (UDOUBLE)y * Ctx->WidthByte;
+            EPD_Common_GrayPlane(image_buffer + (UDOUBLE)y * Packed, Packed, Lut[0], Ctx->Image + Addr);
+            EPD_Common_GrayPlane(image_buffer + (UDOUBLE)y * Packed, Packed, Lut[1],
+                                 Ctx->Image + Paint_PlaneSize(Ctx) + Addr);
+        }
+        Paint_DirtyMemory(Ctx, 0, 0, Ctx->WidthMemory - 1, Ctx->HeightMemory - 1);
+        return;
+    }
+    image_buffer += (UDOUBLE)Ctx->YOffset * Ctx->WidthByte;    //first row of the band
+    for (y = 0; y < Ctx->HeightByte; y++) {
+        for (x = 0; x < Ctx->WidthByte; x++) {//8 pixel =  1 byte
+            Addr = x + y * Ctx->WidthByte;
+            Ctx->Image[Addr] = (unsigned char)image_buffer[Addr];
         }
     }
+    Paint_DirtyMemory(Ctx, 0, 0, Ctx->WidthMemory - 1, Ctx->HeightMemory - 1);
 }
 
 /******************************************************************************
@@ -797,18 +1933,389 @@ parameter:
     yStart           : Y starting coordinates
     xEnd             ：Image width
     yEnd             : Image height
+Info:
+    The bytes are copied as they are, on a planar gray picture the set bits
+    are WHITE and the clear ones BLACK.
 ******************************************************************************/
-void Paint_DrawImage(const unsigned char *image_buffer, UWORD xStart, UWORD yStart, UWORD W_Image, UWORD H_Image) 
+void Paint_DrawImage(PAINT *Ctx, const unsigned char *image_buffer, UWORD xStart, UWORD yStart, UWORD W_Image, UWORD H_Image) 
 {
     UWORD x, y;
 	UWORD w_byte=(W_Image%8)?(W_Image/8)+1:W_Image/8;
     UDOUBLE Addr = 0;
 	UDOUBLE pAddr = 0;
+    UBYTE Plane, White[2], Black[2];
+    if (Ctx->List != NULL) {
+        //image memory rows, rotate and mirror do not apply
+        PAINT_ITEM Item = Paint_Item(PAINT_OP_IMAGE, xStart, yStart, W_Image, H_Image, 0, 0);
+        Item.Ptr = image_buffer;
+        Item.Ystart = yStart;
+        Item.Yend = ((UDOUBLE)yStart + H_Image - 1 > 0xFFFF)? 0xFFFF : yStart + H_Image - 1;
+        if (H_Image != 0)
+            Paint_ListPut(Ctx, &Item, NULL);
+        return;
+    }
+    //a plain copy unless a plane of planar gray stores WHITE as 0
+    for (Plane = 0; Plane < Paint_Planes(Ctx); Plane++) {
+        White[Plane] = Paint_FillByte(Ctx, WHITE, Plane);
+        Black[Plane] = Paint_FillByte(Ctx, BLACK, Plane);
+    }
     for (y = 0; y < H_Image; y++) {
+        if ((UWORD)(y + yStart - Ctx->YOffset) >= Ctx->HeightByte)
+            continue;   //outside the image or the band
         for (x = 0; x < w_byte; x++) {//8 pixel =  1 byte
             Addr = x + y * w_byte;
-			pAddr=x+(xStart/8)+((y+yStart)*Paint.WidthByte);
-            Paint.Image[pAddr] = (unsigned char)image_buffer[Addr];
+			pAddr=x+(xStart/8)+((UDOUBLE)(y+yStart-Ctx->YOffset)*Ctx->WidthByte);
+            for (Plane = 0; Plane < Paint_Planes(Ctx); Plane++)
+                Ctx->Image[pAddr + Plane * Paint_PlaneSize(Ctx)] = (image_buffer[Addr] & White[Plane])
+                                                                 | (~image_buffer[Addr] & Black[Plane]);
+        }
+    }
+    if (W_Image != 0 && H_Image != 0)
+        Paint_DirtyMemory(Ctx, xStart / 8 * 8, yStart, xStart / 8 * 8 + w_byte * 8 - 1, yStart + H_Image - 1);
+}
+
+/******************************************************************************
+function:	Draw a row of pixels given as indices into a color table
+parameter:
+    Xstart : X starting coordinate
+    Ypoint : Y coordinate
+    Index  : a color index per pixel
+    Len    : pixels in the row
+    Color  : the colors, as the drawing functions take them
+    Colors : entries of Color, up to 16
+Info:
+    E.g. a dithered or palette quantized image row. Packed straight into
+    the image bytes at ROTATE_0 without mirroring, pixel by pixel
+    otherwise. Not for display lists, the row is not kept.
+******************************************************************************/
+void Paint_DrawIndexRow(PAINT *Ctx, UWORD Xstart, UWORD Ypoint, const UBYTE *Index, UWORD Len,
+                        const UWORD *Color, UBYTE Colors)
+{
+    UWORD x, X, Y;
+    UBYTE Bits = Paint_Bits(Ctx), Value[16], i;
+
+    if (Ctx->List != NULL) {
+        Debug("Paint_DrawIndexRow is not recorded\r\n");
+        return;
+    }
+    if (Bits == 0 || Colors == 0 || Colors > 16) {
+        Debug("Paint_DrawIndexRow scale or color table not supported\r\n");
+        return;
+    }
+    if (Xstart >= Ctx->Width || Ypoint >= Ctx->Height || Len == 0)
+        return;
+    if (Len > Ctx->Width - Xstart)
+        Len = Ctx->Width - Xstart;
+    //the bits of each color, plane 0 in bit 0, plane 1 in bit 1 when planar
+    for (i = 0; i < Colors; i++)
+        Value[i] = (Ctx->Gray != NULL)? Ctx->Gray[Color[i] % 4] : Paint_FillByte(Ctx, Color[i], 0) & ((1 << Bits) - 1);
+    Paint_Dirty(Ctx, Xstart, Ypoint, Xstart + Len - 1, Ypoint);
+
+    if (Ctx->Rotate != ROTATE_0 || Ctx->Mirror != MIRROR_NONE || Xstart + Len > Ctx->WidthMemory) {
+        PAINT_PIXEL SetPixel = Paint_Pixel(Ctx);
+        for (x = 0; x < Len; x++)
+            SetPixel(Ctx, Xstart + x, Ypoint, Color[Index[x] % Colors]);
+        return;
+    }
+    Y = Ypoint - Ctx->YOffset;
+    if (Y >= Ctx->HeightByte || Ypoint >= Ctx->HeightMemory)
+        return;     //outside the band
+    UBYTE *Row = Ctx->Image + (UDOUBLE)Y * Ctx->WidthByte;
+    if (Ctx->Gray != NULL) {
+        UBYTE *Row1 = Row + Paint_PlaneSize(Ctx);
+        for (x = 0, X = Xstart; x < Len; x++, X++) {
+            UBYTE Mask = 0x80 >> (X % 8), v = Value[Index[x] % Colors];
+            Row[X / 8] = (v & 0x01)? Row[X / 8] | Mask : Row[X / 8] & ~Mask;
+            Row1[X / 8] = (v & 0x02)? Row1[X / 8] | Mask : Row1[X / 8] & ~Mask;
+        }
+    } else {
+        for (x = 0, X = Xstart; x < Len; x++, X++) {
+            UBYTE Shift = 8 - Bits - (X * Bits) % 8;
+            UBYTE *p = Row + (UDOUBLE)X * Bits / 8;
+            *p = (*p & ~(((1 << Bits) - 1) << Shift)) | (Value[Index[x] % Colors] << Shift);
+        }
+    }
+}
+
+/******************************************************************************
+function:	Draw a row of gray levels, e.g. a dithered image row
+parameter:
+    Xstart : X starting coordinate
+    Ypoint : Y coordinate
+    Level  : a level per pixel, 0 black .. Levels - 1 white
+    Len    : pixels in the row
+    Levels : 2 or 4
+Info:
+    At 4 gray each level is a gray, at 1 bit the lighter half is WHITE.
+    See Paint_DrawIndexRow().
+******************************************************************************/
+void Paint_DrawGrayRow(PAINT *Ctx, UWORD Xstart, UWORD Ypoint, const UBYTE *Level, UWORD Len, UBYTE Levels)
+{
+    UWORD Color[4];
+    UBYTE L;
+
+    if ((Levels != 2 && Levels != 4) || (Ctx->Scale < 2 || Ctx->Scale > 4)) {
+        Debug("Paint_DrawGrayRow 2 or 4 levels on scale 2, 3 color or 4\r\n");
+        return;
+    }
+    for (L = 0; L < Levels; L++) {
+        if (Ctx->Scale == 4)
+            Color[L] = L * 3 / (Levels - 1);
+        else
+            Color[L] = (L * 2 >= Levels)? WHITE : BLACK;
+    }
+    Paint_DrawIndexRow(Ctx, Xstart, Ypoint, Level, Len, Color, Levels);
+}
+
+/******************************************************************************
+function:	Draw a display list
+parameter:
+    List : recorded with Paint_Record()
+Info:
+    Ctx is a picture of the size the list was recorded on, usually a band of
+    it, see Paint_SetBand(). Starts from the rotate, mirror and scale the
+    recording started with. Items outside the band are skipped.
+******************************************************************************/
+void Paint_Replay(PAINT *Ctx, const PAINT_LIST *List)
+{
+    PAINT_ITEM Item;
+    UDOUBLE Pos = 0;
+    const char *Text;
+
+    if (Ctx->List != NULL) {
+        Debug("Paint_Replay into a picture that is recording\r\n");
+        return;
+    }
+    if (List->Overflow)
+        Debug("Paint_Replay display list incomplete\r\n");
+
+    Ctx->Rotate = List->Rotate;
+    Ctx->Mirror = List->Mirror;
+    if (Ctx->Scale != List->Scale)
+        Paint_SetScale(Ctx, List->Scale);
+
+    while (Pos + sizeof(PAINT_ITEM) <= List->Used) {
+        memcpy(&Item, List->Data + Pos, sizeof(PAINT_ITEM));
+        Text = (const char *)List->Data + Pos + sizeof(PAINT_ITEM);
+        Pos += Item.Size;
+        if (Item.Yend < Ctx->YOffset || Item.Ystart >= (UDOUBLE)Ctx->YOffset + Ctx->HeightByte)
+            continue;
+
+        switch (Item.Op) {
+        case PAINT_OP_CLEAR:
+            Paint_Clear(Ctx, Item.Color);
+            break;
+        case PAINT_OP_CLEAR_WINDOWS:
+            Paint_ClearWindows(Ctx, Item.X0, Item.Y0, Item.X1, Item.Y1, Item.Color);
+            break;
+        case PAINT_OP_PIXEL:
+            Paint_SetPixel(Ctx, Item.X0, Item.Y0, Item.Color);
+            break;
+        case PAINT_OP_POINT:
+            Paint_DrawPoint(Ctx, Item.X0, Item.Y0, Item.Color, (DOT_PIXEL)Item.Dot, (DOT_STYLE)Item.Style);
+            break;
+        case PAINT_OP_LINE:
+            Paint_DrawLine(Ctx, Item.X0, Item.Y0, Item.X1, Item.Y1, Item.Color,
+                           (DOT_PIXEL)Item.Dot, (LINE_STYLE)Item.Style);
+            break;
+        case PAINT_OP_RECTANGLE:
+            Paint_DrawRectangle(Ctx, Item.X0, Item.Y0, Item.X1, Item.Y1, Item.Color,
+                                (DOT_PIXEL)Item.Dot, (DRAW_FILL)Item.Style);
+            break;
+        case PAINT_OP_CIRCLE:
+            Paint_DrawCircle(Ctx, Item.X0, Item.Y0, Item.X1, Item.Color,
+                             (DOT_PIXEL)Item.Dot, (DRAW_FILL)Item.Style);
+            break;
+        case PAINT_OP_CHAR:
+            Paint_DrawChar(Ctx, Item.X0, Item.Y0, (char)Item.X1, (sFONT *)Item.Ptr, Item.Color, Item.Color2);
+            break;
+        case PAINT_OP_STRING_EN:
+            Paint_DrawString_EN(Ctx, Item.X0, Item.Y0, Text, (sFONT *)Item.Ptr, Item.Color, Item.Color2);
+            break;
+        case PAINT_OP_STRING_CN:
+            Paint_DrawString_CN(Ctx, Item.X0, Item.Y0, Text, (cFONT *)Item.Ptr, Item.Color, Item.Color2);
+            break;
+        case PAINT_OP_STRING_GRAY:
+            Paint_DrawString_Gray(Ctx, Item.X0, Item.Y0, Text, (sFONT_GRAY *)Item.Ptr, Item.Color, Item.Color2);
+            break;
+        case PAINT_OP_BITMAP:
+            Paint_DrawBitMap(Ctx, (const unsigned char *)Item.Ptr);
+            break;
+        case PAINT_OP_IMAGE:
+            Paint_DrawImage(Ctx, (const unsigned char *)Item.Ptr, Item.X0, Item.Y0, Item.X1, Item.Y1);
+            break;
+        case PAINT_OP_ROTATE:
+            Paint_SetRotate(Ctx, Item.X0);
+            break;
+        case PAINT_OP_MIRROR:
+            Paint_SetMirroring(Ctx, Item.X0);
+            break;
+        case PAINT_OP_SCALE:
+            Paint_SetScale(Ctx, Item.X0);
+            break;
         }
     }
 }
+
+/******************************************************************************
+function:	Render one band of a recorded picture, for the panels that stream
+            their planes band by band
+parameter:
+    Pages  : PAINT *[], the picture recording each plane, e.g. {&Black, &Red}
+    Plane  : index into Pages
+    Ystart : first image memory row of the band
+    Rows   : rows in the band
+    Band   : Rows * WidthByte bytes
+Info:
+    The band starts white (0xFF), record a Paint_Clear() first for another
+    background. The pictures stay in recording mode while the bands are
+    rendered, their display lists are not changed.
+******************************************************************************/
+void Paint_RenderBand(void *Pages, UBYTE Plane, UWORD Ystart, UWORD Rows, UBYTE *Band)
+{
+    PAINT *Page = ((PAINT **)Pages)[Plane];
+    PAINT Ctx = *Page;
+
+    if (Page->List == NULL) {
+        Debug("Paint_RenderBand picture not recorded\r\n");
+        return;
+    }
+    if (Page->Gray != NULL) {
+        Debug("Paint_RenderBand planar gray is not banded\r\n");
+        return;
+    }
+    Ctx.List = NULL;
+    if (Ctx.Scale != Page->List->Scale)
+        Paint_SetScale(&Ctx, Page->List->Scale);
+    Paint_SetBand(&Ctx, Band, Ystart, Rows);
+    memset(Band, 0xFF, (UDOUBLE)Ctx.WidthByte * Ctx.HeightByte);
+    Paint_Replay(&Ctx, Page->List);
+}
+
+/******************************************************************************
+function:	The single picture API, drawing on the global Paint
+parameter:
+Info:
+    Kept for existing code, Paint_SelectImage() switches the image under
+    it. Code that draws more than one picture at a time passes its own
+    PAINT instead.
+******************************************************************************/
+void Paint_NewImage(UBYTE *image, UWORD Width, UWORD Height, UWORD Rotate, UWORD Color)
+{
+    Paint_NewImage(&Paint, image, Width, Height, Rotate, Color);
+}
+
+void Paint_SelectImage(UBYTE *image)
+{
+    Paint_SelectImage(&Paint, image);
+}
+
+void Paint_SetRotate(UWORD Rotate)
+{
+    Paint_SetRotate(&Paint, Rotate);
+}
+
+void Paint_SetMirroring(UBYTE mirror)
+{
+    Paint_SetMirroring(&Paint, mirror);
+}
+
+void Paint_SetPixel(UWORD Xpoint, UWORD Ypoint, UWORD Color)
+{
+    Paint_SetPixel(&Paint, Xpoint, Ypoint, Color);
+}
+
+void Paint_SetScale(UBYTE scale)
+{
+    Paint_SetScale(&Paint, scale);
+}
+
+void Paint_SetGrayPlanes(const UBYTE *Map)
+{
+    Paint_SetGrayPlanes(&Paint, Map);
+}
+
+void Paint_SetColorPlanes(const UBYTE *Map)
+{
+    Paint_SetColorPlanes(&Paint, Map);
+}
+
+void Paint_Clear(UWORD Color)
+{
+    Paint_Clear(&Paint, Color);
+}
+
+void Paint_ClearWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color)
+{
+    Paint_ClearWindows(&Paint, Xstart, Ystart, Xend, Yend, Color);
+}
+
+UBYTE Paint_GetDirty(PAINT_RECT *Rect, UBYTE Max, UWORD Align)
+{
+    return Paint_GetDirty(&Paint, Rect, Max, Align);
+}
+
+void Paint_ClearDirty(void)
+{
+    Paint_ClearDirty(&Paint);
+}
+
+void Paint_DrawPoint(UWORD Xpoint, UWORD Ypoint, UWORD Color, DOT_PIXEL Dot_Pixel, DOT_STYLE Dot_FillWay)
+{
+    Paint_DrawPoint(&Paint, Xpoint, Ypoint, Color, Dot_Pixel, Dot_FillWay);
+}
+
+void Paint_DrawLine(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color, DOT_PIXEL Line_width, LINE_STYLE Line_Style)
+{
+    Paint_DrawLine(&Paint, Xstart, Ystart, Xend, Yend, Color, Line_width, Line_Style);
+}
+
+void Paint_DrawRectangle(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill)
+{
+    Paint_DrawRectangle(&Paint, Xstart, Ystart, Xend, Yend, Color, Line_width, Draw_Fill);
+}
+
+void Paint_DrawCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius, UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill)
+{
+    Paint_DrawCircle(&Paint, X_Center, Y_Center, Radius, Color, Line_width, Draw_Fill);
+}
+
+void Paint_DrawChar(UWORD Xstart, UWORD Ystart, const char Acsii_Char, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    Paint_DrawChar(&Paint, Xstart, Ystart, Acsii_Char, Font, Color_Foreground, Color_Background);
+}
+
+void Paint_DrawString_EN(UWORD Xstart, UWORD Ystart, const char * pString, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    Paint_DrawString_EN(&Paint, Xstart, Ystart, pString, Font, Color_Foreground, Color_Background);
+}
+
+void Paint_DrawString_CN(UWORD Xstart, UWORD Ystart, const char * pString, cFONT* font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    Paint_DrawString_CN(&Paint, Xstart, Ystart, pString, font, Color_Foreground, Color_Background);
+}
+
+void Paint_DrawString_Gray(UWORD Xstart, UWORD Ystart, const char * pString, sFONT_GRAY* Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    Paint_DrawString_Gray(&Paint, Xstart, Ystart, pString, Font, Color_Foreground, Color_Background);
+}
+
+void Paint_DrawNum(UWORD Xpoint, UWORD Ypoint, int32_t Nummber, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    Paint_DrawNum(&Paint, Xpoint, Ypoint, Nummber, Font, Color_Foreground, Color_Background);
+}
+
+void Paint_DrawTime(UWORD Xstart, UWORD Ystart, PAINT_TIME *pTime, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    Paint_DrawTime(&Paint, Xstart, Ystart, pTime, Font, Color_Foreground, Color_Background);
+}
+
+void Paint_DrawBitMap(const unsigned char* image_buffer)
+{
+    Paint_DrawBitMap(&Paint, image_buffer);
+}
+
+void Paint_DrawImage(const unsigned char *image_buffer, UWORD xStart, UWORD yStart, UWORD W_Image, UWORD H_Image)
+{
+    Paint_DrawImage(&Paint, image_buffer, xStart, yStart, W_Image, H_Image);
+}
@@ -8,10 +8,41 @@
 *   Achieve display characters: Display a single character, string, number
 *   Achieve time display: adaptive size display time minutes and seconds
 *----------------
-* |	This version:   V3.2
-* | Date        :   2020-07-23
+* |	This version:   V3.3
+* | Date        :   2026-10-17
 * | Info        :
 * -----------------------------------------------------------------------------
+* V3.3(2026-10-17):
+* 1. Change: Paint_Clear(), Paint_ClearWindows()
+*			Fill whole bytes with memset instead of pixel by pixel
+* 2. Change: Paint_DrawRectangle(), Paint_DrawCircle() filled,
+*			horizontal / vertical solid Paint_DrawLine(), Paint_DrawPoint()
+*			Go through the same span fill, for all scales
+* 3. Fix: fills no longer write one pixel past the right / bottom edge
+* 4. Add: Paint_Pixel()
+*			Pixel writer specialized on rotate, mirror and scale, picked once
+*			per draw call by Paint_SetPixel(), points, lines and text
+* 5. Change: Paint_DrawChar()
+*			Blit glyphs row by row with masks at ROTATE_0 / ROTATE_180,
+*			used by Paint_DrawString_EN(), Paint_DrawNum(), Paint_DrawTime()
+*			and at ROTATE_90 / ROTATE_270 from the pre-rotated font tables
+* 6. Add: Paint_GetDirty(), Paint_ClearDirty()
+*			Drawing records the changed areas, for partial window uploads
+* 7. Add: the drawing functions with a PAINT *Ctx first
+*			Draw on any number of pictures, the old forms use the global Paint
+* 8. Add: Paint_Record(), Paint_Replay(), Paint_SetBand(), Paint_RenderBand()
+*			Record a picture as a display list and render it band by band
+* 9. Add: Paint_SetGrayPlanes()
+*			4 gray drawn straight into the two bit planes of the controller
+* 10. Add: Paint_DrawString_Gray()
+*			Anti-aliased text from the 2 bit coverage gray fonts
+* 11. Add: Paint_DrawGrayRow(), Paint_DrawIndexRow()
+*			A row of gray levels or palette colors, for images converted row
+*			by row, see GUI_Dither and GUI_Palette
+* 12. Add: Paint_SetColorPlanes(), COLOR_RED
+*			White, black and red drawn into both planes of a 3 color panel
+*			at once, in the polarity of the controller
+*
 * V3.2(2020-07-23):
 * 1. Change: Paint_SetScale(UBYTE scale)
 *			Add scale 7 for 5.65f e-Parper
@@ -83,7 +114,33 @@
 #include "fonts.h"
 
 /**
- * Image attributes
+ * Changed area of the image, image memory coordinates, end exclusive
+**/
+typedef struct {
+    UWORD Xstart;
+    UWORD Ystart;
+    UWORD Xend;
+    UWORD Yend;
+} PAINT_RECT;
+#define PAINT_DIRTY_MAX 4
+
+/**
+ * Display list, the primitives of a picture recorded by Paint_Record()
+**/
+typedef struct {
+    UBYTE *Data;
+    UDOUBLE Size;
+    UDOUBLE Used;
+    UBYTE Overflow;     //a primitive did not fit, the list is incomplete
+    UWORD Rotate;       //picture state when the recording started
+    UWORD Mirror;
+    UWORD Scale;
+} PAINT_LIST;
+
+/**
+ * Image attributes, one per picture. Every function below takes the
+ * picture it draws on, so pictures can be drawn at the same time, e.g. on
+ * both cores. The forms without it draw on the global Paint.
 **/
 typedef struct {
     UBYTE *Image;
@@ -97,9 +154,19 @@ typedef struct {
     UWORD WidthByte;
     UWORD HeightByte;
     UWORD Scale;
+    PAINT_RECT Dirty[PAINT_DIRTY_MAX];  //changed since Paint_ClearDirty()
+    UBYTE DirtyCount;
+    UWORD YOffset;      //first image memory row in Image, see Paint_SetBand()
+    PAINT_LIST *List;   //recording instead of drawing, see Paint_Record()
+    const UBYTE *Gray;  //plane bits of each color, see Paint_SetGrayPlanes() / Paint_SetColorPlanes(), NULL: packed
 } PAINT;
 extern PAINT Paint;
 
+/**
+ * Pixel writer specialized for one rotate / mirror / scale, see Paint_Pixel()
+**/
+typedef void (*PAINT_PIXEL)(PAINT *Ctx, UWORD Xpoint, UWORD Ypoint, UWORD Color);
+
 /**
  * Display rotate
 **/
@@ -125,6 +192,7 @@ typedef enum {
 #define WHITE          0xFF
 #define BLACK          0x00
 #define RED            BLACK
+#define COLOR_RED      0x01     //red of a 3 color picture, see Paint_SetColorPlanes()
 
 #define IMAGE_BACKGROUND    WHITE
 #define FONT_FOREGROUND     BLACK
@@ -189,32 +257,75 @@ typedef struct {
 extern PAINT_TIME sPaint_time;
 
 //init and Clear
+void Paint_NewImage(PAINT *Ctx, UBYTE *image, UWORD Width, UWORD Height, UWORD Rotate, UWORD Color);
+void Paint_SelectImage(PAINT *Ctx, UBYTE *image);
+void Paint_SetRotate(PAINT *Ctx, UWORD Rotate);
+void Paint_SetMirroring(PAINT *Ctx, UBYTE mirror);
+void Paint_SetPixel(PAINT *Ctx, UWORD Xpoint, UWORD Ypoint, UWORD Color);
+PAINT_PIXEL Paint_Pixel(PAINT *Ctx);
+void Paint_SetScale(PAINT *Ctx, UBYTE scale);
+void Paint_SetGrayPlanes(PAINT *Ctx, const UBYTE *Map);
+void Paint_SetColorPlanes(PAINT *Ctx, const UBYTE *Map);
+
+void Paint_Clear(PAINT *Ctx, UWORD Color);
+void Paint_ClearWindows(PAINT *Ctx, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color);
+
+//Changed areas
+UBYTE Paint_GetDirty(PAINT *Ctx, PAINT_RECT *Rect, UBYTE Max, UWORD Align);
+void Paint_ClearDirty(PAINT *Ctx);
+
+//Display list and bands
+void Paint_Record(PAINT *Ctx, PAINT_LIST *List, UBYTE *Data, UDOUBLE Size);
+void Paint_SetBand(PAINT *Ctx, UBYTE *image, UWORD Ystart, UWORD Rows);
+void Paint_Replay(PAINT *Ctx, const PAINT_LIST *List);
+void Paint_RenderBand(void *Pages, UBYTE Plane, UWORD Ystart, UWORD Rows, UBYTE *Band);
+
+//Drawing
+void Paint_DrawPoint(PAINT *Ctx, UWORD Xpoint, UWORD Ypoint, UWORD Color, DOT_PIXEL Dot_Pixel, DOT_STYLE Dot_FillWay);
+void Paint_DrawLine(PAINT *Ctx, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color, DOT_PIXEL Line_width, LINE_STYLE Line_Style);
+void Paint_DrawRectangle(PAINT *Ctx, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill);
+void Paint_DrawCircle(PAINT *Ctx, UWORD X_Center, UWORD Y_Center, UWORD Radius, UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill);
+
+//Display string
+void Paint_DrawChar(PAINT *Ctx, UWORD Xstart, UWORD Ystart, const char Acsii_Char, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
+void Paint_DrawString_EN(PAINT *Ctx, UWORD Xstart, UWORD Ystart, const char * pString, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
+void Paint_DrawString_CN(PAINT *Ctx, UWORD Xstart, UWORD Ystart, const char * pString, cFONT* font, UWORD Color_Foreground, UWORD Color_Background);
+void Paint_DrawString_Gray(PAINT *Ctx, UWORD Xstart, UWORD Ystart, const char * pString, sFONT_GRAY* Font, UWORD Color_Foreground, UWORD Color_Background);
+void Paint_DrawNum(PAINT *Ctx, UWORD Xpoint, UWORD Ypoint, int32_t Nummber, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
+void Paint_DrawTime(PAINT *Ctx, UWORD Xstart, UWORD Ystart, PAINT_TIME *pTime, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
+
+//pic
+void Paint_DrawBitMap(PAINT *Ctx, const unsigned char* image_buffer);
+void Paint_DrawImage(PAINT *Ctx, const unsigned char *image_buffer, UWORD xStart, UWORD yStart, UWORD W_Image, UWORD H_Image);
+void Paint_DrawGrayRow(PAINT *Ctx, UWORD Xstart, UWORD Ypoint, const UBYTE *Level, UWORD Len, UBYTE Levels);
+void Paint_DrawIndexRow(PAINT *Ctx, UWORD Xstart, UWORD Ypoint, const UBYTE *Index, UWORD Len,
+                        const UWORD *Color, UBYTE Colors);
+
+//The same on the global Paint, the image picked by Paint_SelectImage()
 void Paint_NewImage(UBYTE *image, UWORD Width, UWORD Height, UWORD Rotate, UWORD Color);
 void Paint_SelectImage(UBYTE *image);
 void Paint_SetRotate(UWORD Rotate);
 void Paint_SetMirroring(UBYTE mirror);
 void Paint_SetPixel(UWORD Xpoint, UWORD Ypoint, UWORD Color);
 void Paint_SetScale(UBYTE scale);
-
+void Paint_SetGrayPlanes(const UBYTE *Map);
+void Paint_SetColorPlanes(const UBYTE *Map);
 void Paint_Clear(UWORD Color);
 void Paint_ClearWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color);
-
-//Drawing
+UBYTE Paint_GetDirty(PAINT_RECT *Rect, UBYTE Max, UWORD Align);
+void Paint_ClearDirty(void);
 void Paint_DrawPoint(UWORD Xpoint, UWORD Ypoint, UWORD Color, DOT_PIXEL Dot_Pixel, DOT_STYLE Dot_FillWay);
 void Paint_DrawLine(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color, DOT_PIXEL Line_width, LINE_STYLE Line_Style);
 void Paint_DrawRectangle(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill);
 void Paint_DrawCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius, UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill);
-
-//Display string
 void Paint_DrawChar(UWORD Xstart, UWORD Ystart, const char Acsii_Char, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
 void Paint_DrawString_EN(UWORD Xstart, UWORD Ystart, const char * pString, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
 void Paint_DrawString_CN(UWORD Xstart, UWORD Ystart, const char * pString, cFONT* font, UWORD Color_Foreground, UWORD Color_Background);
+void Paint_DrawString_Gray(UWORD Xstart, UWORD Ystart, const char * pString, sFONT_GRAY* Font, UWORD Color_Foreground, UWORD Color_Background);
 void Paint_DrawNum(UWORD Xpoint, UWORD Ypoint, int32_t Nummber, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
 void Paint_DrawTime(UWORD Xstart, UWORD Ystart, PAINT_TIME *pTime, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
-
-//pic
 void Paint_DrawBitMap(const unsigned char* image_buffer);
-void Paint_DrawImage(const unsigned char *image_buffer, UWORD xStart, UWORD yStart, UWORD W_Image, UWORD H_Image); 
+void Paint_DrawImage(const unsigned char *image_buffer, UWORD xStart, UWORD yStart, UWORD W_Image, UWORD H_Image);
 
 #endif
 
@@ -0,0 +1,233 @@
+/*****************************************************************************
+* | File      	:	GUI_Palette.cpp
+* | Function    :   Quantize RGB or gray images to the palette of a color panel
+* | Info        :
+*----------------
+* |	This version:   V1.0
+* | Date        :   2026-10-17
+* | Info        :
+******************************************************************************/
+#include "GUI_Palette.h"
+#include "utility/Debug.h"
+#include <string.h>
+
+//the colors as the Waveshare image converter uses them
+static const UBYTE Palette_7Color_Rgb[7][3] = {
+    {  0,   0,   0},    //BLACK
+    {255, 255, 255},    //WHITE
+    {  0, 255,   0},    //GREEN
+    {  0,   0, 255},    //BLUE
+    {255,   0,   0},    //RED
+    {255, 255,   0},    //YELLOW
+    {255, 128,   0},    //ORANGE
+};
+static const UBYTE Palette_7Color_Code[7] = {0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6};
+
+static const UBYTE Palette_4Color_Rgb[4][3] = {
+    {  0,   0,   0},    //BLACK
+    {255, 255, 255},    //WHITE
+    {255, 255,   0},    //YELLOW
+    {255,   0,   0},    //RED
+};
+static const UBYTE Palette_4Color_Code[4] = {0x0, 0x1, 0x2, 0x3};
+
+const PALETTE Palette_7Color = {7, 4, Palette_7Color_Rgb, Palette_7Color_Code};
+const PALETTE Palette_4Color = {4, 2, Palette_4Color_Rgb, Palette_4Color_Code};
+
+//Nearest palette color, green weighs most as the eye sees it
+static UBYTE Palette_Nearest(const PALETTE *Palette, int R, int G, int B)
+{
+    UDOUBLE Best_Dist = 0xFFFFFFFF;
+    UBYTE Best = 0;
+    for(UBYTE i = 0; i < Palette->Colors; i++) {
+        int dr = R - Palette->Rgb[i][0], dg = G - Palette->Rgb[i][1], db = B - Palette->Rgb[i][2];
+        UDOUBLE Dist = 2 * dr * dr + 4 * dg * dg + 3 * db * db;
+        if(Dist < Best_Dist) {
+            Best_Dist = Dist;
+            Best = i;
+        }
+    }
+    return Best;
+}
+
+/******************************************************************************
+function :	Nearest palette color of every 4 bit R, G, B
+parameter:
+    Cube : PALETTE_CUBE bytes, index R << 8 | G << 4 | B
+Info:
+    Built once per palette, a pixel is then one lookup.
+******************************************************************************/
+void Palette_BuildCube(const PALETTE *Palette, UBYTE *Cube)
+{
+    for(UWORD i = 0; i < PALETTE_CUBE; i++)
+        Cube[i] = Palette_Nearest(Palette, (i >> 8) * 17, ((i >> 4) & 0x0F) * 17, (i & 0x0F) * 17);
+}
+
+/******************************************************************************
+function :	Set up quantizing an image
+parameter:
+    Palette : palette of the panel
+    Width   : pixels per row
+    Cube    : from Palette_BuildCube() for this palette
+    Error   : (Width + 2) * 3 entries to diffuse the error, NULL: nearest color
+******************************************************************************/
+void Quant_Init(QUANT *Quant, const PALETTE *Palette, UWORD Width, const UBYTE *Cube, int16_t *Error)
+{
+    memset(Quant, 0, sizeof(QUANT));
+    Quant->Palette = Palette;
+    Quant->Width = Width;
+    Quant->Cube = Cube;
+    Quant->Error = Error;
+    Quant_Reset(Quant);
+}
+
+/******************************************************************************
+function :	Start again from the top row
+parameter:
+******************************************************************************/
+void Quant_Reset(QUANT *Quant)
+{
+    Quant->Y = 0;
+    if(Quant->Error != NULL)
+        memset(Quant->Error, 0, (Quant->Width + 2) * 3 * sizeof(int16_t));
+}
+
+/******************************************************************************
+function :	Quantize the next row
+parameter:
+    Row  : Width pixels in, Step bytes each, R G B or gray
+    Step : 3 or 1
+Info:
+    The palette index of pixel x goes to Row[Step * x], the first byte of
+    the pixel, so a row read right to left is not overwritten before it is
+    read. Error diffusion as Dither_Row(), per channel, fixed point with 16
+    steps per value, each channel kept in 0..255 so the error stays small.
+******************************************************************************/
+static void Quant_Map(QUANT *Quant, UBYTE *Row, UBYTE Step)
+{
+    const UBYTE (*Rgb)[3] = Quant->Palette->Rgb;
+    UWORD Width = Quant->Width, i;
+    int x, c, v[3], e, Dir, Carry[3], Below[3];
+    int16_t *Error;
+    UBYTE Index;
+
+    if(Quant->Error == NULL) {
+        for(i = 0; i < Width; i++) {
+            const UBYTE *p = Row + i * Step;
+            const UBYTE *q = p + (Step == 3);   //G and B, the gray again for Step 1
+            Row[i * Step] = Quant->Cube[(p[0] >> 4) << 8 | (q[0] >> 4) << 4 | (q[Step == 3] >> 4)];
+        }
+        Quant->Y++;
+        return;
+    }
+
+    Error = Quant->Error + 3;     //a pixel of room on either side
+    Dir = (Quant->Y & 1)? -1 : 1;
+    x = (Dir > 0)? 0 : Width - 1;
+    memset(Carry, 0, sizeof(Carry));
+    memset(Below, 0, sizeof(Below));
+    for(i = 0; i < Width; i++, x += Dir) {
+        for(c = 0; c < 3; c++) {
+            v[c] = Row[x * Step + (Step == 3? c : 0)] * 16 + Error[x * 3 + c] + Carry[c];
+            if(v[c] < 0)
+                v[c] = 0;
+            else if(v[c] > 255 * 16)
+                v[c] = 255 * 16;
+        }
+        Index = Quant->Cube[(v[0] >> 8) << 8 | (v[1] >> 8) << 4 | (v[2] >> 8)];
+        for(c = 0; c < 3; c++) {
+            e = v[c] - Rgb[Index][c] * 16;
+            Carry[c] = e * 7 / 16;
+            Error[(x - Dir) * 3 + c] += e * 3 / 16;
+            Error[x * 3 + c] = Below[c] + e * 5 / 16;
+            Below[c] = e / 16;
+        }
+        Row[x * Step] = Index;
+    }
+    Quant->Y++;
+}
+
+/******************************************************************************
+function :	Quantize the next row of an RGB image
+parameter:
+    Row : Width * 3 bytes R G B in, Width palette indices out at the start
+******************************************************************************/
+void Quant_Row(QUANT *Quant, UBYTE *Row)
+{
+    Quant_Map(Quant, Row, 3);
+    for(UWORD x = 1; x < Quant->Width; x++)
+        Row[x] = Row[x * 3];
+}
+
+/******************************************************************************
+function :	Quantize the next row of a gray image
+parameter:
+    Row : Width gray values in, Width palette indices out
+******************************************************************************/
+void Quant_RowGray(QUANT *Quant, UBYTE *Row)
+{
+    Quant_Map(Quant, Row, 1);
+}
+
+/******************************************************************************
+function :	Native pixels of a row, as the driver image holds them
+parameter:
+    Index : Width palette indices
+    Out   : (Width * Bits + 7) / 8 bytes, first pixel in the top bits
+******************************************************************************/
+void Quant_Pack(const QUANT *Quant, const UBYTE *Index, UBYTE *Out)
+{
+    const PALETTE *Palette = Quant->Palette;
+    UBYTE Bits = Palette->Bits, PPB = 8 / Bits, Byte = 0;
+    UWORD x;
+
+    for(x = 0; x < Quant->Width; x++) {
+        Byte = (Byte << Bits) | Palette->Code[Index[x] % Palette->Colors];
+        if(x % PPB == PPB - 1)
+            *Out++ = Byte;
+    }
+    if(x % PPB != 0)
+        *Out = Byte << (Bits * (PPB - x % PPB));
+}
+
+/******************************************************************************
+function :	Where the rows of the image come from
+parameter:
+    Source : reads a row of R, G, B
+    arg    : passed to Source
+    Row    : Width * 3 bytes
+******************************************************************************/
+void Quant_SetSource(QUANT *Quant, QUANT_SOURCE Source, void *arg, UBYTE *Row)
+{
+    Quant->Source = Source;
+    Quant->arg = arg;
+    Quant->Row = Row;
+}
+
+/******************************************************************************
+function :	Draw the image into a picture
+parameter:
+    Xstart, Ystart : top left in the picture
+    Height         : rows of the image
+Info:
+    Paint_SetScale(7) for the 7 color panels, (4) for the 4 color ones.
+    Row by row through Paint_DrawIndexRow(), one row of the image in RAM.
+******************************************************************************/
+void Quant_Paint(QUANT *Quant, PAINT *Ctx, UWORD Xstart, UWORD Ystart, UWORD Height)
+{
+    const PALETTE *Palette = Quant->Palette;
+    UWORD Color[16];
+
+    if(Quant->Source == NULL || Quant->Row == NULL) {
+        Debug("Quant no source\r\n");
+        return;
+    }
+    for(UBYTE i = 0; i < Palette->Colors; i++)
+        Color[i] = Palette->Code[i];
+    Quant_Reset(Quant);
+    for(UWORD y = 0; y < Height; y++) {
+        Quant->Source(Quant->arg, y, Quant->Row);
+        Quant_Row(Quant, Quant->Row);
+        Paint_DrawIndexRow(Ctx, Xstart, Ystart + y, Quant->Row, Quant->Width, Color, Palette->Colors);
+    }
+}
@@ -0,0 +1,68 @@
+/*****************************************************************************
+* | File      	:	GUI_Palette.h
+* | Function    :   Quantize RGB or gray images to the palette of a color panel
+* | Info        :
+*   The 7 color panels (EPD_7IN3F, EPD_5IN65F, EPD_4IN01F) take 4 bits per
+*   pixel, the 4 color ones (EPD_7IN3G, EPD_4IN37G, EPD_2IN13G, ...) 2 bits.
+*   Rows are read one at a time, looked up in a cube of the nearest palette
+*   color and, with an error row, diffused:
+*       static UBYTE Cube[PALETTE_CUBE];
+*       static int16_t Error[(EPD_7IN3F_WIDTH + 2) * 3];
+*       static UBYTE Row[EPD_7IN3F_WIDTH * 3];
+*       QUANT Quant;
+*       Palette_BuildCube(&Palette_7Color, Cube);
+*       Quant_Init(&Quant, &Palette_7Color, EPD_7IN3F_WIDTH, Cube, Error);
+*       Quant_SetSource(&Quant, Cover_Row, File, Row);
+*       Quant_Paint(&Quant, &Page, 0, 0, EPD_7IN3F_HEIGHT);   //Paint_SetScale(7)
+*   or Quant_Row() and Quant_Pack() for native rows of the driver image.
+*----------------
+* |	This version:   V1.0
+* | Date        :   2026-10-17
+* | Info        :
+******************************************************************************/
+#ifndef __GUI_PALETTE_H
+#define __GUI_PALETTE_H
+
+#include "DEV_Config.h"
+#include "GUI_Paint.h"
+
+#define PALETTE_CUBE 4096   //bytes of the nearest color cube, 16 steps per channel
+
+typedef struct {
+    UBYTE Colors;               //up to 16
+    UBYTE Bits;                 //per native pixel, 4 or 2
+    const UBYTE (*Rgb)[3];      //the color each one shows on the panel
+    const UBYTE *Code;          //native pixel of each color
+} PALETTE;
+
+extern const PALETTE Palette_7Color;    //f panels
+extern const PALETTE Palette_4Color;    //g panels, black white yellow red
+
+/**
+ * Reads row Y of the image, Width pixels of R, G, B
+**/
+typedef void (*QUANT_SOURCE)(void *arg, UWORD Y, UBYTE *Row);
+
+typedef struct {
+    const PALETTE *Palette;
+    UWORD Width;
+    const UBYTE *Cube;      //from Palette_BuildCube()
+    int16_t *Error;         //(Width + 2) * 3 entries, NULL: nearest color only
+    UWORD Y;                //row quantized next
+    QUANT_SOURCE Source;    //see Quant_SetSource()
+    void *arg;
+    UBYTE *Row;             //Width * 3 bytes
+} QUANT;
+
+void Palette_BuildCube(const PALETTE *Palette, UBYTE *Cube);
+
+void Quant_Init(QUANT *Quant, const PALETTE *Palette, UWORD Width, const UBYTE *Cube, int16_t *Error);
+void Quant_Reset(QUANT *Quant);
+void Quant_Row(QUANT *Quant, UBYTE *Row);
+void Quant_RowGray(QUANT *Quant, UBYTE *Row);
+void Quant_Pack(const QUANT *Quant, const UBYTE *Index, UBYTE *Out);
+
+void Quant_SetSource(QUANT *Quant, QUANT_SOURCE Source, void *arg, UBYTE *Row);
+void Quant_Paint(QUANT *Quant, PAINT *Ctx, UWORD Xstart, UWORD Ystart, UWORD Height);
+
+#endif
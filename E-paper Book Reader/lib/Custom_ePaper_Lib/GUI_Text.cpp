@@ -0,0 +1,284 @@
+/*****************************************************************************
+* | File      	:	GUI_Text.cpp
+* | Function    :   Text pages rendered row by row, without a frame buffer
+* | Info        :
+*----------------
+* |	This version:   V1.0
+* | Date        :   2026-10-17
+* | Info        :
+******************************************************************************/
+#include "GUI_Text.h"
+#include "utility/Debug.h"
+#include <string.h>
+
+/******************************************************************************
+function :	Set up an empty page
+parameter:
+    Width  : page width in pixels, the panel width
+    Height : page height in pixels
+    Run    : storage for the runs
+    Max    : number of runs Run holds
+******************************************************************************/
+void TextPage_Init(TEXT_PAGE *Page, UWORD Width, UWORD Height, TEXT_RUN *Run, UWORD Max)
+{
+    Page->Width = Width;
+    Page->Height = Height;
+    Page->Run = Run;
+    Page->Max = Max;
+    TextPage_Clear(Page, WHITE);
+}
+
+/******************************************************************************
+function :	Drop all runs, e.g. before laying out the next page
+parameter:
+    Background : WHITE or BLACK
+******************************************************************************/
+void TextPage_Clear(TEXT_PAGE *Page, UWORD Background)
+{
+    Page->Background = Background;
+    Page->Count = 0;
+}
+
+//Keeps the runs sorted by Ystart, a page is laid out top down so this is an append
+static UBYTE TextPage_Insert(TEXT_PAGE *Page, const TEXT_RUN *Run)
+{
+    UWORD i;
+    if(Page->Count >= Page->Max) {
+        Debug("TextPage runs full\r\n");
+        return 1;
+    }
+    for(i = Page->Count; i > 0 && Page->Run[i - 1].Ystart > Run->Ystart; i--)
+        Page->Run[i] = Page->Run[i - 1];
+    Page->Run[i] = *Run;
+    Page->Count++;
+    return 0;
+}
+
+/******************************************************************************
+function :	Add a line of English text
+parameter:
+    Xstart           : x of the first character
+    Ystart           : y of the top row
+    Text             : characters ' ' to '~', not copied
+    Len              : number of characters
+    Font             : font
+    Color_Foreground : BLACK or WHITE
+    Color_Background : BLACK, WHITE or FONT_BACKGROUND
+Info:
+    Characters past the right edge are cut, nothing wraps. The set bits of
+    the glyphs take Color_Foreground, Paint_DrawString_EN() swaps the two:
+    a run matches Paint_DrawString_EN(..., Color_Background, Color_Foreground)
+    at ROTATE_0 for a line that fits. Returns 1 when the page has no room
+    for another run.
+******************************************************************************/
+UBYTE TextPage_AddRun(TEXT_PAGE *Page, UWORD Xstart, UWORD Ystart, const char *Text, UWORD Len,
+                      sFONT *Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    TEXT_RUN Run = {Xstart, Ystart, Text, Len, Font, NULL, Color_Foreground, Color_Background};
+    return TextPage_Insert(Page, &Run);
+}
+
+/******************************************************************************
+function :	Add a line of GB2312 and ASCII text
+parameter:
+    as TextPage_AddRun()
+Info:
+    Same pixels as Paint_DrawString_CN() at ROTATE_0. The glyphs are looked
+    up in the font for every row, like Paint_DrawString_CN() does per
+    character, keep CN runs short.
+******************************************************************************/
+UBYTE TextPage_AddRun_CN(TEXT_PAGE *Page, UWORD Xstart, UWORD Ystart, const char *Text, UWORD Len,
+                         cFONT *Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    TEXT_RUN Run = {Xstart, Ystart, Text, Len, NULL, Font, Color_Foreground, Color_Background};
+    return TextPage_Insert(Page, &Run);
+}
+
+/******************************************************************************
+function :	Lay out text as lines of runs, word wrapped
+parameter:
+    Xstart, Ystart : top left of the text area
+    Width, Height  : size of the text area
+    Text           : the text, '\n' ends a line, not copied
+    Font           : font
+    Color_Foreground, Color_Background : as TextPage_AddRun()
+Info:
+    Lines break after the last space that fits, a word longer than a line
+    is cut. Returns the number of bytes of Text laid out: the start of the
+    next page, or where the runs ran out.
+******************************************************************************/
+UDOUBLE TextPage_Layout(TEXT_PAGE *Page, UWORD Xstart, UWORD Ystart, UWORD Width, UWORD Height,
+                        const char *Text, sFONT *Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    UWORD Cols = Width / Font->Width, Len, Break, Draw;
+    UDOUBLE Pos = 0;
+    UDOUBLE Y = Ystart;
+
+    if(Cols == 0)
+        return 0;
+    while(Text[Pos] != '\0' && Y + Font->Height <= (UDOUBLE)Ystart + Height) {
+        //longest line that fits, remembering the last space in it
+        Len = 0;
+        Break = 0;
+        while(Len < Cols && Text[Pos + Len] != '\0' && Text[Pos + Len] != '\n') {
+            if(Text[Pos + Len] == ' ')
+                Break = Len;
+            Len++;
+        }
+        if(Len == Cols && Text[Pos + Len] != '\0' && Text[Pos + Len] != '\n'
+           && Text[Pos + Len] != ' ' && Break > 0)
+            Len = Break;    //do not cut the last word
+
+        Draw = Len;
+        while(Draw > 0 && Text[Pos + Draw - 1] == ' ')
+            Draw--;
+        if(Draw > 0 && TextPage_AddRun(Page, Xstart, Y, Text + Pos, Draw, Font,
+                                       Color_Foreground, Color_Background))
+            return Pos;
+
+        Pos += Len;
+        if(Text[Pos] == '\n')
+            Pos++;
+        else
+            while(Text[Pos] == ' ')
+                Pos++;
+        Y += Font->Height;
+    }
+    return Pos;
+}
+
+/******************************************************************************
+function :	Merge one glyph row into a panel row
+parameter:
+    Row    : panel row, 1 bit per pixel
+    X      : x of the leftmost pixel of the cell
+    Bits   : glyph row, first pixel in the top bit
+    Cols   : pixels in the cell
+    Fore   : 0x00 or 0xFF
+    Back   : 0x00 or 0xFF
+    Opaque : write the clear bits of the cell too
+******************************************************************************/
+static void TextPage_Put(UBYTE *Row, UWORD X, uint32_t Bits, UWORD Cols, UBYTE Fore, UBYTE Back, UBYTE Opaque)
+{
+    UWORD Shift = X % 8, Bytes = (Shift + Cols + 7) / 8;
+    uint64_t Area = ((uint64_t)(0xFFFFFFFF << (32 - Cols)) << 32) >> Shift;
+    uint64_t Glyph = ((uint64_t)(Bits & (0xFFFFFFFF << (32 - Cols))) << 32) >> Shift;
+    UBYTE *p = Row + X / 8;
+
+    for(UWORD k = 0; k < Bytes; k++) {
+        UBYTE a = Area >> (56 - 8 * k);
+        UBYTE m = Glyph >> (56 - 8 * k);
+        if(!Opaque)
+            a = m;
+        p[k] = (p[k] & ~a) | (Fore & m) | (Back & a & ~m);
+    }
+}
+
+//Up to 4 bytes of a glyph row, first pixel in the top bit
+static uint32_t TextPage_Bits(const UBYTE *ptr, UWORD Bytes)
+{
+    uint32_t Bits = 0;
+    for(UWORD k = 0; k < 4; k++) {
+        Bits <<= 8;
+        if(k < Bytes)
+            Bits |= ptr[k];
+    }
+    return Bits;
+}
+
+static void TextPage_RowEN(const TEXT_PAGE *Page, const TEXT_RUN *Run, UWORD Page_Row, UBYTE *Row)
+{
+    sFONT *Font = Run->Font;
+    UWORD Line = Font->Width / 8 + (Font->Width % 8 ? 1 : 0);
+    UBYTE Fore = (Run->Color_Foreground == BLACK)? 0x00 : 0xFF;
+    UBYTE Back = (Run->Color_Background == BLACK)? 0x00 : 0xFF;
+    UBYTE Opaque = (FONT_BACKGROUND != Run->Color_Background);
+    UDOUBLE X = Run->Xstart;
+
+    for(UWORD i = 0; i < Run->Len && X < Page->Width; i++, X += Font->Width) {
+        UBYTE c = Run->Text[i];
+        if(c < ' ' || c > '~')
+            continue;
+        const UBYTE *ptr = Font->table + ((uint32_t)(c - ' ') * Font->Height + Page_Row) * Line;
+        UWORD Cols = (X + Font->Width > Page->Width)? Page->Width - X : Font->Width;
+        TextPage_Put(Row, X, TextPage_Bits(ptr, Line), Cols, Fore, Back, Opaque);
+    }
+}
+
+static void TextPage_RowCN(const TEXT_PAGE *Page, const TEXT_RUN *Run, UWORD Page_Row, UBYTE *Row)
+{
+    cFONT *Font = Run->FontCN;
+    UWORD Line = Font->Width / 8 + (Font->Width % 8 ? 1 : 0);
+    UBYTE Fore = (Run->Color_Foreground == BLACK)? 0x00 : 0xFF;
+    UBYTE Back = (Run->Color_Background == BLACK)? 0x00 : 0xFF;
+    UBYTE Opaque = (FONT_BACKGROUND != Run->Color_Background);
+    const char *p = Run->Text, *End = Run->Text + Run->Len;
+    UDOUBLE X = Run->Xstart;
+    UWORD Num, Step;
+
+    while(p < End && *p != 0 && X < Page->Width) {
+        UBYTE Ascii = ((UBYTE)*p <= 0x7F);
+        for(Num = 0; Num < Font->size; Num++) {
+            const CH_CN *Glyph = &Font->table[Num];
+            const UBYTE *Index = (const UBYTE *)Glyph->index;
+            if(Index[0] == (UBYTE)p[0]
+               && (Ascii || (p + 2 < End && Index[1] == (UBYTE)p[1] && Index[2] == (UBYTE)p[2]))) {
+                UWORD Cols = (X + Font->Width > Page->Width)? Page->Width - X : Font->Width;
+                TextPage_Put(Row, X, TextPage_Bits((const UBYTE *)Glyph->matrix + Page_Row * Line, Line),
+                             Cols, Fore, Back, Opaque);
+                break;
+            }
+        }
+        Step = Ascii? 1 : 3;
+        X += Ascii? Font->ASCII_Width : Font->Width;
+        p += Step;
+    }
+}
+
+/******************************************************************************
+function :	Generate one panel row of the page
+parameter:
+    Ypoint : row
+    Row    : receives (Width + 7) / 8 bytes
+Info:
+    The background, then every run crossing the row, top run first, runs
+    starting on the same row in the order added.
+******************************************************************************/
+void TextPage_RenderRow(const TEXT_PAGE *Page, UWORD Ypoint, UBYTE *Row)
+{
+    memset(Row, (Page->Background == BLACK)? 0x00 : 0xFF, (Page->Width + 7) / 8);
+    for(UWORD i = 0; i < Page->Count; i++) {
+        const TEXT_RUN *Run = &Page->Run[i];
+        UWORD Height;
+        if(Run->Ystart > Ypoint)
+            break;      //sorted, no later run starts above the row
+        Height = (Run->Font != NULL)? Run->Font->Height : Run->FontCN->Height;
+        if(Ypoint - Run->Ystart >= Height)
+            continue;
+        if(Run->Font != NULL)
+            TextPage_RowEN(Page, Run, Ypoint - Run->Ystart, Row);
+        else
+            TextPage_RowCN(Page, Run, Ypoint - Run->Ystart, Row);
+    }
+}
+
+/******************************************************************************
+function :	Render rows of a page, for the panels that stream their planes
+            band by band
+parameter:
+    Pages  : TEXT_PAGE *[], one per plane, an empty page for a blank plane
+    Plane  : index into Pages
+    Ystart : first row
+    Rows   : rows in the band
+    Band   : Rows * (Width + 7) / 8 bytes
+Info:
+    Fits EPD_Panel_Display_Bands() and the other EPD_BAND_RENDER users.
+******************************************************************************/
+void TextPage_RenderBand(void *Pages, UBYTE Plane, UWORD Ystart, UWORD Rows, UBYTE *Band)
+{
+    const TEXT_PAGE *Page = ((TEXT_PAGE **)Pages)[Plane];
+    UWORD Line = (Page->Width + 7) / 8;
+
+    for(UWORD y = 0; y < Rows; y++)
+        TextPage_RenderRow(Page, Ystart + y, Band + (UDOUBLE)y * Line);
+}
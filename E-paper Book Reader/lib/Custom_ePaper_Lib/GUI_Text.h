@@ -0,0 +1,64 @@
+/*****************************************************************************
+* | File      	:	GUI_Text.h
+* | Function    :   Text pages rendered row by row, without a frame buffer
+* | Info        :
+*   A page of a book is a list of positioned glyph runs. The runs point into
+*   the text, nothing is rasterized ahead: each panel row is generated from
+*   the runs and the font tables when the driver sends it, so a page needs
+*   the run list and a few rows instead of a whole plane:
+*       static TEXT_RUN Runs[40];
+*       static UBYTE Band[EPD_5IN83B_V2_WIDTH / 8 * 8];
+*       TEXT_PAGE Page, Red;
+*       TEXT_PAGE *Pages[2] = {&Page, &Red};
+*       TextPage_Init(&Page, EPD_5IN83B_V2_WIDTH, EPD_5IN83B_V2_HEIGHT, Runs, 40);
+*       TextPage_Init(&Red, EPD_5IN83B_V2_WIDTH, EPD_5IN83B_V2_HEIGHT, NULL, 0);
+*       Next = TextPage_Layout(&Page, 10, 10, 628, 460, Book + Start, &Font16, BLACK, WHITE);
+*       EPD_Panel_Display_Bands(&EPD_5IN83B_V2_Panel, Band, sizeof(Band), TextPage_RenderBand, Pages);
+*   Coordinates are image memory coordinates, the page is not rotated.
+*----------------
+* |	This version:   V1.0
+* | Date        :   2026-10-17
+* | Info        :
+******************************************************************************/
+#ifndef __GUI_TEXT_H
+#define __GUI_TEXT_H
+
+#include "DEV_Config.h"
+#include "GUI_Paint.h"
+#include "fonts.h"
+
+/**
+ * One line of text in one font, English (Font) or GB2312 (FontCN)
+**/
+typedef struct {
+    UWORD Xstart;
+    UWORD Ystart;
+    const char *Text;           //not copied, valid while the page is shown
+    UWORD Len;                  //bytes of Text
+    sFONT *Font;
+    cFONT *FontCN;
+    UWORD Color_Foreground;
+    UWORD Color_Background;     //FONT_BACKGROUND: transparent
+} TEXT_RUN;
+
+typedef struct {
+    UWORD Width;
+    UWORD Height;
+    UWORD Background;           //WHITE or BLACK, the color of every row before the runs
+    TEXT_RUN *Run;              //sorted by Ystart
+    UWORD Max;
+    UWORD Count;
+} TEXT_PAGE;
+
+void TextPage_Init(TEXT_PAGE *Page, UWORD Width, UWORD Height, TEXT_RUN *Run, UWORD Max);
+void TextPage_Clear(TEXT_PAGE *Page, UWORD Background);
+UBYTE TextPage_AddRun(TEXT_PAGE *Page, UWORD Xstart, UWORD Ystart, const char *Text, UWORD Len,
+                      sFONT *Font, UWORD Color_Foreground, UWORD Color_Background);
+UBYTE TextPage_AddRun_CN(TEXT_PAGE *Page, UWORD Xstart, UWORD Ystart, const char *Text, UWORD Len,
+                         cFONT *Font, UWORD Color_Foreground, UWORD Color_Background);
+UDOUBLE TextPage_Layout(TEXT_PAGE *Page, UWORD Xstart, UWORD Ystart, UWORD Width, UWORD Height,
+                        const char *Text, sFONT *Font, UWORD Color_Foreground, UWORD Color_Background);
+void TextPage_RenderRow(const TEXT_PAGE *Page, UWORD Ypoint, UBYTE *Row);
+void TextPage_RenderBand(void *Pages, UBYTE Plane, UWORD Ystart, UWORD Rows, UBYTE *Band);
+
+#endif
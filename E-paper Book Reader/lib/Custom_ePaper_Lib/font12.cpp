@@ -1379,6 +1379,7 @@ sFONT Font12 = {
   Font12_Table,
   7, /* Width */
   12, /* Height */
+  NULL, /* table_rot, see Font_Rotated() */
 };
 
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
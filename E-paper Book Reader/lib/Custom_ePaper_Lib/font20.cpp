@@ -2137,6 +2137,7 @@ sFONT Font20 = {
   Font20_Table,
   14, /* Width */
   20, /* Height */
+  NULL, /* table_rot, see Font_Rotated() */
 };
 
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
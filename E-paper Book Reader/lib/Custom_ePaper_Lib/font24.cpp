@@ -2515,6 +2515,7 @@ sFONT Font24 = {
   Font24_Table,
   17, /* Width */
   24, /* Height */
+  NULL, /* table_rot, see Font_Rotated() */
 };
 
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,112 @@
+/**
+  ******************************************************************************
+  * @file    fonts.cpp
+  * @brief   Pre-rotated glyph tables for 90 / 270 degree text, gray fonts
+  ******************************************************************************
+  * At ROTATE_90 / ROTATE_270 a glyph column is a row of the image. The
+  * rotated table holds every glyph transposed: Width rows of Height bits,
+  * row c is column c of the glyph from top to bottom. The same table serves
+  * both angles, the blitter flips the rows as needed.
+  *
+  * A gray font is a 1 bit font at half the size with 2 bits of coverage per
+  * pixel, drawn in 4 gray the edges are shaded and small sizes stay legible.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "fonts.h"
+#include <stdlib.h>
+
+/**
+  * @brief  Transposed glyph table of a font, built in RAM on first use
+  * @param  Font: font to rotate
+  * @retval the table, NULL when out of memory
+  */
+const uint8_t *Font_Rotated(sFONT *Font)
+{
+  uint16_t Line = (Font->Width + 7) / 8;
+  uint16_t Line_Rot = (Font->Height + 7) / 8;
+  uint16_t Glyph, Row, Column;
+  uint8_t *Table;
+  const uint8_t *Built;
+
+  Built = __atomic_load_n(&Font->table_rot, __ATOMIC_ACQUIRE);
+  if (Built != NULL)
+    return Built;
+
+  Table = (uint8_t *)calloc((size_t)FONT_GLYPHS * Font->Width * Line_Rot, 1);
+  if (Table == NULL)
+    return NULL;
+
+  for (Glyph = 0; Glyph < FONT_GLYPHS; Glyph++) {
+    const uint8_t *Src = Font->table + (size_t)Glyph * Font->Height * Line;
+    uint8_t *Dst = Table + (size_t)Glyph * Font->Width * Line_Rot;
+    for (Row = 0; Row < Font->Height; Row++) {
+      for (Column = 0; Column < Font->Width; Column++) {
+        if (Src[Row * Line + Column / 8] & (0x80 >> (Column % 8)))
+          Dst[Column * Line_Rot + Row / 8] |= 0x80 >> (Row % 8);
+      }
+    }
+  }
+  //two pictures drawn on both cores may build it at once, one table wins
+  if (!__atomic_compare_exchange_n(&Font->table_rot, &Built, (const uint8_t *)Table,
+                                   false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+    free(Table);
+    return Built;
+  }
+  return Table;
+}
+
+/**
+  * @brief  Gray fonts, the 1 bit fonts scaled down by 2
+  */
+sFONT_GRAY Font12Gray = {&Font24, 9, 12, NULL};
+sFONT_GRAY Font10Gray = {&Font20, 7, 10, NULL};
+sFONT_GRAY Font8Gray = {&Font16, 6, 8, NULL};
+
+/**
+  * @brief  Coverage glyph table of a gray font, built in RAM on first use
+  * @param  Font: gray font
+  * @retval the table, NULL when out of memory
+  * @note   A glyph row is (Width + 3) / 4 bytes, 2 bits per pixel, first
+  *         pixel in the top bits. Each pixel counts the set bits of a 2x2
+  *         block of the source glyph: 0 none, 1 one, 2 two or three, 3 all.
+  */
+const uint8_t *Font_GrayTable(sFONT_GRAY *Font)
+{
+  sFONT *Src = Font->Source;
+  uint16_t Line_Src = (Src->Width + 7) / 8;
+  uint16_t Line = (Font->Width + 3) / 4;
+  uint16_t Glyph, Row, Column, y, x;
+  uint8_t *Table;
+  const uint8_t *Built;
+
+  Built = __atomic_load_n(&Font->table, __ATOMIC_ACQUIRE);
+  if (Built != NULL)
+    return Built;
+
+  Table = (uint8_t *)calloc((size_t)FONT_GLYPHS * Font->Height * Line, 1);
+  if (Table == NULL)
+    return NULL;
+
+  for (Glyph = 0; Glyph < FONT_GLYPHS; Glyph++) {
+    const uint8_t *Glyph_Src = Src->table + (size_t)Glyph * Src->Height * Line_Src;
+    uint8_t *Dst = Table + (size_t)Glyph * Font->Height * Line;
+    for (Row = 0; Row < Font->Height; Row++) {
+      for (Column = 0; Column < Font->Width; Column++) {
+        uint8_t Sum = 0;
+        for (y = Row * 2; y < Row * 2 + 2 && y < Src->Height; y++)
+          for (x = Column * 2; x < Column * 2 + 2 && x < Src->Width; x++)
+            if (Glyph_Src[y * Line_Src + x / 8] & (0x80 >> (x % 8)))
+              Sum++;
+        Dst[Row * Line + Column / 4] |= ((Sum * 3 + 2) / 4) << (6 - 2 * (Column % 4));
+      }
+    }
+  }
+  if (!__atomic_compare_exchange_n(&Font->table, &Built, (const uint8_t *)Table,
+                                   false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+    free(Table);
+    return Built;
+  }
+  return Table;
+}
@@ -51,6 +51,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include <stdint.h>
+#include <stddef.h>
 // #include <avr/pgmspace.h>
 //ASCII
 typedef struct _tFont
@@ -58,9 +59,22 @@ typedef struct _tFont
   const uint8_t *table;
   uint16_t Width;
   uint16_t Height;
+  const uint8_t *table_rot;   /* transposed glyphs, built by Font_Rotated() */
   
 } sFONT;
 
+#define FONT_GLYPHS             95    /* ' ' to '~' */
+
+//ASCII, 2 bit coverage for 4 gray
+typedef struct _tFontGray
+{
+  sFONT *Source;              /* 1 bit font drawn at twice the size */
+  uint16_t Width;
+  uint16_t Height;
+  const uint8_t *table;       /* 4 pixels per byte, built by Font_GrayTable() */
+
+} sFONT_GRAY;
+
 //GB2312
 typedef struct                                          // 汉字字模数据结构
 {
@@ -84,10 +98,17 @@ extern sFONT Font16;
 extern sFONT Font12;
 extern sFONT Font8;
 
+extern sFONT_GRAY Font12Gray;
+extern sFONT_GRAY Font10Gray;
+extern sFONT_GRAY Font8Gray;
+
 extern cFONT Font12CN;
 extern cFONT Font24CN;
 // extern const unsigned char Font16_Table[];
 
+const uint8_t *Font_Rotated(sFONT *Font);
+const uint8_t *Font_GrayTable(sFONT_GRAY *Font);
+
 #ifdef __cplusplus
 }
 #endif
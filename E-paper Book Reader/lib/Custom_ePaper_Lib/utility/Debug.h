@@ -14,11 +14,17 @@
 #ifndef __DEBUG_H
 #define __DEBUG_H
 
+#ifdef ARDUINO
 #include <Wire.h>
+#else
+#include <stdio.h>
+#endif
 
 #define USE_DEBUG 1
-#if USE_DEBUG
+#if USE_DEBUG && defined(ARDUINO)
 	#define Debug(__info) Serial.print(__info)
+#elif USE_DEBUG
+	#define Debug(__info) printf("%s", __info)
 #else
 	#define Debug(__info)  
 #endif
@@ -29,6 +29,7 @@
 #
 ******************************************************************************/
 #include "EPD_13in3b.h"
+#include "EPD_Common.h"
 #include "Debug.h"
 
 /******************************************************************************
@@ -37,6 +38,7 @@ parameter:
 ******************************************************************************/
 static void EPD_13IN3B_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(100);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -52,10 +54,7 @@ parameter:
 ******************************************************************************/
 static void EPD_13IN3B_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -65,10 +64,7 @@ parameter:
 ******************************************************************************/
 static void EPD_13IN3B_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -78,12 +74,7 @@ parameter:
 void EPD_13IN3B_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-	while(1)
-	{	 //=1 BUSY
-		if(DEV_Digital_Read(EPD_BUSY_PIN)==0) 
-			break;
-		DEV_Delay_ms(20);
-	}
+	DEV_Wait_Busy(0, EPD_BUSY_TIMEOUT_MS);
 	DEV_Delay_ms(20);
     Debug("e-Paper busy release\r\n");
 }
@@ -114,6 +105,8 @@ parameter:
 ******************************************************************************/
 static void EPD_13IN3B_SetWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
 {
+    if(EPD_State_Window(Xstart, Ystart, Xend, Yend))
+        return;
     EPD_13IN3B_SendCommand(0x44); // SET_RAM_X_ADDRESS_START_END_POSITION
     EPD_13IN3B_SendData(Xstart & 0xFF);
     EPD_13IN3B_SendData((Xstart>>8) & 0x03);
@@ -192,23 +185,14 @@ parameter:
 ******************************************************************************/
 void EPD_13IN3B_Clear(void)
 {
-	UWORD i, j;
 	UWORD height = EPD_13IN3B_HEIGHT;
 	UWORD width = EPD_13IN3B_WIDTH/8;	
 	
 	EPD_13IN3B_SendCommand(0x24); 
-	for(i=0; i<height; i++)
-	{
-		for(j=0; j<width; j++)
-			EPD_13IN3B_SendData(0xff);
-	}
+	EPD_Common_SendDataRepeat(0xff, width * height);
 
     EPD_13IN3B_SendCommand(0x26);
-    for (UWORD j = 0; j < height; j++) {
-        for (UWORD i = 0; i < width; i++) {
-            EPD_13IN3B_SendData(0x00);
-        }
-    }
+    EPD_Common_SendDataRepeat(0x00, width * height);
     
 	EPD_13IN3B_TurnOnDisplay();
 }
@@ -220,18 +204,10 @@ void EPD_13IN3B_Clear_Black(void)
     Height = EPD_13IN3B_HEIGHT;
 
     EPD_13IN3B_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_13IN3B_SendData(0x00);
-        }
-    }
+    EPD_Common_SendDataRepeat(0x00, Width * Height);
 
     EPD_13IN3B_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_13IN3B_SendData(0x00);
-        }
-    }
+    EPD_Common_SendDataRepeat(0x00, Width * Height);
 
     EPD_13IN3B_TurnOnDisplay();
 }
@@ -243,50 +219,29 @@ void EPD_13IN3B_Clear_Red(void)
     Height = EPD_13IN3B_HEIGHT;
 
     EPD_13IN3B_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_13IN3B_SendData(0xFF);
-        }
-    }
+    EPD_Common_SendDataRepeat(0xFF, Width * Height);
 
     EPD_13IN3B_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_13IN3B_SendData(0xFF);
-        }
-    }
+    EPD_Common_SendDataRepeat(0xFF, Width * Height);
 
     EPD_13IN3B_TurnOnDisplay();
 }
 
 void EPD_13IN3B_Clear_Base(void)
 {
-	UWORD i, j;
 	UWORD height = EPD_13IN3B_HEIGHT;
 	UWORD width = EPD_13IN3B_WIDTH/8;	
 	
 	EPD_13IN3B_SendCommand(0x24); 
-	for(i=0; i<height; i++)
-	{
-		for(j=0; j<width; j++)
-			EPD_13IN3B_SendData(0xff);
-	}
+	EPD_Common_SendDataRepeat(0xff, width * height);
 
     EPD_13IN3B_SendCommand(0x26);
-    for (UWORD j = 0; j < height; j++) {
-        for (UWORD i = 0; i < width; i++) {
-            EPD_13IN3B_SendData(0x00);
-        }
-    }
+    EPD_Common_SendDataRepeat(0x00, width * height);
     
 	EPD_13IN3B_TurnOnDisplay();
     
     EPD_13IN3B_SendCommand(0x26); 
-	for(i=0; i<height; i++)
-	{
-		for(j=0; j<width; j++)
-			EPD_13IN3B_SendData(0xff);
-	}
+	EPD_Common_SendDataRepeat(0xff, width * height);
 }
 
 /******************************************************************************
@@ -300,18 +255,10 @@ void EPD_13IN3B_Display(const UBYTE *blackimage, const UBYTE *ryimage)
     Height = EPD_13IN3B_HEIGHT;
 
     EPD_13IN3B_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_13IN3B_SendData(blackimage[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(blackimage, Width * Height);
 
     EPD_13IN3B_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_13IN3B_SendData(~ryimage[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataInvert(ryimage, Width * Height);
 
     EPD_13IN3B_TurnOnDisplay();
 }
@@ -324,27 +271,15 @@ void EPD_13IN3B_Display_Base(const UBYTE *blackimage, const UBYTE *ryimage)
     Height = EPD_13IN3B_HEIGHT;
 
     EPD_13IN3B_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_13IN3B_SendData(blackimage[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(blackimage, Width * Height);
 
     EPD_13IN3B_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_13IN3B_SendData(~ryimage[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataInvert(ryimage, Width * Height);
 
     EPD_13IN3B_TurnOnDisplay();
 
     EPD_13IN3B_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_13IN3B_SendData(blackimage[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(blackimage, Width * Height);
 }
 
 void EPD_13IN3B_Display_WritePicture(const UBYTE *image, UBYTE Block)
@@ -356,37 +291,21 @@ void EPD_13IN3B_Display_WritePicture(const UBYTE *image, UBYTE Block)
     if(Block == 0)
     {
         EPD_13IN3B_SendCommand(0x24);
-        for (UWORD j = 0; j < Height/2; j++) {
-            for (UWORD i = 0; i < Width; i++) {
-                EPD_13IN3B_SendData(image[i + j * Width]);
-            }
-        }
+        EPD_Common_SendDataBuffer(image, Width * (Height/2));
     }
     else if(Block == 1)
     {
-        for (UWORD j = 0; j < Height/2; j++) {
-            for (UWORD i = 0; i < Width; i++) {
-                EPD_13IN3B_SendData(image[i + j * Width]);
-            }
-        }
+        EPD_Common_SendDataBuffer(image, Width * (Height/2));
     }
     
     if(Block == 2)
     {
         EPD_13IN3B_SendCommand(0x26);
-        for (UWORD j = 0; j < Height/2; j++) {
-            for (UWORD i = 0; i < Width; i++) {
-                EPD_13IN3B_SendData(~image[i + j * Width]);
-            }
-        }
+        EPD_Common_SendDataInvert(image, Width * (Height/2));
     }
     else if(Block == 3)
     {
-        for (UWORD j = 0; j < Height/2; j++) {
-            for (UWORD i = 0; i < Width; i++) {
-                EPD_13IN3B_SendData(~image[i + j * Width]);
-            }
-        }
+        EPD_Common_SendDataInvert(image, Width * (Height/2));
         EPD_13IN3B_TurnOnDisplay();
     }
 }
@@ -394,6 +313,7 @@ void EPD_13IN3B_Display_WritePicture(const UBYTE *image, UBYTE Block)
 //Partial refresh display
 void EPD_13IN3B_Display_Partial(const UBYTE *Image, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
 {
+    EPD_State_Invalidate();
     if((Xstart % 8 + Xend % 8 == 8 && Xstart % 8 > Xend % 8) || Xstart % 8 + Xend % 8 == 0 || (Xend - Xstart)%8 == 0)
     {
         Xstart = Xstart / 8 ;
@@ -406,7 +326,7 @@ void EPD_13IN3B_Display_Partial(const UBYTE *Image, UWORD Xstart, UWORD Ystart,
     }
     
 
-    UDOUBLE i, Width;
+    UDOUBLE Width;
 	Width = Xend -  Xstart;
 	UDOUBLE IMAGE_COUNTER = Width * (Yend-Ystart);
     printf("IMAGE_COUNTER = %d\r\n", IMAGE_COUNTER);
@@ -438,16 +358,12 @@ void EPD_13IN3B_Display_Partial(const UBYTE *Image, UWORD Xstart, UWORD Ystart,
     EPD_13IN3B_SendData((Ystart>>8) & 0x03);
 
     EPD_13IN3B_SendCommand(0x24); 
-    for (i = 0; i < IMAGE_COUNTER; i++) {
-	    EPD_13IN3B_SendData(Image[i]);
-	}
+    EPD_Common_SendDataBuffer(Image, IMAGE_COUNTER);
 
 	EPD_13IN3B_TurnOnDisplay_Part();
 
     EPD_13IN3B_SendCommand(0x26); 
-    for (i = 0; i < IMAGE_COUNTER; i++) {
-	    EPD_13IN3B_SendData(Image[i]);
-	}
+    EPD_Common_SendDataBuffer(Image, IMAGE_COUNTER);
 
 }
 
@@ -32,6 +32,7 @@
 #define __EPD_13IN3B_B_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_13IN3B_WIDTH       960
@@ -49,4 +50,6 @@ void EPD_13IN3B_Display_Base_White(void);
 void EPD_13IN3B_Display_Partial(const UBYTE *Image, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend);
 void EPD_13IN3B_Sleep(void);
 
+EPD_MODEL(EPD_13IN3B, 2, 1);
+
 #endif
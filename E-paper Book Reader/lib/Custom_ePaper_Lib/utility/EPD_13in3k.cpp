@@ -29,6 +29,7 @@
 #
 ******************************************************************************/
 #include "EPD_13in3k.h"
+#include "EPD_Common.h"
 #include "Debug.h"
 
 const unsigned char Lut_Partial[]={										
@@ -80,6 +81,7 @@ parameter:
 ******************************************************************************/
 static void EPD_13IN3K_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(100);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -95,10 +97,7 @@ parameter:
 ******************************************************************************/
 static void EPD_13IN3K_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -108,10 +107,7 @@ parameter:
 ******************************************************************************/
 static void EPD_13IN3K_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -121,12 +117,7 @@ parameter:
 void EPD_13IN3K_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-	while(1)
-	{	 //=1 BUSY
-		if(DEV_Digital_Read(EPD_BUSY_PIN)==0) 
-			break;
-		DEV_Delay_ms(20);
-	}
+	DEV_Wait_Busy(0, EPD_BUSY_TIMEOUT_MS);
 	DEV_Delay_ms(20);
     Debug("e-Paper busy release\r\n");
 }
@@ -161,11 +152,8 @@ static void EPD_13IN3K_TurnOnDisplay_4GRAY(void)
 
 static void EPD_13IN3K_Lut(const UBYTE *LUT)
 {
-    unsigned int count;
     EPD_13IN3K_SendCommand(0x32);
-    for(count = 0; count < 105 ; count++) {
-        EPD_13IN3K_SendData(LUT[count]);
-    }
+    EPD_Common_SendDataBuffer(LUT, 105);
 
     EPD_13IN3K_SendCommand(0x03);
 	EPD_13IN3K_SendData(LUT[105]);
@@ -185,6 +173,8 @@ parameter:
 ******************************************************************************/
 static void EPD_13IN3K_SetWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
 {
+    if(EPD_State_Window(Xstart, Ystart, Xend, Yend))
+        return;
     EPD_13IN3K_SendCommand(0x44); // SET_RAM_X_ADDRESS_START_END_POSITION
     EPD_13IN3K_SendData(Xstart & 0xFF);
     EPD_13IN3K_SendData((Xstart>>8) & 0x03);
@@ -335,38 +325,24 @@ parameter:
 ******************************************************************************/
 void EPD_13IN3K_Clear(void)
 {
-	UWORD i, j;
 	UWORD height = EPD_13IN3K_HEIGHT;
 	UWORD width = EPD_13IN3K_WIDTH/8;	
 	
 	EPD_13IN3K_SendCommand(0x24);   //write RAM for black(0)/white (1)
-	for(i=0; i<height; i++)
-	{
-		for(j=0; j<width; j++)
-			EPD_13IN3K_SendData(0xff);
-	}
+	EPD_Common_SendDataRepeat(0xff, width * height);
 	EPD_13IN3K_TurnOnDisplay();
 }
 
 void EPD_13IN3K_color_Base(UBYTE color)
 {
-	UWORD i, j;
 	UWORD height = EPD_13IN3K_HEIGHT;
 	UWORD width = EPD_13IN3K_WIDTH/8;	
 	
 	EPD_13IN3K_SendCommand(0x24);
-	for(i=0; i<height; i++)
-	{
-		for(j=0; j<width; j++)
-			EPD_13IN3K_SendData(color);
-	}
+	EPD_Common_SendDataRepeat(color, width * height);
 
     EPD_13IN3K_SendCommand(0x26);
-	for(i=0; i<height; i++)
-	{
-		for(j=0; j<width; j++)
-			EPD_13IN3K_SendData(color);
-	}
+	EPD_Common_SendDataRepeat(color, width * height);
 	EPD_13IN3K_TurnOnDisplay();
 }
 
@@ -377,38 +353,24 @@ parameter:
 ******************************************************************************/
 void EPD_13IN3K_Display(UBYTE *Image)
 {
-	UWORD i, j;
 	UWORD height = EPD_13IN3K_HEIGHT;
 	UWORD width = EPD_13IN3K_WIDTH/8;
 	
 	EPD_13IN3K_SendCommand(0x24);   //write RAM for black(0)/white (1)
-	for(i=0; i<height; i++)
-	{
-		for(j=0; j<width; j++)
-			EPD_13IN3K_SendData(Image[j + i*width]);
-	}
+	EPD_Common_SendDataBuffer(Image, width * height);
 	EPD_13IN3K_TurnOnDisplay();	
 }
 
 void EPD_13IN3K_Display_Base(UBYTE *Image)
 {
-	UWORD i, j;
 	UWORD height = EPD_13IN3K_HEIGHT;
 	UWORD width = EPD_13IN3K_WIDTH/8;
 	
 	EPD_13IN3K_SendCommand(0x24);   //write RAM for black(0)/white (1)
-	for(i=0; i<height; i++)
-	{
-		for(j=0; j<width; j++)
-			EPD_13IN3K_SendData(Image[j + i*width]);
-	}
+	EPD_Common_SendDataBuffer(Image, width * height);
 
     EPD_13IN3K_SendCommand(0x26);   //write RAM for black(0)/white (1)
-	for(i=0; i<height; i++)
-	{
-		for(j=0; j<width; j++)
-			EPD_13IN3K_SendData(Image[j + i*width]);
-	}
+	EPD_Common_SendDataBuffer(Image, width * height);
 	EPD_13IN3K_TurnOnDisplay();	
 }
 
@@ -421,11 +383,7 @@ void EPD_13IN3K_WritePicture(UBYTE *Image, UBYTE Block)
 	if(Block == 0){
 		EPD_13IN3K_SendCommand(0x24);
 	}
-	for (UDOUBLE j = 0; j < Height/2; j++) {
-        for (UDOUBLE i = 0; i < Width; i++) {
-            EPD_13IN3K_SendData(Image[i + j * Width]);
-        }
-	}
+	EPD_Common_SendDataBuffer(Image, Width * (Height/2));
 	if(Block == 1){
 		EPD_13IN3K_TurnOnDisplay();
 	}
@@ -438,24 +396,34 @@ void EPD_13IN3K_WritePicture_Base(UBYTE *Image, UBYTE Block)
 	Height = EPD_13IN3K_HEIGHT;
 	
 	EPD_13IN3K_SendCommand(0x24);
-	for (UDOUBLE j = 0; j < Height/2; j++) {
-        for (UDOUBLE i = 0; i < Width; i++) {
-            EPD_13IN3K_SendData(Image[i + j * Width]);
-        }
-	}
+	EPD_Common_SendDataBuffer(Image, Width * (Height/2));
     
     EPD_13IN3K_SendCommand(0x26);
-	for (UDOUBLE j = 0; j < Height/2; j++) {
-        for (UDOUBLE i = 0; i < Width; i++) {
-            EPD_13IN3K_SendData(Image[i + j * Width]);
-        }
-	}
+	EPD_Common_SendDataBuffer(Image, Width * (Height/2));
     
 	if(Block == 1){
 		EPD_13IN3K_TurnOnDisplay();
 	}
 }
 
+/******************************************************************************
+function :	Renders the frame band by band while sending it and displays
+parameter:
+    Band      : band buffer, e.g. 1/8 of the frame, EPD_13IN3K_WIDTH / 8 * 85
+    Band_Size : size of Band, at least one row
+    Render    : fills a band, e.g. Paint_RenderBand
+    arg       : passed to Render
+Info:
+    Same as EPD_13IN3K_Display() without the 81600 byte frame, instead of
+    splitting it into two blocks by hand as EPD_13IN3K_WritePicture() does.
+******************************************************************************/
+void EPD_13IN3K_Display_Bands(UBYTE *Band, UDOUBLE Band_Size, EPD_BAND_RENDER Render, void *arg)
+{
+	EPD_13IN3K_SendCommand(0x24);   //write RAM for black(0)/white (1)
+	EPD_Common_SendBands(0, EPD_13IN3K_WIDTH / 8, EPD_13IN3K_HEIGHT, Band, Band_Size, Render, arg, 0);
+	EPD_13IN3K_TurnOnDisplay();
+}
+
 void EPD_13IN3K_Display_Part(UBYTE *Image, UWORD x, UWORD y, UWORD w, UWORD l)
 {
 	UWORD Ystart = y;
@@ -475,7 +443,7 @@ void EPD_13IN3K_Display_Part(UBYTE *Image, UWORD x, UWORD y, UWORD w, UWORD l)
         Xend = Xend % 8 == 0 ? Xend / 8 : Xend / 8 + 1;
     }
 
-    UWORD i, Width;
+    UWORD Width;
 	Width = Xend -  Xstart;
 	UWORD IMAGE_COUNTER = Width * (Yend-Ystart);
 
@@ -487,108 +455,49 @@ void EPD_13IN3K_Display_Part(UBYTE *Image, UWORD x, UWORD y, UWORD w, UWORD l)
 	EPD_13IN3K_SetCursor(Xstart*8, y);
 
 	EPD_13IN3K_SendCommand(0x24);   //write RAM for black(0)/white (1)
-	for (i = 0; i < IMAGE_COUNTER; i++) {
-	    EPD_13IN3K_SendData(Image[i]);
-	}
+	EPD_Common_SendDataBuffer(Image, IMAGE_COUNTER);
 
 	EPD_13IN3K_TurnOnDisplay_Part();	
 }
 
 void EPD_13IN3K_4GrayDisplay(UBYTE *Image)
 {
-    UDOUBLE i,j,k,o;
-    UBYTE temp1,temp2,temp3;
+    UBYTE Lut[256], Row[EPD_13IN3K_WIDTH / 16];
+    UWORD i, p;
     UWORD height = EPD_13IN3K_HEIGHT;
 	UWORD width = EPD_13IN3K_WIDTH/8;
-
-    // old  data
-    EPD_13IN3K_SendCommand(0x24);
-    for(i=0; i<height; i++) { 
-        for(o=0; o<width; o++) {
-            if(i<height/2 && o <width/2)
-            {
-                temp3=0;
-                for(j=0; j<2; j++) {
-                    temp1 = Image[(o+i*width/2)*2+j];
-                    for(k=0; k<2; k++) {
-                        temp2 = temp1&0xC0;
-                        if(temp2 == 0xC0)
-                            temp3 |= 0x00;
-                        else if(temp2 == 0x00)
-                            temp3 |= 0x01; 
-                        else if(temp2 == 0x80)
-                            temp3 |= 0x01; 
-                        else //0x40
-                            temp3 |= 0x00; 
-                        temp3 <<= 1;
-
-                        temp1 <<= 2;
-                        temp2 = temp1&0xC0 ;
-                        if(temp2 == 0xC0) 
-                            temp3 |= 0x00;
-                        else if(temp2 == 0x00) 
-                            temp3 |= 0x01;
-                        else if(temp2 == 0x80)
-                            temp3 |= 0x01; 
-                        else    //0x40
-                            temp3 |= 0x00;	
-                        if(j!=1 || k!=1)
-                            temp3 <<= 1;
-
-                        temp1 <<= 2;
-                    }
-                }
-                EPD_13IN3K_SendData(temp3);
-                // printf("%x",temp3);
-            }
-            else
-                EPD_13IN3K_SendData(0x00);
+    UBYTE Cmd[2] = {0x24, 0x26};
+
+    //the image fills the top left quarter, the rest is sent as 0x00
+    for(p=0; p<2; p++) {
+        EPD_13IN3K_SendCommand(Cmd[p]);
+        EPD_Common_GrayLut(EPD_13IN3K_GRAY, p, Lut);
+        for(i=0; i<height/2; i++) {
+            EPD_Common_GrayPlane(Image + (UDOUBLE)i * width, width, Lut, Row);
+            EPD_Common_SendDataBuffer(Row, width/2);
+            EPD_Common_SendDataRepeat(0x00, width - width/2);
         }
+        EPD_Common_SendDataRepeat(0x00, (UDOUBLE)(height - height/2) * width);
     }
 
-    EPD_13IN3K_SendCommand(0x26);   //write RAM for black(0)/white (1)
-    for(i=0; i<height; i++) { 
-        for(o=0; o<width; o++) {
-            if(i<height/2 && o <width/2)
-            {
-                temp3=0;
-                for(j=0; j<2; j++) {
-                    temp1 = Image[(o+i*width/2)*2+j];
-                    for(k=0; k<2; k++) {
-                        temp2 = temp1&0xC0 ;
-                        if(temp2 == 0xC0)
-                            temp3 |= 0x00;//white
-                        else if(temp2 == 0x00)
-                            temp3 |= 0x01;  //black
-                        else if(temp2 == 0x80)
-                            temp3 |= 0x00;  //gray1
-                        else //0x40
-                            temp3 |= 0x01; //gray2
-                        temp3 <<= 1;
-
-                        temp1 <<= 2;
-                        temp2 = temp1&0xC0 ;
-                        if(temp2 == 0xC0)  //white
-                            temp3 |= 0x00;
-                        else if(temp2 == 0x00) //black
-                            temp3 |= 0x01;
-                        else if(temp2 == 0x80)
-                            temp3 |= 0x00; //gray1
-                        else    //0x40
-                            temp3 |= 0x01;	//gray2
-                        if(j!=1 || k!=1)
-                            temp3 <<= 1;
-
-                        temp1 <<= 2;
-                    }
-                }
-                EPD_13IN3K_SendData(temp3);
-                // printf("%x",temp3);
-            }                
-            else
-                EPD_13IN3K_SendData(0x00);
-        }
-    }
+    EPD_13IN3K_TurnOnDisplay_4GRAY();
+}
+
+/******************************************************************************
+function :	Sends a planar 4 gray image to e-Paper and displays
+parameter:
+    Image : the 0x24 plane then the 0x26 plane, the full panel, drawn with
+            Paint_SetGrayPlanes(Ctx, EPD_13IN3K_GRAY)
+******************************************************************************/
+void EPD_13IN3K_4GrayDisplay_Planes(const UBYTE *Image)
+{
+    UDOUBLE Plane = (UDOUBLE)EPD_13IN3K_WIDTH / 8 * EPD_13IN3K_HEIGHT;
+
+    EPD_13IN3K_SendCommand(0x24);
+    EPD_Common_SendDataBuffer(Image, Plane);
+    EPD_13IN3K_SendCommand(0x26);
+    EPD_Common_SendDataBuffer(Image + Plane, Plane);
+
     EPD_13IN3K_TurnOnDisplay_4GRAY();
 }
 
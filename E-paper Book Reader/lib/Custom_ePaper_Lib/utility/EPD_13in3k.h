@@ -32,10 +32,13 @@
 #define __EPD_13IN3K_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
+#include "EPD_Common.h"
 
 // Display resolution
 #define EPD_13IN3K_WIDTH       960
 #define EPD_13IN3K_HEIGHT      680
+#define EPD_13IN3K_GRAY        EPD_Gray_Invert     //4 gray planes, see Paint_SetGrayPlanes()
 
 void EPD_13IN3K_Init(void);
 void EPD_13IN3K_Init_Part(void);
@@ -46,8 +49,12 @@ void EPD_13IN3K_Display(UBYTE *Image);
 void EPD_13IN3K_Display_Base(UBYTE *Image);
 void EPD_13IN3K_WritePicture(UBYTE *Image, UBYTE Block);
 void EPD_13IN3K_WritePicture_Base(UBYTE *Image, UBYTE Block);
+void EPD_13IN3K_Display_Bands(UBYTE *Band, UDOUBLE Band_Size, EPD_BAND_RENDER Render, void *arg);
 void EPD_13IN3K_Display_Part(UBYTE *Image, UWORD x, UWORD y, UWORD w, UWORD l);
 void EPD_13IN3K_4GrayDisplay(UBYTE *Image);
+void EPD_13IN3K_4GrayDisplay_Planes(const UBYTE *Image);
 void EPD_13IN3K_Sleep(void);
 
+EPD_MODEL(EPD_13IN3K, 1, 1);
+
 #endif
@@ -28,6 +28,7 @@
 #
 ******************************************************************************/
 #include "EPD_1in02.h"
+#include "EPD_Common.h"
 /**
  * full screen update LUT
 **/
@@ -85,6 +86,7 @@ parameter:
 ******************************************************************************/
 static void EPD_1IN02_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
 	DEV_Delay_ms(20);
 	DEV_Digital_Write(EPD_RST_PIN, 0);// Module reset
@@ -101,11 +103,7 @@ parameter:
 ******************************************************************************/
 static void EPD_1IN02_SendCommand(UBYTE command)
 {
-	DEV_Digital_Write(EPD_CS_PIN, 0);
-	DEV_Digital_Write(EPD_DC_PIN, 0);// command write
-
-	DEV_SPI_WriteByte(command);
-	DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(command);
 }
 
 /******************************************************************************
@@ -115,10 +113,7 @@ parameter:
 ******************************************************************************/
 static void EPD_1IN02_SendData(UBYTE Data)
 {
-	DEV_Digital_Write(EPD_CS_PIN, 0);
-	DEV_Digital_Write(EPD_DC_PIN, 1);	// command write
-	DEV_SPI_WriteByte(Data);
-	DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -126,14 +121,11 @@ function :	LUT download
 ******************************************************************************/
 void EPD_1IN02_SetFulltReg(void)
 {
-	unsigned int count;
 	EPD_1IN02_SendCommand(0x23);
-	for(count=0;count<42;count++)	     
-	{EPD_1IN02_SendData(lut_w1[count]);}    
+	EPD_Common_SendDataBuffer(lut_w1, 42);    
 	
 	EPD_1IN02_SendCommand(0x24);
-	for(count=0;count<42;count++)	     
-	{EPD_1IN02_SendData(lut_b1[count]);}          
+	EPD_Common_SendDataBuffer(lut_b1, 42);          
 }
 
 /******************************************************************************
@@ -141,16 +133,11 @@ function :	LUT download
 ******************************************************************************/
 void EPD_1IN02_SetPartReg(void)
 {
-	unsigned int count;
 	EPD_1IN02_SendCommand(0x23);
-	for(count=0;count<42;count++){
-		EPD_1IN02_SendData(lut_w[count]);
-	}
+	EPD_Common_SendDataBuffer(lut_w, 42);
 	
 	EPD_1IN02_SendCommand(0x24);
-	for(count=0;count<42;count++){
-		EPD_1IN02_SendData(lut_b[count]);
-	}          
+	EPD_Common_SendDataBuffer(lut_b, 42);          
 }
 
 /******************************************************************************
@@ -158,14 +145,8 @@ function :	Wait until the busy_pin goes LOW
 ******************************************************************************/
 void EPD_1IN02_WaitUntilIdle(void)
 {
-	unsigned char busy;
-	do
-	{
-		EPD_1IN02_SendCommand(0x71);
-		busy = DEV_Digital_Read(EPD_BUSY_PIN);
-		busy =!(busy & 0x01);        
-	}
-	while(busy);
+	EPD_1IN02_SendCommand(0x71);
+	DEV_Wait_Busy(1, EPD_BUSY_TIMEOUT_MS);
 	DEV_Delay_ms(800);                       
 }
 
@@ -286,15 +267,10 @@ function :	Clear screen
 ******************************************************************************/
 void EPD_1IN02_Clear(void)
 { 
-	unsigned int i;
 	EPD_1IN02_SendCommand(0x10);
-	for(i=0;i<1280;i++){
-		EPD_1IN02_SendData(0X00);
-	}
+	EPD_Common_SendDataRepeat(0X00, 1280);
 	EPD_1IN02_SendCommand(0x13);	       //Transfer new data
-	for(i=0;i<1280;i++){
-		EPD_1IN02_SendData(0xff);
-	}
+	EPD_Common_SendDataRepeat(0xff, 1280);
 	EPD_1IN02_TurnOnDisplay();
 }
 
@@ -311,18 +287,10 @@ void EPD_1IN02_Display(UBYTE *Image)
 	Width = (EPD_1IN02_WIDTH % 8 == 0)? (EPD_1IN02_WIDTH / 8 ): (EPD_1IN02_WIDTH / 8 + 1);
 	//EPD_1IN02_Init();
 	EPD_1IN02_SendCommand(0x10);
-	for (UWORD j = 0; j < EPD_1IN02_HEIGHT; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_1IN02_SendData(0xff);
-        }
-	}
+	EPD_Common_SendDataRepeat(0xff, Width * EPD_1IN02_HEIGHT);
 
 	EPD_1IN02_SendCommand(0x13);
-	for (UWORD j = 0; j < EPD_1IN02_HEIGHT; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_1IN02_SendData(Image[i + j * Width]);
-        }
-	}
+	EPD_Common_SendDataBuffer(Image, Width * EPD_1IN02_HEIGHT);
 	EPD_1IN02_TurnOnDisplay();
 }
 
@@ -351,18 +319,10 @@ void EPD_1IN02_DisplayPartial(UBYTE *old_Image, UBYTE *Image)
 
     /* send data */
     EPD_1IN02_SendCommand(0x10);
-    for (UWORD j = 0; j < EPD_1IN02_HEIGHT; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_1IN02_SendData(old_Image[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(old_Image, Width * EPD_1IN02_HEIGHT);
 
     EPD_1IN02_SendCommand(0x13);
-    for (UWORD j = 0; j < EPD_1IN02_HEIGHT; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_1IN02_SendData(Image[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(Image, Width * EPD_1IN02_HEIGHT);
 
     /* Set partial refresh */
     EPD_1IN02_TurnOnDisplay();
@@ -382,6 +342,7 @@ void EPD_1IN02_Sleep(void)
     
     DEV_Delay_ms(200);
     printf("Turn off the power!!! \r\n");
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 0);// Module reset
 }
 
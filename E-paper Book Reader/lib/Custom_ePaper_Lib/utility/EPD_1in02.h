@@ -31,6 +31,7 @@
 #define _EPD_1IN02_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_1IN02_WIDTH   80
@@ -42,6 +43,9 @@ void EPD_1IN02_Display(UBYTE *Image);
 void EPD_1IN02_DisplayPartial(UBYTE *Image1, UBYTE *Image2);
 void EPD_1IN02_Sleep(void);
 void EPD_1IN02_Part_Init(void);
+
+EPD_MODEL(EPD_1IN02, 1, 1);
+
 #endif
 
 
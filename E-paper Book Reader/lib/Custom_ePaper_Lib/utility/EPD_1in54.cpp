@@ -85,6 +85,7 @@
 #
 ******************************************************************************/
 #include "EPD_1in54.h"
+#include "EPD_Common.h"
 #include "Debug.h"
 
 static const unsigned char EPD_1IN54_lut_full_update[] = {
@@ -107,6 +108,7 @@ parameter:
 ******************************************************************************/
 static void EPD_1IN54_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(200);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -122,10 +124,7 @@ parameter:
 ******************************************************************************/
 static void EPD_1IN54_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -135,10 +134,7 @@ parameter:
 ******************************************************************************/
 static void EPD_1IN54_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -148,9 +144,7 @@ parameter:
 void EPD_1IN54_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-    while(DEV_Digital_Read(EPD_BUSY_PIN) == 1) {      //LOW: idle, HIGH: busy
-        DEV_Delay_ms(100);
-    }
+    DEV_Wait_Busy(0, EPD_BUSY_TIMEOUT_MS);
     Debug("e-Paper busy release\r\n");
 }
 
@@ -160,6 +154,8 @@ parameter:
 ******************************************************************************/
 static void EPD_1IN54_SetWindow(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
 {
+    if(EPD_State_Window(Xstart, Ystart, Xend, Yend))
+        return;
     EPD_1IN54_SendCommand(0x44); // SET_RAM_X_ADDRESS_START_END_POSITION
     EPD_1IN54_SendData((Xstart >> 3) & 0xFF);
     EPD_1IN54_SendData((Xend >> 3) & 0xFF);
@@ -232,13 +228,9 @@ void EPD_1IN54_Init(UBYTE Mode)
     //set the look-up table register
     EPD_1IN54_SendCommand(0x32);
     if(Mode == EPD_1IN54_FULL){
-        for (UWORD i = 0; i < 30; i++) {
-                EPD_1IN54_SendData(EPD_1IN54_lut_full_update[i]);
-        }
+        EPD_Common_SendDataBuffer(EPD_1IN54_lut_full_update, 30);
     }else if(Mode == EPD_1IN54_PART){
-        for (UWORD i = 0; i < 30; i++) {
-                EPD_1IN54_SendData(EPD_1IN54_lut_partial_update[i]);
-        }
+        EPD_Common_SendDataBuffer(EPD_1IN54_lut_partial_update, 30);
     }else{
         Debug("error, the Mode is EPD_1IN54_FULL or EPD_1IN54_PART");
     }
@@ -258,9 +250,7 @@ void EPD_1IN54_Clear(void)
     for (UWORD j = 0; j < Height; j++) {
         EPD_1IN54_SetCursor(0, j);
         EPD_1IN54_SendCommand(0x24);
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_1IN54_SendData(0XFF);
-        }
+        EPD_Common_SendDataRepeat(0XFF, Width);
     }
     EPD_1IN54_TurnOnDisplay();
 }
@@ -275,16 +265,12 @@ void EPD_1IN54_Display(UBYTE *Image)
     Width = (EPD_1IN54_WIDTH % 8 == 0)? (EPD_1IN54_WIDTH / 8 ): (EPD_1IN54_WIDTH / 8 + 1);
     Height = EPD_1IN54_HEIGHT;
 
-    UDOUBLE Addr = 0;
     // UDOUBLE Offset = ImageName;
     EPD_1IN54_SetWindow(0, 0, EPD_1IN54_WIDTH, EPD_1IN54_HEIGHT);
     for (UWORD j = 0; j < Height; j++) {
         EPD_1IN54_SetCursor(0, j);
         EPD_1IN54_SendCommand(0x24);
-        for (UWORD i = 0; i < Width; i++) {
-            Addr = i + j * Width;
-            EPD_1IN54_SendData(Image[Addr]);
-        }
+        EPD_Common_SendDataBuffer(Image + j * Width, Width);
     }
     EPD_1IN54_TurnOnDisplay();
 }
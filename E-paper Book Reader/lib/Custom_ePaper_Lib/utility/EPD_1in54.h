@@ -88,6 +88,7 @@
 #define __EPD_1IN54_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_1IN54_WIDTH			200
@@ -101,4 +102,6 @@ void EPD_1IN54_Clear(void);
 void EPD_1IN54_Display(UBYTE *Image);
 void EPD_1IN54_Sleep(void);
 
+EPD_MODEL(EPD_1IN54, 1, 1);
+
 #endif
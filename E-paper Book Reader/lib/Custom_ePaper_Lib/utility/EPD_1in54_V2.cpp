@@ -28,6 +28,8 @@
 #
 ******************************************************************************/
 #include "EPD_1in54_V2.h"
+#include "EPD_Common.h"
+#include "EPD_Panel.h"
 #include "Debug.h"
 
 // waveform full refresh
@@ -84,6 +86,7 @@ parameter:
 ******************************************************************************/
 static void EPD_1IN54_V2_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(20);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -99,10 +102,7 @@ parameter:
 ******************************************************************************/
 static void EPD_1IN54_V2_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -112,10 +112,7 @@ parameter:
 ******************************************************************************/
 static void EPD_1IN54_V2_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -125,9 +122,7 @@ parameter:
 static void EPD_1IN54_V2_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-    while(DEV_Digital_Read(EPD_BUSY_PIN) == 1) {      //LOW: idle, HIGH: busy
-        DEV_Delay_ms(1);
-    }
+    DEV_Wait_Busy(0, EPD_BUSY_TIMEOUT_MS);
     Debug("e-Paper busy release\r\n");
 }
 
@@ -158,8 +153,7 @@ static void EPD_1IN54_V2_TurnOnDisplayPart(void)
 static void EPD_1IN54_V2_Lut(UBYTE *lut)
 {
 	EPD_1IN54_V2_SendCommand(0x32);
-	for(UBYTE i=0; i<153; i++)
-		EPD_1IN54_V2_SendData(lut[i]);
+	EPD_Common_SendDataBuffer(lut, 153);
 	EPD_1IN54_V2_ReadBusy();
 }
 
@@ -182,28 +176,54 @@ static void EPD_1IN54_V2_SetLut(UBYTE *lut)
     EPD_1IN54_V2_SendData(lut[158]);
 }
 
-static void EPD_1IN54_V2_SetWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
-{
-    EPD_1IN54_V2_SendCommand(0x44); // SET_RAM_X_ADDRESS_START_END_POSITION
-    EPD_1IN54_V2_SendData((Xstart>>3) & 0xFF);
-    EPD_1IN54_V2_SendData((Xend>>3) & 0xFF);
-	
-    EPD_1IN54_V2_SendCommand(0x45); // SET_RAM_Y_ADDRESS_START_END_POSITION
-    EPD_1IN54_V2_SendData(Ystart & 0xFF);
-    EPD_1IN54_V2_SendData((Ystart >> 8) & 0xFF);
-    EPD_1IN54_V2_SendData(Yend & 0xFF);
-    EPD_1IN54_V2_SendData((Yend >> 8) & 0xFF);
-}
+static const UBYTE EPD_1IN54_V2_Init_Script[] = {
+    EPD_RESET(20, 2, 20),
+    EPD_BUSY,
+    EPD_CMD(0x12, 0),               //SWRESET
+    EPD_BUSY,
+    EPD_CMD(0x01, 3), 0xC7, 0x00, 0x01, //Driver output control
+    EPD_CMD(0x11, 1), 0x01,         //data entry mode
+    EPD_WINDOW(EPD_RAM_YDEC),
+    EPD_CMD(0x3C, 1), 0x01,         //BorderWavefrom
+    EPD_CMD(0x18, 1), 0x80,
+    EPD_CMD(0x22, 1), 0xB1,         //Load Temperature and waveform setting.
+    EPD_CMD(0x20, 0),
+    EPD_CURSOR(EPD_RAM_YDEC),
+    EPD_BUSY,
+    EPD_LUT(0x32, 0, 153),
+    EPD_BUSY,
+    EPD_LUT(0x3F, 153, 1),
+    EPD_LUT(0x03, 154, 1),          //gate voltage
+    EPD_LUT(0x04, 155, 3),          //source voltage
+    EPD_LUT(0x2C, 158, 1),          //VCOM
+    EPD_END
+};
 
-static void EPD_1IN54_V2_SetCursor(UWORD Xstart, UWORD Ystart)
-{
-    EPD_1IN54_V2_SendCommand(0x4E); // SET_RAM_X_ADDRESS_COUNTER
-    EPD_1IN54_V2_SendData(Xstart & 0xFF);
+static const UBYTE EPD_1IN54_V2_Refresh_Script[] = {
+    EPD_CMD(0x22, 1), 0xC7,
+    EPD_CMD(0x20, 0),
+    EPD_BUSY,
+    EPD_END
+};
 
-    EPD_1IN54_V2_SendCommand(0x4F); // SET_RAM_Y_ADDRESS_COUNTER
-    EPD_1IN54_V2_SendData(Ystart & 0xFF);
-    EPD_1IN54_V2_SendData((Ystart >> 8) & 0xFF);
-}
+static const UBYTE EPD_1IN54_V2_Sleep_Script[] = {
+    EPD_CMD(0x10, 1), 0x01,         //enter deep sleep
+    EPD_DELAY(100),
+    EPD_END
+};
+
+const EPD_PANEL EPD_1IN54_V2_Panel = {
+    "EPD_1IN54_V2", EPD_1IN54_V2_WIDTH, EPD_1IN54_V2_HEIGHT,
+    2, {
+        { 0x24, EPD_PLANE_IMAGE0, 0, 0xFF, 0 },
+        { 0x26, EPD_PLANE_CLEAR, 0, 0xFF, 0 },    //base of the partial refresh
+    },
+    0, 0, 0, 0, 0,
+    EPD_1IN54_V2_Init_Script, EPD_1IN54_V2_Refresh_Script, EPD_1IN54_V2_Sleep_Script,
+    EPD_CAP_PARTIAL,
+    NULL, NULL,                     //the analog supply is switched by each update sequence, no STANDBY
+    WF_Full_1IN54,
+};
 
 /******************************************************************************
 function :	Initialize the e-Paper register
@@ -211,36 +231,7 @@ parameter:
 ******************************************************************************/
 void EPD_1IN54_V2_Init(void)
 {
-    EPD_1IN54_V2_Reset();
-
-    EPD_1IN54_V2_ReadBusy();
-    EPD_1IN54_V2_SendCommand(0x12);  //SWRESET
-    EPD_1IN54_V2_ReadBusy();
-
-    EPD_1IN54_V2_SendCommand(0x01); //Driver output control
-    EPD_1IN54_V2_SendData(0xC7);
-    EPD_1IN54_V2_SendData(0x00);
-    EPD_1IN54_V2_SendData(0x01);
-
-    EPD_1IN54_V2_SendCommand(0x11); //data entry mode
-    EPD_1IN54_V2_SendData(0x01);
-
-	EPD_1IN54_V2_SetWindows(0, EPD_1IN54_V2_HEIGHT-1, EPD_1IN54_V2_WIDTH-1, 0);
-
-    EPD_1IN54_V2_SendCommand(0x3C); //BorderWavefrom
-    EPD_1IN54_V2_SendData(0x01);
-
-    EPD_1IN54_V2_SendCommand(0x18);
-    EPD_1IN54_V2_SendData(0x80);
-
-    EPD_1IN54_V2_SendCommand(0x22); // //Load Temperature and waveform setting.
-    EPD_1IN54_V2_SendData(0XB1);
-    EPD_1IN54_V2_SendCommand(0x20);
-
-    EPD_1IN54_V2_SetCursor(0, EPD_1IN54_V2_HEIGHT-1);
-	EPD_1IN54_V2_ReadBusy();
-	
-	EPD_1IN54_V2_SetLut(WF_Full_1IN54);
+    EPD_Panel_Init(&EPD_1IN54_V2_Panel);
 }
 
 /******************************************************************************
@@ -280,23 +271,7 @@ parameter:
 ******************************************************************************/
 void EPD_1IN54_V2_Clear(void)
 {
-    UWORD Width, Height;
-    Width = (EPD_1IN54_V2_WIDTH % 8 == 0)? (EPD_1IN54_V2_WIDTH / 8 ): (EPD_1IN54_V2_WIDTH / 8 + 1);
-    Height = EPD_1IN54_V2_HEIGHT;
-
-    EPD_1IN54_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_1IN54_V2_SendData(0XFF);
-        }
-    }
-    EPD_1IN54_V2_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_1IN54_V2_SendData(0XFF);
-        }
-    }
-    EPD_1IN54_V2_TurnOnDisplay();
+    EPD_Panel_Clear(&EPD_1IN54_V2_Panel);
 }
 
 /******************************************************************************
@@ -305,19 +280,7 @@ parameter:
 ******************************************************************************/
 void EPD_1IN54_V2_Display(UBYTE *Image)
 {
-    UWORD Width, Height;
-    Width = (EPD_1IN54_V2_WIDTH % 8 == 0)? (EPD_1IN54_V2_WIDTH / 8 ): (EPD_1IN54_V2_WIDTH / 8 + 1);
-    Height = EPD_1IN54_V2_HEIGHT;
-
-    UDOUBLE Addr = 0;
-    EPD_1IN54_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            Addr = i + j * Width;
-            EPD_1IN54_V2_SendData(Image[Addr]);
-        }
-    }
-    EPD_1IN54_V2_TurnOnDisplay();
+    EPD_Panel_Display(&EPD_1IN54_V2_Panel, Image, NULL);
 }
 
 /******************************************************************************
@@ -331,21 +294,10 @@ void EPD_1IN54_V2_DisplayPartBaseImage(UBYTE *Image)
     Width = (EPD_1IN54_V2_WIDTH % 8 == 0)? (EPD_1IN54_V2_WIDTH / 8 ): (EPD_1IN54_V2_WIDTH / 8 + 1);
     Height = EPD_1IN54_V2_HEIGHT;
 
-    UDOUBLE Addr = 0;
     EPD_1IN54_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            Addr = i + j * Width;
-            EPD_1IN54_V2_SendData(Image[Addr]);
-        }
-    }
+    EPD_Common_SendDataBuffer(Image, Width * Height);
     EPD_1IN54_V2_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            Addr = i + j * Width;
-            EPD_1IN54_V2_SendData(Image[Addr]);
-        }
-    }
+    EPD_Common_SendDataBuffer(Image, Width * Height);
     EPD_1IN54_V2_TurnOnDisplay();
 }
 
@@ -359,14 +311,8 @@ void EPD_1IN54_V2_DisplayPart(UBYTE *Image)
     Width = (EPD_1IN54_V2_WIDTH % 8 == 0)? (EPD_1IN54_V2_WIDTH / 8 ): (EPD_1IN54_V2_WIDTH / 8 + 1);
     Height = EPD_1IN54_V2_HEIGHT;
  
-    UDOUBLE Addr = 0;
     EPD_1IN54_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            Addr = i + j * Width;
-            EPD_1IN54_V2_SendData(Image[Addr]);
-        }
-    }
+    EPD_Common_SendDataBuffer(Image, Width * Height);
     EPD_1IN54_V2_TurnOnDisplayPart();
 }
 
@@ -376,7 +322,5 @@ parameter:
 ******************************************************************************/
 void EPD_1IN54_V2_Sleep(void)
 {
-    EPD_1IN54_V2_SendCommand(0x10); //enter deep sleep
-    EPD_1IN54_V2_SendData(0x01);
-    DEV_Delay_ms(100);
+    EPD_Panel_Sleep(&EPD_1IN54_V2_Panel);
 }
@@ -31,11 +31,15 @@
 #define __EPD_1IN54_V2_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
+#include "EPD_Panel.h"
 
 // Display resolution
 #define EPD_1IN54_V2_WIDTH       200
 #define EPD_1IN54_V2_HEIGHT      200
 
+extern const EPD_PANEL EPD_1IN54_V2_Panel;
+
 void EPD_1IN54_V2_Init(void);
 void EPD_1IN54_V2_Init_Partial(void);
 void EPD_1IN54_V2_Clear(void);
@@ -44,4 +48,6 @@ void EPD_1IN54_V2_DisplayPartBaseImage(UBYTE *Image);
 void EPD_1IN54_V2_DisplayPart(UBYTE *Image);
 void EPD_1IN54_V2_Sleep(void);
 
+EPD_MODEL(EPD_1IN54_V2, 1, 1);
+
 #endif
@@ -92,6 +92,7 @@
 #
 ******************************************************************************/
 #include "EPD_1in54b.h"
+#include "EPD_Common.h"
 #include "Debug.h"
 
 const unsigned char EPD_1IN54B_lut_vcom0[] = {0x0E, 0x14, 0x01, 0x0A, 0x06, 0x04, 0x0A, 0x0A, 0x0F, 0x03, 0x03, 0x0C, 0x06, 0x0A, 0x00};
@@ -109,6 +110,7 @@ parameter:
 ******************************************************************************/
 static void EPD_1IN54B_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(100);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -124,10 +126,7 @@ parameter:
 ******************************************************************************/
 static void EPD_1IN54B_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -137,10 +136,7 @@ parameter:
 ******************************************************************************/
 static void EPD_1IN54B_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -150,10 +146,7 @@ parameter:
 static void EPD_1IN54B_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-    while(1) {
-        if(DEV_Digital_Read(EPD_BUSY_PIN) == 1)
-            break;
-    }
+    DEV_Wait_Busy(1, EPD_BUSY_TIMEOUT_MS);
     DEV_Delay_ms(200);
     Debug("e-Paper busy release\r\n");
 }
@@ -164,27 +157,16 @@ parameter:
 ******************************************************************************/
 static void EPD_1IN54B_SetLutBw(void)
 {
-    UWORD count;
     EPD_1IN54B_SendCommand(0x20);// g vcom
-    for(count = 0; count < 15; count++) {
-        EPD_1IN54B_SendData(EPD_1IN54B_lut_vcom0[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_1IN54B_lut_vcom0, 15);
     EPD_1IN54B_SendCommand(0x21);// g ww --
-    for(count = 0; count < 15; count++) {
-        EPD_1IN54B_SendData(EPD_1IN54B_lut_w[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_1IN54B_lut_w, 15);
     EPD_1IN54B_SendCommand(0x22);// g bw r
-    for(count = 0; count < 15; count++) {
-        EPD_1IN54B_SendData(EPD_1IN54B_lut_b[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_1IN54B_lut_b, 15);
     EPD_1IN54B_SendCommand(0x23);// g wb w
-    for(count = 0; count < 15; count++) {
-        EPD_1IN54B_SendData(EPD_1IN54B_lut_g1[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_1IN54B_lut_g1, 15);
     EPD_1IN54B_SendCommand(0x24);// g bb b
-    for(count = 0; count < 15; count++) {
-        EPD_1IN54B_SendData(EPD_1IN54B_lut_g2[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_1IN54B_lut_g2, 15);
 }
 
 /******************************************************************************
@@ -193,19 +175,12 @@ parameter:
 ******************************************************************************/
 static void EPD_1IN54B_SetLutRed(void)
 {
-    UWORD count;
     EPD_1IN54B_SendCommand(0x25);
-    for(count = 0; count < 15; count++) {
-        EPD_1IN54B_SendData(EPD_1IN54B_lut_vcom1[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_1IN54B_lut_vcom1, 15);
     EPD_1IN54B_SendCommand(0x26);
-    for(count = 0; count < 15; count++) {
-        EPD_1IN54B_SendData(EPD_1IN54B_lut_red0[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_1IN54B_lut_red0, 15);
     EPD_1IN54B_SendCommand(0x27);
-    for(count = 0; count < 15; count++) {
-        EPD_1IN54B_SendData(EPD_1IN54B_lut_red1[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_1IN54B_lut_red1, 15);
 }
 
 /******************************************************************************
@@ -259,22 +234,13 @@ void EPD_1IN54B_Clear(void)
     //send black data
     EPD_1IN54B_SendCommand(0x10);// DATA_START_TRANSMISSION_1
     DEV_Delay_ms(2);
-    for(UWORD i = 0; i < Height; i++) {
-        for(UWORD i = 0; i < Width; i++) {
-            EPD_1IN54B_SendData(0xFF);
-            EPD_1IN54B_SendData(0xFF);
-        }
-    }
+    EPD_Common_SendDataRepeat(0xFF, Width * Height * 2);
     DEV_Delay_ms(2);
 
     //send red data
     EPD_1IN54B_SendCommand(0x13);// DATA_START_TRANSMISSION_2
     DEV_Delay_ms(2);
-    for(UWORD i = 0; i < Height; i++) {
-        for(UWORD i = 0; i < Width; i++) {
-            EPD_1IN54B_SendData(0xFF);
-        }
-    }
+    EPD_Common_SendDataRepeat(0xFF, Width * Height);
     DEV_Delay_ms(2);
 
     EPD_1IN54B_SendCommand(0x12);// DISPLAY_REFRESH
@@ -288,12 +254,14 @@ parameter:
 void EPD_1IN54B_Display(const UBYTE *blackimage, const UBYTE *redimage)
 {
     UBYTE Temp = 0x00;
+    UBYTE Row[EPD_1IN54B_WIDTH / 4 + 2];
     UWORD Width, Height;
     Width = (EPD_1IN54B_WIDTH % 8 == 0)? (EPD_1IN54B_WIDTH / 8 ): (EPD_1IN54B_WIDTH / 8 + 1);
     Height = EPD_1IN54B_HEIGHT;
 
     EPD_1IN54B_SendCommand(0x10);// DATA_START_TRANSMISSION_1
     for (UWORD j = 0; j < Height; j++) {
+        // 1bpp -> 2bpp, one row at a time so it goes out as one burst
         for (UWORD i = 0; i < Width; i++) {
             Temp = 0x00;
             for (int bit = 0; bit < 4; bit++) {
@@ -301,24 +269,21 @@ void EPD_1IN54B_Display(const UBYTE *blackimage, const UBYTE *redimage)
                     Temp |= 0xC0 >> (bit * 2);
                 }
             }
-            EPD_1IN54B_SendData(Temp);
+            Row[2 * i] = Temp;
             Temp = 0x00;
             for (int bit = 4; bit < 8; bit++) {
                 if ((blackimage[i + j * Width] & (0x80 >> bit)) != 0) {
                     Temp |= 0xC0 >> ((bit - 4) * 2);
                 }
             }
-            EPD_1IN54B_SendData(Temp);
+            Row[2 * i + 1] = Temp;
         }
+        EPD_Common_SendDataBuffer(Row, Width * 2);
     }
     DEV_Delay_ms(2);
 
     EPD_1IN54B_SendCommand(0x13);// DATA_START_TRANSMISSION_2
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_1IN54B_SendData(redimage[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(redimage, Width * Height);
     DEV_Delay_ms(2);
 
     //Display refresh
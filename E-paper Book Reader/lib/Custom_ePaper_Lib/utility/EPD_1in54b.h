@@ -95,6 +95,7 @@
 #define __EPD_1IN54B_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_1IN54B_WIDTH       200
@@ -105,4 +106,6 @@ void EPD_1IN54B_Clear(void);
 void EPD_1IN54B_Display(const UBYTE *blackimage, const UBYTE *redimage);
 void EPD_1IN54B_Sleep(void);
 
+EPD_MODEL(EPD_1IN54B, 2, 1);
+
 #endif
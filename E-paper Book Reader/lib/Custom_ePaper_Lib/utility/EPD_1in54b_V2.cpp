@@ -29,63 +29,49 @@
 #
 ******************************************************************************/
 #include "EPD_1in54b_V2.h"
-#include "Debug.h"
-
-/******************************************************************************
-function :	Software reset
-parameter:
-******************************************************************************/
-static void EPD_1IN54B_V2_Reset(void)
-{
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(100);
-    DEV_Digital_Write(EPD_RST_PIN, 0);
-    DEV_Delay_ms(10);
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(100);
-}
-
-/******************************************************************************
-function :	send command
-parameter:
-     Reg : Command register
-******************************************************************************/
-static void EPD_1IN54B_V2_SendCommand(UBYTE Reg)
-{
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
-}
-
-/******************************************************************************
-function :	send data
-parameter:
-    Data : Write data
-******************************************************************************/
-static void EPD_1IN54B_V2_SendData(UBYTE Data)
-{
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
-}
-
-/******************************************************************************
-function :	Wait until the busy_pin goes LOW
-parameter:
-******************************************************************************/
-static void EPD_1IN54B_V2_ReadBusy(void)
-{
-    Debug("e-Paper busy\r\n");
-    while(1) {
-        if(DEV_Digital_Read(EPD_BUSY_PIN) == 0)
-            break;
-    }
-    DEV_Delay_ms(200);
-    Debug("e-Paper busy release\r\n");
-}
-
+#include "EPD_Panel.h"
+
+static const UBYTE EPD_1IN54B_V2_Init_Script[] = {
+    EPD_RESET(100, 10, 100),
+    EPD_BUSY,
+    EPD_CMD(0x12, 0),                   //SWRESET
+    EPD_BUSY,
+    EPD_CMD(0x01, 3), 0xC7, 0x00, 0x01, //Driver output control
+    EPD_CMD(0x11, 1), 0x01,             //data entry mode
+    EPD_CMD(0x44, 2), 0x00, 0x18,       //set Ram-X address start/end position, 0x18-->(24+1)*8=200
+    EPD_CMD(0x45, 4), 0xC7, 0x00, 0x00, 0x00, //set Ram-Y address start/end position, 0xC7-->(199+1)=200
+    EPD_CMD(0x3C, 1), 0x05,             //BorderWavefrom
+    EPD_CMD(0x18, 1), 0x80,             //Read built-in temperature sensor
+    EPD_CMD(0x4E, 1), 0x00,             //set RAM x address count to 0
+    EPD_CMD(0x4F, 2), 0xC7, 0x00,       //set RAM y address count to 0X199
+    EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_1IN54B_V2_Refresh_Script[] = {
+    EPD_CMD(0x22, 1), 0xF7,             //Display Update Control
+    EPD_CMD(0x20, 0),                   //Activate Display Update Sequence
+    EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_1IN54B_V2_Sleep_Script[] = {
+    EPD_CMD(0x10, 1), 0x01,             //enter deep sleep
+    EPD_DELAY(100),
+    EPD_END
+};
+
+const EPD_PANEL EPD_1IN54B_V2_Panel = {
+    "EPD_1IN54B_V2", EPD_1IN54B_V2_WIDTH, EPD_1IN54B_V2_HEIGHT,
+    2, {
+        { 0x24, EPD_PLANE_IMAGE0, 0, 0xFF, 0 },   //black
+        { 0x26, EPD_PLANE_IMAGE1, 1, 0x00, 0 },   //red, 1 = red
+    },
+    0, 0, 0, 0, 200,
+    EPD_1IN54B_V2_Init_Script, EPD_1IN54B_V2_Refresh_Script, EPD_1IN54B_V2_Sleep_Script,
+    EPD_CAP_RED,
+    NULL, NULL,
+};
 
 /******************************************************************************
 function :	Initialize the e-Paper register
@@ -93,42 +79,7 @@ parameter:
 ******************************************************************************/
 void EPD_1IN54B_V2_Init(void)
 {
-    EPD_1IN54B_V2_Reset();
-
-    EPD_1IN54B_V2_ReadBusy();   
-    EPD_1IN54B_V2_SendCommand(0x12);  //SWRESET
-    EPD_1IN54B_V2_ReadBusy();   
-
-    EPD_1IN54B_V2_SendCommand(0x01); //Driver output control      
-    EPD_1IN54B_V2_SendData(0xC7);
-    EPD_1IN54B_V2_SendData(0x00);
-    EPD_1IN54B_V2_SendData(0x01);
-
-    EPD_1IN54B_V2_SendCommand(0x11); //data entry mode       
-    EPD_1IN54B_V2_SendData(0x01);
-
-    EPD_1IN54B_V2_SendCommand(0x44); //set Ram-X address start/end position   
-    EPD_1IN54B_V2_SendData(0x00);
-    EPD_1IN54B_V2_SendData(0x18);    //0x18-->(24+1)*8=200
-
-    EPD_1IN54B_V2_SendCommand(0x45); //set Ram-Y address start/end position          
-    EPD_1IN54B_V2_SendData(0xC7);    //0xC7-->(199+1)=200
-    EPD_1IN54B_V2_SendData(0x00);
-    EPD_1IN54B_V2_SendData(0x00);
-    EPD_1IN54B_V2_SendData(0x00); 
-
-    EPD_1IN54B_V2_SendCommand(0x3C); //BorderWavefrom
-    EPD_1IN54B_V2_SendData(0x05);
-
-    EPD_1IN54B_V2_SendCommand(0x18); //Read built-in temperature sensor
-    EPD_1IN54B_V2_SendData(0x80);
-
-    EPD_1IN54B_V2_SendCommand(0x4E);   // set RAM x address count to 0;
-    EPD_1IN54B_V2_SendData(0x00);
-    EPD_1IN54B_V2_SendCommand(0x4F);   // set RAM y address count to 0X199;    
-    EPD_1IN54B_V2_SendData(0xC7);
-    EPD_1IN54B_V2_SendData(0x00);
-    EPD_1IN54B_V2_ReadBusy();
+    EPD_Panel_Init(&EPD_1IN54B_V2_Panel);
 }
 
 /******************************************************************************
@@ -137,22 +88,7 @@ parameter:
 ******************************************************************************/
 void EPD_1IN54B_V2_Clear(void)
 {
-    
-    unsigned int i;	
-    EPD_1IN54B_V2_SendCommand(0x24);   //write RAM for black(0)/white (1)
-    for(i=0;i<5000;i++)
-    {               
-        EPD_1IN54B_V2_SendData(0xff);
-    }
-    EPD_1IN54B_V2_SendCommand(0x26);   //write RAM for black(0)/white (1)
-    for(i=0;i<5000;i++)
-    {               
-        EPD_1IN54B_V2_SendData(0x00);
-    }
-    EPD_1IN54B_V2_SendCommand(0x22); //Display Update Control
-    EPD_1IN54B_V2_SendData(0xF7);   
-    EPD_1IN54B_V2_SendCommand(0x20);  //Activate Display Update Sequence
-    EPD_1IN54B_V2_ReadBusy();   
+    EPD_Panel_Clear(&EPD_1IN54B_V2_Panel);
 }
 
 /******************************************************************************
@@ -161,25 +97,18 @@ parameter:
 ******************************************************************************/
 void EPD_1IN54B_V2_Display(const UBYTE *blackimage, const UBYTE *redimage)
 {
-    UWORD Width, Height;
-    Width = (EPD_1IN54B_V2_WIDTH % 8 == 0)? (EPD_1IN54B_V2_WIDTH / 8 ): (EPD_1IN54B_V2_WIDTH / 8 + 1);
-    Height = EPD_1IN54B_V2_HEIGHT;
+    EPD_Panel_Display(&EPD_1IN54B_V2_Panel, blackimage, redimage);
+}
 
-     unsigned int i;	
-    EPD_1IN54B_V2_SendCommand(0x24);   //write RAM for black(0)/white (1)
-    for(i=0;i<Width*Height;i++)
-    {               
-        EPD_1IN54B_V2_SendData(blackimage[i]);
-    }
-    EPD_1IN54B_V2_SendCommand(0x26);   //write RAM for black(0)/white (1)
-    for(i=0;i<Width*Height;i++)
-    {               
-        EPD_1IN54B_V2_SendData(~redimage[i]);
-    }
-    EPD_1IN54B_V2_SendCommand(0x22); //Display Update Control
-    EPD_1IN54B_V2_SendData(0xF7);   
-    EPD_1IN54B_V2_SendCommand(0x20);  //Activate Display Update Sequence
-    EPD_1IN54B_V2_ReadBusy();   
+/******************************************************************************
+function :	Sends a 3 color picture to e-Paper and displays
+parameter:
+    Image : the black plane then the red plane, drawn with
+            Paint_SetColorPlanes(Ctx, EPD_1IN54B_V2_COLOR)
+******************************************************************************/
+void EPD_1IN54B_V2_Display_Planes(const UBYTE *Image)
+{
+    EPD_Panel_Display_Planes(&EPD_1IN54B_V2_Panel, Image);
 }
 
 /******************************************************************************
@@ -188,7 +117,5 @@ parameter:
 ******************************************************************************/
 void EPD_1IN54B_V2_Sleep(void)
 {
-    EPD_1IN54B_V2_SendCommand(0x10); //enter deep sleep
-    EPD_1IN54B_V2_SendData(0x01); 
-    DEV_Delay_ms(100);
+    EPD_Panel_Sleep(&EPD_1IN54B_V2_Panel);
 }
@@ -32,14 +32,22 @@
 #define __EPD_1IN54B_V2_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
+#include "EPD_Panel.h"
 
 // Display resolution
 #define EPD_1IN54B_V2_WIDTH       200
 #define EPD_1IN54B_V2_HEIGHT      200
+#define EPD_1IN54B_V2_COLOR       EPD_Color_RedHigh    //3 color planes, see Paint_SetColorPlanes()
+
+extern const EPD_PANEL EPD_1IN54B_V2_Panel;
 
 void EPD_1IN54B_V2_Init(void);
 void EPD_1IN54B_V2_Clear(void);
 void EPD_1IN54B_V2_Display(const UBYTE *blackimage, const UBYTE *redimage);
+void EPD_1IN54B_V2_Display_Planes(const UBYTE *Image);
 void EPD_1IN54B_V2_Sleep(void);
 
+EPD_MODEL(EPD_1IN54B_V2, 2, 1);
+
 #endif
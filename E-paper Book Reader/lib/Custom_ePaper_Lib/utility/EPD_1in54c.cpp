@@ -79,62 +79,57 @@
 #
 ******************************************************************************/
 #include "EPD_1in54c.h"
-#include "Debug.h"
-
-/******************************************************************************
-function :	Software reset
-parameter:
-******************************************************************************/
-static void EPD_1IN54C_Reset(void)
-{
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(10);
-    DEV_Digital_Write(EPD_RST_PIN, 0);
-    DEV_Delay_ms(10);
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(10);
-}
-
-/******************************************************************************
-function :	send command
-parameter:
-     Reg : Command register
-******************************************************************************/
-static void EPD_1IN54C_SendCommand(UBYTE Reg)
-{
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
-}
-
-/******************************************************************************
-function :	send data
-parameter:
-    Data : Write data
-******************************************************************************/
-static void EPD_1IN54C_SendData(UBYTE Data)
-{
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
-}
-
-/******************************************************************************
-function :	Wait until the busy_pin goes LOW
-parameter:
-******************************************************************************/
-static void EPD_1IN54C_ReadBusy(void)
-{
-    unsigned char busy;
-    do {
-        EPD_1IN54C_SendCommand(0x71);
-        busy = DEV_Digital_Read(EPD_BUSY_PIN);
-        busy =!(busy & 0x01);
-    } while(busy);
-    DEV_Delay_ms(200);
-}
+#include "EPD_Panel.h"
+
+static const UBYTE EPD_1IN54C_Init_Script[] = {
+    EPD_RESET(10, 10, 10),
+    EPD_CMD(0x06, 3), 0x17, 0x17, 0x17, //boost soft start
+    EPD_CMD(0x04, 0),                   //power on
+    EPD_BUSY,
+    EPD_CMD(0x00, 2), 0x0f, 0x0d,       //panel setting, LUT from OTP, VCOM to 0V fast
+    EPD_CMD(0x61, 3), 0x98, 0x00, 0x98, //resolution setting, 152 x 152
+    EPD_CMD(0x50, 1), 0x77,             //VCOM AND DATA INTERVAL SETTING
+                                        //WBmode:VBDF 17|D7 VBDW 97 VBDB 57
+                                        //WBRmode:VBDF F7 VBDW 77 VBDB 37  VBDR B7
+    EPD_END
+};
+
+static const UBYTE EPD_1IN54C_Refresh_Script[] = {
+    EPD_CMD(0x12, 0),                   //Display refresh
+    EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_1IN54C_Sleep_Script[] = {
+    EPD_CMD(0x02, 0),                   //POWER_OFF
+    EPD_BUSY,
+    EPD_CMD(0x07, 1), 0xA5,             //DEEP_SLEEP, check code
+    EPD_END
+};
+
+static const UBYTE EPD_1IN54C_PowerOff_Script[] = {
+    EPD_CMD(0x02, 0),                   //POWER_OFF
+    EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_1IN54C_PowerOn_Script[] = {
+    EPD_CMD(0x04, 0),                   //POWER_ON
+    EPD_BUSY,
+    EPD_END
+};
+
+const EPD_PANEL EPD_1IN54C_Panel = {
+    "EPD_1IN54C", EPD_1IN54C_WIDTH, EPD_1IN54C_HEIGHT,
+    2, {
+        { 0x10, EPD_PLANE_IMAGE0, 0, 0xFF, 0 },   //black
+        { 0x13, EPD_PLANE_IMAGE1, 0, 0xFF, 0 },   //red, 0 = red
+    },
+    0, 0, 1, 0x71, 200,
+    EPD_1IN54C_Init_Script, EPD_1IN54C_Refresh_Script, EPD_1IN54C_Sleep_Script,
+    EPD_CAP_RED,
+    EPD_1IN54C_PowerOff_Script, EPD_1IN54C_PowerOn_Script,
+};
 
 /******************************************************************************
 function :	Initialize the e-Paper register
@@ -142,27 +137,7 @@ parameter:
 ******************************************************************************/
 void EPD_1IN54C_Init(void)
 {
-    EPD_1IN54C_Reset();
-
-    EPD_1IN54C_SendCommand(0x06); //boost soft start
-    EPD_1IN54C_SendData(0x17);
-    EPD_1IN54C_SendData(0x17);
-    EPD_1IN54C_SendData(0x17);
-    EPD_1IN54C_SendCommand(0x04);
-
-    EPD_1IN54C_ReadBusy();
-
-    EPD_1IN54C_SendCommand(0x00); //panel setting
-    EPD_1IN54C_SendData(0x0f); //LUT from OTP160x296
-    EPD_1IN54C_SendData(0x0d); //VCOM to 0V fast
-
-    EPD_1IN54C_SendCommand(0x61); //resolution setting
-    EPD_1IN54C_SendData(0x98); //152
-    EPD_1IN54C_SendData(0x00); //152
-    EPD_1IN54C_SendData(0x98);
-
-    EPD_1IN54C_SendCommand(0X50); //VCOM AND DATA INTERVAL SETTING
-    EPD_1IN54C_SendData(0x77); //WBmode:VBDF 17|D7 VBDW 97 VBDB 57		WBRmode:VBDF F7 VBDW 77 VBDB 37  VBDR B7
+    EPD_Panel_Init(&EPD_1IN54C_Panel);
 }
 
 /******************************************************************************
@@ -171,29 +146,7 @@ parameter:
 ******************************************************************************/
 void EPD_1IN54C_Clear(void)
 {
-    UWORD Width, Height;
-    Width = (EPD_1IN54C_WIDTH % 8 == 0)? (EPD_1IN54C_WIDTH / 8 ): (EPD_1IN54C_WIDTH / 8 + 1);
-    Height = EPD_1IN54C_HEIGHT;
-
-    //send black data
-    EPD_1IN54C_SendCommand(0x10);
-    for(UWORD i = 0; i < Height; i++) {
-        for(UWORD i = 0; i < Width; i++) {
-            EPD_1IN54C_SendData(0xFF);
-        }
-    }
-
-    //send red data
-    EPD_1IN54C_SendCommand(0x13);
-    for(UWORD i = 0; i < Height; i++) {
-        for(UWORD i = 0; i < Width; i++) {
-            EPD_1IN54C_SendData(0xFF);
-        }
-    }
-
-    //Display refresh
-    EPD_1IN54C_SendCommand(0x12);
-    EPD_1IN54C_ReadBusy();
+    EPD_Panel_Clear(&EPD_1IN54C_Panel);
 }
 
 /******************************************************************************
@@ -202,29 +155,18 @@ parameter:
 ******************************************************************************/
 void EPD_1IN54C_Display(const UBYTE *blackimage, const UBYTE *redimage)
 {
-    UWORD Width, Height;
-    Width = (EPD_1IN54C_WIDTH % 8 == 0)? (EPD_1IN54C_WIDTH / 8 ): (EPD_1IN54C_WIDTH / 8 + 1);
-    Height = EPD_1IN54C_HEIGHT;
-
-    //send black data
-    EPD_1IN54C_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_1IN54C_SendData(blackimage[i + j * Width]);
-        }
-    }
-
-    //send red data
-    EPD_1IN54C_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_1IN54C_SendData(redimage[i + j * Width]);
-        }
-    }
+    EPD_Panel_Display(&EPD_1IN54C_Panel, blackimage, redimage);
+}
 
-    //Display refresh
-    EPD_1IN54C_SendCommand(0x12);
-    EPD_1IN54C_ReadBusy();
+/******************************************************************************
+function :	Sends a 3 color picture to e-Paper and displays
+parameter:
+    Image : the black plane then the red plane, drawn with
+            Paint_SetColorPlanes(Ctx, EPD_1IN54C_COLOR)
+******************************************************************************/
+void EPD_1IN54C_Display_Planes(const UBYTE *Image)
+{
+    EPD_Panel_Display_Planes(&EPD_1IN54C_Panel, Image);
 }
 
 /******************************************************************************
@@ -233,8 +175,5 @@ parameter:
 ******************************************************************************/
 void EPD_1IN54C_Sleep(void)
 {
-    EPD_1IN54C_SendCommand(0X02);  	//power off
-    EPD_1IN54C_ReadBusy();
-    EPD_1IN54C_SendCommand(0X07);  	//deep sleep
-    EPD_1IN54C_SendData(0xA5);
+    EPD_Panel_Sleep(&EPD_1IN54C_Panel);
 }
@@ -82,14 +82,22 @@
 #define __EPD_1IN54C_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
+#include "EPD_Panel.h"
 
 // Display resolution
 #define EPD_1IN54C_WIDTH       152
 #define EPD_1IN54C_HEIGHT      152
+#define EPD_1IN54C_COLOR       EPD_Color_RedLow    //3 color planes, see Paint_SetColorPlanes()
+
+extern const EPD_PANEL EPD_1IN54C_Panel;
 
 void EPD_1IN54C_Init(void);
 void EPD_1IN54C_Clear(void);
 void EPD_1IN54C_Display(const UBYTE *blackimage, const UBYTE *redimage);
+void EPD_1IN54C_Display_Planes(const UBYTE *Image);
 void EPD_1IN54C_Sleep(void);
 
+EPD_MODEL(EPD_1IN54C, 2, 1);
+
 #endif
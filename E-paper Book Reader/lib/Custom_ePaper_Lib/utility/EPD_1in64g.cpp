@@ -28,6 +28,7 @@
 #
 ******************************************************************************/
 #include "EPD_1in64g.h"
+#include "EPD_Common.h"
 #include "Debug.h"
 
 /******************************************************************************
@@ -36,6 +37,7 @@ parameter:
 ******************************************************************************/
 static void EPD_1IN64G_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(20);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -51,10 +53,7 @@ parameter:
 ******************************************************************************/
 static void EPD_1IN64G_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -64,10 +63,7 @@ parameter:
 ******************************************************************************/
 static void EPD_1IN64G_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -77,9 +73,7 @@ parameter:
 static void EPD_1IN64G_ReadBusyH(void)
 {
     Debug("e-Paper busy H\r\n");
-    while(!DEV_Digital_Read(EPD_BUSY_PIN)) {      //LOW: idle, HIGH: busy
-        DEV_Delay_ms(5);
-    }
+    DEV_Wait_Busy(1, EPD_BUSY_TIMEOUT_MS);
     Debug("e-Paper busy H release\r\n");
 }
 
@@ -176,11 +170,7 @@ void EPD_1IN64G_Clear(UBYTE color)
     EPD_1IN64G_ReadBusyH();
 
     EPD_1IN64G_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-                EPD_1IN64G_SendData((color << 6) | (color << 4) | (color << 2) | color);
-        }
-    }
+    EPD_Common_SendDataRepeat((color << 6) | (color << 4) | (color << 2) | color, Width * Height);
 
     EPD_1IN64G_SendCommand(0x68);
     EPD_1IN64G_SendData(0x00);
@@ -205,11 +195,7 @@ void EPD_1IN64G_Display(UBYTE *Image)
     EPD_1IN64G_ReadBusyH();
 
     EPD_1IN64G_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_1IN64G_SendData(Image[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(Image, Width * Height);
     
     EPD_1IN64G_SendCommand(0x68);
     EPD_1IN64G_SendData(0x00);
@@ -13,6 +13,7 @@
 #define __EPD_1IN64G_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_1IN64G_WIDTH       168
@@ -29,4 +30,6 @@ void EPD_1IN64G_Clear(UBYTE color);
 void EPD_1IN64G_Display(UBYTE *Image);
 void EPD_1IN64G_Sleep(void);
 
+EPD_MODEL(EPD_1IN64G, 1, 2);
+
 #endif
@@ -49,6 +49,7 @@
 #
 ******************************************************************************/
 #include "EPD_2in13.h"
+#include "EPD_Common.h"
 #include "Debug.h"
 
 const unsigned char EPD_2IN13_lut_full_update[] = {
@@ -70,6 +71,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN13_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(200);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -85,10 +87,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN13_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -98,10 +97,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN13_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -111,9 +107,7 @@ parameter:
 void EPD_2IN13_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-    while(DEV_Digital_Read(EPD_BUSY_PIN) == 1) {      //LOW: idle, HIGH: busy
-        DEV_Delay_ms(100);
-    }
+    DEV_Wait_Busy(0, EPD_BUSY_TIMEOUT_MS);
     Debug("e-Paper busy release\r\n");
 }
 
@@ -133,6 +127,8 @@ static void EPD_2IN13_TurnOnDisplay(void)
 
 static void EPD_2IN13_SetWindows(int x_start, int y_start, int x_end, int y_end)
 {
+    if(EPD_State_Window(x_start, y_start, x_end, y_end))
+        return;
     EPD_2IN13_SendCommand(0x44);
     /* x point must be the multiple of 8 or the last 3 bits will be ignored */
     EPD_2IN13_SendData((x_start >> 3) & 0xFF);
@@ -191,13 +187,9 @@ void EPD_2IN13_Init(UBYTE Mode)
     //set the look-up table register
     EPD_2IN13_SendCommand(0x32);
     if(Mode == EPD_2IN13_FULL) {
-        for (UWORD i = 0; i < 30; i++) {
-            EPD_2IN13_SendData(EPD_2IN13_lut_full_update[i]);
-        }
+        EPD_Common_SendDataBuffer(EPD_2IN13_lut_full_update, 30);
     } else if(Mode == EPD_2IN13_PART) {
-        for (UWORD i = 0; i < 30; i++) {
-            EPD_2IN13_SendData(EPD_2IN13_lut_partial_update[i]);
-        }
+        EPD_Common_SendDataBuffer(EPD_2IN13_lut_partial_update, 30);
     } else {
         Debug("error, the Mode is EPD_2IN13_FULL or EPD_2IN13_PART");
     }
@@ -216,9 +208,7 @@ void EPD_2IN13_Clear(void)
     for (UWORD j = 0; j < Height; j++) {
         EPD_2IN13_SetCursor(0, j);
         EPD_2IN13_SendCommand(0x24);
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13_SendData(0Xff);
-        }
+        EPD_Common_SendDataRepeat(0Xff, Width);
     }
     EPD_2IN13_TurnOnDisplay();
 }
@@ -237,9 +227,7 @@ void EPD_2IN13_Display(UBYTE *Image)
     for (UWORD j = 0; j < Height; j++) {
         EPD_2IN13_SetCursor(0, j);
         EPD_2IN13_SendCommand(0x24);
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13_SendData(Image[i + j * Width]);
-        }
+        EPD_Common_SendDataBuffer(Image + j * Width, Width);
     }
     EPD_2IN13_TurnOnDisplay();
 }
@@ -52,6 +52,7 @@
 #define _EPD2IN13_H
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_2IN13_WIDTH       122
@@ -65,4 +66,6 @@ void EPD_2IN13_Clear(void);
 void EPD_2IN13_Display(UBYTE *Image);
 void EPD_2IN13_Sleep(void);
 
+EPD_MODEL(EPD_2IN13, 1, 1);
+
 #endif
@@ -51,6 +51,8 @@
 #
 ******************************************************************************/
 #include "EPD_2in13_V2.h"
+#include "EPD_Common.h"
+#include "EPD_Panel.h"
 #include "Debug.h"
 
 const unsigned char EPD_2IN13_V2_lut_full_update[]= {
@@ -94,6 +96,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN13_V2_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(200);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -109,10 +112,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN13_V2_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -122,10 +122,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN13_V2_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -135,9 +132,7 @@ parameter:
 void EPD_2IN13_V2_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-    while(DEV_Digital_Read(EPD_BUSY_PIN) == 1) {      //LOW: idle, HIGH: busy
-        DEV_Delay_ms(100);
-    }
+    DEV_Wait_Busy(0, EPD_BUSY_TIMEOUT_MS);
     Debug("e-Paper busy release\r\n");
 }
 
@@ -164,83 +159,74 @@ static void EPD_2IN13_V2_TurnOnDisplayPart(void)
     EPD_2IN13_V2_SendCommand(0x20);
     EPD_2IN13_V2_ReadBusy();
 }
+static const UBYTE EPD_2IN13_V2_Init_Script[] = {
+    EPD_RESET(200, 10, 200),
+    EPD_BUSY,
+    EPD_CMD(0x12, 0),               //soft reset
+    EPD_BUSY,
+    EPD_CMD(0x74, 1), 0x54,         //set analog block control
+    EPD_CMD(0x7E, 1), 0x3B,         //set digital block control
+    EPD_CMD(0x01, 3), 0xF9, 0x00, 0x00, //Driver output control
+    EPD_CMD(0x11, 1), 0x01,         //data entry mode
+    EPD_WINDOW(EPD_RAM_YDEC),
+    EPD_CMD(0x3C, 1), 0x03,         //BorderWavefrom
+    EPD_CMD(0x2C, 1), 0x55,         //VCOM Voltage
+    EPD_LUT(0x03, 70, 1),
+    EPD_LUT(0x04, 71, 3),
+    EPD_LUT(0x3A, 74, 1),           //Dummy Line
+    EPD_LUT(0x3B, 75, 1),           //Gate time
+    EPD_LUT(0x32, 0, 70),
+    EPD_CURSOR(EPD_RAM_YDEC),
+    EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_2IN13_V2_Refresh_Script[] = {
+    EPD_CMD(0x22, 1), 0xC7,
+    EPD_CMD(0x20, 0),
+    EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_2IN13_V2_Sleep_Script[] = {
+    EPD_CMD(0x22, 1), 0xC3,         //POWER OFF
+    EPD_CMD(0x20, 0),
+    EPD_CMD(0x10, 1), 0x01,         //enter deep sleep
+    EPD_DELAY(100),
+    EPD_END
+};
+
+const EPD_PANEL EPD_2IN13_V2_Panel = {
+    "EPD_2IN13_V2", EPD_2IN13_V2_WIDTH, EPD_2IN13_V2_HEIGHT,
+    1, {
+        { 0x24, EPD_PLANE_IMAGE0, 0, 0xFF, 0 },
+    },
+    0, 0, 0, 0, 0,
+    EPD_2IN13_V2_Init_Script, EPD_2IN13_V2_Refresh_Script, EPD_2IN13_V2_Sleep_Script,
+    EPD_CAP_PARTIAL,
+    NULL, NULL,                     //the analog supply is switched by each update sequence, no STANDBY
+    EPD_2IN13_V2_lut_full_update,
+};
+
 /******************************************************************************
 function :	Initialize the e-Paper register
 parameter:
+    Mode : EPD_2IN13_V2_FULL or EPD_2IN13_V2_PART
 ******************************************************************************/
 void EPD_2IN13_V2_Init(UBYTE Mode)
 {
-    UBYTE count;
-    EPD_2IN13_V2_Reset();
-
     if(Mode == EPD_2IN13_V2_FULL) {
-        EPD_2IN13_V2_ReadBusy();
-        EPD_2IN13_V2_SendCommand(0x12); // soft reset
-        EPD_2IN13_V2_ReadBusy();
-
-        EPD_2IN13_V2_SendCommand(0x74); //set analog block control
-        EPD_2IN13_V2_SendData(0x54);
-        EPD_2IN13_V2_SendCommand(0x7E); //set digital block control
-        EPD_2IN13_V2_SendData(0x3B);
-
-        EPD_2IN13_V2_SendCommand(0x01); //Driver output control
-        EPD_2IN13_V2_SendData(0xF9);
-        EPD_2IN13_V2_SendData(0x00);
-        EPD_2IN13_V2_SendData(0x00);
-
-        EPD_2IN13_V2_SendCommand(0x11); //data entry mode
-        EPD_2IN13_V2_SendData(0x01);
-
-        EPD_2IN13_V2_SendCommand(0x44); //set Ram-X address start/end position
-        EPD_2IN13_V2_SendData(0x00);
-        EPD_2IN13_V2_SendData(0x0F);    //0x0C-->(15+1)*8=128
-
-        EPD_2IN13_V2_SendCommand(0x45); //set Ram-Y address start/end position
-        EPD_2IN13_V2_SendData(0xF9);   //0xF9-->(249+1)=250
-        EPD_2IN13_V2_SendData(0x00);
-        EPD_2IN13_V2_SendData(0x00);
-        EPD_2IN13_V2_SendData(0x00);
-
-        EPD_2IN13_V2_SendCommand(0x3C); //BorderWavefrom
-        EPD_2IN13_V2_SendData(0x03);
-
-        EPD_2IN13_V2_SendCommand(0x2C); //VCOM Voltage
-        EPD_2IN13_V2_SendData(0x55); //
-
-        EPD_2IN13_V2_SendCommand(0x03);
-        EPD_2IN13_V2_SendData(EPD_2IN13_V2_lut_full_update[70]);
-
-        EPD_2IN13_V2_SendCommand(0x04); //
-        EPD_2IN13_V2_SendData(EPD_2IN13_V2_lut_full_update[71]);
-        EPD_2IN13_V2_SendData(EPD_2IN13_V2_lut_full_update[72]);
-        EPD_2IN13_V2_SendData(EPD_2IN13_V2_lut_full_update[73]);
-
-        EPD_2IN13_V2_SendCommand(0x3A);     //Dummy Line
-        EPD_2IN13_V2_SendData(EPD_2IN13_V2_lut_full_update[74]);
-        EPD_2IN13_V2_SendCommand(0x3B);     //Gate time
-        EPD_2IN13_V2_SendData(EPD_2IN13_V2_lut_full_update[75]);
-
-        EPD_2IN13_V2_SendCommand(0x32);
-        for(count = 0; count < 70; count++) {
-            EPD_2IN13_V2_SendData(EPD_2IN13_V2_lut_full_update[count]);
-        }
-
-        EPD_2IN13_V2_SendCommand(0x4E);   // set RAM x address count to 0;
-        EPD_2IN13_V2_SendData(0x00);
-        EPD_2IN13_V2_SendCommand(0x4F);   // set RAM y address count to 0X127;
-        EPD_2IN13_V2_SendData(0xF9);
-        EPD_2IN13_V2_SendData(0x00);
-        EPD_2IN13_V2_ReadBusy();
+        EPD_Panel_Init(&EPD_2IN13_V2_Panel);
     } else if(Mode == EPD_2IN13_V2_PART) {
+        EPD_2IN13_V2_Reset();
+
         EPD_2IN13_V2_SendCommand(0x2C);     //VCOM Voltage
         EPD_2IN13_V2_SendData(0x26);
 
         EPD_2IN13_V2_ReadBusy();
 
         EPD_2IN13_V2_SendCommand(0x32);
-        for(count = 0; count < 70; count++) {
-            EPD_2IN13_V2_SendData(EPD_2IN13_V2_lut_partial_update[count]);
-        }
+        EPD_Common_SendDataBuffer(EPD_2IN13_V2_lut_partial_update, 70);
 
         EPD_2IN13_V2_SendCommand(0x37);
         EPD_2IN13_V2_SendData(0x00);
@@ -270,18 +256,7 @@ parameter:
 ******************************************************************************/
 void EPD_2IN13_V2_Clear(void)
 {
-    UWORD Width, Height;
-    Width = (EPD_2IN13_V2_WIDTH % 8 == 0)? (EPD_2IN13_V2_WIDTH / 8 ): (EPD_2IN13_V2_WIDTH / 8 + 1);
-    Height = EPD_2IN13_V2_HEIGHT;
-
-    EPD_2IN13_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13_V2_SendData(0XFF);
-        }
-    }
-
-    EPD_2IN13_V2_TurnOnDisplay();
+    EPD_Panel_Clear(&EPD_2IN13_V2_Panel);
 }
 
 /******************************************************************************
@@ -290,17 +265,7 @@ parameter:
 ******************************************************************************/
 void EPD_2IN13_V2_Display(UBYTE *Image)
 {
-    UWORD Width, Height;
-    Width = (EPD_2IN13_V2_WIDTH % 8 == 0)? (EPD_2IN13_V2_WIDTH / 8 ): (EPD_2IN13_V2_WIDTH / 8 + 1);
-    Height = EPD_2IN13_V2_HEIGHT;
-
-    EPD_2IN13_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13_V2_SendData(Image[i + j * Width]);
-        }
-    }
-    EPD_2IN13_V2_TurnOnDisplay();
+    EPD_Panel_Display(&EPD_2IN13_V2_Panel, Image, NULL);
 }
 
 /******************************************************************************
@@ -314,21 +279,10 @@ void EPD_2IN13_V2_DisplayPartBaseImage(UBYTE *Image)
     Width = (EPD_2IN13_V2_WIDTH % 8 == 0)? (EPD_2IN13_V2_WIDTH / 8 ): (EPD_2IN13_V2_WIDTH / 8 + 1);
     Height = EPD_2IN13_V2_HEIGHT;
 
-    UDOUBLE Addr = 0;
     EPD_2IN13_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            Addr = i + j * Width;
-            EPD_2IN13_V2_SendData(Image[Addr]);
-        }
-    }
+    EPD_Common_SendDataBuffer(Image, Width * Height);
     EPD_2IN13_V2_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            Addr = i + j * Width;
-            EPD_2IN13_V2_SendData(Image[Addr]);
-        }
-    }
+    EPD_Common_SendDataBuffer(Image, Width * Height);
     EPD_2IN13_V2_TurnOnDisplay();
 }
 
@@ -339,11 +293,7 @@ void EPD_2IN13_V2_DisplayPart(UBYTE *Image)
     Width = (EPD_2IN13_V2_WIDTH % 8 == 0)? (EPD_2IN13_V2_WIDTH / 8 ): (EPD_2IN13_V2_WIDTH / 8 + 1);
     Height = EPD_2IN13_V2_HEIGHT;
     EPD_2IN13_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13_V2_SendData(Image[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(Image, Width * Height);
 
     EPD_2IN13_V2_TurnOnDisplayPart();
 }
@@ -354,11 +304,5 @@ parameter:
 ******************************************************************************/
 void EPD_2IN13_V2_Sleep(void)
 {
-    EPD_2IN13_V2_SendCommand(0x22); //POWER OFF
-    EPD_2IN13_V2_SendData(0xC3);
-    EPD_2IN13_V2_SendCommand(0x20);
-
-    EPD_2IN13_V2_SendCommand(0x10); //enter deep sleep
-    EPD_2IN13_V2_SendData(0x01);
-    DEV_Delay_ms(100);
+    EPD_Panel_Sleep(&EPD_2IN13_V2_Panel);
 }
@@ -54,6 +54,8 @@
 #define _EPD_2IN13_V2_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
+#include "EPD_Panel.h"
 
 // Display resolution
 #define EPD_2IN13_V2_WIDTH       122
@@ -62,6 +64,8 @@
 #define EPD_2IN13_V2_FULL			0
 #define EPD_2IN13_V2_PART			1
 
+extern const EPD_PANEL EPD_2IN13_V2_Panel;
+
 void EPD_2IN13_V2_Init(UBYTE Mode);
 void EPD_2IN13_V2_Clear(void);
 void EPD_2IN13_V2_Display(UBYTE *Image);
@@ -69,4 +73,6 @@ void EPD_2IN13_V2_DisplayPart(UBYTE *Image);
 void EPD_2IN13_V2_DisplayPartBaseImage(UBYTE *Image);
 void EPD_2IN13_V2_Sleep(void);
 
+EPD_MODEL(EPD_2IN13_V2, 1, 1);
+
 #endif
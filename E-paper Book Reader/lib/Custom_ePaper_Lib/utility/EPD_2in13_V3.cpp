@@ -29,6 +29,8 @@
 #
 ******************************************************************************/
 #include "EPD_2in13_V3.h"
+#include "EPD_Common.h"
+#include "EPD_Panel.h"
 #include "Debug.h"
 
 UBYTE WF_PARTIAL_2IN13_V3[159] =
@@ -77,20 +79,6 @@ UBYTE WS_20_30_2IN13_V3[159] =
 	0x22,	0x17,	0x41,	0x0,	0x32,	0x36						
 };
 
-/******************************************************************************
-function :	Software reset
-parameter:
-******************************************************************************/
-static void EPD_2in13_V3_Reset(void)
-{
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(20);
-    DEV_Digital_Write(EPD_RST_PIN, 0);
-    DEV_Delay_ms(2);
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(20);
-}
-
 /******************************************************************************
 function :	send command
 parameter:
@@ -98,10 +86,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2in13_V3_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -111,10 +96,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2in13_V3_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -124,12 +106,7 @@ parameter:
 void EPD_2in13_V3_ReadBusy(void)
 {
     printf("e-Paper busy\r\n");
-	while(1)
-	{	 //=1 BUSY
-		if(DEV_Digital_Read(EPD_BUSY_PIN)==0) 
-			break;
-		DEV_Delay_ms(10);
-	}
+	DEV_Wait_Busy(0, EPD_BUSY_TIMEOUT_MS);
 	DEV_Delay_ms(10);
     printf("e-Paper busy release\r\n");
 }
@@ -165,10 +142,8 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN13_V3_LUT(UBYTE *lut)
 {
-	UBYTE count;
 	EPD_2in13_V3_SendCommand(0x32);
-	for(count=0; count<153; count++) 
-		EPD_2in13_V3_SendData(lut[count]); 
+	EPD_Common_SendDataBuffer(lut, 153); 
 	EPD_2in13_V3_ReadBusy();
 }
 
@@ -202,6 +177,8 @@ parameter:
 ******************************************************************************/
 static void EPD_2in13_V3_SetWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
 {
+    if(EPD_State_Window(Xstart, Ystart, Xend, Yend))
+        return;
     EPD_2in13_V3_SendCommand(0x44); // SET_RAM_X_ADDRESS_START_END_POSITION
     EPD_2in13_V3_SendData((Xstart>>3) & 0xFF);
     EPD_2in13_V3_SendData((Xend>>3) & 0xFF);
@@ -229,42 +206,62 @@ static void EPD_2in13_V3_SetCursor(UWORD Xstart, UWORD Ystart)
     EPD_2in13_V3_SendData((Ystart >> 8) & 0xFF);
 }
 
+static const UBYTE EPD_2in13_V3_Init_Script[] = {
+    EPD_RESET(20, 2, 20),
+    EPD_DELAY(100),
+    EPD_BUSY,
+    EPD_CMD(0x12, 0),               //SWRESET
+    EPD_BUSY,
+    EPD_CMD(0x01, 3), 0xf9, 0x00, 0x00, //Driver output control
+    EPD_CMD(0x11, 1), 0x03,         //data entry mode
+    EPD_WINDOW(EPD_RAM_YINC),
+    EPD_CURSOR(EPD_RAM_YINC),
+    EPD_CMD(0x3C, 1), 0x05,         //BorderWavefrom
+    EPD_CMD(0x21, 2), 0x00, 0x80,   //Display update control
+    EPD_CMD(0x18, 1), 0x80,         //Read built-in temperature sensor
+    EPD_BUSY,
+    EPD_LUT(0x32, 0, 153),
+    EPD_BUSY,
+    EPD_LUT(0x3F, 153, 1),
+    EPD_LUT(0x03, 154, 1),          //gate voltage
+    EPD_LUT(0x04, 155, 3),          //source voltage
+    EPD_LUT(0x2C, 158, 1),          //VCOM
+    EPD_END
+};
+
+static const UBYTE EPD_2in13_V3_Refresh_Script[] = {
+    EPD_CMD(0x22, 1), 0xC7,         //Display Update Control
+    EPD_CMD(0x20, 0),               //Activate Display Update Sequence
+    EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_2in13_V3_Sleep_Script[] = {
+    EPD_CMD(0x10, 1), 0x01,         //enter deep sleep
+    EPD_DELAY(100),
+    EPD_END
+};
+
+const EPD_PANEL EPD_2in13_V3_Panel = {
+    "EPD_2in13_V3", EPD_2in13_V3_WIDTH, EPD_2in13_V3_HEIGHT,
+    2, {
+        { 0x24, EPD_PLANE_IMAGE0, 0, 0xFF, 0 },
+        { 0x26, EPD_PLANE_CLEAR, 0, 0xFF, 0 },    //base of the partial refresh
+    },
+    0, 0, 0, 0, 10,
+    EPD_2in13_V3_Init_Script, EPD_2in13_V3_Refresh_Script, EPD_2in13_V3_Sleep_Script,
+    EPD_CAP_PARTIAL,
+    NULL, NULL,                     //the analog supply is switched by each update sequence, no STANDBY
+    WS_20_30_2IN13_V3,
+};
+
 /******************************************************************************
 function :	Initialize the e-Paper register
 parameter:
 ******************************************************************************/
 void EPD_2in13_V3_Init(void)
 {
-	EPD_2in13_V3_Reset();
-	DEV_Delay_ms(100);
-
-	EPD_2in13_V3_ReadBusy();   
-	EPD_2in13_V3_SendCommand(0x12);  //SWRESET
-	EPD_2in13_V3_ReadBusy();   
-
-	EPD_2in13_V3_SendCommand(0x01); //Driver output control      
-	EPD_2in13_V3_SendData(0xf9);
-	EPD_2in13_V3_SendData(0x00);
-	EPD_2in13_V3_SendData(0x00);
-
-	EPD_2in13_V3_SendCommand(0x11); //data entry mode       
-	EPD_2in13_V3_SendData(0x03);
-
-	EPD_2in13_V3_SetWindows(0, 0, EPD_2in13_V3_WIDTH-1, EPD_2in13_V3_HEIGHT-1);
-	EPD_2in13_V3_SetCursor(0, 0);
-	
-	EPD_2in13_V3_SendCommand(0x3C); //BorderWavefrom
-	EPD_2in13_V3_SendData(0x05);	
-
-	EPD_2in13_V3_SendCommand(0x21); //  Display update control
-	EPD_2in13_V3_SendData(0x00);
-	EPD_2in13_V3_SendData(0x80);	
-
-	EPD_2in13_V3_SendCommand(0x18); //Read built-in temperature sensor
-	EPD_2in13_V3_SendData(0x80);	
-
-	EPD_2in13_V3_ReadBusy();
-	EPD_2IN13_V3_LUT_by_host(WS_20_30_2IN13_V3);
+    EPD_Panel_Init(&EPD_2in13_V3_Panel);
 }
 
 /******************************************************************************
@@ -273,29 +270,7 @@ parameter:
 ******************************************************************************/
 void EPD_2in13_V3_Clear(void)
 {
-	UWORD Width, Height;
-    Width = (EPD_2in13_V3_WIDTH % 8 == 0)? (EPD_2in13_V3_WIDTH / 8 ): (EPD_2in13_V3_WIDTH / 8 + 1);
-    Height = EPD_2in13_V3_HEIGHT;
-	
-    EPD_2in13_V3_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) 
-	{
-        for (UWORD i = 0; i < Width; i++) 
-		{
-            EPD_2in13_V3_SendData(0XFF);
-        }
-    }	
-	
-	EPD_2in13_V3_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) 
-	{
-        for (UWORD i = 0; i < Width; i++) 
-		{
-            EPD_2in13_V3_SendData(0XFF);
-        }
-    }	
-
-	EPD_2in13_V3_TurnOnDisplay();
+    EPD_Panel_Clear(&EPD_2in13_V3_Panel);
 }
 
 /******************************************************************************
@@ -305,20 +280,7 @@ parameter:
 ******************************************************************************/
 void EPD_2in13_V3_Display(UBYTE *Image)
 {
-	UWORD Width, Height;
-    Width = (EPD_2in13_V3_WIDTH % 8 == 0)? (EPD_2in13_V3_WIDTH / 8 ): (EPD_2in13_V3_WIDTH / 8 + 1);
-    Height = EPD_2in13_V3_HEIGHT;
-	
-    EPD_2in13_V3_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) 
-	{
-        for (UWORD i = 0; i < Width; i++) 
-		{
-            EPD_2in13_V3_SendData(Image[i + j * Width]);
-        }
-    }	
-	
-	EPD_2in13_V3_TurnOnDisplay();	
+    EPD_Panel_Display(&EPD_2in13_V3_Panel, Image, NULL);
 }
 
 /******************************************************************************
@@ -333,21 +295,9 @@ void EPD_2in13_V3_Display_Base(UBYTE *Image)
     Height = EPD_2in13_V3_HEIGHT;
 	
 	EPD_2in13_V3_SendCommand(0x24);   //Write Black and White image to RAM
-    for (UWORD j = 0; j < Height; j++) 
-	{
-        for (UWORD i = 0; i < Width; i++) 
-		{        
-			EPD_2in13_V3_SendData(Image[i + j * Width]);
-		}
-	}
+    EPD_Common_SendDataBuffer(Image, Width * Height);
 	EPD_2in13_V3_SendCommand(0x26);   //Write Black and White image to RAM
-    for (UWORD j = 0; j < Height; j++) 
-	{
-        for (UWORD i = 0; i < Width; i++) 
-		{
-			EPD_2in13_V3_SendData(Image[i + j * Width]);
-		}
-	}
+    EPD_Common_SendDataBuffer(Image, Width * Height);
 	EPD_2in13_V3_TurnOnDisplay();	
 }
 
@@ -363,6 +313,7 @@ void EPD_2in13_V3_Display_Partial(UBYTE *Image)
     Height = EPD_2in13_V3_HEIGHT;
 	
 	//Reset
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 0);
     DEV_Delay_ms(1);
     DEV_Digital_Write(EPD_RST_PIN, 1);
@@ -393,13 +344,7 @@ void EPD_2in13_V3_Display_Partial(UBYTE *Image)
 	EPD_2in13_V3_SetCursor(0, 0);
 
 	EPD_2in13_V3_SendCommand(0x24);   //Write Black and White image to RAM
-    for (UWORD j = 0; j < Height; j++) 
-	{
-        for (UWORD i = 0; i < Width; i++) 
-		{
-			EPD_2in13_V3_SendData(Image[i + j * Width]);
-		}
-	}
+    EPD_Common_SendDataBuffer(Image, Width * Height);
 	EPD_2in13_V3_TurnOnDisplay_Partial();
 }
 
@@ -409,7 +354,5 @@ parameter:
 ******************************************************************************/
 void EPD_2in13_V3_Sleep(void)
 {
-	EPD_2in13_V3_SendCommand(0x10); //enter deep sleep
-	EPD_2in13_V3_SendData(0x01); 
-	DEV_Delay_ms(100);
+    EPD_Panel_Sleep(&EPD_2in13_V3_Panel);
 }
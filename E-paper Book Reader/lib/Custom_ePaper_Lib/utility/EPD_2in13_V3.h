@@ -32,11 +32,15 @@
 #define __EPD_2in13_V3_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
+#include "EPD_Panel.h"
 
 // Display resolution
 #define EPD_2in13_V3_WIDTH       122
 #define EPD_2in13_V3_HEIGHT      250
 
+extern const EPD_PANEL EPD_2in13_V3_Panel;
+
 void EPD_2in13_V3_Init(void);
 void EPD_2in13_V3_Clear(void);
 void EPD_2in13_V3_Display(UBYTE *Image);
@@ -44,4 +48,6 @@ void EPD_2in13_V3_Display_Base(UBYTE *Image);
 void EPD_2in13_V3_Display_Partial(UBYTE *Image);
 void EPD_2in13_V3_Sleep(void);
 
+EPD_MODEL(EPD_2in13_V3, 1, 1);
+
 #endif
@@ -29,6 +29,8 @@
 #
 ******************************************************************************/
 #include "EPD_2in13_V4.h"
+#include "EPD_Common.h"
+#include "EPD_Panel.h"
 #include "Debug.h"
 
 /******************************************************************************
@@ -37,6 +39,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2in13_V4_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(20);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -52,10 +55,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2in13_V4_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -65,10 +65,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2in13_V4_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -78,12 +75,7 @@ parameter:
 void EPD_2in13_V4_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-	while(1)
-	{	 //=1 BUSY
-		if(DEV_Digital_Read(EPD_BUSY_PIN)==0) 
-			break;
-		DEV_Delay_ms(10);
-	}
+	DEV_Wait_Busy(0, EPD_BUSY_TIMEOUT_MS);
 	DEV_Delay_ms(10);
     Debug("e-Paper busy release\r\n");
 }
@@ -98,6 +90,8 @@ parameter:
 ******************************************************************************/
 static void EPD_2in13_V4_SetWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
 {
+    if(EPD_State_Window(Xstart, Ystart, Xend, Yend))
+        return;
     EPD_2in13_V4_SendCommand(0x44); // SET_RAM_X_ADDRESS_START_END_POSITION
     EPD_2in13_V4_SendData((Xstart>>3) & 0xFF);
     EPD_2in13_V4_SendData((Xend>>3) & 0xFF);
@@ -153,39 +147,54 @@ static void EPD_2in13_V4_TurnOnDisplay_Partial(void)
 	EPD_2in13_V4_ReadBusy();
 }
 
+static const UBYTE EPD_2in13_V4_Init_Script[] = {
+    EPD_RESET(20, 2, 20),
+    EPD_BUSY,
+    EPD_CMD(0x12, 0),               //SWRESET
+    EPD_BUSY,
+    EPD_CMD(0x01, 3), 0xF9, 0x00, 0x00, //Driver output control
+    EPD_CMD(0x11, 1), 0x03,         //data entry mode
+    EPD_WINDOW(EPD_RAM_YINC),
+    EPD_CURSOR(EPD_RAM_YINC),
+    EPD_CMD(0x3C, 1), 0x05,         //BorderWavefrom
+    EPD_CMD(0x21, 2), 0x00, 0x80,   //Display update control
+    EPD_CMD(0x18, 1), 0x80,         //Read built-in temperature sensor
+    EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_2in13_V4_Refresh_Script[] = {
+    EPD_CMD(0x22, 1), 0xF7,         //Display Update Control
+    EPD_CMD(0x20, 0),               //Activate Display Update Sequence
+    EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_2in13_V4_Sleep_Script[] = {
+    EPD_CMD(0x10, 1), 0x01,         //enter deep sleep
+    EPD_DELAY(100),
+    EPD_END
+};
+
+const EPD_PANEL EPD_2in13_V4_Panel = {
+    "EPD_2in13_V4", EPD_2in13_V4_WIDTH, EPD_2in13_V4_HEIGHT,
+    1, {
+        { 0x24, EPD_PLANE_IMAGE0, 0, 0xFF, 0 },
+    },
+    0, 0, 0, 0, 10,
+    EPD_2in13_V4_Init_Script, EPD_2in13_V4_Refresh_Script, EPD_2in13_V4_Sleep_Script,
+    EPD_CAP_PARTIAL | EPD_CAP_FAST,
+    NULL, NULL,                     //the analog supply is switched by each update sequence, no STANDBY
+    NULL,
+};
+
 /******************************************************************************
 function :	Initialize the e-Paper register
 parameter:
 ******************************************************************************/
 void EPD_2in13_V4_Init(void)
 {
-	EPD_2in13_V4_Reset();
-
-	EPD_2in13_V4_ReadBusy();   
-	EPD_2in13_V4_SendCommand(0x12);  //SWRESET
-	EPD_2in13_V4_ReadBusy();   
-		
-	EPD_2in13_V4_SendCommand(0x01); //Driver output control      
-	EPD_2in13_V4_SendData(0xF9);
-	EPD_2in13_V4_SendData(0x00);
-	EPD_2in13_V4_SendData(0x00);
-
-	EPD_2in13_V4_SendCommand(0x11); //data entry mode       
-	EPD_2in13_V4_SendData(0x03);
-
-	EPD_2in13_V4_SetWindows(0, 0, EPD_2in13_V4_WIDTH-1, EPD_2in13_V4_HEIGHT-1);
-	EPD_2in13_V4_SetCursor(0, 0);
-
-	EPD_2in13_V4_SendCommand(0x3C); //BorderWavefrom
-	EPD_2in13_V4_SendData(0x05);	
-		
-	EPD_2in13_V4_SendCommand(0x21); //  Display update control
-	EPD_2in13_V4_SendData(0x00);		
-	EPD_2in13_V4_SendData(0x80);	
-		
-	EPD_2in13_V4_SendCommand(0x18); //Read built-in temperature sensor
-	EPD_2in13_V4_SendData(0x80);	
-	EPD_2in13_V4_ReadBusy();  
+    EPD_Panel_Init(&EPD_2in13_V4_Panel);
 }
 
 void EPD_2in13_V4_Init_Fast(void)
@@ -225,18 +234,7 @@ parameter:
 ******************************************************************************/
 void EPD_2in13_V4_Clear(void)
 {
-	UWORD Width, Height;
-    Width = (EPD_2in13_V4_WIDTH % 8 == 0)? (EPD_2in13_V4_WIDTH / 8 ): (EPD_2in13_V4_WIDTH / 8 + 1);
-    Height = EPD_2in13_V4_HEIGHT;
-	
-    EPD_2in13_V4_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2in13_V4_SendData(0XFF);
-        }
-    }	
-
-	EPD_2in13_V4_TurnOnDisplay();
+    EPD_Panel_Clear(&EPD_2in13_V4_Panel);
 }
 
 void EPD_2in13_V4_Clear_Black(void)
@@ -246,11 +244,7 @@ void EPD_2in13_V4_Clear_Black(void)
     Height = EPD_2in13_V4_HEIGHT;
 	
     EPD_2in13_V4_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2in13_V4_SendData(0X00);
-        }
-    }	
+    EPD_Common_SendDataRepeat(0X00, Width * Height);	
 
 	EPD_2in13_V4_TurnOnDisplay();
 }
@@ -262,18 +256,7 @@ parameter:
 ******************************************************************************/
 void EPD_2in13_V4_Display(UBYTE *Image)
 {
-	UWORD Width, Height;
-    Width = (EPD_2in13_V4_WIDTH % 8 == 0)? (EPD_2in13_V4_WIDTH / 8 ): (EPD_2in13_V4_WIDTH / 8 + 1);
-    Height = EPD_2in13_V4_HEIGHT;
-	
-    EPD_2in13_V4_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2in13_V4_SendData(Image[i + j * Width]);
-        }
-    }	
-	
-	EPD_2in13_V4_TurnOnDisplay();	
+    EPD_Panel_Display(&EPD_2in13_V4_Panel, Image, NULL);
 }
 
 void EPD_2in13_V4_Display_Fast(UBYTE *Image)
@@ -283,11 +266,7 @@ void EPD_2in13_V4_Display_Fast(UBYTE *Image)
     Height = EPD_2in13_V4_HEIGHT;
 	
     EPD_2in13_V4_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2in13_V4_SendData(Image[i + j * Width]);
-        }
-    }	
+    EPD_Common_SendDataBuffer(Image, Width * Height);	
 	
 	EPD_2in13_V4_TurnOnDisplay_Fast();	
 }
@@ -305,17 +284,9 @@ void EPD_2in13_V4_Display_Base(UBYTE *Image)
     Height = EPD_2in13_V4_HEIGHT;
 	
 	EPD_2in13_V4_SendCommand(0x24);   //Write Black and White image to RAM
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {        
-			EPD_2in13_V4_SendData(Image[i + j * Width]);
-		}
-	}
+    EPD_Common_SendDataBuffer(Image, Width * Height);
 	EPD_2in13_V4_SendCommand(0x26);   //Write Black and White image to RAM
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-			EPD_2in13_V4_SendData(Image[i + j * Width]);
-		}
-	}
+    EPD_Common_SendDataBuffer(Image, Width * Height);
 	EPD_2in13_V4_TurnOnDisplay();	
 }
 
@@ -331,6 +302,7 @@ void EPD_2in13_V4_Display_Partial(UBYTE *Image)
     Height = EPD_2in13_V4_HEIGHT;
 	
 	//Reset
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 0);
     DEV_Delay_ms(1);
     DEV_Digital_Write(EPD_RST_PIN, 1);
@@ -350,11 +322,7 @@ void EPD_2in13_V4_Display_Partial(UBYTE *Image)
 	EPD_2in13_V4_SetCursor(0, 0);
 
 	EPD_2in13_V4_SendCommand(0x24);   //Write Black and White image to RAM
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-			EPD_2in13_V4_SendData(Image[i + j * Width]);
-		}
-	}
+    EPD_Common_SendDataBuffer(Image, Width * Height);
 	EPD_2in13_V4_TurnOnDisplay_Partial();
 }
 
@@ -364,7 +332,5 @@ parameter:
 ******************************************************************************/
 void EPD_2in13_V4_Sleep(void)
 {
-	EPD_2in13_V4_SendCommand(0x10); //enter deep sleep
-	EPD_2in13_V4_SendData(0x01); 
-	DEV_Delay_ms(100);
+    EPD_Panel_Sleep(&EPD_2in13_V4_Panel);
 }
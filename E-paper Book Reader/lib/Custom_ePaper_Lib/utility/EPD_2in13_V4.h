@@ -32,12 +32,16 @@
 #define __EPD_2in13_V4_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
+#include "EPD_Panel.h"
 
 
 // Display resolution
 #define EPD_2in13_V4_WIDTH       122
 #define EPD_2in13_V4_HEIGHT      250
 
+extern const EPD_PANEL EPD_2in13_V4_Panel;
+
 void EPD_2in13_V4_Init(void);
 void EPD_2in13_V4_Init_Fast(void);
 void EPD_2in13_V4_Init_GUI(void);
@@ -49,5 +53,6 @@ void EPD_2in13_V4_Display_Base(UBYTE *Image);
 void EPD_2in13_V4_Display_Partial(UBYTE *Image);
 void EPD_2in13_V4_Sleep(void);
 
+EPD_MODEL(EPD_2in13_V4, 1, 1);
 
 #endif
@@ -29,105 +29,50 @@
 #
 ******************************************************************************/
 #include "EPD_2in13b_V4.h"
-#include "Debug.h"
-
-/******************************************************************************
-function :	Software reset
-parameter:
-******************************************************************************/
-static void EPD_2IN13B_V4_Reset(void)
-{
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(20);
-    DEV_Digital_Write(EPD_RST_PIN, 0);
-    DEV_Delay_ms(2);
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(20);
-}
-
-/******************************************************************************
-function :	send command
-parameter:
-     Reg : Command register
-******************************************************************************/
-static void EPD_2IN13B_V4_SendCommand(UBYTE Reg)
-{
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
-}
-
-/******************************************************************************
-function :	send data
-parameter:
-    Data : Write data
-******************************************************************************/
-static void EPD_2IN13B_V4_SendData(UBYTE Data)
-{
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
-}
-
-/******************************************************************************
-function :	Wait until the busy_pin goes LOW
-parameter:
-******************************************************************************/
-void EPD_2IN13B_V4_ReadBusy(void)
-{
-    Debug("e-Paper busy\r\n");
-	while(1)
-	{	 //=1 BUSY
-		if(DEV_Digital_Read(EPD_BUSY_PIN)==0) 
-			break;
-		DEV_Delay_ms(20);
-	}
-	DEV_Delay_ms(20);
-    Debug("e-Paper busy release\r\n");
-}
-
-/******************************************************************************
-function :	Turn On Display
-parameter:
-******************************************************************************/
-static void EPD_2IN13B_V4_TurnOnDisplay(void)
-{
-	EPD_2IN13B_V4_SendCommand(0x20); // Activate Display Update Sequence
-	EPD_2IN13B_V4_ReadBusy();
-}
-
-/******************************************************************************
-function :	Setting the display window
-parameter:
-******************************************************************************/
-static void EPD_2IN13B_V4_SetWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
-{
-    EPD_2IN13B_V4_SendCommand(0x44); // SET_RAM_X_ADDRESS_START_END_POSITION
-    EPD_2IN13B_V4_SendData((Xstart>>3) & 0xFF);
-    EPD_2IN13B_V4_SendData((Xend>>3) & 0xFF);
-	
-    EPD_2IN13B_V4_SendCommand(0x45); // SET_RAM_Y_ADDRESS_START_END_POSITION
-    EPD_2IN13B_V4_SendData(Ystart & 0xFF);
-    EPD_2IN13B_V4_SendData((Ystart >> 8) & 0xFF);
-    EPD_2IN13B_V4_SendData(Yend & 0xFF);
-    EPD_2IN13B_V4_SendData((Yend >> 8) & 0xFF);
-}
-
-/******************************************************************************
-function :	Set Cursor
-parameter:
-******************************************************************************/
-static void EPD_2IN13B_V4_SetCursor(UWORD Xstart, UWORD Ystart)
-{
-    EPD_2IN13B_V4_SendCommand(0x4E); // SET_RAM_X_ADDRESS_COUNTER
-    EPD_2IN13B_V4_SendData(Xstart & 0xFF);
-
-    EPD_2IN13B_V4_SendCommand(0x4F); // SET_RAM_Y_ADDRESS_COUNTER
-    EPD_2IN13B_V4_SendData(Ystart & 0xFF);
-    EPD_2IN13B_V4_SendData((Ystart >> 8) & 0xFF);
-}
+#include "EPD_Panel.h"
+
+static const UBYTE EPD_2IN13B_V4_Init_Script[] = {
+    EPD_RESET(20, 2, 20),
+    EPD_BUSY,
+    EPD_CMD(0x12, 0),               //SWRESET
+    EPD_BUSY,
+    EPD_CMD(0x01, 3), 0xf9, 0x00, 0x00, //Driver output control
+    EPD_CMD(0x11, 1), 0x03,         //data entry mode
+    EPD_CMD(0x44, 2), 0x00, (EPD_2IN13B_V4_WIDTH - 1) >> 3, //SET_RAM_X_ADDRESS_START_END_POSITION
+    EPD_CMD(0x45, 4), 0x00, 0x00,   //SET_RAM_Y_ADDRESS_START_END_POSITION
+        (EPD_2IN13B_V4_HEIGHT - 1) & 0xFF, (EPD_2IN13B_V4_HEIGHT - 1) >> 8,
+    EPD_CMD(0x4E, 1), 0x00,         //SET_RAM_X_ADDRESS_COUNTER
+    EPD_CMD(0x4F, 2), 0x00, 0x00,   //SET_RAM_Y_ADDRESS_COUNTER
+    EPD_CMD(0x3C, 1), 0x05,         //BorderWavefrom
+    EPD_CMD(0x18, 1), 0x80,         //Read built-in temperature sensor
+    EPD_CMD(0x21, 2), 0x80, 0x80,   //Display update control
+    EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_2IN13B_V4_Refresh_Script[] = {
+    EPD_CMD(0x20, 0),               //Activate Display Update Sequence
+    EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_2IN13B_V4_Sleep_Script[] = {
+    EPD_CMD(0x10, 1), 0x01,         //enter deep sleep
+    EPD_DELAY(100),
+    EPD_END
+};
+
+const EPD_PANEL EPD_2IN13B_V4_Panel = {
+    "EPD_2IN13B_V4", EPD_2IN13B_V4_WIDTH, EPD_2IN13B_V4_HEIGHT,
+    2, {
+        { 0x24, EPD_PLANE_IMAGE0, 0, 0xFF, 0 },   //black
+        { 0x26, EPD_PLANE_IMAGE1, 0, 0xFF, 0 },   //red, 0 = red
+    },
+    0, 0, 0, 0, 20,
+    EPD_2IN13B_V4_Init_Script, EPD_2IN13B_V4_Refresh_Script, EPD_2IN13B_V4_Sleep_Script,
+    EPD_CAP_RED,
+    NULL, NULL,                     //the analog supply is switched by each update sequence, no STANDBY
+};
 
 /******************************************************************************
 function :	Initialize the e-Paper register
@@ -135,35 +80,7 @@ parameter:
 ******************************************************************************/
 void EPD_2IN13B_V4_Init(void)
 {
-	EPD_2IN13B_V4_Reset();
-
-	EPD_2IN13B_V4_ReadBusy();   
-	EPD_2IN13B_V4_SendCommand(0x12);  //SWRESET
-	EPD_2IN13B_V4_ReadBusy();   
-
-	EPD_2IN13B_V4_SendCommand(0x01); //Driver output control      
-	EPD_2IN13B_V4_SendData(0xf9);
-	EPD_2IN13B_V4_SendData(0x00);
-	EPD_2IN13B_V4_SendData(0x00);
-
-	EPD_2IN13B_V4_SendCommand(0x11); //data entry mode       
-	EPD_2IN13B_V4_SendData(0x03);
-
-	EPD_2IN13B_V4_SetWindows(0, 0, EPD_2IN13B_V4_WIDTH-1, EPD_2IN13B_V4_HEIGHT-1);
-	EPD_2IN13B_V4_SetCursor(0, 0);
-
-	EPD_2IN13B_V4_SendCommand(0x3C); //BorderWavefrom
-	EPD_2IN13B_V4_SendData(0x05);	
-
-	EPD_2IN13B_V4_SendCommand(0x18); //Read built-in temperature sensor
-	EPD_2IN13B_V4_SendData(0x80);	
-
-	EPD_2IN13B_V4_SendCommand(0x21); //  Display update control
-	EPD_2IN13B_V4_SendData(0x80);	
-	EPD_2IN13B_V4_SendData(0x80);
-
-	EPD_2IN13B_V4_ReadBusy();
-
+    EPD_Panel_Init(&EPD_2IN13B_V4_Panel);
 }
 
 /******************************************************************************
@@ -172,23 +89,7 @@ parameter:
 ******************************************************************************/
 void EPD_2IN13B_V4_Clear(void)
 {
-	UWORD Width, Height;
-    Width = (EPD_2IN13B_V4_WIDTH % 8 == 0)? (EPD_2IN13B_V4_WIDTH / 8 ): (EPD_2IN13B_V4_WIDTH / 8 + 1);
-    Height = EPD_2IN13B_V4_HEIGHT;
-	
-    EPD_2IN13B_V4_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13B_V4_SendData(0XFF);
-        }
-    }	
-    EPD_2IN13B_V4_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13B_V4_SendData(0XFF);
-        }
-    }
-	EPD_2IN13B_V4_TurnOnDisplay();
+    EPD_Panel_Clear(&EPD_2IN13B_V4_Panel);
 }
 
 /******************************************************************************
@@ -197,23 +98,18 @@ parameter:
 ******************************************************************************/
 void EPD_2IN13B_V4_Display(const UBYTE *blackImage, const UBYTE *redImage)
 {
-	UWORD Width, Height;
-    Width = (EPD_2IN13B_V4_WIDTH % 8 == 0)? (EPD_2IN13B_V4_WIDTH / 8 ): (EPD_2IN13B_V4_WIDTH / 8 + 1);
-    Height = EPD_2IN13B_V4_HEIGHT;
-	
-    EPD_2IN13B_V4_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13B_V4_SendData(blackImage[i + j * Width]);
-        }
-    }	
-	EPD_2IN13B_V4_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13B_V4_SendData(redImage[i + j * Width]);
-        }
-    }	
-	EPD_2IN13B_V4_TurnOnDisplay();	
+    EPD_Panel_Display(&EPD_2IN13B_V4_Panel, blackImage, redImage);
+}
+
+/******************************************************************************
+function :	Sends a 3 color picture to e-Paper and displays
+parameter:
+    Image : the black plane then the red plane, drawn with
+            Paint_SetColorPlanes(Ctx, EPD_2IN13B_V4_COLOR)
+******************************************************************************/
+void EPD_2IN13B_V4_Display_Planes(const UBYTE *Image)
+{
+    EPD_Panel_Display_Planes(&EPD_2IN13B_V4_Panel, Image);
 }
 
 /******************************************************************************
@@ -222,7 +118,5 @@ parameter:
 ******************************************************************************/
 void EPD_2IN13B_V4_Sleep(void)
 {
-	EPD_2IN13B_V4_SendCommand(0x10); //enter deep sleep
-	EPD_2IN13B_V4_SendData(0x01); 
-	DEV_Delay_ms(100);
+    EPD_Panel_Sleep(&EPD_2IN13B_V4_Panel);
 }
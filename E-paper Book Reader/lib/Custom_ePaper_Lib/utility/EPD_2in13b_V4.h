@@ -32,14 +32,22 @@
 #define __EPD_2IN13B_V4_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
+#include "EPD_Panel.h"
 
 // Display resolution
 #define EPD_2IN13B_V4_WIDTH       122
 #define EPD_2IN13B_V4_HEIGHT      250
+#define EPD_2IN13B_V4_COLOR       EPD_Color_RedLow    //3 color planes, see Paint_SetColorPlanes()
+
+extern const EPD_PANEL EPD_2IN13B_V4_Panel;
 
 void EPD_2IN13B_V4_Init(void);
 void EPD_2IN13B_V4_Clear(void);
 void EPD_2IN13B_V4_Display(const UBYTE *blackImage, const UBYTE *redImage);
+void EPD_2IN13B_V4_Display_Planes(const UBYTE *Image);
 void EPD_2IN13B_V4_Sleep(void);
 
+EPD_MODEL(EPD_2IN13B_V4, 2, 1);
+
 #endif
@@ -81,72 +81,57 @@
 #
 ******************************************************************************/
 #include "EPD_2in13bc.h"
-#include "Debug.h"
+#include "EPD_Panel.h"
 
-/******************************************************************************
-function :	Software reset
-parameter:
-******************************************************************************/
-static void EPD_2IN13BC_Reset(void)
-{
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(200);
-    DEV_Digital_Write(EPD_RST_PIN, 0);
-    DEV_Delay_ms(200);
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(200);
-}
+static const UBYTE EPD_2IN13BC_Init_Script[] = {
+    EPD_RESET(200, 200, 200),
+    EPD_CMD(0x06, 3), 0x17, 0x17, 0x17, //BOOSTER_SOFT_START
+    EPD_CMD(0x04, 0),                   //POWER_ON
+    EPD_BUSY,
+    EPD_CMD(0x00, 1), 0x8F,             //PANEL_SETTING
+    EPD_CMD(0x50, 1), 0xF0,             //VCOM_AND_DATA_INTERVAL_SETTING
+    EPD_CMD(0x61, 3), EPD_2IN13BC_WIDTH, //RESOLUTION_SETTING, width: 104
+        EPD_2IN13BC_HEIGHT >> 8, EPD_2IN13BC_HEIGHT & 0xFF, //height: 212
+    EPD_END
+};
 
-/******************************************************************************
-function :	send command
-parameter:
-     Reg : Command register
-******************************************************************************/
-static void EPD_2IN13BC_SendCommand(UBYTE Reg)
-{
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
-}
+static const UBYTE EPD_2IN13BC_Refresh_Script[] = {
+    EPD_CMD(0x12, 0),                   //DISPLAY REFRESH
+    EPD_DELAY(10),
+    EPD_BUSY,
+    EPD_END
+};
 
-/******************************************************************************
-function :	send data
-parameter:
-    Data : Write data
-******************************************************************************/
-static void EPD_2IN13BC_SendData(UBYTE Data)
-{
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
-}
+static const UBYTE EPD_2IN13BC_Sleep_Script[] = {
+    EPD_CMD(0x02, 0),                   //POWER_OFF
+    EPD_BUSY,
+    EPD_CMD(0x07, 1), 0xA5,             //DEEP_SLEEP, check code
+    EPD_END
+};
 
-/******************************************************************************
-function :	Wait until the busy_pin goes LOW
-parameter:
-******************************************************************************/
-void EPD_2IN13BC_ReadBusy(void)
-{
-    Debug("e-Paper busy\r\n");
-    while(DEV_Digital_Read(EPD_BUSY_PIN) == 0) {
-        DEV_Delay_ms(100);
-    }
-    Debug("e-Paper busy release\r\n");
-}
+static const UBYTE EPD_2IN13BC_PowerOff_Script[] = {
+    EPD_CMD(0x02, 0),                   //POWER_OFF
+    EPD_BUSY,
+    EPD_END
+};
 
-/******************************************************************************
-function :	Turn On Display
-parameter:
-******************************************************************************/
-static void EPD_2IN13BC_TurnOnDisplay(void)
-{
-    EPD_2IN13BC_SendCommand(0x12);		 //DISPLAY REFRESH
-    DEV_Delay_ms(10);
+static const UBYTE EPD_2IN13BC_PowerOn_Script[] = {
+    EPD_CMD(0x04, 0),                   //POWER_ON
+    EPD_BUSY,
+    EPD_END
+};
 
-    EPD_2IN13BC_ReadBusy();
-}
+const EPD_PANEL EPD_2IN13BC_Panel = {
+    "EPD_2IN13BC", EPD_2IN13BC_WIDTH, EPD_2IN13BC_HEIGHT,
+    2, {
+        { 0x10, EPD_PLANE_IMAGE0, 0, 0xFF, 0 },   //black
+        { 0x13, EPD_PLANE_IMAGE1, 0, 0xFF, 0 },   //red, 0 = red
+    },
+    0x92, 1, 1, 0, 0,
+    EPD_2IN13BC_Init_Script, EPD_2IN13BC_Refresh_Script, EPD_2IN13BC_Sleep_Script,
+    EPD_CAP_RED,
+    EPD_2IN13BC_PowerOff_Script, EPD_2IN13BC_PowerOn_Script,
+};
 
 /******************************************************************************
 function :	Initialize the e-Paper register
@@ -154,25 +139,7 @@ parameter:
 ******************************************************************************/
 void EPD_2IN13BC_Init(void)
 {
-    EPD_2IN13BC_Reset();
-
-    EPD_2IN13BC_SendCommand(0x06); // BOOSTER_SOFT_START
-    EPD_2IN13BC_SendData(0x17);
-    EPD_2IN13BC_SendData(0x17);
-    EPD_2IN13BC_SendData(0x17);
-	
-    EPD_2IN13BC_SendCommand(0x04); // POWER_ON
-    EPD_2IN13BC_ReadBusy();
-	
-    EPD_2IN13BC_SendCommand(0x00); // PANEL_SETTING
-    EPD_2IN13BC_SendData(0x8F);
-	
-    EPD_2IN13BC_SendCommand(0x50); // VCOM_AND_DATA_INTERVAL_SETTING
-    EPD_2IN13BC_SendData(0xF0);
-    EPD_2IN13BC_SendCommand(0x61); // RESOLUTION_SETTING
-    EPD_2IN13BC_SendData(EPD_2IN13BC_WIDTH); // width: 104
-    EPD_2IN13BC_SendData(EPD_2IN13BC_HEIGHT >> 8); // height: 212
-    EPD_2IN13BC_SendData(EPD_2IN13BC_HEIGHT & 0xFF);
+    EPD_Panel_Init(&EPD_2IN13BC_Panel);
 }
 
 /******************************************************************************
@@ -181,28 +148,7 @@ parameter:
 ******************************************************************************/
 void EPD_2IN13BC_Clear(void)
 {
-    UWORD Width = (EPD_2IN13BC_WIDTH % 8 == 0)? (EPD_2IN13BC_WIDTH / 8 ): (EPD_2IN13BC_WIDTH / 8 + 1);
-    UWORD Height = EPD_2IN13BC_HEIGHT;
-    
-    //send black data
-    EPD_2IN13BC_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13BC_SendData(0xFF);
-        }
-    }
-    EPD_2IN13BC_SendCommand(0x92); 
-
-    //send red data
-    EPD_2IN13BC_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13BC_SendData(0xFF);
-        }
-    }
-    EPD_2IN13BC_SendCommand(0x92); 
-    
-    EPD_2IN13BC_TurnOnDisplay();
+    EPD_Panel_Clear(&EPD_2IN13BC_Panel);
 }
 
 /******************************************************************************
@@ -211,27 +157,18 @@ parameter:
 ******************************************************************************/
 void EPD_2IN13BC_Display(const UBYTE *blackimage, const UBYTE *ryimage)
 {
-    UWORD Width, Height;
-    Width = (EPD_2IN13BC_WIDTH % 8 == 0)? (EPD_2IN13BC_WIDTH / 8 ): (EPD_2IN13BC_WIDTH / 8 + 1);
-    Height = EPD_2IN13BC_HEIGHT;
-    
-    EPD_2IN13BC_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13BC_SendData(blackimage[i + j * Width]);
-        }
-    }
-    EPD_2IN13BC_SendCommand(0x92); 
-    
-    EPD_2IN13BC_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13BC_SendData(ryimage[i + j * Width]);
-        }
-    }
-    EPD_2IN13BC_SendCommand(0x92); 
-    
-    EPD_2IN13BC_TurnOnDisplay();
+    EPD_Panel_Display(&EPD_2IN13BC_Panel, blackimage, ryimage);
+}
+
+/******************************************************************************
+function :	Sends a 3 color picture to e-Paper and displays
+parameter:
+    Image : the black plane then the red plane, drawn with
+            Paint_SetColorPlanes(Ctx, EPD_2IN13BC_COLOR)
+******************************************************************************/
+void EPD_2IN13BC_Display_Planes(const UBYTE *Image)
+{
+    EPD_Panel_Display_Planes(&EPD_2IN13BC_Panel, Image);
 }
 
 /******************************************************************************
@@ -240,8 +177,5 @@ parameter:
 ******************************************************************************/
 void EPD_2IN13BC_Sleep(void)
 {
-    EPD_2IN13BC_SendCommand(0x02); // POWER_OFF
-    EPD_2IN13BC_ReadBusy();
-    EPD_2IN13BC_SendCommand(0x07); // DEEP_SLEEP
-    EPD_2IN13BC_SendData(0xA5); // check code
+    EPD_Panel_Sleep(&EPD_2IN13BC_Panel);
 }
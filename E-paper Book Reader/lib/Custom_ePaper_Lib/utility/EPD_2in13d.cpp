@@ -61,6 +61,7 @@
 #
 ******************************************************************************/
 #include "EPD_2in13d.h"
+#include "EPD_Common.h"
 #include "Debug.h"
 
 /**
@@ -171,6 +172,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN13D_Reset(void)
 {
+	EPD_State_Invalidate();
 	DEV_Digital_Write(EPD_RST_PIN, 1);
 	DEV_Delay_ms(200);
 	DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -186,10 +188,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN13D_SendCommand(UBYTE Reg)
 {
-	DEV_Digital_Write(EPD_DC_PIN, 0);
-	DEV_Digital_Write(EPD_CS_PIN, 0);
-	DEV_SPI_WriteByte(Reg);
-	DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -199,10 +198,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN13D_SendData(UBYTE Data)
 {
-	DEV_Digital_Write(EPD_DC_PIN, 1);
-	DEV_Digital_Write(EPD_CS_PIN, 0);
-	DEV_SPI_WriteByte(Data);
-	DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -212,12 +208,8 @@ parameter:
 static void EPD_2IN13D_ReadBusy(void)
 {
 	Debug("e-Paper busy\r\n");
-	UBYTE busy;
-	do {
-		EPD_2IN13D_SendCommand(0x71);
-		busy = DEV_Digital_Read(EPD_BUSY_PIN);
-		busy =!(busy & 0x01);
-	} while(busy);
+	EPD_2IN13D_SendCommand(0x71);
+	DEV_Wait_Busy(1, EPD_BUSY_TIMEOUT_MS);
 	DEV_Delay_ms(200);
 	Debug("e-Paper busy release\r\n");
 }
@@ -231,31 +223,20 @@ static void EPD_2IN13D_SetFullReg(void)
 	EPD_2IN13D_SendCommand(0X50);			//VCOM AND DATA INTERVAL SETTING
 	EPD_2IN13D_SendData(0xb7);		//WBmode:VBDF 17|D7 VBDW 97 VBDB 57		WBRmode:VBDF F7 VBDW 77 VBDB 37  VBDR B7
 
-	unsigned int count;
 	EPD_2IN13D_SendCommand(0x20);
-	for(count=0; count<44; count++) {
-		EPD_2IN13D_SendData(EPD_2IN13D_lut_vcomDC[count]);
-	}
+	EPD_Common_SendDataBuffer(EPD_2IN13D_lut_vcomDC, 44);
 
 	EPD_2IN13D_SendCommand(0x21);
-	for(count=0; count<42; count++) {
-		EPD_2IN13D_SendData(EPD_2IN13D_lut_ww[count]);
-	}
+	EPD_Common_SendDataBuffer(EPD_2IN13D_lut_ww, 42);
 
 	EPD_2IN13D_SendCommand(0x22);
-	for(count=0; count<42; count++) {
-		EPD_2IN13D_SendData(EPD_2IN13D_lut_bw[count]);
-	}
+	EPD_Common_SendDataBuffer(EPD_2IN13D_lut_bw, 42);
 
 	EPD_2IN13D_SendCommand(0x23);
-	for(count=0; count<42; count++) {
-		EPD_2IN13D_SendData(EPD_2IN13D_lut_wb[count]);
-	}
+	EPD_Common_SendDataBuffer(EPD_2IN13D_lut_wb, 42);
 
 	EPD_2IN13D_SendCommand(0x24);
-	for(count=0; count<42; count++) {
-		EPD_2IN13D_SendData(EPD_2IN13D_lut_bb[count]);
-	}
+	EPD_Common_SendDataBuffer(EPD_2IN13D_lut_bb, 42);
 }
 
 /******************************************************************************
@@ -269,31 +250,20 @@ static void EPD_2IN13D_SetPartReg(void)
 	EPD_2IN13D_SendCommand(0X50);
 	EPD_2IN13D_SendData(0xb7);
 
-	unsigned int count;
 	EPD_2IN13D_SendCommand(0x20);
-	for(count=0; count<44; count++) {
-		EPD_2IN13D_SendData(EPD_2IN13D_lut_vcom1[count]);
-	}
+	EPD_Common_SendDataBuffer(EPD_2IN13D_lut_vcom1, 44);
 
 	EPD_2IN13D_SendCommand(0x21);
-	for(count=0; count<42; count++) {
-		EPD_2IN13D_SendData(EPD_2IN13D_lut_ww1[count]);
-	}
+	EPD_Common_SendDataBuffer(EPD_2IN13D_lut_ww1, 42);
 
 	EPD_2IN13D_SendCommand(0x22);
-	for(count=0; count<42; count++) {
-		EPD_2IN13D_SendData(EPD_2IN13D_lut_bw1[count]);
-	}
+	EPD_Common_SendDataBuffer(EPD_2IN13D_lut_bw1, 42);
 
 	EPD_2IN13D_SendCommand(0x23);
-	for(count=0; count<42; count++) {
-		EPD_2IN13D_SendData(EPD_2IN13D_lut_wb1[count]);
-	}
+	EPD_Common_SendDataBuffer(EPD_2IN13D_lut_wb1, 42);
 
 	EPD_2IN13D_SendCommand(0x24);
-	for(count=0; count<42; count++) {
-		EPD_2IN13D_SendData(EPD_2IN13D_lut_bb1[count]);
-	}
+	EPD_Common_SendDataBuffer(EPD_2IN13D_lut_bb1, 42);
 }
 
 /******************************************************************************
@@ -358,18 +328,10 @@ void EPD_2IN13D_Clear(void)
 	Height = EPD_2IN13D_HEIGHT;
 
 	EPD_2IN13D_SendCommand(0x10);
-	for (UWORD j = 0; j < Height; j++) {
-		for (UWORD i = 0; i < Width; i++) {
-			EPD_2IN13D_SendData(0x00);
-		}
-	}
+	EPD_Common_SendDataRepeat(0x00, Width * Height);
 
 	EPD_2IN13D_SendCommand(0x13);
-	for (UWORD j = 0; j < Height; j++) {
-		for (UWORD i = 0; i < Width; i++) {
-			EPD_2IN13D_SendData(0xFF);
-		}
-	}
+	EPD_Common_SendDataRepeat(0xFF, Width * Height);
 
 	EPD_2IN13D_SetFullReg();
 	EPD_2IN13D_TurnOnDisplay();
@@ -386,19 +348,11 @@ void EPD_2IN13D_Display(UBYTE *Image)
 	Height = EPD_2IN13D_HEIGHT;
 
 	EPD_2IN13D_SendCommand(0x10);
-	for (UWORD j = 0; j < Height; j++) {
-		for (UWORD i = 0; i < Width; i++) {
-			EPD_2IN13D_SendData(0x00);
-		}
-	}
+	EPD_Common_SendDataRepeat(0x00, Width * Height);
 	// Dev_Delay_ms(10);
 
 	EPD_2IN13D_SendCommand(0x13);
-	for (UWORD j = 0; j < Height; j++) {
-		for (UWORD i = 0; i < Width; i++) {
-			EPD_2IN13D_SendData(Image[i + j * Width]);
-		}
-	}
+	EPD_Common_SendDataBuffer(Image, Width * Height);
 	// Dev_Delay_ms(10);
 
 	EPD_2IN13D_SetFullReg();
@@ -429,18 +383,10 @@ void EPD_2IN13D_DisplayPart(UBYTE *Image)
 
 	/* send data */
 	EPD_2IN13D_SendCommand(0x10);
-	for (UWORD j = 0; j < EPD_2IN13D_HEIGHT; j++) {
-		for (UWORD i = 0; i < Width; i++) {
-			EPD_2IN13D_SendData(~Image[i + j * Width]);
-		}
-	}
+	EPD_Common_SendDataInvert(Image, Width * EPD_2IN13D_HEIGHT);
 
 	EPD_2IN13D_SendCommand(0x13);
-	for (UWORD j = 0; j < EPD_2IN13D_HEIGHT; j++) {
-		for (UWORD i = 0; i < Width; i++) {
-			EPD_2IN13D_SendData(Image[i + j * Width]);
-		}
-	}
+	EPD_Common_SendDataBuffer(Image, Width * EPD_2IN13D_HEIGHT);
 
 	/* Set partial refresh */
 	EPD_2IN13D_TurnOnDisplay();
@@ -64,6 +64,7 @@
 #define __EPD_2IN13D_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_2IN13D_WIDTH   104
@@ -75,4 +76,6 @@ void EPD_2IN13D_Display(UBYTE *Image);
 void EPD_2IN13D_DisplayPart(UBYTE *Image);
 void EPD_2IN13D_Sleep(void);
 
+EPD_MODEL(EPD_2IN13D, 1, 1);
+
 #endif
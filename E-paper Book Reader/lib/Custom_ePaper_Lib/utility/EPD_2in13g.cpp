@@ -29,6 +29,7 @@
 #
 ******************************************************************************/
 #include "EPD_2in13g.h"
+#include "EPD_Common.h"
 #include "Debug.h" 
 
 UWORD Source_BITS = EPD_2IN13G_WIDTH;
@@ -40,6 +41,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN13G_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(200);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -55,10 +57,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN13G_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);   
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -68,10 +67,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN13G_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -82,9 +78,7 @@ void EPD_2IN13G_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
     DEV_Delay_ms(100);
-    while(DEV_Digital_Read(EPD_BUSY_PIN) != 1) {      //HIGH: idle, LOW: busy
-        DEV_Delay_ms(100);
-    }
+    DEV_Wait_Busy(1, EPD_BUSY_TIMEOUT_MS);
     Debug("e-Paper busy release\r\n");
 }
 
@@ -192,11 +186,7 @@ void EPD_2IN13G_Clear(UBYTE color)
     Height = EPD_2IN13G_HEIGHT;
 
     EPD_2IN13G_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13G_SendData((color << 6) | (color << 4) | (color << 2) | color);
-        }
-    }
+    EPD_Common_SendDataRepeat((color << 6) | (color << 4) | (color << 2) | color, Width * Height);
 
     EPD_2IN13G_TurnOnDisplay();
 }
@@ -211,12 +201,13 @@ void EPD_2IN13G_Display(UBYTE *Image)
     Width = (EPD_2IN13G_WIDTH % 4 == 0)? (EPD_2IN13G_WIDTH / 4 ): (EPD_2IN13G_WIDTH / 4 + 1);
     Height = EPD_2IN13G_HEIGHT;
 
+    UWORD Line = Source_BITS / 4;
+    UWORD Valid = (Line < 31)? Line: 31;
+
     EPD_2IN13G_SendCommand(0x10);
     for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < (Source_BITS / 4); i++) {
-            if(i < 31 ) EPD_2IN13G_SendData(Image[i + j * Width]);
-            else EPD_2IN13G_SendData(0x00);
-        }
+        EPD_Common_SendDataBuffer(Image + j * Width, Valid);
+        EPD_Common_SendDataRepeat(0x00, Line - Valid);
     }
 
     EPD_2IN13G_TurnOnDisplay();
@@ -13,6 +13,7 @@
 #define __EPD_2IN13G_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_2IN13G_WIDTH       122
@@ -29,4 +30,6 @@ void EPD_2IN13G_Clear(UBYTE color);
 void EPD_2IN13G_Display(UBYTE *Image);
 void EPD_2IN13G_Sleep(void);
 
+EPD_MODEL(EPD_2IN13G, 1, 2);
+
 #endif
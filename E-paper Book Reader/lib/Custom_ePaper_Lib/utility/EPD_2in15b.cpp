@@ -28,6 +28,7 @@
 #
 ******************************************************************************/
 #include "EPD_2in15b.h"
+#include "EPD_Common.h"
 
 /******************************************************************************
 function :	Software reset
@@ -35,6 +36,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN15B_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(200);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -50,10 +52,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN15B_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -63,10 +62,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN15B_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -77,9 +73,7 @@ static void EPD_2IN15B_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
     DEV_Delay_ms(50);
-    while(DEV_Digital_Read(EPD_BUSY_PIN) == 1) {      //LOW: idle, HIGH: busy
-        DEV_Delay_ms(10);
-    }
+    DEV_Wait_Busy(0, EPD_BUSY_TIMEOUT_MS);
     DEV_Delay_ms(50);
     Debug("e-Paper busy release\r\n");
 }
@@ -100,6 +94,8 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN15B_SetWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
 {
+    if(EPD_State_Window(Xstart, Ystart, Xend, Yend))
+        return;
     EPD_2IN15B_SendCommand(0x44); // SET_RAM_X_ADDRESS_START_END_POSITION
     EPD_2IN15B_SendData((Xstart>>3) & 0x1F);
     EPD_2IN15B_SendData((Xend>>3) & 0x1F);
@@ -159,18 +155,10 @@ void EPD_2IN15B_Display(const UBYTE *ImageBlack, const UBYTE*ImageRed)
     Height = EPD_2IN15B_HEIGHT;
 
     EPD_2IN15B_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN15B_SendData(ImageBlack[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(ImageBlack, Width * Height);
 	
     EPD_2IN15B_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN15B_SendData(~ImageRed[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataInvert(ImageRed, Width * Height);
 
     EPD_2IN15B_TurnOnDisplay();
 }
@@ -186,17 +174,9 @@ void EPD_2IN15B_Clear(void)
     Height = EPD_2IN15B_HEIGHT;
 
     EPD_2IN15B_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN15B_SendData(0xff);
-        }
-    }
+    EPD_Common_SendDataRepeat(0xff, Width * Height);
 	EPD_2IN15B_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN15B_SendData(0x00);
-        }
-    }
+    EPD_Common_SendDataRepeat(0x00, Width * Height);
     EPD_2IN15B_TurnOnDisplay();
 }
 
@@ -208,22 +188,10 @@ void EPD_2IN15B_Clear_Black(void)
 
     EPD_2IN15B_SendCommand(0x24);
 
-    for (UWORD j = 0; j < Height-50; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN15B_SendData(0xff);
-        }
-    }
-    for (UWORD j = 0; j < 50; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN15B_SendData(0x00);
-        }
-    }
+    EPD_Common_SendDataRepeat(0xff, Width * (Height-50));
+    EPD_Common_SendDataRepeat(0x00, Width * 50);
 	EPD_2IN15B_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN15B_SendData(0x00);
-        }
-    }
+    EPD_Common_SendDataRepeat(0x00, Width * Height);
     EPD_2IN15B_TurnOnDisplay();
 }
 
@@ -234,17 +202,9 @@ void EPD_2IN15B_Clear_Red(void)
     Height = EPD_2IN15B_HEIGHT;
 
     EPD_2IN15B_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN15B_SendData(0xff);
-        }
-    }
+    EPD_Common_SendDataRepeat(0xff, Width * Height);
 	EPD_2IN15B_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN15B_SendData(0xff);
-        }
-    }
+    EPD_Common_SendDataRepeat(0xff, Width * Height);
     EPD_2IN15B_TurnOnDisplay();
 }
 
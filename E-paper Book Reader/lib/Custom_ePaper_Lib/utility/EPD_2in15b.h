@@ -31,6 +31,7 @@
 
 #include "Debug.h"
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_2IN15B_WIDTH       160
@@ -43,4 +44,7 @@ void EPD_2IN15B_Clear(void);
 void EPD_2IN15B_Clear_Black(void);
 void EPD_2IN15B_Clear_Red(void);
 void EPD_2IN15B_Sleep(void);
+
+EPD_MODEL(EPD_2IN15B, 2, 1);
+
 #endif
@@ -14,6 +14,7 @@
 
 #include "Debug.h"
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_2IN15G_WIDTH       160
@@ -30,4 +31,6 @@ void EPD_2IN15G_Clear(UBYTE color);
 void EPD_2IN15G_Display(const UBYTE *Image);
 void EPD_2IN15G_Sleep(void);
 
+EPD_MODEL(EPD_2IN15G, 1, 2);
+
 #endif
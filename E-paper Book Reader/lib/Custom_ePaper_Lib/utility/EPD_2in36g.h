@@ -32,6 +32,7 @@
 #define __EPD_2IN36G_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_2IN36G_WIDTH       168
@@ -48,4 +49,6 @@ void EPD_2IN36G_Clear(UBYTE color);
 void EPD_2IN36G_Display(UBYTE *Image);
 void EPD_2IN36G_Sleep(void);
 
+EPD_MODEL(EPD_2IN36G, 1, 2);
+
 #endif
@@ -28,6 +28,7 @@
 #
 ******************************************************************************/
 #include "EPD_2in66.h"
+#include "EPD_Common.h"
 #include "Debug.h"
 
 const unsigned char WF_PARTIAL[159] ={
@@ -56,6 +57,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN66_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(200);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -71,10 +73,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN66_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -84,10 +83,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN66_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -98,9 +94,7 @@ void EPD_2IN66_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
     DEV_Delay_ms(100);
-    while(DEV_Digital_Read(EPD_BUSY_PIN) == 1) {      //LOW: idle, HIGH: busy
-        DEV_Delay_ms(100);
-    }
+    DEV_Wait_Busy(0, EPD_BUSY_TIMEOUT_MS);
     DEV_Delay_ms(100);
     Debug("e-Paper busy release\r\n");
 }
@@ -123,11 +117,8 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN66_SetLUA(void)
 {
-    UWORD count;
     EPD_2IN66_SendCommand(0x32);
-    for(count=0;count<153;count++){
-        EPD_2IN66_SendData(WF_PARTIAL[count]);
-    }    
+    EPD_Common_SendDataBuffer(WF_PARTIAL, 153);    
     EPD_2IN66_ReadBusy();
 }
 
@@ -216,11 +207,7 @@ void EPD_2IN66_Clear(void)
     Width = (EPD_2IN66_WIDTH % 8 == 0)? (EPD_2IN66_WIDTH / 8 ): (EPD_2IN66_WIDTH / 8 + 1);
     Height = EPD_2IN66_HEIGHT;
     EPD_2IN66_SendCommand(0x24);
-    for (UWORD j = 0; j <=Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN66_SendData(0xff);
-        }
-    }
+    EPD_Common_SendDataRepeat(0xff, Width * (Height + 1));
     EPD_2IN66_TurnOnDisplay();
 }
 
@@ -234,16 +221,10 @@ void EPD_2IN66_Display(UBYTE *Image)
     Width = (EPD_2IN66_WIDTH % 8 == 0)? (EPD_2IN66_WIDTH / 8 ): (EPD_2IN66_WIDTH / 8 + 1);
     Height = EPD_2IN66_HEIGHT;
 
-    UDOUBLE Addr = 0;
 	
     // UDOUBLE Offset = ImageName;
     EPD_2IN66_SendCommand(0x24);
-    for (UWORD j = 0; j <Height; j++) {
-        for (UWORD i = 0; i <Width; i++) {
-            Addr = i + j * Width;
-            EPD_2IN66_SendData(Image[Addr]);
-        }
-    }
+    EPD_Common_SendDataBuffer(Image, Width * Height);
     EPD_2IN66_TurnOnDisplay();
 }
 
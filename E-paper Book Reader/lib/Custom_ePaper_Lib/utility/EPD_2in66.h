@@ -31,6 +31,7 @@
 #define __EPD_2IN66_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_2IN66_WIDTH       152
@@ -43,4 +44,6 @@ void EPD_2IN66_Clear(void);
 void EPD_2IN66_Display(UBYTE *Image);
 void EPD_2IN66_Sleep(void);
 
+EPD_MODEL(EPD_2IN66, 1, 1);
+
 #endif
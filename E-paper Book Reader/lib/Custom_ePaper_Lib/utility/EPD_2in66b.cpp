@@ -28,126 +28,63 @@
 #
 ******************************************************************************/
 #include "EPD_2in66b.h"
-#include "Debug.h"
+#include "EPD_Panel.h"
+
+static const UBYTE EPD_2IN66B_Init_Script[] = {
+    EPD_RESET(200, 2, 200),
+    EPD_DELAY(50), EPD_BUSY,
+    EPD_CMD(0x12, 0),                   //soft reset
+    EPD_DELAY(50), EPD_BUSY,
+    EPD_CMD(0x11, 1), 0x03,             //data entry mode
+    EPD_CMD(0x44, 2), 0x00, (EPD_2IN66B_WIDTH - 1) >> 3, //SET_RAM_X_ADDRESS_START_END_POSITION
+    EPD_CMD(0x45, 4), 0x00, 0x00,       //SET_RAM_Y_ADDRESS_START_END_POSITION
+        (EPD_2IN66B_HEIGHT - 1) & 0xFF, (EPD_2IN66B_HEIGHT - 1) >> 8,
+    EPD_CMD(0x21, 2), 0x00, 0x80,       //Display update control
+    EPD_CMD(0x4E, 1), 0x00,             //SET_RAM_X_ADDRESS_COUNTER
+    EPD_CMD(0x4F, 2), 0x00, 0x00,       //SET_RAM_Y_ADDRESS_COUNTER
+    EPD_DELAY(50), EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_2IN66B_Refresh_Script[] = {
+    EPD_CMD(0x20, 0),                   //Activate Display Update Sequence
+    EPD_DELAY(50), EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_2IN66B_Sleep_Script[] = {
+    EPD_CMD(0x10, 1), 0x01,             //enter deep sleep
+    EPD_END
+};
+
+const EPD_PANEL EPD_2IN66B_Panel = {
+    "EPD_2IN66B", EPD_2IN66B_WIDTH, EPD_2IN66B_HEIGHT,
+    2, {
+        { 0x24, EPD_PLANE_IMAGE0, 0, 0xFF, 0 },   //black
+        { 0x26, EPD_PLANE_IMAGE1, 1, 0x00, 0 },   //red, 1 = red
+    },
+    0, 0, 0, 0, 50,
+    EPD_2IN66B_Init_Script, EPD_2IN66B_Refresh_Script, EPD_2IN66B_Sleep_Script,
+    EPD_CAP_RED,
+    NULL, NULL,
+};
 
 /******************************************************************************
-function :	Software reset
-parameter:
-******************************************************************************/
-static void EPD_2IN66B_Reset(void)
-{
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(200);
-    DEV_Digital_Write(EPD_RST_PIN, 0);
-    DEV_Delay_ms(2);
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(200);
-}
-
-/******************************************************************************
-function :	send command
-parameter:
-     Reg : Command register
-******************************************************************************/
-static void EPD_2IN66B_SendCommand(UBYTE Reg)
-{
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
-}
-
-/******************************************************************************
-function :	send data
-parameter:
-    Data : Write data
-******************************************************************************/
-static void EPD_2IN66B_SendData(UBYTE Data)
-{
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
-}
-
-/******************************************************************************
-function :	Wait until the busy_pin goes LOW
-parameter:
-******************************************************************************/
-static void EPD_2IN66B_ReadBusy(void)
-{
-    Debug("e-Paper busy\r\n");
-    DEV_Delay_ms(50);
-    while(DEV_Digital_Read(EPD_BUSY_PIN) == 1) {      //LOW: idle, HIGH: busy
-        DEV_Delay_ms(10);
-    }
-    DEV_Delay_ms(50);
-    Debug("e-Paper busy release\r\n");
-}
-
-/******************************************************************************
-function :	Turn On Display
-parameter:
-******************************************************************************/
-static void EPD_2IN66B_TurnOnDisplay(void)
-{
-    EPD_2IN66B_SendCommand(0x20);
-    EPD_2IN66B_ReadBusy();
-}
-
-/******************************************************************************
-function :	Setting the display window
-parameter:
-******************************************************************************/
-static void EPD_2IN66B_SetWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
-{
-    EPD_2IN66B_SendCommand(0x44); // SET_RAM_X_ADDRESS_START_END_POSITION
-    EPD_2IN66B_SendData((Xstart>>3) & 0x1F);
-    EPD_2IN66B_SendData((Xend>>3) & 0x1F);
-	
-    EPD_2IN66B_SendCommand(0x45); // SET_RAM_Y_ADDRESS_START_END_POSITION
-    EPD_2IN66B_SendData(Ystart & 0xFF);
-    EPD_2IN66B_SendData((Ystart >> 8) & 0x01);
-    EPD_2IN66B_SendData(Yend & 0xFF);
-    EPD_2IN66B_SendData((Yend >> 8) & 0x01);
-}
-
-/******************************************************************************
-function :	Set Cursor
+function :	Initialize the e-Paper register
 parameter:
 ******************************************************************************/
-static void EPD_2IN66B_SetCursor(UWORD Xstart, UWORD Ystart)
+void EPD_2IN66B_Init(void)
 {
-    EPD_2IN66B_SendCommand(0x4E); // SET_RAM_X_ADDRESS_COUNTER
-    EPD_2IN66B_SendData(Xstart & 0x1F);
-
-    EPD_2IN66B_SendCommand(0x4F); // SET_RAM_Y_ADDRESS_COUNTER
-    EPD_2IN66B_SendData(Ystart & 0xFF);
-    EPD_2IN66B_SendData((Ystart >> 8) & 0x01);
+    EPD_Panel_Init(&EPD_2IN66B_Panel);
 }
 
 /******************************************************************************
-function :	Initialize the e-Paper register
+function :	Clear screen
 parameter:
 ******************************************************************************/
-void EPD_2IN66B_Init(void)
+void EPD_2IN66B_Clear(void)
 {
-    EPD_2IN66B_Reset();
-    EPD_2IN66B_ReadBusy();
-    EPD_2IN66B_SendCommand(0x12);//soft  reset
-    EPD_2IN66B_ReadBusy();
-
-	EPD_2IN66B_SendCommand(0x11); //data entry mode       
-	EPD_2IN66B_SendData(0x03);
-
-	EPD_2IN66B_SetWindows(0, 0, EPD_2IN66B_WIDTH-1, EPD_2IN66B_HEIGHT-1);
-	
-	EPD_2IN66B_SendCommand(0x21); //  Display update control
-	EPD_2IN66B_SendData(0x00);
-	EPD_2IN66B_SendData(0x80);	
-
-	EPD_2IN66B_SetCursor(0, 0);
-	EPD_2IN66B_ReadBusy();
+    EPD_Panel_Clear(&EPD_2IN66B_Panel);
 }
 
 /******************************************************************************
@@ -156,50 +93,18 @@ parameter:
 ******************************************************************************/
 void EPD_2IN66B_Display(UBYTE *ImageBlack, UBYTE*ImageRed)
 {
-    UWORD Width, Height;
-    Width = (EPD_2IN66B_WIDTH % 8 == 0)? (EPD_2IN66B_WIDTH / 8 ): (EPD_2IN66B_WIDTH / 8 + 1);
-    Height = EPD_2IN66B_HEIGHT;
-
-    EPD_2IN66B_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN66B_SendData(ImageBlack[i + j * Width]);
-        }
-    }
-	
-    EPD_2IN66B_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN66B_SendData(~ImageRed[i + j * Width]);
-        }
-    }
-
-    EPD_2IN66B_TurnOnDisplay();
+    EPD_Panel_Display(&EPD_2IN66B_Panel, ImageBlack, ImageRed);
 }
 
 /******************************************************************************
-function :	Clear screen
+function :	Sends a 3 color picture to e-Paper and displays
 parameter:
+    Image : the black plane then the red plane, drawn with
+            Paint_SetColorPlanes(Ctx, EPD_2IN66B_COLOR)
 ******************************************************************************/
-void EPD_2IN66B_Clear(void)
+void EPD_2IN66B_Display_Planes(const UBYTE *Image)
 {
-    UWORD Width, Height;
-    Width = (EPD_2IN66B_WIDTH % 8 == 0)? (EPD_2IN66B_WIDTH / 8 ): (EPD_2IN66B_WIDTH / 8 + 1);
-    Height = EPD_2IN66B_HEIGHT;
-
-    EPD_2IN66B_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN66B_SendData(0xff);
-        }
-    }
-	EPD_2IN66B_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN66B_SendData(0x00);
-        }
-    }
-    EPD_2IN66B_TurnOnDisplay();
+    EPD_Panel_Display_Planes(&EPD_2IN66B_Panel, Image);
 }
 
 /******************************************************************************
@@ -208,6 +113,5 @@ parameter:
 ******************************************************************************/
 void EPD_2IN66B_Sleep(void)
 {
-    EPD_2IN66B_SendCommand(0x10);
-    EPD_2IN66B_SendData(0x01); 
+    EPD_Panel_Sleep(&EPD_2IN66B_Panel);
 }
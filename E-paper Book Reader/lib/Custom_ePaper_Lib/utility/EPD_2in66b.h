@@ -31,14 +31,23 @@
 #define __EPD_2IN66B_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
+#include "EPD_Panel.h"
 
 // Display resolution
 #define EPD_2IN66B_WIDTH       152
 #define EPD_2IN66B_HEIGHT      296
+#define EPD_2IN66B_COLOR       EPD_Color_RedHigh    //3 color planes, see Paint_SetColorPlanes()
+
+extern const EPD_PANEL EPD_2IN66B_Panel;
 
 
 void EPD_2IN66B_Init(void);
 void EPD_2IN66B_Display(UBYTE *ImageBlack, UBYTE*ImageRed);
+void EPD_2IN66B_Display_Planes(const UBYTE *Image);
 void EPD_2IN66B_Clear(void);
 void EPD_2IN66B_Sleep(void);
+
+EPD_MODEL(EPD_2IN66B, 2, 1);
+
 #endif
@@ -29,6 +29,7 @@
 #
 ******************************************************************************/
 #include "EPD_2in66g.h"
+#include "EPD_Common.h"
 #include "Debug.h"
 
 /******************************************************************************
@@ -37,6 +38,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN66g_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(20);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -52,10 +54,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN66g_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -65,10 +64,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN66g_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -78,9 +74,7 @@ parameter:
 static void EPD_2IN66g_ReadBusyH(void)
 {
     Debug("e-Paper busy H\r\n");
-    while(!DEV_Digital_Read(EPD_BUSY_PIN)) {      //LOW: idle, HIGH: busy
-        DEV_Delay_ms(5);
-    }
+    DEV_Wait_Busy(1, EPD_BUSY_TIMEOUT_MS);
     Debug("e-Paper busy H release\r\n");
 }
 
@@ -174,11 +168,7 @@ void EPD_2IN66g_Clear(UBYTE color)
     Height = EPD_2IN66g_HEIGHT;
 
     EPD_2IN66g_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-                EPD_2IN66g_SendData((color << 6) | (color << 4) | (color << 2) | color);
-        }
-    }
+    EPD_Common_SendDataRepeat((color << 6) | (color << 4) | (color << 2) | color, Width * Height);
 
     EPD_2IN66g_TurnOnDisplay();
 }
@@ -194,11 +184,7 @@ void EPD_2IN66g_Display(UBYTE *Image)
     Height = EPD_2IN66g_HEIGHT;
 
     EPD_2IN66g_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN66g_SendData(Image[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(Image, Width * Height);
 	
     EPD_2IN66g_TurnOnDisplay();
 }
@@ -32,6 +32,7 @@
 #define __EPD_2IN66g_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_2IN66g_WIDTH       184
@@ -48,4 +49,6 @@ void EPD_2IN66g_Clear(UBYTE color);
 void EPD_2IN66g_Display(UBYTE *Image);
 void EPD_2IN66g_Sleep(void);
 
+EPD_MODEL(EPD_2IN66g, 1, 2);
+
 #endif
@@ -90,6 +90,7 @@
 #
 ******************************************************************************/
 #include "EPD_2in7.h"
+#include "EPD_Common.h"
 #include "Debug.h"
 
 static const unsigned char EPD_2in7_lut_vcom_dc[] = {
@@ -198,6 +199,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2in7_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(200);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -213,10 +215,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2in7_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -226,10 +225,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2in7_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -239,12 +235,8 @@ parameter:
 static void EPD_2in7_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-    UBYTE busy;
-    do {
-        EPD_2in7_SendCommand(0x71);
-        busy = DEV_Digital_Read(EPD_BUSY_PIN);
-        busy =!(busy & 0x01);
-    } while(busy);
+    EPD_2in7_SendCommand(0x71);
+    DEV_Wait_Busy(1, EPD_BUSY_TIMEOUT_MS);
     DEV_Delay_ms(200);
     Debug("e-Paper busy release\r\n");
 }
@@ -255,65 +247,41 @@ parameter:
 ******************************************************************************/
 static void EPD_2in7_SetLut(void)
 {
-    unsigned int count;
     EPD_2in7_SendCommand(0x20); //vcom
-    for(count = 0; count < 44; count++) {
-        EPD_2in7_SendData(EPD_2in7_lut_vcom_dc[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_2in7_lut_vcom_dc, 44);
 
     EPD_2in7_SendCommand(0x21); //ww --
-    for(count = 0; count < 42; count++) {
-        EPD_2in7_SendData(EPD_2in7_lut_ww[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_2in7_lut_ww, 42);
 
     EPD_2in7_SendCommand(0x22); //bw r
-    for(count = 0; count < 42; count++) {
-        EPD_2in7_SendData(EPD_2in7_lut_bw[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_2in7_lut_bw, 42);
 
     EPD_2in7_SendCommand(0x23); //wb w
-    for(count = 0; count < 42; count++) {
-        EPD_2in7_SendData(EPD_2in7_lut_bb[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_2in7_lut_bb, 42);
 
     EPD_2in7_SendCommand(0x24); //bb b
-    for(count = 0; count < 42; count++) {
-        EPD_2in7_SendData(EPD_2in7_lut_wb[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_2in7_lut_wb, 42);
 }
 
 void EPD_2in7_gray_SetLut(void)
 {
-    unsigned int count;
     EPD_2in7_SendCommand(0x20);							//vcom
-    for(count=0; count<44; count++) {
-        EPD_2in7_SendData(EPD_2in7_gray_lut_vcom[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_2in7_gray_lut_vcom, 44);
 
     EPD_2in7_SendCommand(0x21);							//red not use
-    for(count=0; count<42; count++) {
-        EPD_2in7_SendData(EPD_2in7_gray_lut_ww[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_2in7_gray_lut_ww, 42);
 
     EPD_2in7_SendCommand(0x22);							//bw r
-    for(count=0; count<42; count++) {
-        EPD_2in7_SendData(EPD_2in7_gray_lut_bw[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_2in7_gray_lut_bw, 42);
 
     EPD_2in7_SendCommand(0x23);							//wb w
-    for(count=0; count<42; count++) {
-        EPD_2in7_SendData(EPD_2in7_gray_lut_wb[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_2in7_gray_lut_wb, 42);
 
     EPD_2in7_SendCommand(0x24);							//bb b
-    for(count=0; count<42; count++) {
-        EPD_2in7_SendData(EPD_2in7_gray_lut_bb[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_2in7_gray_lut_bb, 42);
 
     EPD_2in7_SendCommand(0x25);							//vcom
-    for(count=0; count<42; count++) {
-        EPD_2in7_SendData(EPD_2in7_gray_lut_ww[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_2in7_gray_lut_ww, 42);
 
 }
 
@@ -467,18 +435,10 @@ void EPD_2IN7_Clear(void)
     Height = EPD_2IN7_HEIGHT;
 
     EPD_2in7_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2in7_SendData(0XFF);
-        }
-    }
+    EPD_Common_SendDataRepeat(0XFF, Width * Height);
 
     EPD_2in7_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2in7_SendData(0XFF);
-        }
-    }
+    EPD_Common_SendDataRepeat(0XFF, Width * Height);
 
     EPD_2in7_SendCommand(0x12);
     EPD_2in7_ReadBusy();
@@ -495,100 +455,22 @@ void EPD_2IN7_Display(const UBYTE *Image)
     Height = EPD_2IN7_HEIGHT;
 
     EPD_2in7_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2in7_SendData(0XFF);
-        }
-    }
+    EPD_Common_SendDataRepeat(0XFF, Width * Height);
 
     EPD_2in7_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2in7_SendData(Image[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(Image, Width * Height);
     EPD_2in7_SendCommand(0x12);
     EPD_2in7_ReadBusy();
 }
 
 void EPD_2IN7_4GrayDisplay(const UBYTE *Image)
 {
-    UDOUBLE i,j,k;
-    UBYTE temp1,temp2,temp3;
-
     // old  data
     EPD_2in7_SendCommand(0x10);
-    for(i=0; i<5808; i++) {             //5808*4  46464
-        temp3=0;
-        for(j=0; j<2; j++) {
-            temp1 = Image[i*2+j];
-            for(k=0; k<2; k++) {
-                temp2 = temp1&0xC0;
-                if(temp2 == 0xC0)
-                    temp3 |= 0x01;//white
-                else if(temp2 == 0x00)
-                    temp3 |= 0x00;  //black
-                else if(temp2 == 0x80)
-                    temp3 |= 0x01;  //gray1
-                else //0x40
-                    temp3 |= 0x00; //gray2
-                temp3 <<= 1;
-
-                temp1 <<= 2;
-                temp2 = temp1&0xC0 ;
-                if(temp2 == 0xC0)  //white
-                    temp3 |= 0x01;
-                else if(temp2 == 0x00) //black
-                    temp3 |= 0x00;
-                else if(temp2 == 0x80)
-                    temp3 |= 0x01; //gray1
-                else    //0x40
-                    temp3 |= 0x00;	//gray2
-                if(j!=1 || k!=1)
-                    temp3 <<= 1;
-
-                temp1 <<= 2;
-            }
-
-        }
-        EPD_2in7_SendData(temp3);
-    }
+    EPD_Common_SendGrayPlane(Image, 11616, EPD_2IN7_GRAY, 0);
     // new  data
     EPD_2in7_SendCommand(0x13);
-    for(i=0; i<5808; i++) {             //5808*4  46464
-        temp3=0;
-        for(j=0; j<2; j++) {
-            temp1 = Image[i*2+j];
-            for(k=0; k<2; k++) {
-                temp2 = temp1&0xC0 ;
-                if(temp2 == 0xC0)
-                    temp3 |= 0x01;//white
-                else if(temp2 == 0x00)
-                    temp3 |= 0x00;  //black
-                else if(temp2 == 0x80)
-                    temp3 |= 0x00;  //gray1
-                else //0x40
-                    temp3 |= 0x01; //gray2
-                temp3 <<= 1;
-
-                temp1 <<= 2;
-                temp2 = temp1&0xC0 ;
-                if(temp2 == 0xC0)  //white
-                    temp3 |= 0x01;
-                else if(temp2 == 0x00) //black
-                    temp3 |= 0x00;
-                else if(temp2 == 0x80)
-                    temp3 |= 0x00; //gray1
-                else    //0x40
-                    temp3 |= 0x01;	//gray2
-                if(j!=1 || k!=1)
-                    temp3 <<= 1;
-
-                temp1 <<= 2;
-            }
-        }
-        EPD_2in7_SendData(temp3);
-    }
+    EPD_Common_SendGrayPlane(Image, 11616, EPD_2IN7_GRAY, 1);
 
     EPD_2in7_gray_SetLut();
     EPD_2in7_SendCommand(0x12);
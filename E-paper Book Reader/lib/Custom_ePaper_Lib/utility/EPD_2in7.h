@@ -94,10 +94,13 @@
 #define __EPD_2IN7_H_
 
 #include "DEV_Config.h"
+#include "EPD_Common.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_2IN7_WIDTH       176
 #define EPD_2IN7_HEIGHT      264 //46464
+#define EPD_2IN7_GRAY        EPD_Gray_Swap       //4 gray planes, see Paint_SetGrayPlanes()
 
 
 
@@ -108,4 +111,7 @@ void EPD_2IN7_Sleep(void);
 
 void EPD_2IN7_Init_4Gray(void);
 void EPD_2IN7_4GrayDisplay(const UBYTE *Image);
+
+EPD_MODEL(EPD_2IN7, 1, 1);
+
 #endif
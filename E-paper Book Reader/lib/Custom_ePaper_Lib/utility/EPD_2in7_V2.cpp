@@ -29,6 +29,8 @@
 #
 ******************************************************************************/
 #include "EPD_2in7_V2.h"
+#include "EPD_Common.h"
+#include "EPD_Panel.h"
 #include "Debug.h"
 
 UBYTE LUT_DATA_4Gray[159] =
@@ -60,6 +62,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN7_V2_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(20);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -75,10 +78,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN7_V2_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -88,10 +88,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN7_V2_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -101,10 +98,7 @@ parameter:
 static void EPD_2IN7_V2_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-    do {
-        if(DEV_Digital_Read(EPD_BUSY_PIN) == 0)
-			break;
-    } while(1);
+    DEV_Wait_Busy(0, EPD_BUSY_TIMEOUT_MS);
     DEV_Delay_ms(20);
     Debug("e-Paper busy release\r\n");
 }
@@ -150,40 +144,55 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN7_V2_Lut(void)
 {
-    unsigned int count;
     EPD_2IN7_V2_SendCommand(0x32); //vcom
-    for(count = 0; count < 153; count++) {
-        EPD_2IN7_V2_SendData(LUT_DATA_4Gray[count]);
-    }
+    EPD_Common_SendDataBuffer(LUT_DATA_4Gray, 153);
 }
 
 
+static const UBYTE EPD_2IN7_V2_Init_Script[] = {
+    EPD_RESET(20, 2, 20),
+    EPD_BUSY,
+    EPD_CMD(0x12, 0),               //SWRESET
+    EPD_BUSY,
+    EPD_CMD(0x45, 4), 0x00, 0x00, 0x07, 0x01, //set Ram-Y address start/end position, 0x0107-->(263+1)=264
+    EPD_CMD(0x4F, 2), 0x00, 0x00,   //set RAM y address count to 0
+    EPD_CMD(0x11, 1), 0x03,         //data entry mode
+    EPD_END
+};
+
+static const UBYTE EPD_2IN7_V2_Refresh_Script[] = {
+    EPD_CMD(0x22, 1), 0xF7,         //Display Update Control
+    EPD_CMD(0x20, 0),               //Activate Display Update Sequence
+    EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_2IN7_V2_Sleep_Script[] = {
+    EPD_CMD(0x10, 1), 0x01,         //enter deep sleep
+    EPD_END
+};
+
+const EPD_PANEL EPD_2IN7_V2_Panel = {
+    "EPD_2IN7_V2", EPD_2IN7_V2_WIDTH, EPD_2IN7_V2_HEIGHT,
+    1, {
+        { 0x24, EPD_PLANE_IMAGE0, 0, 0xFF, 0 },
+    },
+    0, 0, 0, 0, 20,
+    EPD_2IN7_V2_Init_Script, EPD_2IN7_V2_Refresh_Script, EPD_2IN7_V2_Sleep_Script,
+    EPD_CAP_PARTIAL | EPD_CAP_FAST | EPD_CAP_4GRAY,
+    NULL, NULL,                     //the analog supply is switched by each update sequence, no STANDBY
+    NULL,
+};
+
 /******************************************************************************
 function :	Initialize the e-Paper register
 parameter:
 ******************************************************************************/
 void EPD_2IN7_V2_Init(void)
 {
-    EPD_2IN7_V2_Reset();
-	EPD_2IN7_V2_ReadBusy();
-	
-	EPD_2IN7_V2_SendCommand(0x12); //SWRESET
-	EPD_2IN7_V2_ReadBusy();
-
-    EPD_2IN7_V2_SendCommand(0x45); //set Ram-Y address start/end position          
-	EPD_2IN7_V2_SendData(0x00);
-	EPD_2IN7_V2_SendData(0x00);
-	EPD_2IN7_V2_SendData(0x07); //0x0107-->(263+1)=264
-	EPD_2IN7_V2_SendData(0x01);
-
-    EPD_2IN7_V2_SendCommand(0x4F);   // set RAM y address count to 0;    
-	EPD_2IN7_V2_SendData(0x00);
-	EPD_2IN7_V2_SendData(0x00);
-
-    EPD_2IN7_V2_SendCommand(0x11);   // data entry mode
-	EPD_2IN7_V2_SendData(0x03);
-
+    EPD_Panel_Init(&EPD_2IN7_V2_Panel);
 }
+
 void EPD_2IN7_V2_Init_Fast(void)
 {
     EPD_2IN7_V2_Reset();
@@ -290,18 +299,7 @@ parameter:
 ******************************************************************************/
 void EPD_2IN7_V2_Clear(void)
 {
-    UWORD Width, Height;
-    Width = (EPD_2IN7_V2_WIDTH % 8 == 0)? (EPD_2IN7_V2_WIDTH / 8 ): (EPD_2IN7_V2_WIDTH / 8 + 1);
-    Height = EPD_2IN7_V2_HEIGHT;
-
-    EPD_2IN7_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN7_V2_SendData(0XFF);
-        }
-    }
-
-	EPD_2IN7_V2_TurnOnDisplay();
+    EPD_Panel_Clear(&EPD_2IN7_V2_Panel);
 }
 
 /******************************************************************************
@@ -310,18 +308,7 @@ parameter:
 ******************************************************************************/
 void EPD_2IN7_V2_Display(UBYTE *Image)
 {
-    UWORD Width, Height;
-    Width = (EPD_2IN7_V2_WIDTH % 8 == 0)? (EPD_2IN7_V2_WIDTH / 8 ): (EPD_2IN7_V2_WIDTH / 8 + 1);
-    Height = EPD_2IN7_V2_HEIGHT;
-	
-    EPD_2IN7_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN7_V2_SendData(Image[i + j * Width]);
-        }
-    }
-	
-	EPD_2IN7_V2_TurnOnDisplay();
+    EPD_Panel_Display(&EPD_2IN7_V2_Panel, Image, NULL);
 }
 
 void EPD_2IN7_V2_Display_Fast(UBYTE *Image)
@@ -331,11 +318,7 @@ void EPD_2IN7_V2_Display_Fast(UBYTE *Image)
     Height = EPD_2IN7_V2_HEIGHT;
 	
     EPD_2IN7_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN7_V2_SendData(Image[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(Image, Width * Height);
 	EPD_2IN7_V2_TurnOnDisplay_Fast();
 }
 
@@ -346,17 +329,9 @@ void EPD_2IN7_V2_Display_Base(UBYTE *Image)
     Height = EPD_2IN7_V2_HEIGHT;
 
 	EPD_2IN7_V2_SendCommand(0x24);   //Write Black and White image to RAM
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN7_V2_SendData(Image[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(Image, Width * Height);
 	EPD_2IN7_V2_SendCommand(0x26);   //Write Black and White image to RAM
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN7_V2_SendData(Image[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(Image, Width * Height);
 	EPD_2IN7_V2_TurnOnDisplay();	
 }
 
@@ -367,17 +342,9 @@ void EPD_2IN7_V2_Display_Base_color(UBYTE color)
     Height = EPD_2IN7_V2_HEIGHT;
 
 	EPD_2IN7_V2_SendCommand(0x24);   //Write Black and White image to RAM
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN7_V2_SendData(color);
-        }
-    }
+    EPD_Common_SendDataRepeat(color, Width * Height);
 	EPD_2IN7_V2_SendCommand(0x26);   //Write Black and White image to RAM
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN7_V2_SendData(color);
-        }
-    }
+    EPD_Common_SendDataRepeat(color, Width * Height);
 	// EPD_2IN7_V2_TurnOnDisplay();	
 }
 
@@ -395,7 +362,7 @@ void EPD_2IN7_V2_Display_Partial(const UBYTE *Image, UWORD Xstart, UWORD Ystart,
     }
     
 
-    UWORD i, Width;
+    UWORD Width;
 	Width = Xend -  Xstart;
 	UWORD IMAGE_COUNTER = Width * (Yend-Ystart);
 
@@ -424,93 +391,19 @@ void EPD_2IN7_V2_Display_Partial(const UBYTE *Image, UWORD Xstart, UWORD Ystart,
 
 
     EPD_2IN7_V2_SendCommand(0x24);   //Write Black and White image to RAM
-    for (i = 0; i < IMAGE_COUNTER; i++) {
-	    EPD_2IN7_V2_SendData(Image[i]);
-	}
+    EPD_Common_SendDataBuffer(Image, IMAGE_COUNTER);
 	EPD_2IN7_V2_TurnOnDisplay_Partial();
 }
 
 
 void EPD_2IN7_V2_4GrayDisplay(UBYTE *Image)
 {
-    UDOUBLE i,j,k;
-    UBYTE temp1,temp2,temp3;
-
     // old  data
     EPD_2IN7_V2_SendCommand(0x24);
-    for(i=0; i<5808; i++) {             //5808*4  46464
-        temp3=0;
-        for(j=0; j<2; j++) {
-            temp1 = Image[i*2+j];
-            for(k=0; k<2; k++) {
-                temp2 = temp1&0xC0;
-                if(temp2 == 0xC0)
-                    temp3 |= 0x00;
-                else if(temp2 == 0x00)
-                    temp3 |= 0x01; 
-                else if(temp2 == 0x80)
-                    temp3 |= 0x01; 
-                else //0x40
-                    temp3 |= 0x00; 
-                temp3 <<= 1;
-
-                temp1 <<= 2;
-                temp2 = temp1&0xC0 ;
-                if(temp2 == 0xC0) 
-                    temp3 |= 0x00;
-                else if(temp2 == 0x00) 
-                    temp3 |= 0x01;
-                else if(temp2 == 0x80)
-                    temp3 |= 0x01; 
-                else    //0x40
-                    temp3 |= 0x00;	
-                if(j!=1 || k!=1)
-                    temp3 <<= 1;
-
-                temp1 <<= 2;
-            }
-
-        }
-        EPD_2IN7_V2_SendData(temp3);
-        // printf("%x",temp3);
-    }
+    EPD_Common_SendGrayPlane(Image, 11616, EPD_2IN7_V2_GRAY, 0);
 
     EPD_2IN7_V2_SendCommand(0x26);   //write RAM for black(0)/white (1)
-    for(i=0; i<5808; i++) {             //5808*4  46464
-        temp3=0;
-        for(j=0; j<2; j++) {
-            temp1 = Image[i*2+j];
-            for(k=0; k<2; k++) {
-                temp2 = temp1&0xC0 ;
-                if(temp2 == 0xC0)
-                    temp3 |= 0x00;//white
-                else if(temp2 == 0x00)
-                    temp3 |= 0x01;  //black
-                else if(temp2 == 0x80)
-                    temp3 |= 0x00;  //gray1
-                else //0x40
-                    temp3 |= 0x01; //gray2
-                temp3 <<= 1;
-
-                temp1 <<= 2;
-                temp2 = temp1&0xC0 ;
-                if(temp2 == 0xC0)  //white
-                    temp3 |= 0x00;
-                else if(temp2 == 0x00) //black
-                    temp3 |= 0x01;
-                else if(temp2 == 0x80)
-                    temp3 |= 0x00; //gray1
-                else    //0x40
-                    temp3 |= 0x01;	//gray2
-                if(j!=1 || k!=1)
-                    temp3 <<= 1;
-
-                temp1 <<= 2;
-            }
-        }
-        EPD_2IN7_V2_SendData(temp3);
-        // printf("%x",temp3);
-    }
+    EPD_Common_SendGrayPlane(Image, 11616, EPD_2IN7_V2_GRAY, 1);
 
     EPD_2IN7_V2_TurnOnDisplay_4GRAY();
 }
@@ -521,6 +414,5 @@ parameter:
 ******************************************************************************/
 void EPD_2IN7_V2_Sleep(void)
 {
-    EPD_2IN7_V2_SendCommand(0X10);
-    EPD_2IN7_V2_SendData(0x01);
+    EPD_Panel_Sleep(&EPD_2IN7_V2_Panel);
 }
@@ -32,10 +32,16 @@
 #define __EPD_2IN7_V2_H_
 
 #include "DEV_Config.h"
+#include "EPD_Common.h"
+#include "EPD_Model.h"
+#include "EPD_Panel.h"
 
 // Display resolution
 #define EPD_2IN7_V2_WIDTH       176
 #define EPD_2IN7_V2_HEIGHT      264
+#define EPD_2IN7_V2_GRAY        EPD_Gray_Invert     //4 gray planes, see Paint_SetGrayPlanes()
+
+extern const EPD_PANEL EPD_2IN7_V2_Panel;
 
 void EPD_2IN7_V2_Init(void);
 void EPD_2IN7_V2_Init_Fast(void);
@@ -49,4 +55,6 @@ void EPD_2IN7_V2_Display_Partial(const UBYTE *Image, UWORD Xstart, UWORD Ystart,
 void EPD_2IN7_V2_4GrayDisplay(UBYTE *Image);
 void EPD_2IN7_V2_Sleep(void);
 
+EPD_MODEL(EPD_2IN7_V2, 1, 1);
+
 #endif
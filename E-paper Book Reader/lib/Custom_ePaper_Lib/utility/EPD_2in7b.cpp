@@ -87,148 +87,104 @@
 #
 ******************************************************************************/
 #include "EPD_2in7b.h"
-#include "Debug.h"
-
-static const unsigned char EPD_2IN7B_lut_vcom_dc[] = {
-    0x00, 0x00,
-    0x00, 0x1A, 0x1A, 0x00, 0x00, 0x01,
-    0x00, 0x0A, 0x0A, 0x00, 0x00, 0x08,
-    0x00, 0x0E, 0x01, 0x0E, 0x01, 0x10,
-    0x00, 0x0A, 0x0A, 0x00, 0x00, 0x08,
-    0x00, 0x04, 0x10, 0x00, 0x00, 0x05,
-    0x00, 0x03, 0x0E, 0x00, 0x00, 0x0A,
-    0x00, 0x23, 0x00, 0x00, 0x00, 0x01
+#include "EPD_Panel.h"
+
+static const UBYTE EPD_2IN7B_Init_Script[] = {
+    EPD_RESET(200, 10, 200),
+    EPD_CMD(0x04, 0),                   //POWER_ON
+    EPD_BUSY,
+    EPD_CMD(0x00, 1), 0xaf,             //PANEL_SETTING, KW-BF   KWR-AF BWROTP 0f
+    EPD_CMD(0x30, 1), 0x3a,             //PLL_CONTROL, 3A 100HZ   29 150Hz 39 200HZ    31 171HZ
+    EPD_CMD(0x01, 5), 0x03, 0x00, 0x2b, 0x2b, 0x09, //POWER_SETTING, VDS_EN VDG_EN, VCOM_HV VGHL_LV, VDH, VDL, VDHR
+    EPD_CMD(0x06, 3), 0x07, 0x07, 0x17, //BOOSTER_SOFT_START
+    EPD_CMD(0xF8, 2), 0x60, 0xA5,       //Power optimization
+    EPD_CMD(0xF8, 2), 0x89, 0xA5,
+    EPD_CMD(0xF8, 2), 0x90, 0x00,
+    EPD_CMD(0xF8, 2), 0x93, 0x2A,
+    EPD_CMD(0xF8, 2), 0x73, 0x41,
+    EPD_CMD(0x82, 1), 0x12,             //VCM_DC_SETTING_REGISTER
+    EPD_CMD(0x50, 1), 0x87,             //VCOM_AND_DATA_INTERVAL_SETTING, define by OTP
+    EPD_CMD(0x20, 44),                  //vcom
+        0x00, 0x00,
+        0x00, 0x1A, 0x1A, 0x00, 0x00, 0x01,
+        0x00, 0x0A, 0x0A, 0x00, 0x00, 0x08,
+        0x00, 0x0E, 0x01, 0x0E, 0x01, 0x10,
+        0x00, 0x0A, 0x0A, 0x00, 0x00, 0x08,
+        0x00, 0x04, 0x10, 0x00, 0x00, 0x05,
+        0x00, 0x03, 0x0E, 0x00, 0x00, 0x0A,
+        0x00, 0x23, 0x00, 0x00, 0x00, 0x01,
+    EPD_CMD(0x21, 42),                  //ww --
+        0x90, 0x1A, 0x1A, 0x00, 0x00, 0x01,
+        0x40, 0x0A, 0x0A, 0x00, 0x00, 0x08,
+        0x84, 0x0E, 0x01, 0x0E, 0x01, 0x10,
+        0x80, 0x0A, 0x0A, 0x00, 0x00, 0x08,
+        0x00, 0x04, 0x10, 0x00, 0x00, 0x05,
+        0x00, 0x03, 0x0E, 0x00, 0x00, 0x0A,
+        0x00, 0x23, 0x00, 0x00, 0x00, 0x01,
+    EPD_CMD(0x22, 42),                  //bw r
+        0xA0, 0x1A, 0x1A, 0x00, 0x00, 0x01,
+        0x00, 0x0A, 0x0A, 0x00, 0x00, 0x08,
+        0x84, 0x0E, 0x01, 0x0E, 0x01, 0x10,
+        0x90, 0x0A, 0x0A, 0x00, 0x00, 0x08,
+        0xB0, 0x04, 0x10, 0x00, 0x00, 0x05,
+        0xB0, 0x03, 0x0E, 0x00, 0x00, 0x0A,
+        0xC0, 0x23, 0x00, 0x00, 0x00, 0x01,
+    EPD_CMD(0x23, 42),                  //wb w
+        0x90, 0x1A, 0x1A, 0x00, 0x00, 0x01,
+        0x40, 0x0A, 0x0A, 0x00, 0x00, 0x08,
+        0x84, 0x0E, 0x01, 0x0E, 0x01, 0x10,
+        0x80, 0x0A, 0x0A, 0x00, 0x00, 0x08,
+        0x00, 0x04, 0x10, 0x00, 0x00, 0x05,
+        0x00, 0x03, 0x0E, 0x00, 0x00, 0x0A,
+        0x00, 0x23, 0x00, 0x00, 0x00, 0x01,
+    EPD_CMD(0x24, 42),                  //bb b
+        0x90, 0x1A, 0x1A, 0x00, 0x00, 0x01,
+        0x20, 0x0A, 0x0A, 0x00, 0x00, 0x08,
+        0x84, 0x0E, 0x01, 0x0E, 0x01, 0x10,
+        0x10, 0x0A, 0x0A, 0x00, 0x00, 0x08,
+        0x00, 0x04, 0x10, 0x00, 0x00, 0x05,
+        0x00, 0x03, 0x0E, 0x00, 0x00, 0x0A,
+        0x00, 0x23, 0x00, 0x00, 0x00, 0x01,
+    EPD_CMD(0x16, 1), 0x00,             //PARTIAL_DISPLAY_REFRESH
+    EPD_END
 };
 
-//R21H
-static const unsigned char EPD_2IN7B_lut_ww[] = {
-    0x90, 0x1A, 0x1A, 0x00, 0x00, 0x01,
-    0x40, 0x0A, 0x0A, 0x00, 0x00, 0x08,
-    0x84, 0x0E, 0x01, 0x0E, 0x01, 0x10,
-    0x80, 0x0A, 0x0A, 0x00, 0x00, 0x08,
-    0x00, 0x04, 0x10, 0x00, 0x00, 0x05,
-    0x00, 0x03, 0x0E, 0x00, 0x00, 0x0A,
-    0x00, 0x23, 0x00, 0x00, 0x00, 0x01
+static const UBYTE EPD_2IN7B_Refresh_Script[] = {
+    EPD_CMD(0x12, 0),                   //DISPLAY_REFRESH
+    EPD_BUSY,
+    EPD_END
 };
 
-//R22H    r
-static const unsigned char EPD_2IN7B_lut_bw[] = {
-    0xA0, 0x1A, 0x1A, 0x00, 0x00, 0x01,
-    0x00, 0x0A, 0x0A, 0x00, 0x00, 0x08,
-    0x84, 0x0E, 0x01, 0x0E, 0x01, 0x10,
-    0x90, 0x0A, 0x0A, 0x00, 0x00, 0x08,
-    0xB0, 0x04, 0x10, 0x00, 0x00, 0x05,
-    0xB0, 0x03, 0x0E, 0x00, 0x00, 0x0A,
-    0xC0, 0x23, 0x00, 0x00, 0x00, 0x01
+static const UBYTE EPD_2IN7B_Sleep_Script[] = {
+    EPD_CMD(0x50, 1), 0xf7,
+    EPD_CMD(0x02, 0),                   //power off
+    EPD_CMD(0x07, 1), 0xA5,             //deep sleep
+    EPD_END
 };
 
-//R23H    w
-static const unsigned char EPD_2IN7B_lut_bb[] = {
-    0x90, 0x1A, 0x1A, 0x00, 0x00, 0x01,
-    0x40, 0x0A, 0x0A, 0x00, 0x00, 0x08,
-    0x84, 0x0E, 0x01, 0x0E, 0x01, 0x10,
-    0x80, 0x0A, 0x0A, 0x00, 0x00, 0x08,
-    0x00, 0x04, 0x10, 0x00, 0x00, 0x05,
-    0x00, 0x03, 0x0E, 0x00, 0x00, 0x0A,
-    0x00, 0x23, 0x00, 0x00, 0x00, 0x01
+static const UBYTE EPD_2IN7B_PowerOff_Script[] = {
+    EPD_CMD(0x02, 0),                   //POWER_OFF
+    EPD_BUSY,
+    EPD_END
 };
 
-//R24H    b
-static const unsigned char EPD_2IN7B_lut_wb[] = {
-    0x90, 0x1A, 0x1A, 0x00, 0x00, 0x01,
-    0x20, 0x0A, 0x0A, 0x00, 0x00, 0x08,
-    0x84, 0x0E, 0x01, 0x0E, 0x01, 0x10,
-    0x10, 0x0A, 0x0A, 0x00, 0x00, 0x08,
-    0x00, 0x04, 0x10, 0x00, 0x00, 0x05,
-    0x00, 0x03, 0x0E, 0x00, 0x00, 0x0A,
-    0x00, 0x23, 0x00, 0x00, 0x00, 0x01
+static const UBYTE EPD_2IN7B_PowerOn_Script[] = {
+    EPD_CMD(0x04, 0),                   //POWER_ON
+    EPD_BUSY,
+    EPD_END
 };
 
-/******************************************************************************
-function :	Software reset
-parameter:
-******************************************************************************/
-static void EPD_2IN7B_Reset(void)
-{
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(200);
-    DEV_Digital_Write(EPD_RST_PIN, 0);
-    DEV_Delay_ms(10);
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(200);
-}
-
-/******************************************************************************
-function :	send command
-parameter:
-     Reg : Command register
-******************************************************************************/
-static void EPD_2IN7B_SendCommand(UBYTE Reg)
-{
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
-}
-
-/******************************************************************************
-function :	send data
-parameter:
-    Data : Write data
-******************************************************************************/
-static void EPD_2IN7B_SendData(UBYTE Data)
-{
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
-}
-
-/******************************************************************************
-function :	Wait until the busy_pin goes LOW
-parameter:
-******************************************************************************/
-static void EPD_2IN7B_ReadBusy(void)
-{
-    Debug("e-Paper busy\r\n");
-    while(DEV_Digital_Read(EPD_BUSY_PIN) == 0) {      //0: busy, 1: idle
-        DEV_Delay_ms(100);
-    }    
-    Debug("e-Paper busy release\r\n");
-}
-
-/******************************************************************************
-function :	set the look-up tables
-parameter:
-******************************************************************************/
-static void EPD_2IN7B_SetLut(void)
-{
-    unsigned int count;     
-    EPD_2IN7B_SendCommand(0x20); //vcom
-    for(count = 0; count < 44; count++) {
-        EPD_2IN7B_SendData(EPD_2IN7B_lut_vcom_dc[count]);
-    }
-    
-    EPD_2IN7B_SendCommand(0x21); //ww --
-    for(count = 0; count < 42; count++) {
-        EPD_2IN7B_SendData(EPD_2IN7B_lut_ww[count]);
-    }   
-    
-    EPD_2IN7B_SendCommand(0x22); //bw r
-    for(count = 0; count < 42; count++) {
-        EPD_2IN7B_SendData(EPD_2IN7B_lut_bw[count]);
-    } 
-
-    EPD_2IN7B_SendCommand(0x23); //wb w
-    for(count = 0; count < 42; count++) {
-        EPD_2IN7B_SendData(EPD_2IN7B_lut_bb[count]);
-    } 
-
-    EPD_2IN7B_SendCommand(0x24); //bb b
-    for(count = 0; count < 42; count++) {
-        EPD_2IN7B_SendData(EPD_2IN7B_lut_wb[count]);
-    } 
-}
+const EPD_PANEL EPD_2IN7B_Panel = {
+    "EPD_2IN7B", EPD_2IN7B_WIDTH, EPD_2IN7B_HEIGHT,
+    2, {
+        { 0x10, EPD_PLANE_IMAGE0, 1, 0x00, 0 },   //black, 1 = black
+        { 0x13, EPD_PLANE_IMAGE1, 1, 0x00, 0 },   //red, 1 = red
+    },
+    0x11, 1, 1, 0, 0,
+    EPD_2IN7B_Init_Script, EPD_2IN7B_Refresh_Script, EPD_2IN7B_Sleep_Script,
+    EPD_CAP_RED,
+    EPD_2IN7B_PowerOff_Script, EPD_2IN7B_PowerOn_Script,
+};
 
 /******************************************************************************
 function :	Initialize the e-Paper register
@@ -236,63 +192,7 @@ parameter:
 ******************************************************************************/
 void EPD_2IN7B_Init(void)
 {
-    EPD_2IN7B_Reset();
-
-    EPD_2IN7B_SendCommand(0x04); // POWER_ON
-    EPD_2IN7B_ReadBusy();
-
-    EPD_2IN7B_SendCommand(0x00); // PANEL_SETTING
-    EPD_2IN7B_SendData(0xaf); // KW-BF   KWR-AF BWROTP 0f
-
-    EPD_2IN7B_SendCommand(0x30); // PLL_CONTROL
-    EPD_2IN7B_SendData(0x3a); //3A 100HZ   29 150Hz 39 200HZ    31 171HZ
-
-    EPD_2IN7B_SendCommand(0x01); // PANEL_SETTING
-    EPD_2IN7B_SendData(0x03); // VDS_EN, VDG_EN
-    EPD_2IN7B_SendData(0x00); // VCOM_HV, VGHL_LV[1], VGHL_LV[0]
-    EPD_2IN7B_SendData(0x2b); // VDH
-    EPD_2IN7B_SendData(0x2b); // VDL
-    EPD_2IN7B_SendData(0x09); // VDHR
-
-    EPD_2IN7B_SendCommand(0x06);  // BOOSTER_SOFT_START
-    EPD_2IN7B_SendData(0x07);
-    EPD_2IN7B_SendData(0x07);
-    EPD_2IN7B_SendData(0x17);
-
-    // Power optimization
-    EPD_2IN7B_SendCommand(0xF8);
-    EPD_2IN7B_SendData(0x60);
-    EPD_2IN7B_SendData(0xA5);
-
-    // Power optimization
-    EPD_2IN7B_SendCommand(0xF8);
-    EPD_2IN7B_SendData(0x89);
-    EPD_2IN7B_SendData(0xA5);
-
-    // Power optimization
-    EPD_2IN7B_SendCommand(0xF8);
-    EPD_2IN7B_SendData(0x90);
-    EPD_2IN7B_SendData(0x00);
-
-    // Power optimization
-    EPD_2IN7B_SendCommand(0xF8);
-    EPD_2IN7B_SendData(0x93);
-    EPD_2IN7B_SendData(0x2A);
-
-    // Power optimization
-    EPD_2IN7B_SendCommand(0xF8);
-    EPD_2IN7B_SendData(0x73);
-    EPD_2IN7B_SendData(0x41);
-
-    EPD_2IN7B_SendCommand(0x82); // VCM_DC_SETTING_REGISTER
-    EPD_2IN7B_SendData(0x12);
-    EPD_2IN7B_SendCommand(0x50); // VCOM_AND_DATA_INTERVAL_SETTING
-    EPD_2IN7B_SendData(0x87); // define by OTP
-
-    EPD_2IN7B_SetLut();
-
-    EPD_2IN7B_SendCommand(0x16); // PARTIAL_DISPLAY_REFRESH
-    EPD_2IN7B_SendData(0x00);
+    EPD_Panel_Init(&EPD_2IN7B_Panel);
 }
 
 /******************************************************************************
@@ -300,29 +200,8 @@ function :	Clear screen
 parameter:
 ******************************************************************************/
 void EPD_2IN7B_Clear(void)
-{    
-    UWORD Width, Height;
-    Width = (EPD_2IN7B_WIDTH % 8 == 0)? (EPD_2IN7B_WIDTH / 8 ): (EPD_2IN7B_WIDTH / 8 + 1);
-    Height = EPD_2IN7B_HEIGHT;
-
-    EPD_2IN7B_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN7B_SendData(0X00);
-        }
-    }
-    EPD_2IN7B_SendCommand(0x11); // DATA_STOP
-
-    EPD_2IN7B_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN7B_SendData(0X00);
-        }
-    }
-    EPD_2IN7B_SendCommand(0x11); // DATA_STOP
-    
-    EPD_2IN7B_SendCommand(0x12);
-    EPD_2IN7B_ReadBusy();
+{
+    EPD_Panel_Clear(&EPD_2IN7B_Panel);
 }
 
 /******************************************************************************
@@ -331,29 +210,7 @@ parameter:
 ******************************************************************************/
 void EPD_2IN7B_Display(UBYTE *Imageblack, UBYTE *Imagered)
 {
-    UWORD Width, Height;
-    Width = (EPD_2IN7B_WIDTH % 8 == 0)? (EPD_2IN7B_WIDTH / 8 ): (EPD_2IN7B_WIDTH / 8 + 1);
-    Height = EPD_2IN7B_HEIGHT;
-
-    EPD_2IN7B_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN7B_SendData(~Imageblack[i + j * Width]);
-        }
-    }
-    EPD_2IN7B_SendCommand(0x11); // DATA_STOP
-    
-    EPD_2IN7B_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN7B_SendData(~Imagered[i + j * Width]);
-        }
-    }
- 
-    EPD_2IN7B_SendCommand(0x11); // DATA_STOP
-    
-    EPD_2IN7B_SendCommand(0x12);
-    EPD_2IN7B_ReadBusy();
+    EPD_Panel_Display(&EPD_2IN7B_Panel, Imageblack, Imagered);
 }
 
 /******************************************************************************
@@ -362,9 +219,5 @@ parameter:
 ******************************************************************************/
 void EPD_2IN7B_Sleep(void)
 {
-    EPD_2IN7B_SendCommand(0X50);
-    EPD_2IN7B_SendData(0xf7);
-    EPD_2IN7B_SendCommand(0X02); //power off
-    EPD_2IN7B_SendCommand(0X07); //deep sleep
-    EPD_2IN7B_SendData(0xA5);
+    EPD_Panel_Sleep(&EPD_2IN7B_Panel);
 }
@@ -90,14 +90,20 @@
 #define __EPD_2IN7B_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
+#include "EPD_Panel.h"
 
 // Display resolution
 #define EPD_2IN7B_WIDTH       176
 #define EPD_2IN7B_HEIGHT      264
 
+extern const EPD_PANEL EPD_2IN7B_Panel;
+
 void EPD_2IN7B_Init(void);
 void EPD_2IN7B_Clear(void);
 void EPD_2IN7B_Display(UBYTE *Imageblack, UBYTE *Imagered);
 void EPD_2IN7B_Sleep(void);
 
+EPD_MODEL(EPD_2IN7B, 2, 1);
+
 #endif
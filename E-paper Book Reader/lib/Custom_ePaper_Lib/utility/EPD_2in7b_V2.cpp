@@ -29,97 +29,45 @@
 #
 ******************************************************************************/
 #include "EPD_2in7b_V2.h"
-#include "Debug.h"
-
-/******************************************************************************
-function :	Software reset
-parameter:
-******************************************************************************/
-static void EPD_2IN7B_V2_Reset(void)
-{
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(200);
-    DEV_Digital_Write(EPD_RST_PIN, 0);
-    DEV_Delay_ms(2);
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(200);
-}
-
-/******************************************************************************
-function :	send command
-parameter:
-     Reg : Command register
-******************************************************************************/
-static void EPD_2IN7B_V2_SendCommand(UBYTE Reg)
-{
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
-}
-
-/******************************************************************************
-function :	send data
-parameter:
-    Data : Write data
-******************************************************************************/
-static void EPD_2IN7B_V2_SendData(UBYTE Data)
-{
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
-}
-
-/******************************************************************************
-function :	Wait until the busy_pin goes LOW
-parameter:
-******************************************************************************/
-static void EPD_2IN7B_V2_ReadBusy(void)
-{
-    Debug("e-Paper busy\r\n");
-    while(DEV_Digital_Read(EPD_BUSY_PIN) == 1) {      //0: busy, 1: idle
-        DEV_Delay_ms(20);
-    }
-    Debug("e-Paper busy release\r\n");
-}
-
-static void EPD_2IN7B_V2_TurnOnDisplay(void)
-{
-	EPD_2IN7B_V2_SendCommand(0x20); 
-	EPD_2IN7B_V2_ReadBusy();
-}
-
-/******************************************************************************
-function :	Setting the display window
-parameter:
-******************************************************************************/
-static void EPD_2IN7B_V2_SetWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
-{
-    EPD_2IN7B_V2_SendCommand(0x44); // SET_RAM_X_ADDRESS_START_END_POSITION
-    EPD_2IN7B_V2_SendData((Xstart>>3) & 0xFF);
-    EPD_2IN7B_V2_SendData((Xend>>3) & 0xFF);
-	
-    EPD_2IN7B_V2_SendCommand(0x45); // SET_RAM_Y_ADDRESS_START_END_POSITION
-    EPD_2IN7B_V2_SendData(Ystart & 0xFF);
-    EPD_2IN7B_V2_SendData((Ystart >> 8) & 0xFF);
-    EPD_2IN7B_V2_SendData(Yend & 0xFF);
-    EPD_2IN7B_V2_SendData((Yend >> 8) & 0xFF);
-}
-
-/******************************************************************************
-function :	Set Cursor
-parameter:
-******************************************************************************/
-static void EPD_2IN7B_V2_SetCursor(UWORD Xstart, UWORD Ystart)
-{
-    EPD_2IN7B_V2_SendCommand(0x4E); // SET_RAM_X_ADDRESS_COUNTER
-    EPD_2IN7B_V2_SendData(Xstart & 0xFF);
-
-    EPD_2IN7B_V2_SendCommand(0x4F); // SET_RAM_Y_ADDRESS_COUNTER
-    EPD_2IN7B_V2_SendData(Ystart & 0xFF);
-    EPD_2IN7B_V2_SendData((Ystart >> 8) & 0xFF);
-}
+#include "EPD_Panel.h"
+
+static const UBYTE EPD_2IN7B_V2_Init_Script[] = {
+    EPD_RESET(200, 2, 200),
+    EPD_BUSY,
+    EPD_CMD(0x12, 0),                   //soft reset
+    EPD_BUSY,
+    EPD_CMD(0x00, 3), 0x27, 0x01, 0x00,
+    EPD_CMD(0x11, 1), 0x03,             //data entry mode
+    EPD_CMD(0x44, 2), 0x00, (EPD_2IN7B_V2_WIDTH - 1) >> 3, //SET_RAM_X_ADDRESS_START_END_POSITION
+    EPD_CMD(0x45, 4), 0x00, 0x00,       //SET_RAM_Y_ADDRESS_START_END_POSITION
+        (EPD_2IN7B_V2_HEIGHT - 1) & 0xFF, (EPD_2IN7B_V2_HEIGHT - 1) >> 8,
+    EPD_CMD(0x4E, 1), 0x00,             //SET_RAM_X_ADDRESS_COUNTER
+    EPD_CMD(0x4F, 2), 0x00, 0x00,       //SET_RAM_Y_ADDRESS_COUNTER
+    EPD_END
+};
+
+static const UBYTE EPD_2IN7B_V2_Refresh_Script[] = {
+    EPD_CMD(0x20, 0),                   //Activate Display Update Sequence
+    EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_2IN7B_V2_Sleep_Script[] = {
+    EPD_CMD(0x10, 1), 0x01,             //Deep sleep
+    EPD_END
+};
+
+const EPD_PANEL EPD_2IN7B_V2_Panel = {
+    "EPD_2IN7B_V2", EPD_2IN7B_V2_WIDTH, EPD_2IN7B_V2_HEIGHT,
+    2, {
+        { 0x24, EPD_PLANE_IMAGE0, 0, 0xFF, 0 },   //black
+        { 0x26, EPD_PLANE_IMAGE1, 1, 0x00, 0 },   //red, 1 = red
+    },
+    0, 0, 0, 0, 0,
+    EPD_2IN7B_V2_Init_Script, EPD_2IN7B_V2_Refresh_Script, EPD_2IN7B_V2_Sleep_Script,
+    EPD_CAP_RED,
+    NULL, NULL,
+};
 
 /******************************************************************************
 function :	Initialize the e-Paper register
@@ -127,22 +75,7 @@ parameter:
 ******************************************************************************/
 void EPD_2IN7B_V2_Init(void)
 {
-	EPD_2IN7B_V2_Reset();
-
-	EPD_2IN7B_V2_ReadBusy();
-	EPD_2IN7B_V2_SendCommand(0x12);    
-	EPD_2IN7B_V2_ReadBusy();
-	
-	EPD_2IN7B_V2_SendCommand(0x00);    
-	EPD_2IN7B_V2_SendData(0x27);
-	EPD_2IN7B_V2_SendData(0x01);
-	EPD_2IN7B_V2_SendData(0x00);
-	
-	EPD_2IN7B_V2_SendCommand(0x11);    
-	EPD_2IN7B_V2_SendData(0x03);
-
-	EPD_2IN7B_V2_SetWindows(0, 0, EPD_2IN7B_V2_WIDTH-1, EPD_2IN7B_V2_HEIGHT-1);
-	EPD_2IN7B_V2_SetCursor(0, 0);
+    EPD_Panel_Init(&EPD_2IN7B_V2_Panel);
 }
 
 /******************************************************************************
@@ -150,25 +83,8 @@ function :	Clear screen
 parameter:
 ******************************************************************************/
 void EPD_2IN7B_V2_Clear(void)
-{    
-    UWORD Width, Height;
-    Width = (EPD_2IN7B_V2_WIDTH % 8 == 0)? (EPD_2IN7B_V2_WIDTH / 8 ): (EPD_2IN7B_V2_WIDTH / 8 + 1);
-    Height = EPD_2IN7B_V2_HEIGHT;
-
-    EPD_2IN7B_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN7B_V2_SendData(0Xff);
-        }
-    }
-    EPD_2IN7B_V2_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN7B_V2_SendData(0X00);
-        }
-    }
-
-	EPD_2IN7B_V2_TurnOnDisplay();
+{
+    EPD_Panel_Clear(&EPD_2IN7B_V2_Panel);
 }
 
 /******************************************************************************
@@ -177,25 +93,18 @@ parameter:
 ******************************************************************************/
 void EPD_2IN7B_V2_Display(UBYTE *Imageblack, UBYTE *Imagered)
 {
-    UWORD Width, Height;
-    Width = (EPD_2IN7B_V2_WIDTH % 8 == 0)? (EPD_2IN7B_V2_WIDTH / 8 ): (EPD_2IN7B_V2_WIDTH / 8 + 1);
-    Height = EPD_2IN7B_V2_HEIGHT;
-
-    EPD_2IN7B_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN7B_V2_SendData(Imageblack[i + j * Width]);
-        }
-    }
-    
-    EPD_2IN7B_V2_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN7B_V2_SendData(~Imagered[i + j * Width]);
-        }
-    }
+    EPD_Panel_Display(&EPD_2IN7B_V2_Panel, Imageblack, Imagered);
+}
 
-	EPD_2IN7B_V2_TurnOnDisplay();
+/******************************************************************************
+function :	Sends a 3 color picture to e-Paper and displays
+parameter:
+    Image : the black plane then the red plane, drawn with
+            Paint_SetColorPlanes(Ctx, EPD_2IN7B_V2_COLOR)
+******************************************************************************/
+void EPD_2IN7B_V2_Display_Planes(const UBYTE *Image)
+{
+    EPD_Panel_Display_Planes(&EPD_2IN7B_V2_Panel, Image);
 }
 
 /******************************************************************************
@@ -204,6 +113,5 @@ parameter:
 ******************************************************************************/
 void EPD_2IN7B_V2_Sleep(void)
 {
-  	EPD_2IN7B_V2_SendCommand(0x10);  // Deep sleep
-  	EPD_2IN7B_V2_SendData(0x01);
+    EPD_Panel_Sleep(&EPD_2IN7B_V2_Panel);
 }
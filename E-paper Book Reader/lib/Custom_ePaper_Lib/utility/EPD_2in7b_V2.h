@@ -32,14 +32,22 @@
 #define __EPD_2IN7B_V2_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
+#include "EPD_Panel.h"
 
 // Display resolution
 #define EPD_2IN7B_V2_WIDTH       176
 #define EPD_2IN7B_V2_HEIGHT      264
+#define EPD_2IN7B_V2_COLOR       EPD_Color_RedHigh    //3 color planes, see Paint_SetColorPlanes()
+
+extern const EPD_PANEL EPD_2IN7B_V2_Panel;
 
 void EPD_2IN7B_V2_Init(void);
 void EPD_2IN7B_V2_Clear(void);
 void EPD_2IN7B_V2_Display(UBYTE *Imageblack, UBYTE *Imagered);
+void EPD_2IN7B_V2_Display_Planes(const UBYTE *Image);
 void EPD_2IN7B_V2_Sleep(void);
 
+EPD_MODEL(EPD_2IN7B_V2, 2, 1);
+
 #endif
@@ -77,6 +77,7 @@
 #
 ******************************************************************************/
 #include "EPD_2in9.h"
+#include "EPD_Common.h"
 #include "Debug.h"
 
 const unsigned char EPD_2IN9_lut_full_update[] = {
@@ -102,6 +103,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN9_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(200);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -117,10 +119,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN9_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -130,10 +129,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN9_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -144,9 +140,7 @@ void EPD_2IN9_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
     DEV_Delay_ms(100);
-    while(DEV_Digital_Read(EPD_BUSY_PIN) == 1) {      //LOW: idle, HIGH: busy
-        DEV_Delay_ms(100);
-    }
+    DEV_Wait_Busy(0, EPD_BUSY_TIMEOUT_MS);
     Debug("e-Paper busy release\r\n");
 }
 
@@ -156,6 +150,8 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN9_SetWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
 {
+    if(EPD_State_Window(Xstart, Ystart, Xend, Yend))
+        return;
     EPD_2IN9_SendCommand(0x44); // SET_RAM_X_ADDRESS_START_END_POSITION
     EPD_2IN9_SendData((Xstart >> 3) & 0xFF);
     EPD_2IN9_SendData((Xend >> 3) & 0xFF);
@@ -230,13 +226,9 @@ void EPD_2IN9_Init(UBYTE Mode)
     //set the look-up table register
     EPD_2IN9_SendCommand(0x32); // WRITE_LUT_REGISTER
     if(Mode == EPD_2IN9_FULL){
-        for (UWORD i = 0; i < 30; i++) {
-                EPD_2IN9_SendData(EPD_2IN9_lut_full_update[i]);
-        }
+        EPD_Common_SendDataBuffer(EPD_2IN9_lut_full_update, 30);
     }else if(Mode == EPD_2IN9_PART){
-        for (UWORD i = 0; i < 30; i++) {
-                EPD_2IN9_SendData(EPD_2IN9_lut_partial_update[i]);
-        }
+        EPD_Common_SendDataBuffer(EPD_2IN9_lut_partial_update, 30);
     }else{
         Debug("error, the Mode is EPD_2IN9_FULL or EPD_2IN9_PART");
     }
@@ -255,9 +247,7 @@ void EPD_2IN9_Clear(void)
     for (UWORD j = 0; j < Height; j++) {
         EPD_2IN9_SetCursor(0, j);
         EPD_2IN9_SendCommand(0x24);
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9_SendData(0XFF);
-        }
+        EPD_Common_SendDataRepeat(0XFF, Width);
     }
     EPD_2IN9_TurnOnDisplay();
 }
@@ -272,16 +262,12 @@ void EPD_2IN9_Display(UBYTE *Image)
     Width = (EPD_2IN9_WIDTH % 8 == 0)? (EPD_2IN9_WIDTH / 8 ): (EPD_2IN9_WIDTH / 8 + 1);
     Height = EPD_2IN9_HEIGHT;
 
-    UDOUBLE Addr = 0;
     // UDOUBLE Offset = ImageName;
     EPD_2IN9_SetWindows(0, 0, EPD_2IN9_WIDTH, EPD_2IN9_HEIGHT);
     for (UWORD j = 0; j < Height; j++) {
         EPD_2IN9_SetCursor(0, j);
         EPD_2IN9_SendCommand(0x24);
-        for (UWORD i = 0; i < Width; i++) {
-            Addr = i + j * Width;
-            EPD_2IN9_SendData(Image[Addr]);
-        }
+        EPD_Common_SendDataBuffer(Image + j * Width, Width);
     }
     EPD_2IN9_TurnOnDisplay();
 }
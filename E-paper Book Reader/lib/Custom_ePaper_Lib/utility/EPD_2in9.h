@@ -80,6 +80,7 @@
 #define __EPD_2IN9_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_2IN9_WIDTH       128
@@ -93,4 +94,6 @@ void EPD_2IN9_Clear(void);
 void EPD_2IN9_Display(UBYTE *Image);
 void EPD_2IN9_Sleep(void);
 
+EPD_MODEL(EPD_2IN9, 1, 1);
+
 #endif
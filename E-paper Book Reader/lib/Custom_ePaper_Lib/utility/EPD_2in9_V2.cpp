@@ -29,8 +29,13 @@
 #
 ******************************************************************************/
 #include "EPD_2in9_V2.h"
+#include "EPD_Common.h"
+#include "EPD_Panel.h"
 #include "Debug.h"
 
+//Init mode of EPD_2IN9_V2_Gray4_Init, see EPD_State_Check(), 0 is EPD_Panel_Init
+#define EPD_2IN9_V2_MODE_4GRAY  2
+
 UBYTE _WF_PARTIAL_2IN9[159] =
 {
 0x0,0x40,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
@@ -106,6 +111,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN9_V2_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(10);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -121,10 +127,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN9_V2_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -134,10 +137,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN9_V2_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -147,27 +147,22 @@ parameter:
 void EPD_2IN9_V2_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-	while(1)
-	{	 //=1 BUSY
-		if(DEV_Digital_Read(EPD_BUSY_PIN)==0) 
-			break;
-		DEV_Delay_ms(50);
-	}
+	DEV_Wait_Busy(0, EPD_BUSY_TIMEOUT_MS);
 	DEV_Delay_ms(50);
     Debug("e-Paper busy release\r\n");
 }
 
 static void EPD_2IN9_V2_LUT(UBYTE *lut)
 {
-	UBYTE count;
 	EPD_2IN9_V2_SendCommand(0x32);
-	for(count=0; count<153; count++) 
-		EPD_2IN9_V2_SendData(lut[count]); 
+	EPD_Common_SendDataBuffer(lut, 153); 
 	EPD_2IN9_V2_ReadBusy();
 }
 
 static void EPD_2IN9_V2_LUT_by_host(UBYTE *lut)
 {
+	if(EPD_State_Lut(lut))
+		return;
 	EPD_2IN9_V2_LUT((UBYTE *)lut);			//lut
 	EPD_2IN9_V2_SendCommand(0x3f);
 	EPD_2IN9_V2_SendData(*(lut+153));
@@ -208,6 +203,8 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN9_V2_SetWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
 {
+    if(EPD_State_Window(Xstart, Ystart, Xend, Yend))
+        return;
     EPD_2IN9_V2_SendCommand(0x44); // SET_RAM_X_ADDRESS_START_END_POSITION
     EPD_2IN9_V2_SendData((Xstart>>3) & 0xFF);
     EPD_2IN9_V2_SendData((Xend>>3) & 0xFF);
@@ -233,41 +230,66 @@ static void EPD_2IN9_V2_SetCursor(UWORD Xstart, UWORD Ystart)
     EPD_2IN9_V2_SendData((Ystart >> 8) & 0xFF);
 }
 
+static const UBYTE EPD_2IN9_V2_Init_Script[] = {
+    EPD_RESET(10, 2, 10),
+    EPD_DELAY(100),
+    EPD_BUSY,
+    EPD_CMD(0x12, 0),               //soft reset
+    EPD_BUSY,
+    EPD_CMD(0x01, 3), 0x27, 0x01, 0x00, //Driver output control
+    EPD_CMD(0x11, 1), 0x03,         //data entry mode
+    EPD_WINDOW(EPD_RAM_YINC),
+    EPD_CMD(0x21, 2), 0x00, 0x80,   //Display update control
+    EPD_CURSOR(EPD_RAM_YINC),
+    EPD_BUSY,
+    EPD_LUT(0x32, 0, 153),
+    EPD_BUSY,
+    EPD_LUT(0x3F, 153, 1),
+    EPD_LUT(0x03, 154, 1),          //gate voltage
+    EPD_LUT(0x04, 155, 3),          //source voltage
+    EPD_LUT(0x2C, 158, 1),          //VCOM
+    EPD_END
+};
+
+static const UBYTE EPD_2IN9_V2_Refresh_Script[] = {
+    EPD_CMD(0x22, 1), 0xC7,         //Display Update Control
+    EPD_CMD(0x20, 0),               //Activate Display Update Sequence
+    EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_2IN9_V2_Sleep_Script[] = {
+    EPD_CMD(0x10, 1), 0x01,         //enter deep sleep
+    EPD_DELAY(100),
+    EPD_END
+};
+
+const EPD_PANEL EPD_2IN9_V2_Panel = {
+    "EPD_2IN9_V2", EPD_2IN9_V2_WIDTH, EPD_2IN9_V2_HEIGHT,
+    2, {
+        { 0x24, EPD_PLANE_IMAGE0, 0, 0xFF, 0 },
+        { 0x26, EPD_PLANE_CLEAR, 0, 0xFF, 0 },    //base of the partial refresh
+    },
+    0, 0, 0, 0, 50,
+    EPD_2IN9_V2_Init_Script, EPD_2IN9_V2_Refresh_Script, EPD_2IN9_V2_Sleep_Script,
+    EPD_CAP_PARTIAL | EPD_CAP_4GRAY,
+    NULL, NULL,                     //the analog supply is switched by each update sequence, no STANDBY
+    WS_20_30,
+};
+
 /******************************************************************************
 function :	Initialize the e-Paper register
 parameter:
 ******************************************************************************/
 void EPD_2IN9_V2_Init(void)
 {
-	EPD_2IN9_V2_Reset();
-	DEV_Delay_ms(100);
-
-	EPD_2IN9_V2_ReadBusy();   
-	EPD_2IN9_V2_SendCommand(0x12); // soft reset
-	EPD_2IN9_V2_ReadBusy();
-	
-	EPD_2IN9_V2_SendCommand(0x01); //Driver output control      
-	EPD_2IN9_V2_SendData(0x27);
-	EPD_2IN9_V2_SendData(0x01);
-	EPD_2IN9_V2_SendData(0x00);
-	
-	EPD_2IN9_V2_SendCommand(0x11); //data entry mode       
-	EPD_2IN9_V2_SendData(0x03);
-	
-	EPD_2IN9_V2_SetWindows(0, 0, EPD_2IN9_V2_WIDTH-1, EPD_2IN9_V2_HEIGHT-1);
-	
-	EPD_2IN9_V2_SendCommand(0x21); //  Display update control
-	EPD_2IN9_V2_SendData(0x00);
-	EPD_2IN9_V2_SendData(0x80);	
-	
-	EPD_2IN9_V2_SetCursor(0, 0);
-	EPD_2IN9_V2_ReadBusy();	
-	
-	EPD_2IN9_V2_LUT_by_host(WS_20_30);
+    EPD_Panel_Init(&EPD_2IN9_V2_Panel);
 }
 
 void EPD_2IN9_V2_Gray4_Init(void)
 {
+	if(EPD_State_Check("EPD_2IN9_V2", EPD_2IN9_V2_MODE_4GRAY))
+		return;
 	EPD_2IN9_V2_Reset();
 	DEV_Delay_ms(100);
 
@@ -292,6 +314,7 @@ void EPD_2IN9_V2_Gray4_Init(void)
 	EPD_2IN9_V2_ReadBusy();	
 
 	EPD_2IN9_V2_LUT_by_host(Gray4);
+	EPD_State_Set("EPD_2IN9_V2", EPD_2IN9_V2_MODE_4GRAY);
 }
 
 /******************************************************************************
@@ -300,20 +323,7 @@ parameter:
 ******************************************************************************/
 void EPD_2IN9_V2_Clear(void)
 {
-	UWORD i;
-	
-	EPD_2IN9_V2_SendCommand(0x24);   //write RAM for black(0)/white (1)
-	for(i=0;i<4736;i++)
-	{
-		EPD_2IN9_V2_SendData(0xff);
-	}
-
-	EPD_2IN9_V2_SendCommand(0x26);   //write RAM for black(0)/white (1)
-	for(i=0;i<4736;i++)
-	{
-		EPD_2IN9_V2_SendData(0xff);
-	}
-	EPD_2IN9_V2_TurnOnDisplay();
+    EPD_Panel_Clear(&EPD_2IN9_V2_Panel);
 }
 
 /******************************************************************************
@@ -322,120 +332,52 @@ parameter:
 ******************************************************************************/
 void EPD_2IN9_V2_Display(UBYTE *Image)
 {
-	UWORD i;	
-	EPD_2IN9_V2_SendCommand(0x24);   //write RAM for black(0)/white (1)
-	for(i=0;i<4736;i++)
-	{
-		EPD_2IN9_V2_SendData(Image[i]);
-	}
-	EPD_2IN9_V2_TurnOnDisplay();	
+    EPD_Panel_Display(&EPD_2IN9_V2_Panel, Image, NULL);
 }
 
 void EPD_2IN9_V2_Display_Base(UBYTE *Image)
 {
-	UWORD i;   
 
 	EPD_2IN9_V2_SendCommand(0x24);   //Write Black and White image to RAM
-	for(i=0;i<4736;i++)
-	{               
-		EPD_2IN9_V2_SendData(Image[i]);
-	}
+	EPD_Common_SendDataBuffer(Image, 4736);
 	EPD_2IN9_V2_SendCommand(0x26);   //Write Black and White image to RAM
-	for(i=0;i<4736;i++)
-	{               
-		EPD_2IN9_V2_SendData(Image[i]);
-	}
+	EPD_Common_SendDataBuffer(Image, 4736);
 	EPD_2IN9_V2_TurnOnDisplay();	
 }
 
 void EPD_2IN9_V2_4GrayDisplay(UBYTE *Image)
 {
-    UDOUBLE i,j,k;
-    UBYTE temp1,temp2,temp3;
-
     // old  data
     EPD_2IN9_V2_SendCommand(0x24);
-    for(i=0; i<4736; i++) { 
-        temp3=0;
-        for(j=0; j<2; j++) {
-            temp1 = Image[i*2+j];
-            for(k=0; k<2; k++) {
-                temp2 = temp1&0xC0;
-                if(temp2 == 0xC0)
-                    temp3 |= 0x00;
-                else if(temp2 == 0x00)
-                    temp3 |= 0x01; 
-                else if(temp2 == 0x80)
-                    temp3 |= 0x01; 
-                else //0x40
-                    temp3 |= 0x00; 
-                temp3 <<= 1;
-
-                temp1 <<= 2;
-                temp2 = temp1&0xC0 ;
-                if(temp2 == 0xC0) 
-                    temp3 |= 0x00;
-                else if(temp2 == 0x00) 
-                    temp3 |= 0x01;
-                else if(temp2 == 0x80)
-                    temp3 |= 0x01; 
-                else    //0x40
-                    temp3 |= 0x00;	
-                if(j!=1 || k!=1)
-                    temp3 <<= 1;
-
-                temp1 <<= 2;
-            }
-        }
-        EPD_2IN9_V2_SendData(temp3);
-        // printf("%x ",temp3);
-    }
+    EPD_Common_SendGrayPlane(Image, 9472, EPD_2IN9_V2_GRAY, 0);
 
     EPD_2IN9_V2_SendCommand(0x26);   //write RAM for black(0)/white (1)
-    for(i=0; i<4736; i++) {            
-        temp3=0;
-        for(j=0; j<2; j++) {
-            temp1 = Image[i*2+j];
-            for(k=0; k<2; k++) {
-                temp2 = temp1&0xC0 ;
-                if(temp2 == 0xC0)
-                    temp3 |= 0x00;//white
-                else if(temp2 == 0x00)
-                    temp3 |= 0x01;  //black
-                else if(temp2 == 0x80)
-                    temp3 |= 0x00;  //gray1
-                else //0x40
-                    temp3 |= 0x01; //gray2
-                temp3 <<= 1;
-
-                temp1 <<= 2;
-                temp2 = temp1&0xC0 ;
-                if(temp2 == 0xC0)  //white
-                    temp3 |= 0x00;
-                else if(temp2 == 0x00) //black
-                    temp3 |= 0x01;
-                else if(temp2 == 0x80)
-                    temp3 |= 0x00; //gray1
-                else    //0x40
-                    temp3 |= 0x01;	//gray2
-                if(j!=1 || k!=1)
-                    temp3 <<= 1;
-
-                temp1 <<= 2;
-            }
-        }
-        EPD_2IN9_V2_SendData(temp3);
-        // printf("%x ",temp3);
-    }
+    EPD_Common_SendGrayPlane(Image, 9472, EPD_2IN9_V2_GRAY, 1);
+
+    EPD_2IN9_V2_TurnOnDisplay();
+}
+
+/******************************************************************************
+function :	Sends a planar 4 gray image to e-Paper and displays
+parameter:
+    Image : the 0x24 plane then the 0x26 plane, drawn with
+            Paint_SetGrayPlanes(Ctx, EPD_2IN9_V2_GRAY)
+******************************************************************************/
+void EPD_2IN9_V2_4GrayDisplay_Planes(const UBYTE *Image)
+{
+    EPD_2IN9_V2_SendCommand(0x24);
+    EPD_Common_SendDataBuffer(Image, 4736);
+    EPD_2IN9_V2_SendCommand(0x26);
+    EPD_Common_SendDataBuffer(Image + 4736, 4736);
 
     EPD_2IN9_V2_TurnOnDisplay();
 }
 
 void EPD_2IN9_V2_Display_Partial(UBYTE *Image)
 {
-	UWORD i;
 
 //Reset
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 0);
     DEV_Delay_ms(1);
     DEV_Digital_Write(EPD_RST_PIN, 1);
@@ -466,10 +408,7 @@ void EPD_2IN9_V2_Display_Partial(UBYTE *Image)
 	EPD_2IN9_V2_SetCursor(0, 0);
 
 	EPD_2IN9_V2_SendCommand(0x24);   //Write Black and White image to RAM
-	for(i=0;i<4736;i++)
-	{
-		EPD_2IN9_V2_SendData(Image[i]);
-	} 
+	EPD_Common_SendDataBuffer(Image, 4736); 
 	EPD_2IN9_V2_TurnOnDisplay_Partial();
 }
 
@@ -479,7 +418,5 @@ parameter:
 ******************************************************************************/
 void EPD_2IN9_V2_Sleep(void)
 {
-	EPD_2IN9_V2_SendCommand(0x10); //enter deep sleep
-	EPD_2IN9_V2_SendData(0x01); 
-	DEV_Delay_ms(100);
+    EPD_Panel_Sleep(&EPD_2IN9_V2_Panel);
 }
@@ -32,10 +32,16 @@
 #define __EPD_2IN9_V2_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
+#include "EPD_Common.h"
+#include "EPD_Panel.h"
 
 // Display resolution
 #define EPD_2IN9_V2_WIDTH       128
 #define EPD_2IN9_V2_HEIGHT      296
+#define EPD_2IN9_V2_GRAY        EPD_Gray_Invert     //4 gray planes, see Paint_SetGrayPlanes()
+
+extern const EPD_PANEL EPD_2IN9_V2_Panel;
 
 void EPD_2IN9_V2_Init(void);
 void EPD_2IN9_V2_Gray4_Init(void);
@@ -43,6 +49,10 @@ void EPD_2IN9_V2_Clear(void);
 void EPD_2IN9_V2_Display(UBYTE *Image);
 void EPD_2IN9_V2_Display_Base(UBYTE *Image);
 void EPD_2IN9_V2_4GrayDisplay(UBYTE *Image);
+void EPD_2IN9_V2_4GrayDisplay_Planes(const UBYTE *Image);
 void EPD_2IN9_V2_Display_Partial(UBYTE *Image);
 void EPD_2IN9_V2_Sleep(void);
+
+EPD_MODEL(EPD_2IN9_V2, 1, 1);
+
 #endif
@@ -29,66 +29,56 @@
 #
 ******************************************************************************/
 #include "EPD_2in9b_V3.h"
-#include "Debug.h"
-
-/******************************************************************************
-function :	Software reset
-parameter:
-******************************************************************************/
-static void EPD_2IN9B_V3_Reset(void)
-{
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(200);
-    DEV_Digital_Write(EPD_RST_PIN, 0);
-    DEV_Delay_ms(5);
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(200);
-}
-
-/******************************************************************************
-function :	send command
-parameter:
-     Reg : Command register
-******************************************************************************/
-static void EPD_2IN9B_V3_SendCommand(UBYTE Reg)
-{
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
-}
-
-/******************************************************************************
-function :	send data
-parameter:
-    Data : Write data
-******************************************************************************/
-static void EPD_2IN9B_V3_SendData(UBYTE Data)
-{
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
-}
-
-/******************************************************************************
-function :	Wait until the busy_pin goes LOW
-parameter:
-******************************************************************************/
-void EPD_2IN9B_V3_ReadBusy(void)
-{
-    Debug("e-Paper busy\r\n");
-    UBYTE busy;
-	do
-	{
-		EPD_2IN9B_V3_SendCommand(0x71);
-		busy = DEV_Digital_Read(EPD_BUSY_PIN);
-		busy =!(busy & 0x01);        
-	}
-	while(busy); 
-    Debug("e-Paper busy release\r\n");
-    DEV_Delay_ms(200);
-}
+#include "EPD_Panel.h"
+
+static const UBYTE EPD_2IN9B_V3_Init_Script[] = {
+    EPD_RESET(200, 5, 200),
+    EPD_CMD(0x04, 0),
+    EPD_BUSY,
+    EPD_CMD(0x00, 2), 0x0f, 0x89,   //panel setting, LUT from OTP, temperature sensor, boost
+    EPD_CMD(0x61, 3), 0x80, 0x01, 0x28, //resolution setting
+    EPD_CMD(0x50, 1), 0x77,         //VCOM AND DATA INTERVAL SETTING
+                                    //WBmode:VBDF 17|D7 VBDW 97 VBDB 57
+                                    //WBRmode:VBDF F7 VBDW 77 VBDB 37  VBDR B7
+    EPD_END
+};
+
+static const UBYTE EPD_2IN9B_V3_Refresh_Script[] = {
+    EPD_CMD(0x12, 0),               //DISPLAY REFRESH
+    EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_2IN9B_V3_Sleep_Script[] = {
+    EPD_CMD(0x02, 0),               //POWER_OFF
+    EPD_BUSY,
+    EPD_CMD(0x07, 1), 0xA5,         //DEEP_SLEEP, check code
+    EPD_END
+};
+
+static const UBYTE EPD_2IN9B_V3_PowerOff_Script[] = {
+    EPD_CMD(0x02, 0),                           //POWER OFF
+    EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_2IN9B_V3_PowerOn_Script[] = {
+    EPD_CMD(0x04, 0),                           //POWER ON
+    EPD_BUSY,
+    EPD_END
+};
+
+const EPD_PANEL EPD_2IN9B_V3_Panel = {
+    "EPD_2IN9B_V3", EPD_2IN9B_V3_WIDTH, EPD_2IN9B_V3_HEIGHT,
+    2, {
+        { 0x10, EPD_PLANE_IMAGE0, 0, 0xFF, 0 },   //black
+        { 0x13, EPD_PLANE_IMAGE1, 0, 0xFF, 0 },   //red, 0 = red
+    },
+    0x92, 0, 1, 0x71, 200,
+    EPD_2IN9B_V3_Init_Script, EPD_2IN9B_V3_Refresh_Script, EPD_2IN9B_V3_Sleep_Script,
+    EPD_CAP_RED,
+    EPD_2IN9B_V3_PowerOff_Script, EPD_2IN9B_V3_PowerOn_Script,
+};
 
 /******************************************************************************
 function :	Initialize the e-Paper register
@@ -96,23 +86,7 @@ parameter:
 ******************************************************************************/
 void EPD_2IN9B_V3_Init(void)
 {
-    EPD_2IN9B_V3_Reset();
-
-    EPD_2IN9B_V3_SendCommand(0x04);  
-    EPD_2IN9B_V3_ReadBusy();//waiting for the electronic paper IC to release the idle signal
-
-    EPD_2IN9B_V3_SendCommand(0x00);//panel setting
-    EPD_2IN9B_V3_SendData(0x0f);//LUT from OTP，128x296
-    EPD_2IN9B_V3_SendData(0x89);//Temperature sensor, boost and other related timing settings
-
-    EPD_2IN9B_V3_SendCommand(0x61);//resolution setting
-    EPD_2IN9B_V3_SendData (0x80);
-    EPD_2IN9B_V3_SendData (0x01);
-    EPD_2IN9B_V3_SendData (0x28);
-
-    EPD_2IN9B_V3_SendCommand(0X50);//VCOM AND DATA INTERVAL SETTING			
-    EPD_2IN9B_V3_SendData(0x77);//WBmode:VBDF 17|D7 VBDW 97 VBDB 57		
-                            //WBRmode:VBDF F7 VBDW 77 VBDB 37  VBDR B7
+    EPD_Panel_Init(&EPD_2IN9B_V3_Panel);
 }
 
 /******************************************************************************
@@ -121,27 +95,7 @@ parameter:
 ******************************************************************************/
 void EPD_2IN9B_V3_Clear(void)
 {
-    UWORD Width = (EPD_2IN9B_V3_WIDTH % 8 == 0)? (EPD_2IN9B_V3_WIDTH / 8 ): (EPD_2IN9B_V3_WIDTH / 8 + 1);
-    UWORD Height = EPD_2IN9B_V3_HEIGHT;
-
-    //send black data
-    EPD_2IN9B_V3_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9B_V3_SendData(0xFF);
-        }
-    }
-
-    //send red data
-    EPD_2IN9B_V3_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9B_V3_SendData(0xFF);
-        }
-    }
-    
-    EPD_2IN9B_V3_SendCommand(0x12);
-    EPD_2IN9B_V3_ReadBusy();
+    EPD_Panel_Clear(&EPD_2IN9B_V3_Panel);
 }
 
 /******************************************************************************
@@ -150,28 +104,18 @@ parameter:
 ******************************************************************************/
 void EPD_2IN9B_V3_Display(const UBYTE *blackimage, const UBYTE *ryimage)
 {
-    UWORD Width, Height;
-    Width = (EPD_2IN9B_V3_WIDTH % 8 == 0)? (EPD_2IN9B_V3_WIDTH / 8 ): (EPD_2IN9B_V3_WIDTH / 8 + 1);
-    Height = EPD_2IN9B_V3_HEIGHT;
-
-    EPD_2IN9B_V3_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9B_V3_SendData(blackimage[i + j * Width]);
-        }
-    }
-    EPD_2IN9B_V3_SendCommand(0x92);
-    
-    EPD_2IN9B_V3_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9B_V3_SendData(ryimage[i + j * Width]);
-        }
-    }
-    EPD_2IN9B_V3_SendCommand(0x92);
+    EPD_Panel_Display(&EPD_2IN9B_V3_Panel, blackimage, ryimage);
+}
 
-    EPD_2IN9B_V3_SendCommand(0x12);
-    EPD_2IN9B_V3_ReadBusy();
+/******************************************************************************
+function :	Sends a 3 color picture to e-Paper and displays
+parameter:
+    Image : the black plane then the red plane, drawn with
+            Paint_SetColorPlanes(Ctx, EPD_2IN9B_V3_COLOR)
+******************************************************************************/
+void EPD_2IN9B_V3_Display_Planes(const UBYTE *Image)
+{
+    EPD_Panel_Display_Planes(&EPD_2IN9B_V3_Panel, Image);
 }
 
 /******************************************************************************
@@ -180,8 +124,5 @@ parameter:
 ******************************************************************************/
 void EPD_2IN9B_V3_Sleep(void)
 {
-    EPD_2IN9B_V3_SendCommand(0x02); // POWER_OFF
-    EPD_2IN9B_V3_ReadBusy();
-    EPD_2IN9B_V3_SendCommand(0x07); // DEEP_SLEEP
-    EPD_2IN9B_V3_SendData(0xA5); // check code
+    EPD_Panel_Sleep(&EPD_2IN9B_V3_Panel);
 }
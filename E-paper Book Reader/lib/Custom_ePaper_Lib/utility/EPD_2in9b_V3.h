@@ -32,14 +32,22 @@
 #define __EPD_2IN9B_V3_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
+#include "EPD_Panel.h"
 
 // Display resolution
 #define EPD_2IN9B_V3_WIDTH       128
 #define EPD_2IN9B_V3_HEIGHT      296
+#define EPD_2IN9B_V3_COLOR       EPD_Color_RedLow    //3 color planes, see Paint_SetColorPlanes()
+
+extern const EPD_PANEL EPD_2IN9B_V3_Panel;
 
 void EPD_2IN9B_V3_Init(void);
 void EPD_2IN9B_V3_Clear(void);
 void EPD_2IN9B_V3_Display(const UBYTE *blackimage, const UBYTE *ryimage);
+void EPD_2IN9B_V3_Display_Planes(const UBYTE *Image);
 void EPD_2IN9B_V3_Sleep(void);
 
+EPD_MODEL(EPD_2IN9B_V3, 2, 1);
+
 #endif
@@ -29,6 +29,7 @@
 #
 ******************************************************************************/
 #include "EPD_2in9b_V4.h"
+#include "EPD_Common.h"
 #include "Debug.h"
 #include <time.h>
 
@@ -38,6 +39,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN9B_V4_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(200);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -53,10 +55,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN9B_V4_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -66,10 +65,7 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN9B_V4_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -79,12 +75,7 @@ parameter:
 void EPD_2IN9B_V4_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-	while(1)
-	{	 //=1 BUSY
-		if(DEV_Digital_Read(EPD_BUSY_PIN)==0) 
-			break;
-		DEV_Delay_ms(50);
-	}
+	DEV_Wait_Busy(0, EPD_BUSY_TIMEOUT_MS);
     Debug("e-Paper busy release\r\n");
     DEV_Delay_ms(200);
 }
@@ -238,19 +229,11 @@ void EPD_2IN9B_V4_Clear(void)
 
     //send black data
     EPD_2IN9B_V4_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9B_V4_SendData(0xFF);
-        }
-    }
+    EPD_Common_SendDataRepeat(0xFF, Width * Height);
 
     //send red data
     EPD_2IN9B_V4_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9B_V4_SendData(0x00);
-        }
-    }
+    EPD_Common_SendDataRepeat(0x00, Width * Height);
 
     EPD_2IN9B_V4_TurnOnDisplay();
 }
@@ -262,19 +245,11 @@ void EPD_2IN9B_V4_Clear_Fast(void)
 
     //send black data
     EPD_2IN9B_V4_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9B_V4_SendData(0xFF);
-        }
-    }
+    EPD_Common_SendDataRepeat(0xFF, Width * Height);
 
     //send red data
     EPD_2IN9B_V4_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9B_V4_SendData(0x00);
-        }
-    }
+    EPD_Common_SendDataRepeat(0x00, Width * Height);
 
     EPD_2IN9B_V4_TurnOnDisplay_Fast();
 }
@@ -286,19 +261,11 @@ void EPD_2IN9B_V4_Clear_Black_Fast(void)
 
     //send black data
     EPD_2IN9B_V4_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9B_V4_SendData(0x00);
-        }
-    }
+    EPD_Common_SendDataRepeat(0x00, Width * Height);
 
     //send red data
     EPD_2IN9B_V4_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9B_V4_SendData(0x00);
-        }
-    }
+    EPD_Common_SendDataRepeat(0x00, Width * Height);
 
     EPD_2IN9B_V4_TurnOnDisplay_Fast();
 }
@@ -310,19 +277,11 @@ void EPD_2IN9B_V4_Clear_Red_Fast(void)
 
     //send black data
     EPD_2IN9B_V4_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9B_V4_SendData(0xFF);
-        }
-    }
+    EPD_Common_SendDataRepeat(0xFF, Width * Height);
 
     //send red data
     EPD_2IN9B_V4_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9B_V4_SendData(0xFF);
-        }
-    }
+    EPD_Common_SendDataRepeat(0xFF, Width * Height);
 
     EPD_2IN9B_V4_TurnOnDisplay_Fast();
 }
@@ -338,18 +297,10 @@ void EPD_2IN9B_V4_Display(const UBYTE *blackimage, const UBYTE *ryimage)
     Height = EPD_2IN9B_V4_HEIGHT;
 
     EPD_2IN9B_V4_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9B_V4_SendData(blackimage[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(blackimage, Width * Height);
 
     EPD_2IN9B_V4_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9B_V4_SendData(~ryimage[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataInvert(ryimage, Width * Height);
 
     EPD_2IN9B_V4_TurnOnDisplay();
 }
@@ -361,18 +312,10 @@ void EPD_2IN9B_V4_Display_Fast(const UBYTE *blackimage, const UBYTE *ryimage)
     Height = EPD_2IN9B_V4_HEIGHT;
 
     EPD_2IN9B_V4_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9B_V4_SendData(blackimage[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(blackimage, Width * Height);
 
     EPD_2IN9B_V4_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9B_V4_SendData(~ryimage[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataInvert(ryimage, Width * Height);
 
     EPD_2IN9B_V4_TurnOnDisplay_Fast();
 }
@@ -384,27 +327,15 @@ void EPD_2IN9B_V4_Display_Base(const UBYTE *blackimage, const UBYTE *ryimage)
     Height = EPD_2IN9B_V4_HEIGHT;
 
     EPD_2IN9B_V4_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9B_V4_SendData(blackimage[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(blackimage, Width * Height);
 
     EPD_2IN9B_V4_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9B_V4_SendData(~ryimage[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataInvert(ryimage, Width * Height);
 
     EPD_2IN9B_V4_TurnOnDisplay_Base();
 
     EPD_2IN9B_V4_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9B_V4_SendData(blackimage[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(blackimage, Width * Height);
 }
 
 //Partial refresh display
@@ -422,7 +353,7 @@ void EPD_2IN9B_V4_Display_Partial(const UBYTE *Image, UWORD Xstart, UWORD Ystart
     }
     
 
-    UWORD i, Width;
+    UWORD Width;
 	Width = Xend -  Xstart;
 	UWORD IMAGE_COUNTER = Width * (Yend-Ystart);
 
@@ -446,9 +377,7 @@ void EPD_2IN9B_V4_Display_Partial(const UBYTE *Image, UWORD Xstart, UWORD Ystart
 
 
     EPD_2IN9B_V4_SendCommand(0x24);   //Write Black and White image to RAM
-    for (i = 0; i < IMAGE_COUNTER; i++) {
-	    EPD_2IN9B_V4_SendData(Image[i]);
-	}
+    EPD_Common_SendDataBuffer(Image, IMAGE_COUNTER);
 	EPD_2IN9B_V4_TurnOnDisplay_Partial();
 
 }
@@ -32,6 +32,7 @@
 #define __EPD_2IN9B_V4_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_2IN9B_V4_WIDTH       128
@@ -49,4 +50,6 @@ void EPD_2IN9B_V4_Display_Base(const UBYTE *blackimage, const UBYTE *ryimage);
 void EPD_2IN9B_V4_Display_Partial(const UBYTE *Image, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend);
 void EPD_2IN9B_V4_Sleep(void);
 
+EPD_MODEL(EPD_2IN9B_V4, 2, 1);
+
 #endif
@@ -82,60 +82,56 @@
 #
 ******************************************************************************/
 #include "EPD_2in9bc.h"
-#include "Debug.h"
+#include "EPD_Panel.h"
 
-/******************************************************************************
-function :	Software reset
-parameter:
-******************************************************************************/
-static void EPD_2IN9BC_Reset(void)
-{
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(200);
-    DEV_Digital_Write(EPD_RST_PIN, 0);
-    DEV_Delay_ms(10);
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(200);
-}
+static const UBYTE EPD_2IN9BC_Init_Script[] = {
+    EPD_RESET(200, 10, 200),
+    EPD_CMD(0x06, 3), 0x17, 0x17, 0x17, //BOOSTER_SOFT_START
+    EPD_CMD(0x04, 0),                   //POWER_ON
+    EPD_BUSY,
+    EPD_CMD(0x00, 1), 0x8F,             //PANEL_SETTING
+    EPD_CMD(0x50, 1), 0x77,             //VCOM_AND_DATA_INTERVAL_SETTING
+    EPD_CMD(0x61, 3), 0x80, 0x01, 0x28, //TCON_RESOLUTION
+    EPD_CMD(0x82, 1), 0x0A,             //VCM_DC_SETTING_REGISTER
+    EPD_END
+};
 
-/******************************************************************************
-function :	send command
-parameter:
-     Reg : Command register
-******************************************************************************/
-static void EPD_2IN9BC_SendCommand(UBYTE Reg)
-{
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
-}
+static const UBYTE EPD_2IN9BC_Refresh_Script[] = {
+    EPD_CMD(0x12, 0),                   //DISPLAY REFRESH
+    EPD_BUSY,
+    EPD_END
+};
 
-/******************************************************************************
-function :	send data
-parameter:
-    Data : Write data
-******************************************************************************/
-static void EPD_2IN9BC_SendData(UBYTE Data)
-{
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
-}
+static const UBYTE EPD_2IN9BC_Sleep_Script[] = {
+    EPD_CMD(0x02, 0),                   //POWER_OFF
+    EPD_BUSY,
+    EPD_CMD(0x07, 1), 0xA5,             //DEEP_SLEEP, check code
+    EPD_END
+};
 
-/******************************************************************************
-function :	Wait until the busy_pin goes LOW
-parameter:
-******************************************************************************/
-void EPD_2IN9BC_ReadBusy(void)
-{
-    Debug("e-Paper busy\r\n");
-    while(DEV_Digital_Read(EPD_BUSY_PIN) == 0) {      //LOW: idle, HIGH: busy
-        DEV_Delay_ms(100);
-    }
-    Debug("e-Paper busy release\r\n");
-}
+static const UBYTE EPD_2IN9BC_PowerOff_Script[] = {
+    EPD_CMD(0x02, 0),                   //POWER_OFF
+    EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_2IN9BC_PowerOn_Script[] = {
+    EPD_CMD(0x04, 0),                   //POWER_ON
+    EPD_BUSY,
+    EPD_END
+};
+
+const EPD_PANEL EPD_2IN9BC_Panel = {
+    "EPD_2IN9BC", EPD_2IN9BC_WIDTH, EPD_2IN9BC_HEIGHT,
+    2, {
+        { 0x10, EPD_PLANE_IMAGE0, 0, 0xFF, 0 },   //black
+        { 0x13, EPD_PLANE_IMAGE1, 0, 0xFF, 0 },   //red, 0 = red
+    },
+    0x92, 0, 1, 0, 0,
+    EPD_2IN9BC_Init_Script, EPD_2IN9BC_Refresh_Script, EPD_2IN9BC_Sleep_Script,
+    EPD_CAP_RED,
+    EPD_2IN9BC_PowerOff_Script, EPD_2IN9BC_PowerOn_Script,
+};
 
 /******************************************************************************
 function :	Initialize the e-Paper register
@@ -143,29 +139,7 @@ parameter:
 ******************************************************************************/
 void EPD_2IN9BC_Init(void)
 {
-    EPD_2IN9BC_Reset();
-
-    EPD_2IN9BC_SendCommand(0x06); // BOOSTER_SOFT_START
-    EPD_2IN9BC_SendData(0x17);
-    EPD_2IN9BC_SendData(0x17);
-    EPD_2IN9BC_SendData(0x17);
-	
-    EPD_2IN9BC_SendCommand(0x04); // POWER_ON
-    EPD_2IN9BC_ReadBusy();
-	
-    EPD_2IN9BC_SendCommand(0x00); // PANEL_SETTING
-    EPD_2IN9BC_SendData(0x8F);
-	
-    EPD_2IN9BC_SendCommand(0x50); // VCOM_AND_DATA_INTERVAL_SETTING
-    EPD_2IN9BC_SendData(0x77);
-	
-    EPD_2IN9BC_SendCommand(0x61); // TCON_RESOLUTION
-    EPD_2IN9BC_SendData(0x80);
-    EPD_2IN9BC_SendData(0x01);
-    EPD_2IN9BC_SendData(0x28);
-	
-    EPD_2IN9BC_SendCommand(0x82); // VCM_DC_SETTING_REGISTER
-    EPD_2IN9BC_SendData(0X0A);
+    EPD_Panel_Init(&EPD_2IN9BC_Panel);
 }
 
 /******************************************************************************
@@ -174,27 +148,7 @@ parameter:
 ******************************************************************************/
 void EPD_2IN9BC_Clear(void)
 {
-    UWORD Width = (EPD_2IN9BC_WIDTH % 8 == 0)? (EPD_2IN9BC_WIDTH / 8 ): (EPD_2IN9BC_WIDTH / 8 + 1);
-    UWORD Height = EPD_2IN9BC_HEIGHT;
-
-    //send black data
-    EPD_2IN9BC_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9BC_SendData(0xFF);
-        }
-    }
-
-    //send red data
-    EPD_2IN9BC_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9BC_SendData(0xFF);
-        }
-    }
-		
-		EPD_2IN9BC_SendCommand(0x12);
-		EPD_2IN9BC_ReadBusy();
+    EPD_Panel_Clear(&EPD_2IN9BC_Panel);
 }
 
 /******************************************************************************
@@ -203,28 +157,18 @@ parameter:
 ******************************************************************************/
 void EPD_2IN9BC_Display(const UBYTE *blackimage, const UBYTE *ryimage)
 {
-    UWORD Width, Height;
-    Width = (EPD_2IN9BC_WIDTH % 8 == 0)? (EPD_2IN9BC_WIDTH / 8 ): (EPD_2IN9BC_WIDTH / 8 + 1);
-    Height = EPD_2IN9BC_HEIGHT;
-
-    EPD_2IN9BC_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9BC_SendData(blackimage[i + j * Width]);
-        }
-    }
-    EPD_2IN9BC_SendCommand(0x92);
-    
-    EPD_2IN9BC_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9BC_SendData(ryimage[i + j * Width]);
-        }
-    }
-    EPD_2IN9BC_SendCommand(0x92);
+    EPD_Panel_Display(&EPD_2IN9BC_Panel, blackimage, ryimage);
+}
 
-    EPD_2IN9BC_SendCommand(0x12);
-    EPD_2IN9BC_ReadBusy();
+/******************************************************************************
+function :	Sends a 3 color picture to e-Paper and displays
+parameter:
+    Image : the black plane then the red plane, drawn with
+            Paint_SetColorPlanes(Ctx, EPD_2IN9BC_COLOR)
+******************************************************************************/
+void EPD_2IN9BC_Display_Planes(const UBYTE *Image)
+{
+    EPD_Panel_Display_Planes(&EPD_2IN9BC_Panel, Image);
 }
 
 /******************************************************************************
@@ -233,8 +177,5 @@ parameter:
 ******************************************************************************/
 void EPD_2IN9BC_Sleep(void)
 {
-    EPD_2IN9BC_SendCommand(0x02); // POWER_OFF
-    EPD_2IN9BC_ReadBusy();
-    EPD_2IN9BC_SendCommand(0x07); // DEEP_SLEEP
-    EPD_2IN9BC_SendData(0xA5); // check code
+    EPD_Panel_Sleep(&EPD_2IN9BC_Panel);
 }
@@ -55,6 +55,7 @@
 #define __EPD_2IN9D_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_2IN9D_WIDTH   128
@@ -66,4 +67,6 @@ void EPD_2IN9D_Display(UBYTE *Image);
 void EPD_2IN9D_DisplayPart(UBYTE *Image);
 void EPD_2IN9D_Sleep(void);
 
+EPD_MODEL(EPD_2IN9D, 1, 1);
+
 #endif
@@ -13,6 +13,7 @@
 #define __EPD_3IN0G_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_3IN0G_WIDTH       168
@@ -29,4 +30,6 @@ void EPD_3IN0G_Clear(UBYTE color);
 void EPD_3IN0G_Display(UBYTE *Image);
 void EPD_3IN0G_Sleep(void);
 
+EPD_MODEL(EPD_3IN0G, 1, 2);
+
 #endif
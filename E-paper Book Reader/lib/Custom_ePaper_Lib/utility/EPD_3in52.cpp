@@ -29,6 +29,7 @@
 #
 ******************************************************************************/
 #include "EPD_3in52.h"
+#include "EPD_Common.h"
 #include "Debug.h"
 
 //GC 0.9S
@@ -198,6 +199,7 @@ parameter:
 ******************************************************************************/
 void EPD_3IN52_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(200);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -213,10 +215,7 @@ parameter:
 ******************************************************************************/
 void EPD_3IN52_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -226,10 +225,7 @@ parameter:
 ******************************************************************************/
 void EPD_3IN52_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -239,10 +235,7 @@ parameter:
 void EPD_3IN52_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-    UBYTE busy;
-    do {
-        busy = DEV_Digital_Read(EPD_BUSY_PIN);
-    } while(!busy);
+    DEV_Wait_Busy(1, EPD_BUSY_TIMEOUT_MS);
     DEV_Delay_ms(200);
     Debug("e-Paper busy release\r\n");
 }
@@ -253,36 +246,20 @@ void EPD_3IN52_ReadBusy(void)
  */
 void EPD_3IN52_lut(void)
 {
-    UBYTE count;
     EPD_3IN52_SendCommand(0x20);        // vcom
-    for(count = 0; count < 42 ; count++)
-    {
-        EPD_3IN52_SendData(EPD_3IN52_lut_vcom[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_3IN52_lut_vcom, 42);
          
     EPD_3IN52_SendCommand(0x21);        // ww --
-    for(count = 0; count < 42 ; count++)
-    {
-        EPD_3IN52_SendData(EPD_3IN52_lut_ww[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_3IN52_lut_ww, 42);
         
     EPD_3IN52_SendCommand(0x22);        // bw r
-    for(count = 0; count < 42 ; count++)
-    {
-        EPD_3IN52_SendData(EPD_3IN52_lut_bw[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_3IN52_lut_bw, 42);
         
     EPD_3IN52_SendCommand(0x23);        // wb w
-    for(count = 0; count < 42 ; count++)
-    {
-        EPD_3IN52_SendData(EPD_3IN52_lut_bb[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_3IN52_lut_bb, 42);
         
     EPD_3IN52_SendCommand(0x24);        // bb b
-    for(count = 0; count < 42 ; count++)
-    {
-        EPD_3IN52_SendData(EPD_3IN52_lut_wb[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_3IN52_lut_wb, 42);
 }
 
 /**
@@ -300,38 +277,22 @@ void EPD_3IN52_refresh(void)
 // LUT download
 void EPD_3IN52_lut_GC(void)
 {
-    UBYTE count;
     EPD_3IN52_SendCommand(0x20);        // vcom
-    for(count = 0; count < 56 ; count++)
-    {
-        EPD_3IN52_SendData(EPD_3IN52_lut_R20_GC[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_3IN52_lut_R20_GC, 56);
         
     EPD_3IN52_SendCommand(0x21);        // red not use
-    for(count = 0; count < 42 ; count++)
-    {
-        EPD_3IN52_SendData(EPD_3IN52_lut_R21_GC[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_3IN52_lut_R21_GC, 42);
         
     EPD_3IN52_SendCommand(0x24);        // bb b
-    for(count = 0; count < 42 ; count++)
-    {
-        EPD_3IN52_SendData(EPD_3IN52_lut_R24_GC[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_3IN52_lut_R24_GC, 42);
     
     if(EPD_3IN52_Flag == 0)
     {
         EPD_3IN52_SendCommand(0x22);    // bw r
-        for(count = 0; count < 56 ; count++)
-        {
-            EPD_3IN52_SendData(EPD_3IN52_lut_R22_GC[count]);
-        }
+        EPD_Common_SendDataBuffer(EPD_3IN52_lut_R22_GC, 56);
             
         EPD_3IN52_SendCommand(0x23);    // wb w
-        for(count = 0; count < 42 ; count++)
-        {
-            EPD_3IN52_SendData(EPD_3IN52_lut_R23_GC[count]);
-        }
+        EPD_Common_SendDataBuffer(EPD_3IN52_lut_R23_GC, 42);
             
         EPD_3IN52_Flag = 1;
     }
@@ -339,16 +300,10 @@ void EPD_3IN52_lut_GC(void)
     else
     {
         EPD_3IN52_SendCommand(0x22);    // bw r
-        for(count = 0; count < 56 ; count++)
-        {
-            EPD_3IN52_SendData(EPD_3IN52_lut_R23_GC[count]);
-        }
+        EPD_Common_SendDataBuffer(EPD_3IN52_lut_R23_GC, 56);
             
         EPD_3IN52_SendCommand(0x23);    // wb w
-        for(count = 0; count < 42 ; count++)
-        {
-            EPD_3IN52_SendData(EPD_3IN52_lut_R22_GC[count]);
-        }
+        EPD_Common_SendDataBuffer(EPD_3IN52_lut_R22_GC, 42);
             
        EPD_3IN52_Flag = 0;
     }
@@ -357,38 +312,22 @@ void EPD_3IN52_lut_GC(void)
 // LUT download        
 void EPD_3IN52_lut_DU(void)
 {
-    UBYTE count;
     EPD_3IN52_SendCommand(0x20);      // vcom
-    for(count = 0; count < 56 ; count++)
-    {
-        EPD_3IN52_SendData(EPD_3IN52_lut_R20_DU[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_3IN52_lut_R20_DU, 56);
         
     EPD_3IN52_SendCommand(0x21);     // red not use
-    for(count = 0; count < 42 ; count++)
-    {
-        EPD_3IN52_SendData(EPD_3IN52_lut_R21_DU[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_3IN52_lut_R21_DU, 42);
         
     EPD_3IN52_SendCommand(0x24);    // bb b
-    for(count = 0; count < 42 ; count++)
-    {
-        EPD_3IN52_SendData(EPD_3IN52_lut_R24_DU[count]);
-    }
+    EPD_Common_SendDataBuffer(EPD_3IN52_lut_R24_DU, 42);
     
     if(EPD_3IN52_Flag == 0)
     {
         EPD_3IN52_SendCommand(0x22);      // bw r
-        for(count = 0; count < 56 ; count++)
-        {
-            EPD_3IN52_SendData(EPD_3IN52_lut_R22_DU[count]);
-        }
+        EPD_Common_SendDataBuffer(EPD_3IN52_lut_R22_DU, 56);
             
         EPD_3IN52_SendCommand(0x23);     // wb w
-        for(count = 0; count < 42 ; count++)
-        {
-            EPD_3IN52_SendData(EPD_3IN52_lut_R23_DU[count]);
-        }
+        EPD_Common_SendDataBuffer(EPD_3IN52_lut_R23_DU, 42);
             
         EPD_3IN52_Flag = 1;
     }
@@ -396,16 +335,10 @@ void EPD_3IN52_lut_DU(void)
     else
     {
         EPD_3IN52_SendCommand(0x22);    // bw r
-        for(count = 0; count < 56 ; count++)
-        {
-            EPD_3IN52_SendData(EPD_3IN52_lut_R23_DU[count]);
-        }
+        EPD_Common_SendDataBuffer(EPD_3IN52_lut_R23_DU, 56);
             
         EPD_3IN52_SendCommand(0x23);   // wb w
-        for(count = 0; count < 42 ; count++)
-        {
-            EPD_3IN52_SendData(EPD_3IN52_lut_R22_DU[count]);
-        }
+        EPD_Common_SendDataBuffer(EPD_3IN52_lut_R22_DU, 42);
             
         EPD_3IN52_Flag = 0;
     }
@@ -465,96 +398,98 @@ void EPD_3IN52_Init(void)
 
 void EPD_3IN52_display(UBYTE* picData)
 {
-    UWORD i;
     EPD_3IN52_SendCommand(0x13);		     //Transfer new data
-    for(i=0;i<(EPD_3IN52_WIDTH*EPD_3IN52_HEIGHT/8);i++)	     
-    {
-        EPD_3IN52_SendData(*picData);
-        picData++;
-    }
+    EPD_Common_SendDataBuffer(picData, EPD_3IN52_WIDTH*EPD_3IN52_HEIGHT/8);
 }
 
 void EPD_3IN52_display_NUM(UBYTE NUM)
 {
     UWORD row, column;
-    // UWORD pcnt = 0;
+    UBYTE Row[EPD_3IN52_WIDTH/8];
 
     EPD_3IN52_SendCommand(0x13);		     //Transfer new data
 
+    switch (NUM)
+    {
+        case EPD_3IN52_WHITE:
+            EPD_Common_SendDataRepeat(0xFF, EPD_3IN52_WIDTH*EPD_3IN52_HEIGHT/8);
+            return;
+
+        case EPD_3IN52_BLACK:
+            EPD_Common_SendDataRepeat(0x00, EPD_3IN52_WIDTH*EPD_3IN52_HEIGHT/8);
+            return;
+
+        case EPD_3IN52_Source_Line:
+            EPD_Common_SendDataRepeat(0xAA, EPD_3IN52_WIDTH*EPD_3IN52_HEIGHT/8);
+            return;
+
+        case EPD_3IN52_Image:
+            //EPD_3IN52_SendData(gImage_1[pcnt++]);
+            return;
+
+        default:
+            break;
+    }
+
     for(column=0; column<EPD_3IN52_HEIGHT; column++)   
     {
         for(row=0; row<EPD_3IN52_WIDTH/8; row++)  
         {
             switch (NUM)
             {
-                case EPD_3IN52_WHITE:
-                    EPD_3IN52_SendData(0xFF);
-                    break;  
-                        
-                case EPD_3IN52_BLACK:
-                    EPD_3IN52_SendData(0x00);
-                    break;  
-                        
-                case EPD_3IN52_Source_Line:
-                    EPD_3IN52_SendData(0xAA);  
-                    break;
-                        
                 case EPD_3IN52_Gate_Line:
                     if(column%2)
-                        EPD_3IN52_SendData(0xff); //An odd number of Gate line  
+                        Row[row] = 0xff; //An odd number of Gate line  
                     else
-                        EPD_3IN52_SendData(0x00); //The even line Gate  
+                        Row[row] = 0x00; //The even line Gate  
                     break;			
                         
                 case EPD_3IN52_Chessboard:
                     if(row>=(EPD_3IN52_WIDTH/8/2)&&column>=(EPD_3IN52_HEIGHT/2))
-                        EPD_3IN52_SendData(0xff);
+                        Row[row] = 0xff;
                     else if(row<(EPD_3IN52_WIDTH/8/2)&&column<(EPD_3IN52_HEIGHT/2))
-                        EPD_3IN52_SendData(0xff);										
+                        Row[row] = 0xff;										
                     else
-                        EPD_3IN52_SendData(0x00);
+                        Row[row] = 0x00;
                     break; 			
                         
                 case EPD_3IN52_LEFT_BLACK_RIGHT_WHITE:
                     if(row>=(EPD_3IN52_WIDTH/8/2))
-                        EPD_3IN52_SendData(0xff);
+                        Row[row] = 0xff;
                     else
-                        EPD_3IN52_SendData(0x00);
+                        Row[row] = 0x00;
                     break;
                             
                 case EPD_3IN52_UP_BLACK_DOWN_WHITE:
                     if(column>=(EPD_3IN52_HEIGHT/2))
-                        EPD_3IN52_SendData(0xFF);
+                        Row[row] = 0xFF;
                     else
-                        EPD_3IN52_SendData(0x00);
+                        Row[row] = 0x00;
                     break;
                             
                 case EPD_3IN52_Frame:
                     if(column==0||column==(EPD_3IN52_HEIGHT-1))
-                        EPD_3IN52_SendData(0x00);						
+                        Row[row] = 0x00;						
                     else if(row==0)
-                        EPD_3IN52_SendData(0x7F);
+                        Row[row] = 0x7F;
                     else if(row==(EPD_3IN52_WIDTH/8-1))
-                        EPD_3IN52_SendData(0xFE);					
+                        Row[row] = 0xFE;					
                     else
-                        EPD_3IN52_SendData(0xFF);
+                        Row[row] = 0xFF;
                     break; 					
                             
                 case EPD_3IN52_Crosstalk:
                     if((row>=(EPD_3IN52_WIDTH/8/3)&&row<=(EPD_3IN52_WIDTH/8/3*2)&&column<=(EPD_3IN52_HEIGHT/3))||(row>=(EPD_3IN52_WIDTH/8/3)&&row<=(EPD_3IN52_WIDTH/8/3*2)&&column>=(EPD_3IN52_HEIGHT/3*2)))
-                        EPD_3IN52_SendData(0x00);
+                        Row[row] = 0x00;
                     else
-                        EPD_3IN52_SendData(0xFF);
+                        Row[row] = 0xFF;
                     break; 					
-                            
-                case EPD_3IN52_Image:
-                        //EPD_3IN52_SendData(gImage_1[pcnt++]);
-                    break;  
                                         
                 default:
-                    break;
+                    return;
             }
         }
+        EPD_Common_SendDataBuffer(Row, EPD_3IN52_WIDTH/8);
     }	
 }
 
@@ -564,12 +499,8 @@ parameter:
 ******************************************************************************/
 void EPD_3IN52_Clear(void)
 {
-    UWORD i;
     EPD_3IN52_SendCommand(0x13);		     //Transfer new data
-    for(i=0;i<(EPD_3IN52_WIDTH*EPD_3IN52_HEIGHT/8);i++)	     
-    {
-        EPD_3IN52_SendData(0xFF);
-    }
+    EPD_Common_SendDataRepeat(0xFF, (EPD_3IN52_WIDTH*EPD_3IN52_HEIGHT/8));
     EPD_3IN52_lut_GC();
 	EPD_3IN52_refresh();
 }
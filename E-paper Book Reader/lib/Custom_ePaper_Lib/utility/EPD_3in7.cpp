@@ -29,6 +29,7 @@
 #
 ******************************************************************************/
 #include "EPD_3in7.h"
+#include "EPD_Common.h"
 #include "Debug.h"
 
 static const UBYTE lut_4Gray_GC[] =
@@ -97,6 +98,7 @@ parameter:
 ******************************************************************************/
 static void EPD_3IN7_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(300);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -112,10 +114,7 @@ parameter:
 ******************************************************************************/
 static void EPD_3IN7_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -125,19 +124,13 @@ parameter:
 ******************************************************************************/
 static void EPD_3IN7_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 static void EPD_3IN7_ReadBusy_HIGH(void)
 {
     Debug("e-Paper busy\r\n");
-    UBYTE busy;
-    do {
-        busy = DEV_Digital_Read(EPD_BUSY_PIN);
-    } while(busy);
+    DEV_Wait_Busy(0, EPD_BUSY_TIMEOUT_MS);
     DEV_Delay_ms(200);
     Debug("e-Paper busy release\r\n");
 }
@@ -148,21 +141,24 @@ parameter:
 ******************************************************************************/
 void EPD_3IN7_Load_LUT(UBYTE lut)
 {
-  UWORD i;
+  const UBYTE *pLut;
+  if(lut == 0)
+      pLut = lut_4Gray_GC;
+  else if(lut == 1)
+      pLut = lut_1Gray_GC;
+  else if(lut == 2)
+      pLut = lut_1Gray_DU;
+  else if(lut == 3)
+      pLut = lut_1Gray_A2;
+  else
+      pLut = NULL;
+
   EPD_3IN7_SendCommand(0x32);
-  for (i = 0; i < 105; i++)
-  {
-    if(lut == 0)
-        EPD_3IN7_SendData(lut_4Gray_GC[i]);
-    else if(lut == 1)
-        EPD_3IN7_SendData(lut_1Gray_GC[i]);
-    else if(lut == 2)
-        EPD_3IN7_SendData(lut_1Gray_DU[i]);
-    else if(lut == 3)
-        EPD_3IN7_SendData(lut_1Gray_A2[i]);  
-    else
-        Debug("There is no such lut \r\n");
+  if(pLut == NULL) {
+      Debug("There is no such lut \r\n");
+      return;
   }
+  EPD_Common_SendDataBuffer(pLut, 105);
 }
 
 /******************************************************************************
@@ -341,11 +337,7 @@ void EPD_3IN7_4Gray_Clear(void)
     EPD_3IN7_SendData(0x00);
     
     EPD_3IN7_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-       for (UWORD i = 0; i < Width; i++) {
-           EPD_3IN7_SendData(0xff);
-       }
-    }
+    EPD_Common_SendDataRepeat(0xff, Width * Height);
     
     EPD_3IN7_SendCommand(0x4E);
     EPD_3IN7_SendData(0x00);
@@ -356,11 +348,7 @@ void EPD_3IN7_4Gray_Clear(void)
     EPD_3IN7_SendData(0x00);
     
     EPD_3IN7_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-       for (UWORD i = 0; i < Width; i++) {
-           EPD_3IN7_SendData(0xff);
-       }
-    }
+    EPD_Common_SendDataRepeat(0xff, Width * Height);
       
     EPD_3IN7_Load_LUT(0);
     EPD_3IN7_SendCommand(0x22);
@@ -376,7 +364,6 @@ parameter:
 ******************************************************************************/
 void EPD_3IN7_1Gray_Clear(void)
 {
-  UWORD i;
   UWORD IMAGE_COUNTER = EPD_3IN7_WIDTH * EPD_3IN7_HEIGHT / 8;
 
   EPD_3IN7_SendCommand(0x4E);
@@ -387,10 +374,7 @@ void EPD_3IN7_1Gray_Clear(void)
   EPD_3IN7_SendData(0x00);
 
   EPD_3IN7_SendCommand(0x24);
-  for (i = 0; i < IMAGE_COUNTER; i++)
-  {
-    EPD_3IN7_SendData(0xff);
-  }
+  EPD_Common_SendDataRepeat(0xff, IMAGE_COUNTER);
   
   EPD_3IN7_Load_LUT(2);
   
@@ -404,9 +388,6 @@ parameter:
 ******************************************************************************/
 void EPD_3IN7_4Gray_Display(const UBYTE *Image)
 {
-    UDOUBLE i,j,k;
-    UBYTE temp1,temp2,temp3;
-    
     EPD_3IN7_SendCommand(0x49);
     EPD_3IN7_SendData(0x00);
 
@@ -421,41 +402,7 @@ void EPD_3IN7_4Gray_Display(const UBYTE *Image)
     EPD_3IN7_SendData(0x00);
     
     EPD_3IN7_SendCommand(0x24);
-    for(i=0;i<16800;i++){
-        temp3=0;
-        for(j=0; j<2; j++) {
-            temp1 = Image[i*2+j];
-            for(k=0; k<2; k++) {
-                temp2 = temp1&0xC0;
-                if(temp2 == 0xC0)
-                    temp3 |= 0x01;//white
-                else if(temp2 == 0x00)
-                    temp3 |= 0x00;  //black
-                else if(temp2 == 0x80)
-                    temp3 |= 0x00;  //gray1
-                else //0x40
-                    temp3 |= 0x01; //gray2
-                temp3 <<= 1;
-
-                temp1 <<= 2;
-                temp2 = temp1&0xC0 ;
-                if(temp2 == 0xC0)  //white
-                    temp3 |= 0x01;
-                else if(temp2 == 0x00) //black
-                    temp3 |= 0x00;
-                else if(temp2 == 0x80)
-                    temp3 |= 0x00; //gray1
-                else    //0x40
-                    temp3 |= 0x01;	//gray2
-                if(j!=1 || k!=1)
-                    temp3 <<= 1;
-
-                temp1 <<= 2;
-            }
-
-        }
-        EPD_3IN7_SendData(temp3);
-    }
+    EPD_Common_SendGrayPlane(Image, 33600, EPD_3IN7_GRAY, 0);
     // new  data
     EPD_3IN7_SendCommand(0x4E);
     EPD_3IN7_SendData(0x00);
@@ -467,40 +414,46 @@ void EPD_3IN7_4Gray_Display(const UBYTE *Image)
     EPD_3IN7_SendData(0x00);
     
     EPD_3IN7_SendCommand(0x26);
-    for(i=0; i<16800; i++) {
-        temp3=0;
-        for(j=0; j<2; j++) {
-            temp1 = Image[i*2+j];
-            for(k=0; k<2; k++) {
-                temp2 = temp1&0xC0 ;
-                if(temp2 == 0xC0)
-                    temp3 |= 0x01;//white
-                else if(temp2 == 0x00)
-                    temp3 |= 0x00;  //black
-                else if(temp2 == 0x80)
-                    temp3 |= 0x01;  //gray1
-                else //0x40
-                    temp3 |= 0x00; //gray2
-                temp3 <<= 1;
-
-                temp1 <<= 2;
-                temp2 = temp1&0xC0 ;
-                if(temp2 == 0xC0)  //white
-                    temp3 |= 0x01;
-                else if(temp2 == 0x00) //black
-                    temp3 |= 0x00;
-                else if(temp2 == 0x80)
-                    temp3 |= 0x01; //gray1
-                else    //0x40
-                    temp3 |= 0x00;	//gray2
-                if(j!=1 || k!=1)
-                    temp3 <<= 1;
-
-                temp1 <<= 2;
-            }
-        }
-        EPD_3IN7_SendData(temp3);
-    }
+    EPD_Common_SendGrayPlane(Image, 33600, EPD_3IN7_GRAY, 1);
+
+    EPD_3IN7_Load_LUT(0);
+    
+    EPD_3IN7_SendCommand(0x22);
+    EPD_3IN7_SendData(0xC7);
+    
+    EPD_3IN7_SendCommand(0x20);
+    
+    EPD_3IN7_ReadBusy_HIGH(); 
+}
+
+/******************************************************************************
+function :	Sends a planar 4 gray image to e-Paper and displays
+parameter:
+    Image : the 0x24 plane then the 0x26 plane, drawn with
+            Paint_SetGrayPlanes(Ctx, EPD_3IN7_GRAY)
+******************************************************************************/
+void EPD_3IN7_4Gray_Display_Planes(const UBYTE *Image)
+{
+    EPD_3IN7_SendCommand(0x49);
+    EPD_3IN7_SendData(0x00);
+
+    EPD_3IN7_SendCommand(0x4E);
+    EPD_3IN7_SendData(0x00);
+    EPD_3IN7_SendData(0x00);
+    EPD_3IN7_SendCommand(0x4F);
+    EPD_3IN7_SendData(0x00);
+    EPD_3IN7_SendData(0x00);
+    EPD_3IN7_SendCommand(0x24);
+    EPD_Common_SendDataBuffer(Image, 16800);
+
+    EPD_3IN7_SendCommand(0x4E);
+    EPD_3IN7_SendData(0x00);
+    EPD_3IN7_SendData(0x00);
+    EPD_3IN7_SendCommand(0x4F);
+    EPD_3IN7_SendData(0x00);
+    EPD_3IN7_SendData(0x00);
+    EPD_3IN7_SendCommand(0x26);
+    EPD_Common_SendDataBuffer(Image + 16800, 16800);
 
     EPD_3IN7_Load_LUT(0);
     
@@ -518,7 +471,6 @@ parameter:
 ******************************************************************************/
 void EPD_3IN7_1Gray_Display(const UBYTE *Image)
 {
-  UWORD i;
   UWORD IMAGE_COUNTER = EPD_3IN7_WIDTH * EPD_3IN7_HEIGHT / 8;
 
   EPD_3IN7_SendCommand(0x4E);
@@ -529,10 +481,7 @@ void EPD_3IN7_1Gray_Display(const UBYTE *Image)
   EPD_3IN7_SendData(0x00);
 
   EPD_3IN7_SendCommand(0x24);
-  for (i = 0; i < IMAGE_COUNTER; i++)
-  {
-    EPD_3IN7_SendData(Image[i]);
-  }
+  EPD_Common_SendDataBuffer(Image, IMAGE_COUNTER);
 
   EPD_3IN7_Load_LUT(2);
   EPD_3IN7_SendCommand(0x20);
@@ -545,7 +494,7 @@ parameter:
 ******************************************************************************/
 void EPD_3IN7_1Gray_Display_Part(const UBYTE *Image, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
 {
-  UWORD i, Width;
+  UWORD Width;
   Width = (Xend-Xstart)%8 == 0 ? (Xend-Xstart)/8 : (Xend-Xstart)/8+1;
   UWORD IMAGE_COUNTER = Width * (Yend-Ystart);
 
@@ -561,10 +510,7 @@ void EPD_3IN7_1Gray_Display_Part(const UBYTE *Image, UWORD Xstart, UWORD Ystart,
   EPD_3IN7_SendData((Yend>>8) & 0x03);
 
   EPD_3IN7_SendCommand(0x24);
-  for (i = 0; i < IMAGE_COUNTER; i++)
-  {
-    EPD_3IN7_SendData(Image[i]);
-  }
+  EPD_Common_SendDataBuffer(Image, IMAGE_COUNTER);
   
   EPD_3IN7_Load_LUT(2);
   EPD_3IN7_SendCommand(0x20);
@@ -32,14 +32,17 @@
 #define __EPD_3IN7_H_
 
 #include "DEV_Config.h"
+#include "EPD_Common.h"
 
 // Display resolution
 #define EPD_3IN7_WIDTH       280
 #define EPD_3IN7_HEIGHT      480 
+#define EPD_3IN7_GRAY        EPD_Gray_Direct     //4 gray planes, see Paint_SetGrayPlanes()
 
 void EPD_3IN7_4Gray_Clear(void);
 void EPD_3IN7_4Gray_Init(void);
 void EPD_3IN7_4Gray_Display(const UBYTE *Image);
+void EPD_3IN7_4Gray_Display_Planes(const UBYTE *Image);
 
 void EPD_3IN7_1Gray_Clear(void);
 void EPD_3IN7_1Gray_Init(void);
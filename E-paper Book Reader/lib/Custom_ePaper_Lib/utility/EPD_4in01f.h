@@ -32,6 +32,7 @@
 #define __EPD_4IN01F_H__
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 /**********************************
 Color Index
@@ -54,6 +55,8 @@ void EPD_4IN01F_Display(const UBYTE *image);
 void EPD_4IN01F_Init(void);
 void EPD_4IN01F_Display_part(const UBYTE *image, UWORD xstart, UWORD ystart, UWORD image_width, UWORD image_heigh);
 
+EPD_MODEL(EPD_4IN01F, 1, 4);
+
 #endif
 
 
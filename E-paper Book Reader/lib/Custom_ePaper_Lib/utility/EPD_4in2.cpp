@@ -110,8 +110,14 @@
 #
 ******************************************************************************/
 #include "EPD_4in2.h"
+#include "EPD_Common.h"
 #include "Debug.h"
 
+//Init modes, see EPD_State_Check()
+#define EPD_4IN2_MODE_PARTIAL   1
+#define EPD_4IN2_MODE_FAST      2
+#define EPD_4IN2_MODE_4GRAY     3
+
 static const unsigned char EPD_4IN2_lut_vcom0[] = {
     0x00, 0x08, 0x08, 0x00, 0x00, 0x02,	
 	0x00, 0x0F, 0x0F, 0x00, 0x00, 0x01,	
@@ -277,6 +283,7 @@ parameter:
 ******************************************************************************/
 static void EPD_4IN2_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 0);
     DEV_Delay_ms(10);
     DEV_Digital_Write(EPD_RST_PIN, 1);
@@ -300,10 +307,7 @@ parameter:
 ******************************************************************************/
 static void EPD_4IN2_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -313,10 +317,7 @@ parameter:
 ******************************************************************************/
 static void EPD_4IN2_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -327,10 +328,7 @@ void EPD_4IN2_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
 	EPD_4IN2_SendCommand(0x71);
-    while(DEV_Digital_Read(EPD_BUSY_PIN) == 0) {      //LOW: idle, HIGH: busy
-		EPD_4IN2_SendCommand(0x71);
-        DEV_Delay_ms(100);
-    }
+    DEV_Wait_Busy(1, EPD_BUSY_TIMEOUT_MS);
     Debug("e-Paper busy release\r\n");
 }
 
@@ -351,80 +349,67 @@ parameter:
 ******************************************************************************/
 static void EPD_4IN2_Partial_SetLut(void)
 {
-	unsigned int count;
+	if(EPD_State_Lut(EPD_4IN2_Partial_lut_vcom1))
+		return;
 	EPD_4IN2_SendCommand(0x20);
-	for(count=0;count<44;count++)	     
-		{EPD_4IN2_SendData(EPD_4IN2_Partial_lut_vcom1[count]);}
+	EPD_Common_SendDataBuffer(EPD_4IN2_Partial_lut_vcom1, 44);
 
 	EPD_4IN2_SendCommand(0x21);
-	for(count=0;count<42;count++)	     
-		{EPD_4IN2_SendData(EPD_4IN2_Partial_lut_ww1[count]);}   
+	EPD_Common_SendDataBuffer(EPD_4IN2_Partial_lut_ww1, 42);   
 	
 	EPD_4IN2_SendCommand(0x22);
-	for(count=0;count<42;count++)	     
-		{EPD_4IN2_SendData(EPD_4IN2_Partial_lut_bw1[count]);} 
+	EPD_Common_SendDataBuffer(EPD_4IN2_Partial_lut_bw1, 42); 
 
 	EPD_4IN2_SendCommand(0x23);
-	for(count=0;count<42;count++)	     
-		{EPD_4IN2_SendData(EPD_4IN2_Partial_lut_wb1[count]);} 
+	EPD_Common_SendDataBuffer(EPD_4IN2_Partial_lut_wb1, 42); 
 
 	EPD_4IN2_SendCommand(0x24);
-	for(count=0;count<42;count++)	     
-		{EPD_4IN2_SendData(EPD_4IN2_Partial_lut_bb1[count]);} 
+	EPD_Common_SendDataBuffer(EPD_4IN2_Partial_lut_bb1, 42); 
 }
 
 static void EPD_4IN2_SetLut(void)
 {
-	unsigned int count;
+	if(EPD_State_Lut(EPD_4IN2_lut_vcom0))
+		return;
 	EPD_4IN2_SendCommand(0x20);
-	for(count=0;count<36;count++)	     
-		{EPD_4IN2_SendData(EPD_4IN2_lut_vcom0[count]);}
+	EPD_Common_SendDataBuffer(EPD_4IN2_lut_vcom0, 36);
 
 	EPD_4IN2_SendCommand(0x21);
-	for(count=0;count<36;count++)	     
-		{EPD_4IN2_SendData(EPD_4IN2_lut_ww[count]);}   
+	EPD_Common_SendDataBuffer(EPD_4IN2_lut_ww, 36);   
 	
 	EPD_4IN2_SendCommand(0x22);
-	for(count=0;count<36;count++)	     
-		{EPD_4IN2_SendData(EPD_4IN2_lut_bw[count]);} 
+	EPD_Common_SendDataBuffer(EPD_4IN2_lut_bw, 36); 
 
 	EPD_4IN2_SendCommand(0x23);
-	for(count=0;count<36;count++)	     
-		{EPD_4IN2_SendData(EPD_4IN2_lut_wb[count]);} 
+	EPD_Common_SendDataBuffer(EPD_4IN2_lut_wb, 36); 
 
 	EPD_4IN2_SendCommand(0x24);
-	for(count=0;count<36;count++)	     
-		{EPD_4IN2_SendData(EPD_4IN2_lut_bb[count]);}   
+	EPD_Common_SendDataBuffer(EPD_4IN2_lut_bb, 36);   
 }
 
 //LUT download
 static void EPD_4IN2_4Gray_lut(void)
 {
-	unsigned int count;	 
+	if(EPD_State_Lut(EPD_4IN2_4Gray_lut_vcom))
+		return;
 	{
 		EPD_4IN2_SendCommand(0x20);							//vcom
-		for(count=0;count<42;count++)
-			{EPD_4IN2_SendData(EPD_4IN2_4Gray_lut_vcom[count]);}
+		EPD_Common_SendDataBuffer(EPD_4IN2_4Gray_lut_vcom, 42);
 		
 	EPD_4IN2_SendCommand(0x21);							//red not use
-	for(count=0;count<42;count++)
-		{EPD_4IN2_SendData(EPD_4IN2_4Gray_lut_ww[count]);}
+	EPD_Common_SendDataBuffer(EPD_4IN2_4Gray_lut_ww, 42);
 
 		EPD_4IN2_SendCommand(0x22);							//bw r
-		for(count=0;count<42;count++)
-			{EPD_4IN2_SendData(EPD_4IN2_4Gray_lut_bw[count]);}
+		EPD_Common_SendDataBuffer(EPD_4IN2_4Gray_lut_bw, 42);
 
 		EPD_4IN2_SendCommand(0x23);							//wb w
-		for(count=0;count<42;count++)
-			{EPD_4IN2_SendData(EPD_4IN2_4Gray_lut_wb[count]);}
+		EPD_Common_SendDataBuffer(EPD_4IN2_4Gray_lut_wb, 42);
 
 		EPD_4IN2_SendCommand(0x24);							//bb b
-		for(count=0;count<42;count++)
-			{EPD_4IN2_SendData(EPD_4IN2_4Gray_lut_bb[count]);}
+		EPD_Common_SendDataBuffer(EPD_4IN2_4Gray_lut_bb, 42);
 
 		EPD_4IN2_SendCommand(0x25);							//vcom
-		for(count=0;count<42;count++)
-			{EPD_4IN2_SendData(EPD_4IN2_4Gray_lut_ww[count]);}
+		EPD_Common_SendDataBuffer(EPD_4IN2_4Gray_lut_ww, 42);
 	}	         
 }
 /******************************************************************************
@@ -434,6 +419,8 @@ parameter:
 
 void EPD_4IN2_Init_Partial(void)
 {
+    if(EPD_State_Check("EPD_4IN2", EPD_4IN2_MODE_PARTIAL))
+        return;
     EPD_4IN2_Reset();
 
     EPD_4IN2_SendCommand(0x01); // POWER SETTING
@@ -469,11 +456,14 @@ void EPD_4IN2_Init_Partial(void)
     EPD_4IN2_SendData(0x07); // 97white border 77black border		VBDF 17|D7 VBDW 97 VBDB 57		VBDF F7 VBDW 77 VBDB 37  VBDR B7
 
     EPD_4IN2_Partial_SetLut();
+    EPD_State_Set("EPD_4IN2", EPD_4IN2_MODE_PARTIAL);
 }
 
 //UC8176C
 void EPD_4IN2_Init_Fast(void)
 {
+	if(EPD_State_Check("EPD_4IN2", EPD_4IN2_MODE_FAST))
+		return;
 	EPD_4IN2_Reset();
 	EPD_4IN2_SendCommand(0x01);			//POWER SETTING 
 	EPD_4IN2_SendData (0x03);	          
@@ -509,12 +499,14 @@ void EPD_4IN2_Init_Fast(void)
 	EPD_4IN2_SendCommand(0X50);
 	EPD_4IN2_SendData(0x97);
 
-	EPD_4IN2_SetLut();		
-		
+	EPD_4IN2_SetLut();
+	EPD_State_Set("EPD_4IN2", EPD_4IN2_MODE_FAST);
 }	
 
 void EPD_4IN2_Init_4Gray(void)
 {
+	if(EPD_State_Check("EPD_4IN2", EPD_4IN2_MODE_4GRAY))
+		return;
 	EPD_4IN2_Reset();
 	EPD_4IN2_SendCommand(0x01);			//POWER SETTING
 	EPD_4IN2_SendData (0x03);
@@ -548,6 +540,7 @@ void EPD_4IN2_Init_4Gray(void)
 
 	EPD_4IN2_SendCommand(0X50);			//VCOM AND DATA INTERVAL SETTING			
 	EPD_4IN2_SendData(0x97);
+	EPD_State_Set("EPD_4IN2", EPD_4IN2_MODE_4GRAY);
 }
 /******************************************************************************
 function :	Clear screen
@@ -560,18 +553,10 @@ void EPD_4IN2_Clear(void)
     Height = EPD_4IN2_HEIGHT;
 
     EPD_4IN2_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2_SendData(0xFF);
-        }
-    }
+    EPD_Common_SendDataRepeat(0xFF, Width * Height);
 
     EPD_4IN2_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2_SendData(0xFF);
-        }
-    }
+    EPD_Common_SendDataRepeat(0xFF, Width * Height);
 
 	EPD_4IN2_SendCommand(0x12);		 //DISPLAY REFRESH 		
 	DEV_Delay_ms(1);	
@@ -589,18 +574,10 @@ void EPD_4IN2_Display(UBYTE *Image)
     Height = EPD_4IN2_HEIGHT;
 
 	EPD_4IN2_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2_SendData(0x00);
-        }
-    }
+    EPD_Common_SendDataRepeat(0x00, Width * Height);
 
     EPD_4IN2_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2_SendData(Image[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(Image, Width * Height);
 
 	EPD_4IN2_SendCommand(0x12);		 //DISPLAY REFRESH 		
 	DEV_Delay_ms(10);		
@@ -636,16 +613,14 @@ void EPD_4IN2_PartialDisplay(UWORD X_start,UWORD Y_start,UWORD X_end,UWORD Y_end
 
 	EPD_4IN2_SendCommand(0x10);	       //writes Old data to SRAM for programming
     for (UWORD j = 0; j < Y_end - Y_start; j++) {
-        for (UWORD i = 0; i < (X_end - X_start)/8; i++) {
-            EPD_4IN2_SendData(DATA[(Y_start + j)*Width + X_start/8 + i]);
-        }
+        EPD_Common_SendDataBuffer(DATA + (Y_start + j)*Width + X_start/8, (X_end - X_start)/8);
     }
 	EPD_4IN2_SendCommand(0x13);				 //writes New data to SRAM.
     for (UWORD j = 0; j < Y_end - Y_start; j++) {
         for (UWORD i = 0; i < (X_end - X_start)/8; i++) {
-            EPD_4IN2_SendData(~Image[(Y_start + j)*Width + X_start/8 + i]);
 			DATA[(Y_start + j)*Width + X_start/8 + i] = ~Image[(Y_start + j)*Width + X_start/8 + i];
         }
+        EPD_Common_SendDataBuffer(DATA + (Y_start + j)*Width + X_start/8, (X_end - X_start)/8);
     }
 
 	EPD_4IN2_SendCommand(0x12);		 //DISPLAY REFRESH 		             
@@ -655,98 +630,38 @@ void EPD_4IN2_PartialDisplay(UWORD X_start,UWORD Y_start,UWORD X_end,UWORD Y_end
 
 void EPD_4IN2_4GrayDisplay(const UBYTE *Image)
 {
-    UDOUBLE i,j,k,m;
-    UBYTE temp1,temp2,temp3;
 /****Color display description****
       white  gray1  gray2  black
 0x10|  01     01     00     00
 0x13|  01     00     01     00
 *********************************/
-	EPD_4IN2_SendCommand(0x10);	       
-	// EPD_4IN2_HEIGHT
-	// EPD_4IN2_WIDTH
-	for(m = 0; m<EPD_4IN2_HEIGHT;m++)
-		for(i=0;i<EPD_4IN2_WIDTH/8;i++)
-		{
-			temp3=0;
-			for(j=0;j<2;j++)	
-			{
-				
-				temp1 = Image[(m*(EPD_4IN2_WIDTH/8)+i)*2+j];
-				for(k=0;k<2;k++)	
-				{
-					temp2 = temp1&0xC0 ;
-					if(temp2 == 0xC0)
-						temp3 |= 0x01;//white
-					else if(temp2 == 0x00)
-						temp3 |= 0x00;  //black
-					else if(temp2 == 0x80) 
-						temp3 |= 0x01;  //gray1
-					else //0x40
-						temp3 |= 0x00; //gray2
-					temp3 <<= 1;	
-					
-					temp1 <<= 2;
-					temp2 = temp1&0xC0 ;
-					if(temp2 == 0xC0)  //white
-						temp3 |= 0x01;
-					else if(temp2 == 0x00) //black
-						temp3 |= 0x00;
-					else if(temp2 == 0x80)
-						temp3 |= 0x01; //gray1
-					else    //0x40
-							temp3 |= 0x00;	//gray2	
-					if(j!=1 || k!=1)				
-						temp3 <<= 1;
-					
-					temp1 <<= 2;
-				}
-				
-			 }
-			EPD_4IN2_SendData(temp3);			
-		}
+    UDOUBLE Len = (UDOUBLE)EPD_4IN2_WIDTH / 4 * EPD_4IN2_HEIGHT;
+
+	EPD_4IN2_SendCommand(0x10);
+	EPD_Common_SendGrayPlane(Image, Len, EPD_4IN2_GRAY, 0);
     // new  data
-    EPD_4IN2_SendCommand(0x13);	 
-	for(m = 0; m<EPD_4IN2_HEIGHT;m++)
-		for(i=0;i<EPD_4IN2_WIDTH/8;i++)
-		{
-			temp3=0;
-			for(j=0;j<2;j++)	
-			{
-				temp1 = Image[(m*(EPD_4IN2_WIDTH/8)+i)*2+j];
-				for(k=0;k<2;k++)	
-				{
-					temp2 = temp1&0xC0 ;
-					if(temp2 == 0xC0)
-						temp3 |= 0x01;//white
-					else if(temp2 == 0x00)
-						temp3 |= 0x00;  //black
-					else if(temp2 == 0x80) 
-						temp3 |= 0x00;  //gray1
-					else //0x40
-						temp3 |= 0x01; //gray2
-					temp3 <<= 1;	
-					
-					temp1 <<= 2;
-					temp2 = temp1&0xC0 ;
-					if(temp2 == 0xC0)  //white
-						temp3 |= 0x01;
-					else if(temp2 == 0x00) //black
-						temp3 |= 0x00;
-					else if(temp2 == 0x80)
-						temp3 |= 0x00; //gray1
-					else    //0x40
-							temp3 |= 0x01;	//gray2
-					if(j!=1 || k!=1)					
-						temp3 <<= 1;
-					
-					temp1 <<= 2;
-				}
-				
-			 }
-			EPD_4IN2_SendData(temp3);	
-		}
-    
+    EPD_4IN2_SendCommand(0x13);
+	EPD_Common_SendGrayPlane(Image, Len, EPD_4IN2_GRAY, 1);
+
+    EPD_4IN2_4Gray_lut();
+    EPD_4IN2_TurnOnDisplay();
+}
+
+/******************************************************************************
+function :	Sends a planar 4 gray image to e-Paper and displays
+parameter:
+    Image : the 0x10 plane then the 0x13 plane, drawn with
+            Paint_SetGrayPlanes(Ctx, EPD_4IN2_GRAY)
+******************************************************************************/
+void EPD_4IN2_4GrayDisplay_Planes(const UBYTE *Image)
+{
+    UDOUBLE Plane = (UDOUBLE)EPD_4IN2_WIDTH / 8 * EPD_4IN2_HEIGHT;
+
+	EPD_4IN2_SendCommand(0x10);
+	EPD_Common_SendDataBuffer(Image, Plane);
+    EPD_4IN2_SendCommand(0x13);
+	EPD_Common_SendDataBuffer(Image + Plane, Plane);
+
     EPD_4IN2_4Gray_lut();
     EPD_4IN2_TurnOnDisplay();
 }
@@ -764,4 +679,5 @@ void EPD_4IN2_Sleep(void)
 
     EPD_4IN2_SendCommand(0x07); // DEEP_SLEEP
     EPD_4IN2_SendData(0XA5);
+    EPD_State_Invalidate();
 }
@@ -113,10 +113,12 @@
 #define _EPD_4IN2_H_
 
 #include "DEV_Config.h"
+#include "EPD_Common.h"
 
 // Display resolution
 #define EPD_4IN2_WIDTH       400
 #define EPD_4IN2_HEIGHT      300
+#define EPD_4IN2_GRAY        EPD_Gray_Swap       //4 gray planes, see Paint_SetGrayPlanes()
 
 void EPD_4IN2_Init_Fast(void);
 void EPD_4IN2_Init_Partial(void);
@@ -127,6 +129,7 @@ void EPD_4IN2_PartialDisplay(UWORD X_start,UWORD Y_start,UWORD X_end,UWORD Y_end
 
 void EPD_4IN2_Init_4Gray(void);
 void EPD_4IN2_4GrayDisplay(const UBYTE *Image);
+void EPD_4IN2_4GrayDisplay_Planes(const UBYTE *Image);
 
 
 #endif
@@ -29,6 +29,7 @@
 #
 ******************************************************************************/
 #include "EPD_4in26.h"
+#include "EPD_Common.h"
 #include "Debug.h"
 
 const unsigned char LUT_DATA_4Gray[112] =    //112bytes
@@ -59,6 +60,7 @@ parameter:
 ******************************************************************************/
 static void EPD_4in26_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(100);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -74,10 +76,7 @@ parameter:
 ******************************************************************************/
 static void EPD_4in26_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -87,18 +86,12 @@ parameter:
 ******************************************************************************/
 static void EPD_4in26_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 static void EPD_4in26_SendData2(UBYTE *pData, UDOUBLE len)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_Write_nByte(pData, len);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendDataBuffer(pData, len);
 }
 
 /******************************************************************************
@@ -108,12 +101,7 @@ parameter:
 void EPD_4in26_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-	while(1)
-	{	 //=1 BUSY
-		if(DEV_Digital_Read(EPD_BUSY_PIN)==0) 
-			break;
-		DEV_Delay_ms(20);
-	}
+	DEV_Wait_Busy(0, EPD_BUSY_TIMEOUT_MS);
 	DEV_Delay_ms(20);
     Debug("e-Paper busy release\r\n");
 }
@@ -160,11 +148,8 @@ parameter:
 ******************************************************************************/
 static void EPD_4in26_Lut(void)
 {
-    unsigned int count;
     EPD_4in26_SendCommand(0x32); //vcom
-    for(count = 0; count < 105 ; count++) {
-        EPD_4in26_SendData(LUT_DATA_4Gray[count]);
-    }
+    EPD_Common_SendDataBuffer(LUT_DATA_4Gray, 105);
 
     EPD_4in26_SendCommand(0x03); //VGH      
 	EPD_4in26_SendData(LUT_DATA_4Gray[105]);
@@ -184,6 +169,8 @@ parameter:
 ******************************************************************************/
 static void EPD_4in26_SetWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
 {
+    if(EPD_State_Window(Xstart, Ystart, Xend, Yend))
+        return;
     EPD_4in26_SendCommand(0x44); // SET_RAM_X_ADDRESS_START_END_POSITION
     EPD_4in26_SendData(Xstart & 0xFF);
     EPD_4in26_SendData((Xstart>>8) & 0x03);
@@ -419,12 +406,12 @@ void EPD_4in26_Display_Fast(UBYTE *Image)
 	EPD_4in26_TurnOnDisplay_Fast();	
 }
 
-void EPD_4in26_Display_Part(UBYTE *Image, UWORD x, UWORD y, UWORD w, UWORD l)
+/******************************************************************************
+function :	Reset into a partial update of a window, up to the RAM write
+parameter:
+******************************************************************************/
+static void EPD_4in26_Part_Begin(UWORD x, UWORD y, UWORD w, UWORD l)
 {
-	UWORD i;
-	UWORD height = l;
-	UWORD width =  (w % 8 == 0)? (w / 8 ): (w / 8 + 1);
-
     EPD_4in26_Reset();
 
 	EPD_4in26_SendCommand(0x18); // use the internal temperature sensor
@@ -438,6 +425,15 @@ void EPD_4in26_Display_Part(UBYTE *Image, UWORD x, UWORD y, UWORD w, UWORD l)
 	EPD_4in26_SetCursor(x, y);
 
 	EPD_4in26_SendCommand(0x24);   //write RAM for black(0)/white (1)
+}
+
+void EPD_4in26_Display_Part(UBYTE *Image, UWORD x, UWORD y, UWORD w, UWORD l)
+{
+	UWORD i;
+	UWORD height = l;
+	UWORD width =  (w % 8 == 0)? (w / 8 ): (w / 8 + 1);
+
+	EPD_4in26_Part_Begin(x, y, w, l);
 	for(i=0; i<height; i++)
 	{
 		EPD_4in26_SendData2((UBYTE *)(Image+i*width), width);
@@ -445,86 +441,66 @@ void EPD_4in26_Display_Part(UBYTE *Image, UWORD x, UWORD y, UWORD w, UWORD l)
 	EPD_4in26_TurnOnDisplay_Part();	
 }
 
-void EPD_4in26_4GrayDisplay(UBYTE *Image)
+/******************************************************************************
+function :	Partial refresh of a window, taken from the full frame
+parameter:
+    Image : full frame image, EPD_4in26_WIDTH x EPD_4in26_HEIGHT
+    x     : x starting point, rounded down to 8
+    y     : y starting point
+    w     : width, rounded up so the window ends on a byte
+    l     : height
+Info:
+    Only the window is sent, row by row from the frame, e.g. the
+    rectangle from Paint_GetDirty(Rect, 1, 8).
+******************************************************************************/
+void EPD_4in26_Display_Part_Frame(const UBYTE *Image, UWORD x, UWORD y, UWORD w, UWORD l)
 {
-    UDOUBLE i,j,k;
-    UBYTE temp1,temp2,temp3;
+	UWORD i;
+	UWORD Line = EPD_4in26_WIDTH / 8;
+	UWORD x_end = (x + w + 7) / 8;
+
+	x = x / 8;
+	if(x_end > Line)
+		x_end = Line;
+	if(y + l > EPD_4in26_HEIGHT)
+		l = EPD_4in26_HEIGHT - y;
+	if(x >= x_end || y >= EPD_4in26_HEIGHT || l == 0)
+		return;
+
+	EPD_4in26_Part_Begin(x * 8, y, (x_end - x) * 8, l);
+	for(i=0; i<l; i++)
+	{
+		EPD_Common_SendDataBuffer(Image + (UDOUBLE)(y + i) * Line + x, x_end - x);
+	}
+	EPD_4in26_TurnOnDisplay_Part();	
+}
 
+void EPD_4in26_4GrayDisplay(UBYTE *Image)
+{
     // old  data
     EPD_4in26_SendCommand(0x24);
-    for(i=0; i<48000; i++) {             //5808*4  46464
-        temp3=0;
-        for(j=0; j<2; j++) {
-            temp1 = Image[i*2+j];
-            for(k=0; k<2; k++) {
-                temp2 = temp1&0xC0;
-                if(temp2 == 0xC0)
-                    temp3 |= 0x00;
-                else if(temp2 == 0x00)
-                    temp3 |= 0x01; 
-                else if(temp2 == 0x80)
-                    temp3 |= 0x01; 
-                else //0x40
-                    temp3 |= 0x00; 
-                temp3 <<= 1;
-
-                temp1 <<= 2;
-                temp2 = temp1&0xC0 ;
-                if(temp2 == 0xC0) 
-                    temp3 |= 0x00;
-                else if(temp2 == 0x00) 
-                    temp3 |= 0x01;
-                else if(temp2 == 0x80)
-                    temp3 |= 0x01; 
-                else    //0x40
-                    temp3 |= 0x00;	
-                if(j!=1 || k!=1)
-                    temp3 <<= 1;
-
-                temp1 <<= 2;
-            }
-
-        }
-        EPD_4in26_SendData(temp3);
-        // printf("%x",temp3);
-    }
+    EPD_Common_SendGrayPlane(Image, 96000, EPD_4in26_GRAY, 0);
 
     EPD_4in26_SendCommand(0x26);   //write RAM for black(0)/white (1)
-    for(i=0; i<48000; i++) {             //5808*4  46464
-        temp3=0;
-        for(j=0; j<2; j++) {
-            temp1 = Image[i*2+j];
-            for(k=0; k<2; k++) {
-                temp2 = temp1&0xC0 ;
-                if(temp2 == 0xC0)
-                    temp3 |= 0x00;//white
-                else if(temp2 == 0x00)
-                    temp3 |= 0x01;  //black
-                else if(temp2 == 0x80)
-                    temp3 |= 0x00;  //gray1
-                else //0x40
-                    temp3 |= 0x01; //gray2
-                temp3 <<= 1;
-
-                temp1 <<= 2;
-                temp2 = temp1&0xC0 ;
-                if(temp2 == 0xC0)  //white
-                    temp3 |= 0x00;
-                else if(temp2 == 0x00) //black
-                    temp3 |= 0x01;
-                else if(temp2 == 0x80)
-                    temp3 |= 0x00; //gray1
-                else    //0x40
-                    temp3 |= 0x01;	//gray2
-                if(j!=1 || k!=1)
-                    temp3 <<= 1;
-
-                temp1 <<= 2;
-            }
-        }
-        EPD_4in26_SendData(temp3);
-        // printf("%x",temp3);
-    }
+    EPD_Common_SendGrayPlane(Image, 96000, EPD_4in26_GRAY, 1);
+
+    EPD_4in26_TurnOnDisplay_4GRAY();
+}
+
+/******************************************************************************
+function :	Sends a planar 4 gray image to e-Paper and displays
+parameter:
+    Image : the 0x24 plane then the 0x26 plane, drawn with
+            Paint_SetGrayPlanes(Ctx, EPD_4in26_GRAY)
+******************************************************************************/
+void EPD_4in26_4GrayDisplay_Planes(const UBYTE *Image)
+{
+    UDOUBLE Plane = (UDOUBLE)EPD_4in26_WIDTH / 8 * EPD_4in26_HEIGHT;
+
+    EPD_4in26_SendCommand(0x24);
+    EPD_Common_SendDataBuffer(Image, Plane);
+    EPD_4in26_SendCommand(0x26);
+    EPD_Common_SendDataBuffer(Image + Plane, Plane);
 
     EPD_4in26_TurnOnDisplay_4GRAY();
 }
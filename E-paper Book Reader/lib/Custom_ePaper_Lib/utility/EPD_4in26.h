@@ -32,10 +32,13 @@
 #define __EPD_4in26_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
+#include "EPD_Common.h"
 
 // Display resolution
 #define EPD_4in26_WIDTH       800
 #define EPD_4in26_HEIGHT      480
+#define EPD_4in26_GRAY        EPD_Gray_Invert     //4 gray planes, see Paint_SetGrayPlanes()
 
 void EPD_4in26_Init(void);
 void EPD_4in26_Init_Fast(void);
@@ -45,8 +48,11 @@ void EPD_4in26_Display(UBYTE *Image);
 void EPD_4in26_Display_Base(UBYTE *Image);
 void EPD_4in26_Display_Fast(UBYTE *Image);
 void EPD_4in26_Display_Part(UBYTE *Image, UWORD x, UWORD y, UWORD w, UWORD l);
+void EPD_4in26_Display_Part_Frame(const UBYTE *Image, UWORD x, UWORD y, UWORD w, UWORD l);
 void EPD_4in26_4GrayDisplay(UBYTE *Image);
+void EPD_4in26_4GrayDisplay_Planes(const UBYTE *Image);
 void EPD_4in26_Sleep(void);
 
+EPD_MODEL(EPD_4in26, 1, 1);
 
 #endif
@@ -29,6 +29,8 @@
 #
 ******************************************************************************/
 #include "EPD_4in2_V2.h"
+#include "EPD_Common.h"
+#include "EPD_Panel.h"
 #include "Debug.h"
 
 const unsigned char LUT_ALL[233]={							
@@ -74,6 +76,7 @@ parameter:
 ******************************************************************************/
 static void EPD_4IN2_V2_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(100);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -89,10 +92,7 @@ parameter:
 ******************************************************************************/
 static void EPD_4IN2_V2_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -102,10 +102,7 @@ parameter:
 ******************************************************************************/
 static void EPD_4IN2_V2_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -115,9 +112,7 @@ parameter:
 void EPD_4IN2_V2_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-    while(DEV_Digital_Read(EPD_BUSY_PIN) == 1) {      //LOW: idle, HIGH: busy
-        DEV_Delay_ms(10);
-    }
+    DEV_Wait_Busy(0, EPD_BUSY_TIMEOUT_MS);
     Debug("e-Paper busy release\r\n");
 }
 
@@ -125,14 +120,6 @@ void EPD_4IN2_V2_ReadBusy(void)
 function :	Turn On Display
 parameter:
 ******************************************************************************/
-static void EPD_4IN2_V2_TurnOnDisplay(void)
-{
-    EPD_4IN2_V2_SendCommand(0x22);
-	EPD_4IN2_V2_SendData(0xF7);
-    EPD_4IN2_V2_SendCommand(0x20);
-    EPD_4IN2_V2_ReadBusy();
-}
-
 static void EPD_4IN2_V2_TurnOnDisplay_Fast(void)
 {
     EPD_4IN2_V2_SendCommand(0x22);
@@ -163,6 +150,8 @@ parameter:
 ******************************************************************************/
 static void EPD_4IN2_V2_SetWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
 {
+    if(EPD_State_Window(Xstart, Ystart, Xend, Yend))
+        return;
     EPD_4IN2_V2_SendCommand(0x44); // SET_RAM_X_ADDRESS_START_END_POSITION
     EPD_4IN2_V2_SendData((Xstart>>3) & 0xFF);
     EPD_4IN2_V2_SendData((Xend>>3) & 0xFF);
@@ -191,14 +180,11 @@ static void EPD_4IN2_V2_SetCursor(UWORD Xstart, UWORD Ystart)
 //LUT download
 static void EPD_4IN2_V2_4Gray_lut(void)
 {
-    unsigned char i;
+    unsigned char i = 227;
 
     //WS byte 0~152, the content of VS[nX-LUTm], TP[nX], RP[n], SR[nXY], FR[n] and XON[nXY]
     EPD_4IN2_V2_SendCommand(0x32);					
-    for(i=0;i<227;i++)
-    {
-        EPD_4IN2_V2_SendData(LUT_ALL[i]);
-    }	
+    EPD_Common_SendDataBuffer(LUT_ALL, 227);	
     //WS byte 153, the content of Option for LUT end	
     EPD_4IN2_V2_SendCommand(0x3F);					
     EPD_4IN2_V2_SendData(LUT_ALL[i++]);
@@ -218,38 +204,53 @@ static void EPD_4IN2_V2_4Gray_lut(void)
     EPD_4IN2_V2_SendData(LUT_ALL[i++]);//VCOM
 }
 
+static const UBYTE EPD_4IN2_V2_Init_Script[] = {
+    EPD_RESET(100, 2, 100),
+    EPD_BUSY,
+    EPD_CMD(0x12, 0),               //soft reset
+    EPD_BUSY,
+    EPD_CMD(0x21, 2), 0x40, 0x00,   //Display update control
+    EPD_CMD(0x3C, 1), 0x05,         //BorderWavefrom
+    EPD_CMD(0x11, 1), 0x03,         //data entry mode, X-mode
+    EPD_WINDOW(EPD_RAM_YINC),
+    EPD_CURSOR(EPD_RAM_YINC),
+    EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_4IN2_V2_Refresh_Script[] = {
+    EPD_CMD(0x22, 1), 0xF7,
+    EPD_CMD(0x20, 0),
+    EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_4IN2_V2_Sleep_Script[] = {
+    EPD_CMD(0x10, 1), 0x01,         //DEEP_SLEEP
+    EPD_DELAY(200),
+    EPD_END
+};
+
+const EPD_PANEL EPD_4IN2_V2_Panel = {
+    "EPD_4IN2_V2", EPD_4IN2_V2_WIDTH, EPD_4IN2_V2_HEIGHT,
+    2, {
+        { 0x24, EPD_PLANE_IMAGE0, 0, 0xFF, 0 },
+        { 0x26, EPD_PLANE_IMAGE0, 0, 0xFF, 0 },   //base of the partial refresh
+    },
+    0, 0, 0, 0, 0,
+    EPD_4IN2_V2_Init_Script, EPD_4IN2_V2_Refresh_Script, EPD_4IN2_V2_Sleep_Script,
+    EPD_CAP_PARTIAL | EPD_CAP_FAST | EPD_CAP_4GRAY,
+    NULL, NULL,                     //the analog supply is switched by each update sequence, no STANDBY
+    NULL,
+};
+
 /******************************************************************************
 function :	Initialize the e-Paper register
 parameter:
 ******************************************************************************/
 void EPD_4IN2_V2_Init(void)
 {
-    EPD_4IN2_V2_Reset();
-
-    EPD_4IN2_V2_ReadBusy();   
-    EPD_4IN2_V2_SendCommand(0x12);   // soft  reset
-    EPD_4IN2_V2_ReadBusy();
-	
-    // EPD_4IN2_V2_SendCommand(0x01); //Driver output control      
-    // EPD_4IN2_V2_SendData((EPD_4IN2_V2_HEIGHT-1)%256);   
-    // EPD_4IN2_V2_SendData((EPD_4IN2_V2_HEIGHT-1)/256);
-    // EPD_4IN2_V2_SendData(0x00);
-
-    EPD_4IN2_V2_SendCommand(0x21); //  Display update control
-    EPD_4IN2_V2_SendData(0x40);		
-    EPD_4IN2_V2_SendData(0x00);		
-
-    EPD_4IN2_V2_SendCommand(0x3C); //BorderWavefrom
-    EPD_4IN2_V2_SendData(0x05);
-	
-    EPD_4IN2_V2_SendCommand(0x11);	// data  entry  mode
-    EPD_4IN2_V2_SendData(0x03);		// X-mode   
-		
-	EPD_4IN2_V2_SetWindows(0, 0, EPD_4IN2_V2_WIDTH-1, EPD_4IN2_V2_HEIGHT-1);
-	 
-	EPD_4IN2_V2_SetCursor(0, 0);
-	
-    EPD_4IN2_V2_ReadBusy();
+    EPD_Panel_Init(&EPD_4IN2_V2_Panel);
 }
 
 /******************************************************************************
@@ -340,24 +341,7 @@ parameter:
 ******************************************************************************/
 void EPD_4IN2_V2_Clear(void)
 {
-    UWORD Width, Height;
-    Width = (EPD_4IN2_V2_WIDTH % 8 == 0)? (EPD_4IN2_V2_WIDTH / 8 ): (EPD_4IN2_V2_WIDTH / 8 + 1);
-    Height = EPD_4IN2_V2_HEIGHT;
-
-    EPD_4IN2_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2_V2_SendData(0xFF);
-        }
-    }
-
-    EPD_4IN2_V2_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2_V2_SendData(0xFF);
-        }
-    }
-    EPD_4IN2_V2_TurnOnDisplay();
+    EPD_Panel_Clear(&EPD_4IN2_V2_Panel);
 }
 
 /******************************************************************************
@@ -366,24 +350,7 @@ parameter:
 ******************************************************************************/
 void EPD_4IN2_V2_Display(UBYTE *Image)
 {
-    UWORD Width, Height;
-    Width = (EPD_4IN2_V2_WIDTH % 8 == 0)? (EPD_4IN2_V2_WIDTH / 8 ): (EPD_4IN2_V2_WIDTH / 8 + 1);
-    Height = EPD_4IN2_V2_HEIGHT;
-
-    EPD_4IN2_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2_V2_SendData(Image[i + j * Width]);
-        }
-    }
-
-    EPD_4IN2_V2_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2_V2_SendData(Image[i + j * Width]);
-        }
-    }
-    EPD_4IN2_V2_TurnOnDisplay();
+    EPD_Panel_Display(&EPD_4IN2_V2_Panel, Image, NULL);
 }
 
 /******************************************************************************
@@ -397,121 +364,33 @@ void EPD_4IN2_V2_Display_Fast(UBYTE *Image)
     Height = EPD_4IN2_V2_HEIGHT;
 
     EPD_4IN2_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2_V2_SendData(Image[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(Image, Width * Height);
 
     EPD_4IN2_V2_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2_V2_SendData(Image[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(Image, Width * Height);
     EPD_4IN2_V2_TurnOnDisplay_Fast();
 }
 
 
 void EPD_4IN2_V2_Display_4Gray(UBYTE *Image)
 {
-    UDOUBLE i,j,k,m;
-    UBYTE temp1,temp2,temp3;
 /****Color display description****
       white  gray2  gray1  black
 0x10|  01     01     00     00
 0x13|  01     00     01     00
 *********************************/
-	EPD_4IN2_V2_SendCommand(0x24);	       
-	// EPD_4IN2_HEIGHT
-	// EPD_4IN2_WIDTH
-	for(m = 0; m<EPD_4IN2_V2_HEIGHT;m++)
-		for(i=0;i<EPD_4IN2_V2_WIDTH/8;i++)
-		{
-			temp3=0;
-			for(j=0;j<2;j++)	
-			{
-				
-				temp1 = Image[(m*(EPD_4IN2_V2_WIDTH/8)+i)*2+j];
-				for(k=0;k<2;k++)	
-				{
-					temp2 = temp1&0xC0 ;
-					if(temp2 == 0xC0)
-						temp3 |= 0x01;//white
-					else if(temp2 == 0x00)
-						temp3 |= 0x00;  //black
-					else if(temp2 == 0x80) 
-						temp3 |= 0x00;  //gray1
-					else //0x40
-						temp3 |= 0x01; //gray2
-					temp3 <<= 1;	
-					
-					temp1 <<= 2;
-					temp2 = temp1&0xC0 ;
-					if(temp2 == 0xC0)  //white
-						temp3 |= 0x01;
-					else if(temp2 == 0x00) //black
-						temp3 |= 0x00;
-					else if(temp2 == 0x80)
-						temp3 |= 0x00; //gray1
-					else    //0x40
-							temp3 |= 0x01;	//gray2	
-					if(j!=1 || k!=1)				
-						temp3 <<= 1;
-					
-					temp1 <<= 2;
-				}
-				
-			 }
-			EPD_4IN2_V2_SendData(temp3);			
-		}
+	EPD_4IN2_V2_SendCommand(0x24);
+	EPD_Common_SendGrayPlane(Image, 30000, EPD_4IN2_V2_GRAY, 0);
     // new  data
-    EPD_4IN2_V2_SendCommand(0x26);	 
-	for(m = 0; m<EPD_4IN2_V2_HEIGHT;m++)
-		for(i=0;i<EPD_4IN2_V2_WIDTH/8;i++)
-		{
-			temp3=0;
-			for(j=0;j<2;j++)	
-			{
-				temp1 = Image[(m*(EPD_4IN2_V2_WIDTH/8)+i)*2+j];
-				for(k=0;k<2;k++)	
-				{
-					temp2 = temp1&0xC0 ;
-					if(temp2 == 0xC0)
-						temp3 |= 0x01;//white
-					else if(temp2 == 0x00)
-						temp3 |= 0x00;  //black
-					else if(temp2 == 0x80) 
-						temp3 |= 0x01;  //gray1
-					else //0x40
-						temp3 |= 0x00; //gray2
-					temp3 <<= 1;	
-					
-					temp1 <<= 2;
-					temp2 = temp1&0xC0 ;
-					if(temp2 == 0xC0)  //white
-						temp3 |= 0x01;
-					else if(temp2 == 0x00) //black
-						temp3 |= 0x00;
-					else if(temp2 == 0x80)
-						temp3 |= 0x01; //gray1
-					else    //0x40
-							temp3 |= 0x00;	//gray2
-					if(j!=1 || k!=1)					
-						temp3 <<= 1;
-					
-					temp1 <<= 2;
-				}
-				
-			 }
-			EPD_4IN2_V2_SendData(temp3);	
-		}
+    EPD_4IN2_V2_SendCommand(0x26);
+	EPD_Common_SendGrayPlane(Image, 30000, EPD_4IN2_V2_GRAY, 1);
     EPD_4IN2_V2_TurnOnDisplay_4Gray();
 }
 
 // Send partial data for partial refresh
 void EPD_4IN2_V2_PartialDisplay(UBYTE *Image, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
 {
+    EPD_State_Invalidate();
     if((Xstart % 8 + Xend % 8 == 8 && Xstart % 8 > Xend % 8) || Xstart % 8 + Xend % 8 == 0 || (Xend - Xstart)%8 == 0)
 	{
 			Xstart = Xstart / 8 ;
@@ -524,7 +403,7 @@ void EPD_4IN2_V2_PartialDisplay(UBYTE *Image, UWORD Xstart, UWORD Ystart, UWORD
 	}
 
 
-	UWORD i, Width;
+	UWORD Width;
 	Width = Xend -  Xstart;
 	UWORD IMAGE_COUNTER = Width * (Yend-Ystart);
 
@@ -557,9 +436,7 @@ void EPD_4IN2_V2_PartialDisplay(UBYTE *Image, UWORD Xstart, UWORD Ystart, UWORD
 	EPD_4IN2_V2_SendData((Ystart>>8) & 0x01);
 	
     EPD_4IN2_V2_SendCommand(0x24);
-    for (i = 0; i < IMAGE_COUNTER; i++) {
-		EPD_4IN2_V2_SendData(Image[i]);
-	}
+    EPD_Common_SendDataBuffer(Image, IMAGE_COUNTER);
 	
 	EPD_4IN2_V2_TurnOnDisplay_Partial();
 }
@@ -570,7 +447,5 @@ parameter:
 ******************************************************************************/
 void EPD_4IN2_V2_Sleep(void)
 {
-    EPD_4IN2_V2_SendCommand(0x10); // DEEP_SLEEP
-    EPD_4IN2_V2_SendData(0x01);
-	DEV_Delay_ms(200);
+    EPD_Panel_Sleep(&EPD_4IN2_V2_Panel);
 }
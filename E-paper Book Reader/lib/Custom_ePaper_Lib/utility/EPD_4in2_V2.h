@@ -32,10 +32,16 @@
 #define _EPD_4IN2_V2_H_
 
 #include "DEV_Config.h"
+#include "EPD_Common.h"
+#include "EPD_Model.h"
+#include "EPD_Panel.h"
 
 // Display resolution
 #define EPD_4IN2_V2_WIDTH       400
 #define EPD_4IN2_V2_HEIGHT      300
+#define EPD_4IN2_V2_GRAY        EPD_Gray_Direct     //4 gray planes, see Paint_SetGrayPlanes()
+
+extern const EPD_PANEL EPD_4IN2_V2_Panel;
 
 #define Seconds_1_5S      0
 #define Seconds_1S        1
@@ -50,4 +56,6 @@ void EPD_4IN2_V2_Display_4Gray(UBYTE *Image);
 void EPD_4IN2_V2_PartialDisplay(UBYTE *Image, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend);
 void EPD_4IN2_V2_Sleep(void);
 
+EPD_MODEL(EPD_4IN2_V2, 1, 1);
+
 #endif
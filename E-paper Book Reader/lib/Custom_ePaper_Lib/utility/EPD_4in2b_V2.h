@@ -31,14 +31,20 @@
 #define __EPD_4IN2B_V2_H_
 
 #include "DEV_Config.h"
+#include "EPD_Common.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_4IN2B_V2_WIDTH       400
 #define EPD_4IN2B_V2_HEIGHT      300
+#define EPD_4IN2B_V2_COLOR       EPD_Color_RedHigh    //3 color planes, see Paint_SetColorPlanes()
 
 void EPD_4IN2B_V2_Init(void);
 void EPD_4IN2B_V2_Clear(void);
 void EPD_4IN2B_V2_Display(const UBYTE *blackimage, const UBYTE *ryimage);
+void EPD_4IN2B_V2_Display_Planes(const UBYTE *Image);
 void EPD_4IN2B_V2_Sleep(void);
 
+EPD_MODEL(EPD_4IN2B_V2, 2, 1);
+
 #endif
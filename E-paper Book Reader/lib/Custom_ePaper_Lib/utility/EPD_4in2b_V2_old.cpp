@@ -29,6 +29,7 @@
 #
 ******************************************************************************/
 #include "EPD_4in2b_V2_old.h"
+#include "EPD_Common.h"
 
 static uint8_t flag=0;
 
@@ -38,6 +39,7 @@ parameter:
 ******************************************************************************/
 static void EPD_4IN2B_V2_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(200);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -53,10 +55,7 @@ parameter:
 ******************************************************************************/
 static void EPD_4IN2B_V2_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -66,10 +65,7 @@ parameter:
 ******************************************************************************/
 static void EPD_4IN2B_V2_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -79,10 +75,8 @@ parameter:
 void EPD_4IN2B_V2_ReadBusy_old_1(void)
 {
     Debug("e-Paper busy\r\n");
-	do{
-		EPD_4IN2B_V2_SendCommand(0x71);
-		DEV_Delay_ms(20);
-	}while(!(DEV_Digital_Read(EPD_BUSY_PIN)));      //0: busy, 1: idle
+	EPD_4IN2B_V2_SendCommand(0x71);
+	DEV_Wait_Busy(1, EPD_BUSY_TIMEOUT_MS);      //0: busy, 1: idle
     DEV_Delay_ms(20);
 	Debug("e-Paper busy release\r\n");
 }
@@ -90,9 +84,7 @@ void EPD_4IN2B_V2_ReadBusy_old_1(void)
 void EPD_4IN2B_V2_ReadBusy_new_1(void)
 {
     Debug("e-Paper busy\r\n");
-    while(DEV_Digital_Read(EPD_BUSY_PIN) == 1) {      //LOW: idle, HIGH: busy
-        DEV_Delay_ms(10);
-    }
+    DEV_Wait_Busy(0, EPD_BUSY_TIMEOUT_MS);
     Debug("e-Paper busy release\r\n");
 }
 
@@ -110,6 +102,8 @@ parameter:
 ******************************************************************************/
 static void EPD_4IN2B_V2_SetWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
 {
+    if(EPD_State_Window(Xstart, Ystart, Xend, Yend))
+        return;
     EPD_4IN2B_V2_SendCommand(0x44); // SET_RAM_X_ADDRESS_START_END_POSITION
     EPD_4IN2B_V2_SendData((Xstart>>3) & 0xFF);
     EPD_4IN2B_V2_SendData((Xend>>3) & 0xFF);
@@ -219,18 +213,10 @@ void EPD_4IN2B_V2_Clear_old_1(void)
     Height = EPD_4IN2B_V2_HEIGHT;
 
     EPD_4IN2B_V2_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2B_V2_SendData(0xFF);
-        }
-    }
+    EPD_Common_SendDataRepeat(0xFF, Width * Height);
 
     EPD_4IN2B_V2_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2B_V2_SendData(0xFF);
-        }
-    }
+    EPD_Common_SendDataRepeat(0xFF, Width * Height);
 
     EPD_4IN2B_V2_SendCommand(0x12);
     DEV_Delay_ms(100);
@@ -245,18 +231,10 @@ void EPD_4IN2B_V2_Clear_new_1(void)
     Height = EPD_4IN2B_V2_HEIGHT;
 
     EPD_4IN2B_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2B_V2_SendData(0xFF);
-        }
-    }
+    EPD_Common_SendDataRepeat(0xFF, Width * Height);
 
     EPD_4IN2B_V2_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2B_V2_SendData(0x00);
-        }
-    }
+    EPD_Common_SendDataRepeat(0x00, Width * Height);
 
     EPD_4IN2B_V2_SendCommand(0x22);
 	EPD_4IN2B_V2_SendData(0xF7);
@@ -283,18 +261,10 @@ void EPD_4IN2B_V2_Display_old_1(const UBYTE *blackimage, const UBYTE *ryimage)
     Height = EPD_4IN2B_V2_HEIGHT;
 
     EPD_4IN2B_V2_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2B_V2_SendData(blackimage[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(blackimage, Width * Height);
 
     EPD_4IN2B_V2_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2B_V2_SendData(ryimage[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(ryimage, Width * Height);
 
     EPD_4IN2B_V2_SendCommand(0x12);
     DEV_Delay_ms(100);
@@ -308,18 +278,10 @@ void EPD_4IN2B_V2_Display_new_1(const UBYTE *blackimage, const UBYTE *ryimage)
     Height = EPD_4IN2B_V2_HEIGHT;
 
     EPD_4IN2B_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2B_V2_SendData(blackimage[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(blackimage, Width * Height);
 
     EPD_4IN2B_V2_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2B_V2_SendData(~ryimage[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataInvert(ryimage, Width * Height);
 
     EPD_4IN2B_V2_SendCommand(0x22);
 	EPD_4IN2B_V2_SendData(0xF7);
@@ -82,71 +82,54 @@
 #
 ******************************************************************************/
 #include "EPD_4in2bc.h"
-#include "Debug.h"
-
-/******************************************************************************
-function :	Software reset
-parameter:
-******************************************************************************/
-static void EPD_4IN2BC_Reset(void)
-{
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(200);
-    DEV_Digital_Write(EPD_RST_PIN, 0);
-    DEV_Delay_ms(200);
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(200);
-}
-
-/******************************************************************************
-function :	send command
-parameter:
-     Reg : Command register
-******************************************************************************/
-static void EPD_4IN2BC_SendCommand(UBYTE Reg)
-{
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
-}
-
-/******************************************************************************
-function :	send data
-parameter:
-    Data : Write data
-******************************************************************************/
-static void EPD_4IN2BC_SendData(UBYTE Data)
-{
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
-}
-
-/******************************************************************************
-function :	Wait until the busy_pin goes LOW
-parameter:
-******************************************************************************/
-void EPD_4IN2BC_ReadBusy(void)
-{
-    Debug("e-Paper busy\r\n");
-    while(DEV_Digital_Read(EPD_BUSY_PIN) == 0) {      //0: busy, 1: idle
-        DEV_Delay_ms(100);
-    }
-    Debug("e-Paper busy release\r\n");
-}
-
-/******************************************************************************
-function :	Turn On Display
-parameter:
-******************************************************************************/
-static void EPD_4IN2BC_TurnOnDisplay(void)
-{
-    EPD_4IN2BC_SendCommand(0x12); // DISPLAY_REFRESH
-    DEV_Delay_ms(100);
-    EPD_4IN2BC_ReadBusy();
-}
+#include "EPD_Panel.h"
+
+static const UBYTE EPD_4IN2BC_Init_Script[] = {
+    EPD_RESET(200, 200, 200),
+    EPD_CMD(0x06, 3), 0x17, 0x17, 0x17, //BOOSTER_SOFT_START, 07 0f 17 1f 27 2F 37 2f
+    EPD_CMD(0x04, 0),                   //POWER_ON
+    EPD_BUSY,
+    EPD_CMD(0x00, 1), 0x0F,             //PANEL_SETTING, LUT from OTP
+    EPD_END
+};
+
+static const UBYTE EPD_4IN2BC_Refresh_Script[] = {
+    EPD_CMD(0x12, 0),                   //DISPLAY_REFRESH
+    EPD_DELAY(100),
+    EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_4IN2BC_Sleep_Script[] = {
+    EPD_CMD(0x02, 0),                   //POWER_OFF
+    EPD_BUSY,
+    EPD_CMD(0x07, 1), 0xA5,             //DEEP_SLEEP, check code
+    EPD_END
+};
+
+static const UBYTE EPD_4IN2BC_PowerOff_Script[] = {
+    EPD_CMD(0x02, 0),                   //POWER_OFF
+    EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_4IN2BC_PowerOn_Script[] = {
+    EPD_CMD(0x04, 0),                   //POWER_ON
+    EPD_BUSY,
+    EPD_END
+};
+
+const EPD_PANEL EPD_4IN2BC_Panel = {
+    "EPD_4IN2BC", EPD_4IN2BC_WIDTH, EPD_4IN2BC_HEIGHT,
+    2, {
+        { 0x10, EPD_PLANE_IMAGE0, 0, 0xFF, 0 },   //black
+        { 0x13, EPD_PLANE_IMAGE1, 0, 0xFF, 0 },   //red, 0 = red
+    },
+    0, 0, 1, 0, 0,
+    EPD_4IN2BC_Init_Script, EPD_4IN2BC_Refresh_Script, EPD_4IN2BC_Sleep_Script,
+    EPD_CAP_RED,
+    EPD_4IN2BC_PowerOff_Script, EPD_4IN2BC_PowerOn_Script,
+};
 
 /******************************************************************************
 function :	Initialize the e-Paper register
@@ -154,16 +137,7 @@ parameter:
 ******************************************************************************/
 void EPD_4IN2BC_Init(void)
 {
-    EPD_4IN2BC_Reset();
-
-    EPD_4IN2BC_SendCommand(0x06); // BOOSTER_SOFT_START
-    EPD_4IN2BC_SendData(0x17);
-    EPD_4IN2BC_SendData(0x17);
-    EPD_4IN2BC_SendData(0x17); // 07 0f 17 1f 27 2F 37 2f
-    EPD_4IN2BC_SendCommand(0x04); // POWER_ON
-    EPD_4IN2BC_ReadBusy();
-    EPD_4IN2BC_SendCommand(0x00); // PANEL_SETTING
-    EPD_4IN2BC_SendData(0x0F); // LUT from OTP
+    EPD_Panel_Init(&EPD_4IN2BC_Panel);
 }
 
 /******************************************************************************
@@ -172,25 +146,7 @@ parameter:
 ******************************************************************************/
 void EPD_4IN2BC_Clear(void)
 {
-    UWORD Width, Height;
-    Width = (EPD_4IN2BC_WIDTH % 8 == 0)? (EPD_4IN2BC_WIDTH / 8 ): (EPD_4IN2BC_WIDTH / 8 + 1);
-    Height = EPD_4IN2BC_HEIGHT;
-
-    EPD_4IN2BC_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2BC_SendData(0xFF);
-        }
-    }
-
-    EPD_4IN2BC_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2BC_SendData(0xFF);
-        }
-    }
-
-    EPD_4IN2BC_TurnOnDisplay();
+    EPD_Panel_Clear(&EPD_4IN2BC_Panel);
 }
 
 /******************************************************************************
@@ -199,25 +155,18 @@ parameter:
 ******************************************************************************/
 void EPD_4IN2BC_Display(const UBYTE *blackimage, const UBYTE *ryimage)
 {
-    UWORD Width, Height;
-    Width = (EPD_4IN2BC_WIDTH % 8 == 0)? (EPD_4IN2BC_WIDTH / 8 ): (EPD_4IN2BC_WIDTH / 8 + 1);
-    Height = EPD_4IN2BC_HEIGHT;
-
-    EPD_4IN2BC_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2BC_SendData(blackimage[i + j * Width]);
-        }
-    }
-
-    EPD_4IN2BC_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2BC_SendData(ryimage[i + j * Width]);
-        }
-    }
+    EPD_Panel_Display(&EPD_4IN2BC_Panel, blackimage, ryimage);
+}
 
-    EPD_4IN2BC_TurnOnDisplay();
+/******************************************************************************
+function :	Sends a 3 color picture to e-Paper and displays
+parameter:
+    Image : the black plane then the red plane, drawn with
+            Paint_SetColorPlanes(Ctx, EPD_4IN2BC_COLOR)
+******************************************************************************/
+void EPD_4IN2BC_Display_Planes(const UBYTE *Image)
+{
+    EPD_Panel_Display_Planes(&EPD_4IN2BC_Panel, Image);
 }
 
 /******************************************************************************
@@ -226,8 +175,5 @@ parameter:
 ******************************************************************************/
 void EPD_4IN2BC_Sleep(void)
 {
-    EPD_4IN2BC_SendCommand(0x02); // POWER_OFF
-    EPD_4IN2BC_ReadBusy();
-    EPD_4IN2BC_SendCommand(0x07); // DEEP_SLEEP
-    EPD_4IN2BC_SendData(0XA5);
+    EPD_Panel_Sleep(&EPD_4IN2BC_Panel);
 }
@@ -85,14 +85,22 @@
 #define __EPD_4IN2BC_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
+#include "EPD_Panel.h"
 
 // Display resolution
 #define EPD_4IN2BC_WIDTH       400
 #define EPD_4IN2BC_HEIGHT      300
+#define EPD_4IN2BC_COLOR       EPD_Color_RedLow    //3 color planes, see Paint_SetColorPlanes()
+
+extern const EPD_PANEL EPD_4IN2BC_Panel;
 
 void EPD_4IN2BC_Init(void);
 void EPD_4IN2BC_Clear(void);
 void EPD_4IN2BC_Display(const UBYTE *blackimage, const UBYTE *ryimage);
+void EPD_4IN2BC_Display_Planes(const UBYTE *Image);
 void EPD_4IN2BC_Sleep(void);
 
+EPD_MODEL(EPD_4IN2BC, 2, 1);
+
 #endif
@@ -32,6 +32,7 @@
 #define __EPD_4IN37G_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_4IN37G_WIDTH		512
@@ -48,4 +49,6 @@ void EPD_4IN37G_Clear(UBYTE color);
 void EPD_4IN37G_Display(UBYTE *Image);
 void EPD_4IN37G_Sleep(void);
 
+EPD_MODEL(EPD_4IN37G, 1, 2);
+
 #endif
@@ -29,6 +29,7 @@
 #
 ******************************************************************************/
 #include "EPD_5in65f.h"
+#include "EPD_Common.h"
 
 /******************************************************************************
 function :	Software reset
@@ -36,6 +37,7 @@ parameter:
 ******************************************************************************/
 static void EPD_5IN65F_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(200);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -51,10 +53,7 @@ parameter:
 ******************************************************************************/
 static void EPD_5IN65F_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -64,21 +63,18 @@ parameter:
 ******************************************************************************/
 static void EPD_5IN65F_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 
 static void EPD_5IN65F_BusyHigh(void)// If BUSYN=0 then waiting
 {
-    while(!(DEV_Digital_Read(EPD_BUSY_PIN)));
+    DEV_Wait_Busy(1, EPD_BUSY_TIMEOUT_MS);
 }
 
 static void EPD_5IN65F_BusyLow(void)// If BUSYN=1 then waiting
 {
-    while(DEV_Digital_Read(EPD_BUSY_PIN));
+    DEV_Wait_Busy(0, EPD_BUSY_TIMEOUT_MS);
 }
 
 /******************************************************************************
@@ -136,10 +132,7 @@ void EPD_5IN65F_Clear(UBYTE color)
     EPD_5IN65F_SendData(0x01);
     EPD_5IN65F_SendData(0xC0);
     EPD_5IN65F_SendCommand(0x10);
-    for(int i=0; i<EPD_5IN65F_HEIGHT; i++) {
-        for(int j=0; j<EPD_5IN65F_WIDTH/2; j++)
-            EPD_5IN65F_SendData((color<<4)|color);
-    }
+    EPD_Common_SendDataRepeat((color<<4)|color, (EPD_5IN65F_WIDTH/2) * EPD_5IN65F_HEIGHT);
     EPD_5IN65F_SendCommand(0x04);//0x04
     EPD_5IN65F_BusyHigh();
     EPD_5IN65F_SendCommand(0x12);//0x12
@@ -155,18 +148,13 @@ parameter:
 ******************************************************************************/
 void EPD_5IN65F_Display(const UBYTE *image)
 {
-    UWORD i, j;
     EPD_5IN65F_SendCommand(0x61);//Set Resolution setting
     EPD_5IN65F_SendData(0x02);
     EPD_5IN65F_SendData(0x58);
     EPD_5IN65F_SendData(0x01);
     EPD_5IN65F_SendData(0xC0);
     EPD_5IN65F_SendCommand(0x10);
-    for(i=0; i<EPD_5IN65F_HEIGHT; i++) {
-        for(j=0; j<EPD_5IN65F_WIDTH/2; j++) {
-					EPD_5IN65F_SendData(image[j+i*EPD_5IN65F_WIDTH/2]);
-				}
-    }
+    EPD_Common_SendDataBuffer(image, (EPD_5IN65F_WIDTH/2) * EPD_5IN65F_HEIGHT);
     EPD_5IN65F_SendCommand(0x04);//0x04
     EPD_5IN65F_BusyHigh();
     EPD_5IN65F_SendCommand(0x12);//0x12
@@ -183,7 +171,12 @@ parameter:
 void EPD_5IN65F_Display_part(const UBYTE *image, UWORD xstart, UWORD ystart, 
 									UWORD image_width, UWORD image_heigh)
 {
-    unsigned long i,j;
+    unsigned long i;
+    UWORD Line = EPD_5IN65F_WIDTH / 2;
+    UWORD Left = xstart / 2;
+    UWORD Right = (image_width + xstart) / 2;
+    if(Right > Line)
+        Right = Line;
     EPD_5IN65F_SendCommand(0x61);//Set Resolution setting
     EPD_5IN65F_SendData(0x02);
     EPD_5IN65F_SendData(0x58);
@@ -191,14 +184,14 @@ void EPD_5IN65F_Display_part(const UBYTE *image, UWORD xstart, UWORD ystart,
     EPD_5IN65F_SendData(0xC0);
     EPD_5IN65F_SendCommand(0x10);
     for(i=0; i<EPD_5IN65F_HEIGHT; i++) {
-        for(j=0; j< EPD_5IN65F_WIDTH/2; j++) {
-						if(i<image_heigh+ystart && i>=ystart && j<(image_width+xstart)/2 && j>=xstart/2) {
-							EPD_5IN65F_SendData(image[(j-xstart/2) + (image_width/2*(i-ystart))]);
-						}
-						else {
-							EPD_5IN65F_SendData(0x11);
-						}
-				}
+        if(i<image_heigh+ystart && i>=ystart && Right > Left) {
+            EPD_Common_SendDataRepeat(0x11, Left);
+            EPD_Common_SendDataBuffer(image + (image_width/2*(i-ystart)), Right - Left);
+            EPD_Common_SendDataRepeat(0x11, Line - Right);
+        }
+        else {
+            EPD_Common_SendDataRepeat(0x11, Line);
+        }
     }
     EPD_5IN65F_SendCommand(0x04);//0x04
     EPD_5IN65F_BusyHigh();
@@ -220,6 +213,7 @@ void EPD_5IN65F_Sleep(void)
     EPD_5IN65F_SendCommand(0x07);
     EPD_5IN65F_SendData(0xA5);
     DEV_Delay_ms(100);
+	EPD_State_Invalidate();
 	DEV_Digital_Write(EPD_RST_PIN, 0); // Reset
 }
 
@@ -32,6 +32,7 @@
 #define __EPD_5IN65F_H__
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 /**********************************
 Color Index
@@ -55,6 +56,8 @@ void EPD_5IN65F_DisplayFullImage(const UBYTE *image);
 void EPD_5IN65F_Init(void);
 void EPD_5IN65F_Display_part(const UBYTE *image, UWORD xstart, UWORD ystart, UWORD image_width, UWORD image_heigh);
 
+EPD_MODEL(EPD_5IN65F, 1, 4);
+
 #endif
 
 
@@ -28,6 +28,7 @@
 #
 ******************************************************************************/
 #include "EPD_5in79g.h"
+#include "EPD_Common.h"
 
 /******************************************************************************
 function :	Software reset
@@ -35,6 +36,7 @@ parameter:
 ******************************************************************************/
 static void EPD_5in79g_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(200);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -50,10 +52,7 @@ parameter:
 ******************************************************************************/
 static void EPD_5in79g_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -63,11 +62,7 @@ parameter:
 ******************************************************************************/
 static void EPD_5in79g_SendData(UBYTE Data)
 {
-    
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -77,13 +72,7 @@ parameter:
 void EPD_5in79g_ReadBus(void)
 {
     printf("e-Paper busy\r\n");
-	UBYTE busy;
-	do
-	{
-		busy = DEV_Digital_Read(EPD_BUSY_PIN);
-        DEV_Delay_ms(10);   
-	}
-	while(!busy);   
+	DEV_Wait_Busy(1, EPD_BUSY_TIMEOUT_MS);
 	DEV_Delay_ms(200);     
     printf("e-Paper busy release\r\n");
 }
@@ -174,21 +163,13 @@ void EPD_5in79g_Clear(UBYTE color)
     EPD_5in79g_SendData(0x02);
 
     EPD_5in79g_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-                EPD_5in79g_SendData((color << 6) | (color << 4) | (color << 2) | color);
-        }
-    }
+    EPD_Common_SendDataRepeat((color << 6) | (color << 4) | (color << 2) | color, Width * Height);
 
     EPD_5in79g_SendCommand(0xA2);	//********************
     EPD_5in79g_SendData(0x01);
 
     EPD_5in79g_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-                EPD_5in79g_SendData((color << 6) | (color << 4) | (color << 2) | color);
-        }
-    }
+    EPD_Common_SendDataRepeat((color << 6) | (color << 4) | (color << 2) | color, Width * Height);
 
 
     EPD_5in79g_TurnOnDisplay();
@@ -210,14 +191,9 @@ void EPD_5in79g_Show(void)
     EPD_5in79g_SendCommand(0x10);
     for (UWORD j = 0; j < Height; j++) {
 
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_5in79g_SendData(Color_seven[0]);
-        }
+        EPD_Common_SendDataRepeat(Color_seven[0], Width);
 
-        for (UWORD i = 0; i < Width; i++) {
-            // EPD_5in79g_SendData(0x55);
-            EPD_5in79g_SendData(Color_seven[1]);
-        }
+        EPD_Common_SendDataRepeat(Color_seven[1], Width);
     }
     
 
@@ -225,14 +201,9 @@ void EPD_5in79g_Show(void)
     EPD_5in79g_SendData(0x01);
     EPD_5in79g_SendCommand(0x10);
     for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_5in79g_SendData(Color_seven[2]);
-        }
-
-        for (UWORD i = 0; i < Width; i++) {
-            // EPD_5in79g_SendData(0x55);
-            EPD_5in79g_SendData(Color_seven[3]);
-        }
+        EPD_Common_SendDataRepeat(Color_seven[2], Width);
+
+        EPD_Common_SendDataRepeat(Color_seven[3], Width);
     }
 
 
@@ -257,26 +228,16 @@ void EPD_5in79g_Display(const UBYTE *Image)
     
     for (UWORD j = 0; j < Height/2; j++) {
 
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_5in79g_SendData(Image[i + j * Width1]);
-        }
-
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_5in79g_SendData(Image[i + (Height - j - 1) * Width1]);
-        }
+        EPD_Common_SendDataBuffer(Image + j * Width1, Width);
+        EPD_Common_SendDataBuffer(Image + (Height - j - 1) * Width1, Width);
     }
 
     EPD_5in79g_SendCommand(0xA2);	//********************
     EPD_5in79g_SendData(0x01);
     EPD_5in79g_SendCommand(0x10);
     for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_5in79g_SendData(Image[j * Width1 + i + Width]);
-        }
-
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_5in79g_SendData(Image[(Height - j - 1) * Width1 + i + Width]);
-        }
+        EPD_Common_SendDataBuffer(Image + j * Width1 + Width, Width);
+        EPD_Common_SendDataBuffer(Image + (Height - j - 1) * Width1 + Width, Width);
     }
 
     EPD_5in79g_TurnOnDisplay();
@@ -294,23 +255,15 @@ void EPD_5in79g_Display_Partial(const UBYTE *Image)
     EPD_5in79g_SendCommand(0x10);
     
     for (UWORD j = 0; j < Height/2; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_5in79g_SendData(Image[i + j * Width]);
-        }
+        EPD_Common_SendDataBuffer(Image + j * Width, Width);
 
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_5in79g_SendData(0x55);
-        }
+        EPD_Common_SendDataRepeat(0x55, Width);
     }
 
     EPD_5in79g_SendCommand(0xA2);	//********************
     EPD_5in79g_SendData(0x01);
     EPD_5in79g_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_5in79g_SendData(0x55);
-        }
-    }
+    EPD_Common_SendDataRepeat(0x55, Width * Height);
 
     EPD_5in79g_TurnOnDisplay();
 }
@@ -88,6 +88,7 @@
 #define __EPD_5IN83_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_5IN83_WIDTH       600
@@ -98,4 +99,6 @@ void EPD_5IN83_Clear(void);
 void EPD_5IN83_Display(UBYTE *Image);
 void EPD_5IN83_Sleep(void);
 
+EPD_MODEL(EPD_5IN83, 1, 1);
+
 #endif
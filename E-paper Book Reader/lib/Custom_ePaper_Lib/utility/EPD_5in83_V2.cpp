@@ -27,75 +27,61 @@
 # THE SOFTWARE.
 #
 ******************************************************************************/
-#include "EPD_5IN83_V2.h"
-#include "Debug.h"
-
-/******************************************************************************
-function :	Software reset
-parameter:
-******************************************************************************/
-static void EPD_5IN83_V2_Reset(void)
-{
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(200);
-    DEV_Digital_Write(EPD_RST_PIN, 0);
-    DEV_Delay_ms(5);
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(200);
-}
-
-/******************************************************************************
-function :	send command
-parameter:
-     Reg : Command register
-******************************************************************************/
-static void EPD_5IN83_V2_SendCommand(UBYTE Reg)
-{
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
-}
-
-/******************************************************************************
-function :	send data
-parameter:
-    Data : Write data
-******************************************************************************/
-static void EPD_5IN83_V2_SendData(UBYTE Data)
-{
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
-}
-
-/******************************************************************************
-function :	Wait until the busy_pin goes LOW
-parameter:
-******************************************************************************/
-static void EPD_5IN83_V2_ReadBusy(void)
-{
-	Debug("e-Paper busy\r\n");
-	do {
-		EPD_5IN83_V2_SendCommand(0x71);
-		DEV_Delay_ms(50);    
-	}
-	while(!DEV_Digital_Read(EPD_BUSY_PIN));   
-	Debug("e-Paper busy release\r\n");
-	DEV_Delay_ms(50);    
-}
-
-/******************************************************************************
-function :	Turn On Display
-parameter:
-******************************************************************************/
-static void EPD_5IN83_V2_TurnOnDisplay(void)
-{
-    EPD_5IN83_V2_SendCommand(0x12); // DISPLAY_REFRESH
-    DEV_Delay_ms(100);
-    EPD_5IN83_V2_ReadBusy();
-}
+#include "EPD_5in83_V2.h"
+#include "EPD_Panel.h"
+
+static const UBYTE EPD_5IN83_V2_Init_Script[] = {
+    EPD_RESET(200, 5, 200),
+    EPD_CMD(0x01, 4), 0x07, 0x07, 0x3f, 0x3f,   //POWER SETTING, VGH=20V,VGL=-20V, VDH=15V, VDL=-15V
+    EPD_CMD(0x04, 0),                           //POWER ON
+    EPD_DELAY(100),
+    EPD_BUSY,
+    EPD_CMD(0x00, 1), 0x1F,                     //PANNEL SETTING, KW-3f KWR-2F BWROTP 0f BWOTP 1f
+    EPD_CMD(0x61, 4), 0x02, 0x88, 0x01, 0xE0,   //tres, source 648, gate 480
+    EPD_CMD(0x15, 1), 0x00,
+    EPD_CMD(0x50, 2), 0x10, 0x07,               //VCOM AND DATA INTERVAL SETTING
+    EPD_CMD(0x60, 1), 0x22,                     //TCON SETTING
+    EPD_END
+};
+
+static const UBYTE EPD_5IN83_V2_Refresh_Script[] = {
+    EPD_CMD(0x12, 0),                           //DISPLAY_REFRESH
+    EPD_DELAY(100),
+    EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_5IN83_V2_Sleep_Script[] = {
+    EPD_CMD(0x02, 0),                           //POWER_OFF
+    EPD_BUSY,
+    EPD_CMD(0x07, 1), 0xA5,                     //DEEP_SLEEP
+    EPD_END
+};
+
+static const UBYTE EPD_5IN83_V2_PowerOff_Script[] = {
+    EPD_CMD(0x02, 0),                           //POWER OFF
+    EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_5IN83_V2_PowerOn_Script[] = {
+    EPD_CMD(0x04, 0),                           //POWER ON
+    EPD_DELAY(100),
+    EPD_BUSY,
+    EPD_END
+};
+
+const EPD_PANEL EPD_5IN83_V2_Panel = {
+    "EPD_5IN83_V2", EPD_5IN83_V2_WIDTH, EPD_5IN83_V2_HEIGHT,
+    2, {
+        { 0x10, EPD_PLANE_FILL, 0, 0x00, 0 },     //old data, unused
+        { 0x13, EPD_PLANE_IMAGE0, 1, 0x00, 0 },
+    },
+    0, 0, 1, 0x71, 50,
+    EPD_5IN83_V2_Init_Script, EPD_5IN83_V2_Refresh_Script, EPD_5IN83_V2_Sleep_Script,
+    0,
+    EPD_5IN83_V2_PowerOff_Script, EPD_5IN83_V2_PowerOn_Script,
+};
 
 /******************************************************************************
 function :	Initialize the e-Paper register
@@ -103,36 +89,7 @@ parameter:
 ******************************************************************************/
 void EPD_5IN83_V2_Init(void)
 {
-    EPD_5IN83_V2_Reset();
-
-	EPD_5IN83_V2_SendCommand(0x01);			//POWER SETTING
-	EPD_5IN83_V2_SendData (0x07);
-	EPD_5IN83_V2_SendData (0x07);    //VGH=20V,VGL=-20V
-	EPD_5IN83_V2_SendData (0x3f);		//VDH=15V
-	EPD_5IN83_V2_SendData (0x3f);		//VDL=-15V
-
-	EPD_5IN83_V2_SendCommand(0x04); //POWER ON
-	DEV_Delay_ms(100);  
-	EPD_5IN83_V2_ReadBusy();        //waiting for the electronic paper IC to release the idle signal
-
-	EPD_5IN83_V2_SendCommand(0X00);			//PANNEL SETTING
-	EPD_5IN83_V2_SendData(0x1F);   //KW-3f   KWR-2F	BWROTP 0f	BWOTP 1f
-
-	EPD_5IN83_V2_SendCommand(0x61);        	//tres			
-	EPD_5IN83_V2_SendData (0x02);		//source 648
-	EPD_5IN83_V2_SendData (0x88);
-	EPD_5IN83_V2_SendData (0x01);		//gate 480
-	EPD_5IN83_V2_SendData (0xE0);
-
-	EPD_5IN83_V2_SendCommand(0X15);		
-	EPD_5IN83_V2_SendData(0x00);		
-
-	EPD_5IN83_V2_SendCommand(0X50);			//VCOM AND DATA INTERVAL SETTING
-	EPD_5IN83_V2_SendData(0x10);
-	EPD_5IN83_V2_SendData(0x07);
-
-	EPD_5IN83_V2_SendCommand(0X60);			//TCON SETTING
-	EPD_5IN83_V2_SendData(0x22);
+    EPD_Panel_Init(&EPD_5IN83_V2_Panel);
 }
 
 /******************************************************************************
@@ -141,19 +98,7 @@ parameter:
 ******************************************************************************/
 void EPD_5IN83_V2_Clear(void)
 {
-    UWORD Width, Height, i;
-    Width = (EPD_5IN83_V2_WIDTH % 8 == 0)? (EPD_5IN83_V2_WIDTH / 8 ): (EPD_5IN83_V2_WIDTH / 8 + 1);
-    Height = EPD_5IN83_V2_HEIGHT;
-
-	EPD_5IN83_V2_SendCommand(0x10);
-	for(i=0; i<Width*Height; i++) {
-		EPD_5IN83_V2_SendData(0x00);  
-	}
-	EPD_5IN83_V2_SendCommand(0x13);
-	for(i=0; i<Width*Height; i++) {
-		EPD_5IN83_V2_SendData(0x00);  
-	}
-	EPD_5IN83_V2_TurnOnDisplay();
+    EPD_Panel_Clear(&EPD_5IN83_V2_Panel);
 }
 
 /******************************************************************************
@@ -162,23 +107,7 @@ parameter:
 ******************************************************************************/
 void EPD_5IN83_V2_Display(UBYTE *Image)
 {
-    UWORD Width, Height, i, j;
-    Width = (EPD_5IN83_V2_WIDTH % 8 == 0)? (EPD_5IN83_V2_WIDTH / 8 ): (EPD_5IN83_V2_WIDTH / 8 + 1);
-    Height = EPD_5IN83_V2_HEIGHT;
-
-	EPD_5IN83_V2_SendCommand(0x10);
-	for(i=0;i<Height;i++) {
-		for(j=0; j<Width; j++) {
-			EPD_5IN83_V2_SendData(0x00);  
-		}
-	}
-	EPD_5IN83_V2_SendCommand(0x13);
-	for(i=0;i<Height;i++) {
-		for(j=0; j<Width; j++) {
-		EPD_5IN83_V2_SendData(~Image[i*Width + j]);  
-		}
-	}
-    EPD_5IN83_V2_TurnOnDisplay();
+    EPD_Panel_Display(&EPD_5IN83_V2_Panel, Image, NULL);
 }
 
 /******************************************************************************
@@ -187,9 +116,5 @@ parameter:
 ******************************************************************************/
 void EPD_5IN83_V2_Sleep(void)
 {
-    EPD_5IN83_V2_SendCommand(0x02); // POWER_OFF
-    EPD_5IN83_V2_ReadBusy();
-    EPD_5IN83_V2_SendCommand(0x07); // DEEP_SLEEP
-    EPD_5IN83_V2_SendData(0XA5);
+    EPD_Panel_Sleep(&EPD_5IN83_V2_Panel);
 }
-
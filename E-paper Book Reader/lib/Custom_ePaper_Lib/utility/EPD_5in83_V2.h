@@ -31,14 +31,20 @@
 #define __EPD_5IN83_V2_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
+#include "EPD_Panel.h"
 
 // Display resolution
 #define EPD_5IN83_V2_WIDTH       648
 #define EPD_5IN83_V2_HEIGHT      480
 
+extern const EPD_PANEL EPD_5IN83_V2_Panel;
+
 void EPD_5IN83_V2_Init(void);
 void EPD_5IN83_V2_Clear(void);
 void EPD_5IN83_V2_Display(UBYTE *Image);
 void EPD_5IN83_V2_Sleep(void);
 
+EPD_MODEL(EPD_5IN83_V2, 1, 1);
+
 #endif
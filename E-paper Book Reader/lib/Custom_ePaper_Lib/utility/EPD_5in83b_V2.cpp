@@ -28,167 +28,118 @@
 #
 ******************************************************************************/
 #include "EPD_5in83b_V2.h"
-#include "Debug.h"
+#include "EPD_Panel.h"
+
+static const UBYTE EPD_5IN83B_V2_Init_Script[] = {
+    EPD_RESET(200, 5, 200),
+    EPD_CMD(0x01, 4), 0x07, 0x07, 0x3f, 0x3f,   //POWER SETTING, VGH=20V,VGL=-20V, VDH=15V, VDL=-15V
+    EPD_CMD(0x04, 0),                           //POWER ON
+    EPD_DELAY(100),
+    EPD_BUSY,
+    EPD_CMD(0x00, 1), 0x0F,                     //PANNEL SETTING, KW-3f KWR-2F BWROTP 0f BWOTP 1f
+    EPD_CMD(0x61, 4), 0x02, 0x88, 0x01, 0xe0,   //tres, source 648, gate 480
+    EPD_CMD(0x15, 1), 0x00,
+    EPD_CMD(0x50, 2), 0x11, 0x07,               //VCOM AND DATA INTERVAL SETTING
+    EPD_CMD(0x60, 1), 0x22,                     //TCON SETTING
+    EPD_END
+};
+
+static const UBYTE EPD_5IN83B_V2_Refresh_Script[] = {
+    EPD_CMD(0x12, 0),                           //DISPLAY REFRESH
+    EPD_DELAY(100),                             //!!!The delay here is necessary, 200uS at least!!!
+    EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_5IN83B_V2_Sleep_Script[] = {
+    EPD_CMD(0x02, 0),                           //power off
+    EPD_BUSY,
+    EPD_CMD(0x07, 1), 0xA5,                     //deep sleep
+    EPD_END
+};
+
+static const UBYTE EPD_5IN83B_V2_PowerOff_Script[] = {
+    EPD_CMD(0x02, 0),                           //POWER OFF
+    EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_5IN83B_V2_PowerOn_Script[] = {
+    EPD_CMD(0x04, 0),                           //POWER ON
+    EPD_DELAY(100),
+    EPD_BUSY,
+    EPD_END
+};
+
+const EPD_PANEL EPD_5IN83B_V2_Panel = {
+    "EPD_5IN83B_V2", EPD_5IN83B_V2_WIDTH, EPD_5IN83B_V2_HEIGHT,
+    2, {
+        { 0x10, EPD_PLANE_IMAGE0, 0, 0xFF, 0 },   //black
+        { 0x13, EPD_PLANE_IMAGE1, 1, 0x00, 1 },   //red, 1 = red, kept
+    },
+    0, 0, 1, 0x71, 200,
+    EPD_5IN83B_V2_Init_Script, EPD_5IN83B_V2_Refresh_Script, EPD_5IN83B_V2_Sleep_Script,
+    EPD_CAP_RED,
+    EPD_5IN83B_V2_PowerOff_Script, EPD_5IN83B_V2_PowerOn_Script,
+};
 
 /******************************************************************************
-function :	Software reset
-parameter:
-******************************************************************************/
-static void EPD_5IN83B_V2_Reset(void)
-{
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(200);
-    DEV_Digital_Write(EPD_RST_PIN, 0);
-    DEV_Delay_ms(5);
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(200);
-}
-
-/******************************************************************************
-function :	send command
-parameter:
-     Reg : Command register
-******************************************************************************/
-static void EPD_5IN83B_V2_SendCommand(UBYTE Reg)
-{
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
-}
-
-/******************************************************************************
-function :	send data
-parameter:
-    Data : Write data
-******************************************************************************/
-static void EPD_5IN83B_V2_SendData(UBYTE Data)
-{
-    
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
-}
-
-/******************************************************************************
-function :	Wait until the busy_pin goes LOW
+function :	Initialize the e-Paper register
 parameter:
 ******************************************************************************/
-void EPD_5IN83B_V2_WaitUntilIdle(void)
+UBYTE EPD_5IN83B_V2_Init(void)
 {
-    Debug("e-Paper busy\r\n");
-	UBYTE busy;
-	do
-	{
-		EPD_5IN83B_V2_SendCommand(0x71);
-		busy = DEV_Digital_Read(EPD_BUSY_PIN);
-		busy =!(busy & 0x01);
-	}
-	while(busy);   
-	DEV_Delay_ms(200);     
-    Debug("e-Paper busy release\r\n");
+    return EPD_Panel_Init(&EPD_5IN83B_V2_Panel);
 }
 
 /******************************************************************************
-function :	Turn On Display
+function :	Clear screen
 parameter:
 ******************************************************************************/
-static void EPD_5IN83B_V2_TurnOnDisplay(void)
+void EPD_5IN83B_V2_Clear(void)
 {
-	EPD_5IN83B_V2_SendCommand(0x12);			//DISPLAY REFRESH 	
-	DEV_Delay_ms(100);	        //!!!The delay here is necessary, 200uS at least!!!     
-	EPD_5IN83B_V2_WaitUntilIdle();        //waiting for the electronic paper IC to release the idle signal
+    EPD_Panel_Clear(&EPD_5IN83B_V2_Panel);
 }
 
 /******************************************************************************
-function :	Initialize the e-Paper register
+function :	Sends the image buffer in RAM to e-Paper and displays
 parameter:
 ******************************************************************************/
-UBYTE EPD_5IN83B_V2_Init(void)
+void EPD_5IN83B_V2_Display(const UBYTE *blackimage, const UBYTE *ryimage)
 {
-    EPD_5IN83B_V2_Reset();
-
-	EPD_5IN83B_V2_SendCommand(0x01);			//POWER SETTING
-	EPD_5IN83B_V2_SendData (0x07);
-	EPD_5IN83B_V2_SendData (0x07);    //VGH=20V,VGL=-20V
-	EPD_5IN83B_V2_SendData (0x3f);		//VDH=15V
-	EPD_5IN83B_V2_SendData (0x3f);		//VDL=-15V
-
-	EPD_5IN83B_V2_SendCommand(0x04); //POWER ON
-	DEV_Delay_ms(100);  
-	EPD_5IN83B_V2_WaitUntilIdle();        //waiting for the electronic paper IC to release the idle signal
-
-	EPD_5IN83B_V2_SendCommand(0X00);			//PANNEL SETTING
-	EPD_5IN83B_V2_SendData(0x0F);   //KW-3f   KWR-2F	BWROTP 0f	BWOTP 1f
-
-	EPD_5IN83B_V2_SendCommand(0x61);        	//tres			
-	EPD_5IN83B_V2_SendData (0x02);		//source 648
-	EPD_5IN83B_V2_SendData (0x88);
-	EPD_5IN83B_V2_SendData (0x01);		//gate 480
-	EPD_5IN83B_V2_SendData (0xe0);
-
-	EPD_5IN83B_V2_SendCommand(0X15);		
-	EPD_5IN83B_V2_SendData(0x00);		
-
-	EPD_5IN83B_V2_SendCommand(0X50);			//VCOM AND DATA INTERVAL SETTING
-	EPD_5IN83B_V2_SendData(0x11);
-	EPD_5IN83B_V2_SendData(0x07);
-
-	EPD_5IN83B_V2_SendCommand(0X60);			//TCON SETTING
-	EPD_5IN83B_V2_SendData(0x22);
-		
-    return 0;
+    EPD_Panel_Display(&EPD_5IN83B_V2_Panel, blackimage, ryimage);
 }
 
 /******************************************************************************
-function :	Clear screen
+function :	Sends a 3 color picture to e-Paper and displays
 parameter:
+    Image : the black plane then the red plane, drawn with
+            Paint_SetColorPlanes(Ctx, EPD_5IN83B_V2_COLOR)
 ******************************************************************************/
-void EPD_5IN83B_V2_Clear(void)
+void EPD_5IN83B_V2_Display_Planes(const UBYTE *Image)
 {
-    UWORD Width, Height;
-    Width =(EPD_5IN83B_V2_WIDTH % 8 == 0)?(EPD_5IN83B_V2_WIDTH / 8 ):(EPD_5IN83B_V2_WIDTH / 8 + 1);
-    Height = EPD_5IN83B_V2_HEIGHT;
-    UWORD i;
-    EPD_5IN83B_V2_SendCommand(0x10);
-    for(i=0; i<Width*Height; i++) {
-        EPD_5IN83B_V2_SendData(0xff);
-
-    }
-    EPD_5IN83B_V2_SendCommand(0x13);
-    for(i=0; i<Width*Height; i++)	{
-        EPD_5IN83B_V2_SendData(0x00);
-
-    }
-    EPD_5IN83B_V2_TurnOnDisplay();
+    EPD_Panel_Display_Planes(&EPD_5IN83B_V2_Panel, Image);
 }
 
 /******************************************************************************
-function :	Sends the image buffer in RAM to e-Paper and displays
+function :	Sends the image buffer to e-Paper and starts the refresh without
+            waiting for it
 parameter:
+    blackimage : black plane
+    ryimage    : red plane
+    callback   : called from DEV_Busy_Poll()/DEV_Busy_Await() when the
+                 refresh is done, may be NULL
+    arg        : passed to callback
+Info:
+    Returns as soon as the refresh has started. Poll with DEV_Busy_Poll() or
+    block with DEV_Busy_Await(); on ESP32 DEV_Busy_NotifyTask() also gets a
+    task notification when BUSY releases. The images may be reused right
+    away, any further EPD_5IN83B_V2_xxx call waits for the refresh first.
 ******************************************************************************/
-void EPD_5IN83B_V2_Display(const UBYTE *blackimage, const UBYTE *ryimage)
+void EPD_5IN83B_V2_Display_Async(const UBYTE *blackimage, const UBYTE *ryimage,
+                                 DEV_BUSY_CALLBACK callback, void *arg)
 {
-    UDOUBLE Width, Height;
-    Width =(EPD_5IN83B_V2_WIDTH % 8 == 0)?(EPD_5IN83B_V2_WIDTH / 8 ):(EPD_5IN83B_V2_WIDTH / 8 + 1);
-    Height = EPD_5IN83B_V2_HEIGHT;
-	//send black data
-    EPD_5IN83B_V2_SendCommand(0x10);
-    for (UDOUBLE j = 0; j < Height; j++) {
-        for (UDOUBLE i = 0; i < Width; i++) {
-            EPD_5IN83B_V2_SendData(blackimage[i + j * Width]);
-        }
-    }
-
-    //send red data
-    EPD_5IN83B_V2_SendCommand(0x13);
-    for (UDOUBLE j = 0; j < Height; j++) {
-        for (UDOUBLE i = 0; i < Width; i++) {
-            EPD_5IN83B_V2_SendData(~ryimage[i + j * Width]);
-        }
-    }
-    EPD_5IN83B_V2_TurnOnDisplay();
+    EPD_Panel_Display_Async(&EPD_5IN83B_V2_Panel, blackimage, ryimage, callback, arg);
 }
 
 /******************************************************************************
@@ -197,8 +148,5 @@ parameter:
 ******************************************************************************/
 void EPD_5IN83B_V2_Sleep(void)
 {
-	EPD_5IN83B_V2_SendCommand(0X02);  	//power off
-	EPD_5IN83B_V2_WaitUntilIdle();        //waiting for the electronic paper IC to release the idle signal
-	EPD_5IN83B_V2_SendCommand(0X07);  	//deep sleep
-	EPD_5IN83B_V2_SendData(0xA5);
+    EPD_Panel_Sleep(&EPD_5IN83B_V2_Panel);
 }
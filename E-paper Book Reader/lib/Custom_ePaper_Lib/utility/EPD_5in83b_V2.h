@@ -32,15 +32,25 @@
 #define _EPD_5IN83B_V2_h_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
+#include "EPD_Panel.h"
 
 
 // Display resolution
 #define EPD_5IN83B_V2_WIDTH       648
 #define EPD_5IN83B_V2_HEIGHT      480
+#define EPD_5IN83B_V2_COLOR       EPD_Color_RedHigh    //3 color planes, see Paint_SetColorPlanes()
+
+extern const EPD_PANEL EPD_5IN83B_V2_Panel;
 
 UBYTE EPD_5IN83B_V2_Init(void);
 void EPD_5IN83B_V2_Clear(void);
 void EPD_5IN83B_V2_Display(const UBYTE *blackimage, const UBYTE *ryimage);
+void EPD_5IN83B_V2_Display_Planes(const UBYTE *Image);
+void EPD_5IN83B_V2_Display_Async(const UBYTE *blackimage, const UBYTE *ryimage,
+                                 DEV_BUSY_CALLBACK callback, void *arg);
 void EPD_5IN83B_V2_Sleep(void);
 
+EPD_MODEL(EPD_5IN83B_V2, 2, 1);
+
 #endif
@@ -86,6 +86,7 @@
 #define __EPD_5IN83BC_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_5IN83BC_WIDTH       600
@@ -97,4 +98,6 @@ void EPD_5IN83BC_Display(const UBYTE *blackimage, const UBYTE *ryimage);
 void EPD_5IN83BC_DisplayHalfScreen(const UBYTE *blackimage, const UBYTE *ryimage);
 void EPD_5IN83BC_Sleep(void);
 
+EPD_MODEL(EPD_5IN83BC, 2, 1);
+
 #endif
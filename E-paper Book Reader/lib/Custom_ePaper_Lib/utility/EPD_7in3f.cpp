@@ -29,6 +29,7 @@
 #
 ******************************************************************************/
 #include "EPD_7in3f.h"
+#include "EPD_Common.h"
 #include "Debug.h"
 
 /******************************************************************************
@@ -37,6 +38,7 @@ parameter:
 ******************************************************************************/
 static void EPD_7IN3F_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(20);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -52,10 +54,7 @@ parameter:
 ******************************************************************************/
 static void EPD_7IN3F_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -65,10 +64,7 @@ parameter:
 ******************************************************************************/
 static void EPD_7IN3F_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -78,9 +74,7 @@ parameter:
 static void EPD_7IN3F_ReadBusyH(void)
 {
     Debug("e-Paper busy H\r\n");
-    while(!DEV_Digital_Read(EPD_BUSY_PIN)) {      //LOW: busy, HIGH: idle
-        DEV_Delay_ms(1);
-    }
+    DEV_Wait_Busy(1, EPD_BUSY_TIMEOUT_MS);
     Debug("e-Paper busy H release\r\n");
 }
 
@@ -210,11 +204,7 @@ void EPD_7IN3F_Clear(UBYTE color)
     Height = EPD_7IN3F_HEIGHT;
 
     EPD_7IN3F_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_7IN3F_SendData((color<<4)|color);
-        }
-    }
+    EPD_Common_SendDataRepeat((color<<4)|color, Width * Height);
 
     EPD_7IN3F_TurnOnDisplay();
 }
@@ -225,7 +215,7 @@ parameter:
 ******************************************************************************/
 void EPD_7IN3F_Show7Block(void)
 {
-    unsigned long i, j, k;
+    unsigned long i, k;
     unsigned char const Color_seven[8] = 
     {EPD_7IN3F_BLACK, EPD_7IN3F_BLUE, EPD_7IN3F_GREEN, EPD_7IN3F_ORANGE,
     EPD_7IN3F_RED, EPD_7IN3F_YELLOW, EPD_7IN3F_WHITE, EPD_7IN3F_WHITE};
@@ -233,17 +223,13 @@ void EPD_7IN3F_Show7Block(void)
     EPD_7IN3F_SendCommand(0x10);
     for(i=0; i<240; i++) {
         for(k = 0 ; k < 4; k ++) {
-            for(j = 0 ; j < 100; j ++) {
-                EPD_7IN3F_SendData((Color_seven[k]<<4) |Color_seven[k]);
-            }
+            EPD_Common_SendDataRepeat((Color_seven[k]<<4) |Color_seven[k], 100);
         }
     }
     
     for(i=0; i<240; i++) {
         for(k = 4 ; k < 8; k ++) {
-            for(j = 0 ; j < 100; j ++) {
-                EPD_7IN3F_SendData((Color_seven[k]<<4) |Color_seven[k]);
-            }
+            EPD_Common_SendDataRepeat((Color_seven[k]<<4) |Color_seven[k], 100);
         }
     }
     EPD_7IN3F_TurnOnDisplay();
@@ -260,30 +246,30 @@ void EPD_7IN3F_Display(const UBYTE *Image)
     Height = EPD_7IN3F_HEIGHT;
 
     EPD_7IN3F_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_7IN3F_SendData(Image[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(Image, Width * Height);
     EPD_7IN3F_TurnOnDisplay();
 }
 
 void EPD_7IN3F_DisplayPart(UBYTE *Image, UWORD xstart, UWORD ystart, UWORD image_width, UWORD image_heigh)
 {
-	unsigned long i, j;
-	UWORD Width, Height;
+	unsigned long i;
+	UWORD Width, Height, Left, Right;
 	Width = (EPD_7IN3F_WIDTH % 2 == 0)? (EPD_7IN3F_WIDTH / 2 ): (EPD_7IN3F_WIDTH / 2 + 1);
 	Height = EPD_7IN3F_HEIGHT;
+	Left = xstart / 2;
+	Right = (image_width + xstart) / 2;
+	if(Right > Width)
+		Right = Width;
 	
 	EPD_7IN3F_SendCommand(0x10);
 	for(i=0; i<Height; i++) {
-		for(j=0; j<Width; j++) {
-			if((i<image_heigh+ystart) && (i>=ystart) && (j<(image_width+xstart)/2) && (j>=xstart/2)) {
-				EPD_7IN3F_SendData(Image[(j-xstart/2) + (image_width/2*(i-ystart))]);
-			}
-			else {
-				EPD_7IN3F_SendData(0x11);
-			}
+		if((i<image_heigh+ystart) && (i>=ystart) && (Right > Left)) {
+			EPD_Common_SendDataRepeat(0x11, Left);
+			EPD_Common_SendDataBuffer(Image + (image_width/2*(i-ystart)), Right - Left);
+			EPD_Common_SendDataRepeat(0x11, Width - Right);
+		}
+		else {
+			EPD_Common_SendDataRepeat(0x11, Width);
 		}
 	}
 	EPD_7IN3F_TurnOnDisplay();
@@ -32,6 +32,7 @@
 #define __EPD_7IN3F_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_7IN3F_WIDTH       800
@@ -56,4 +57,6 @@ void EPD_7IN3F_Display(const UBYTE *Image);
 void EPD_7IN3F_DisplayPart(UBYTE *Image, UWORD xstart, UWORD ystart, UWORD image_width, UWORD image_heigh);
 void EPD_7IN3F_Sleep(void);
 
+EPD_MODEL(EPD_7IN3F, 1, 4);
+
 #endif
@@ -33,6 +33,7 @@
 #define __EPD_7IN3G_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_7IN3G_WIDTH       800
@@ -49,4 +50,6 @@ void EPD_7IN3G_Clear(UBYTE color);
 void EPD_7IN3G_Display(UBYTE *Image);
 void EPD_7IN3G_Sleep(void);
 
+EPD_MODEL(EPD_7IN3G, 1, 2);
+
 #endif
@@ -85,6 +85,7 @@
 #
 ******************************************************************************/
 #include "EPD_7in5.h"
+#include "EPD_Common.h"
 #include "Debug.h"
 
 /******************************************************************************
@@ -93,6 +94,7 @@ parameter:
 ******************************************************************************/
 static void EPD_7IN5_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(200);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -108,10 +110,7 @@ parameter:
 ******************************************************************************/
 static void EPD_7IN5_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -121,10 +120,7 @@ parameter:
 ******************************************************************************/
 static void EPD_7IN5_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -134,9 +130,7 @@ parameter:
 void EPD_7IN5_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-    while(DEV_Digital_Read(EPD_BUSY_PIN) == 0) {      //LOW: idle, HIGH: busy
-        DEV_Delay_ms(100);
-    }
+    DEV_Wait_Busy(1, EPD_BUSY_TIMEOUT_MS);
     Debug("e-Paper busy release\r\n");
 }
 
@@ -213,13 +207,7 @@ void EPD_7IN5_Clear(void)
     Height = EPD_7IN5_HEIGHT;
 
     EPD_7IN5_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            for(UBYTE k = 0; k < 4; k++) {
-                EPD_7IN5_SendData(0x33);
-            }
-        }
-    }
+    EPD_Common_SendDataRepeat(0x33, 4 * Width * Height);
     EPD_7IN5_TurnOnDisplay();
 }
 
@@ -230,12 +218,14 @@ parameter:
 void EPD_7IN5_Display(UBYTE *Image)
 {
     UBYTE Data_Black, Data;
-    UWORD Width, Height;
+    UBYTE Row[(EPD_7IN5_WIDTH + 7) / 8 * 4];
+    UWORD Width, Height, n;
     Width = (EPD_7IN5_WIDTH % 8 == 0)? (EPD_7IN5_WIDTH / 8 ): (EPD_7IN5_WIDTH / 8 + 1);
     Height = EPD_7IN5_HEIGHT;
 
     EPD_7IN5_SendCommand(0x10);
     for (UWORD j = 0; j < Height; j++) {
+        n = 0;
         for (UWORD i = 0; i < Width; i++) {
             Data_Black = ~Image[i + j * Width];
             for(UBYTE k = 0; k < 8; k++) {
@@ -251,9 +241,10 @@ void EPD_7IN5_Display(UBYTE *Image)
                 else
                     Data |= 0x03;
                 Data_Black <<= 1;
-                EPD_7IN5_SendData(Data);
+                Row[n++] = Data;
             }
         }
+        EPD_Common_SendDataBuffer(Row, n);
     }
     EPD_7IN5_TurnOnDisplay();
 }
@@ -88,6 +88,7 @@
 #define __EPD_7IN5_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_7IN5_WIDTH       640
@@ -98,4 +99,6 @@ void EPD_7IN5_Clear(void);
 void EPD_7IN5_Display(UBYTE *Image);
 void EPD_7IN5_Sleep(void);
 
+EPD_MODEL(EPD_7IN5, 1, 1);
+
 #endif
@@ -1,4 +1,5 @@
 #include "EPD_7in5_HD.h"
+#include "EPD_Common.h"
 #include "Debug.h"
 
 
@@ -9,6 +10,7 @@ parameter:
 ******************************************************************************/
 static void EPD_7IN5_HD_Reset(void)
 {
+EPD_State_Invalidate();
 
 //    DEV_Digital_Write(EPD_RST_PIN, 1);
 //    DEV_Delay_ms(200);
@@ -25,10 +27,7 @@ parameter:
 ******************************************************************************/
 static void EPD_7IN5_HD_SendCommand(UBYTE Reg)
 {
-	DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -38,10 +37,7 @@ parameter:
 ******************************************************************************/
 static void EPD_7IN5_HD_SendData(UBYTE Data)
 {
-	DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -50,11 +46,8 @@ parameter:
 ******************************************************************************/
 void EPD_7IN5_HD_ReadBusy(void)
 {
-    UBYTE busy;
     printf("e-Paper busy\r\n");
-    do {
-        busy = DEV_Digital_Read(EPD_BUSY_PIN);
-    } while(busy);
+    DEV_Wait_Busy(0, EPD_BUSY_TIMEOUT_MS);
     printf("e-Paper busy release\r\n");
 	DEV_Delay_ms(200);
 }
@@ -130,7 +123,7 @@ parameter:
 ******************************************************************************/
 void EPD_7IN5_HD_Clear(void)
 {
-	UDOUBLE i, j, width, height;
+	UDOUBLE width, height;
     width = (EPD_7IN5_HD_WIDTH % 8 == 0)? (EPD_7IN5_HD_WIDTH / 8 ): (EPD_7IN5_HD_WIDTH / 8 + 1);
     height = EPD_7IN5_HD_HEIGHT;
 	//EPD_7IN5_HD_ReadBusy();
@@ -138,17 +131,9 @@ void EPD_7IN5_HD_Clear(void)
     EPD_7IN5_HD_SendData(0x00);
     EPD_7IN5_HD_SendData(0x00);
 	EPD_7IN5_HD_SendCommand(0x24);			//BLOCK
-	for (j = 0; j < height; j++) {
-        for (i = 0; i < width; i++){
-			EPD_7IN5_HD_SendData(0xff);
-		}
-	}
+	EPD_Common_SendDataRepeat(0xff, width * height);
 	EPD_7IN5_HD_SendCommand(0x26);			
-	for (j = 0; j < height; j++) {
-        for (i = 0; i < width; i++){
-			EPD_7IN5_HD_SendData(0xff);
-		}
-	}
+	EPD_Common_SendDataRepeat(0xff, width * height);
 	EPD_7IN5_HD_SendCommand(0x22);
 	EPD_7IN5_HD_SendData(0xC7);
 	EPD_7IN5_HD_SendCommand(0x20);
@@ -163,7 +148,7 @@ parameter:
 ******************************************************************************/
 void EPD_7IN5_HD_Display(const UBYTE *blackimage)
 {
-    UDOUBLE i, j, width, height;
+    UDOUBLE width, height;
     width = (EPD_7IN5_HD_WIDTH % 8 == 0)? (EPD_7IN5_HD_WIDTH / 8 ): (EPD_7IN5_HD_WIDTH / 8 + 1);
     height = EPD_7IN5_HD_HEIGHT;
 	
@@ -171,17 +156,9 @@ void EPD_7IN5_HD_Display(const UBYTE *blackimage)
     EPD_7IN5_HD_SendData(0x00);
     EPD_7IN5_HD_SendData(0x00);
 	EPD_7IN5_HD_SendCommand(0x24);			//BLOCK
-	for (j = 0; j < height; j++) {
-        for (i = 0; i < width; i++){
-			EPD_7IN5_HD_SendData(blackimage[i + j * width]);
-		}
-	}
+	EPD_Common_SendDataBuffer(blackimage, width * height);
 	EPD_7IN5_HD_SendCommand(0x26);			//RED
-	for (j = 0; j < height; j++) {
-        for (i = 0; i < width; i++){
-			EPD_7IN5_HD_SendData(0xff);
-		}
-	}
+	EPD_Common_SendDataRepeat(0xff, width * height);
 	EPD_7IN5_HD_SendCommand(0x22);
 	EPD_7IN5_HD_SendData(0xC7);
 	EPD_7IN5_HD_SendCommand(0x20);
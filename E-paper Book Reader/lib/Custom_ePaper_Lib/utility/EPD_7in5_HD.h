@@ -2,6 +2,7 @@
 #define EPD7IN5_HD_H
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_7IN5_HD_WIDTH       880
@@ -13,7 +14,7 @@ void EPD_7IN5_HD_Clear(void);
 void EPD_7IN5_HD_Display(const UBYTE *blackimage);
 void EPD_7IN5_HD_Sleep(void);
 
-
+EPD_MODEL(EPD_7IN5_HD, 1, 1);
 
 #endif /* EPD7IN5_H */
 
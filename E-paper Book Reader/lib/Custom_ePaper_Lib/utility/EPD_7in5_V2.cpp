@@ -29,6 +29,8 @@
 #
 ******************************************************************************/
 #include "EPD_7in5_V2.h"
+#include "EPD_Common.h"
+#include "EPD_Panel.h"
 #include "Debug.h"
 
 /******************************************************************************
@@ -37,6 +39,7 @@ parameter:
 ******************************************************************************/
 static void EPD_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(20);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -52,10 +55,7 @@ parameter:
 ******************************************************************************/
 static void EPD_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -65,18 +65,7 @@ parameter:
 ******************************************************************************/
 static void EPD_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
-}
-
-static void EPD_SendData2(UBYTE *pData, UDOUBLE len)
-{
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_Write_nByte(pData, len);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -86,9 +75,7 @@ parameter:
 static void EPD_WaitUntilIdle(void)
 {
     Debug("e-Paper busy\r\n");
-	do{
-		DEV_Delay_ms(5);  
-	}while(!(DEV_Digital_Read(EPD_BUSY_PIN)));   
+	DEV_Wait_Busy(1, EPD_BUSY_TIMEOUT_MS);   
 	DEV_Delay_ms(5);      
     Debug("e-Paper busy release\r\n");
 }
@@ -103,58 +90,69 @@ static void EPD_7IN5_V2_TurnOnDisplay(void)
     EPD_WaitUntilIdle();
 }
 
+static const UBYTE EPD_7IN5_V2_Init_Script[] = {
+    EPD_RESET(20, 2, 20),
+    EPD_CMD(0x01, 4), 0x07, 0x07, 0x3f, 0x3f,   //POWER SETTING, VGH=20V,VGL=-20V, VDH=15V, VDL=-15V
+    EPD_CMD(0x06, 4), 0x17, 0x17, 0x28, 0x17,   //Booster Soft Start, enhanced display drive
+    EPD_CMD(0x04, 0),                           //POWER ON
+    EPD_DELAY(100),
+    EPD_BUSY,
+    EPD_CMD(0x00, 1), 0x1F,                     //PANNEL SETTING, KW-3f KWR-2F BWROTP 0f BWOTP 1f
+    EPD_CMD(0x61, 4), 0x03, 0x20, 0x01, 0xE0,   //tres, source 800, gate 480
+    EPD_CMD(0x15, 1), 0x00,
+    EPD_CMD(0x50, 2), 0x10, 0x07,               //VCOM AND DATA INTERVAL SETTING, 0x10 0x17 if the screen appears gray
+    EPD_CMD(0x60, 1), 0x22,                     //TCON SETTING
+    EPD_END
+};
+
+static const UBYTE EPD_7IN5_V2_Refresh_Script[] = {
+    EPD_CMD(0x12, 0),                           //DISPLAY REFRESH
+    EPD_DELAY(100),                             //necessary, 200uS at least
+    EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_7IN5_V2_Sleep_Script[] = {
+    EPD_CMD(0x50, 1), 0xF7,
+    EPD_CMD(0x02, 0),                           //power off
+    EPD_BUSY,
+    EPD_CMD(0x07, 1), 0xA5,                     //deep sleep
+    EPD_END
+};
+
+static const UBYTE EPD_7IN5_V2_PowerOff_Script[] = {
+    EPD_CMD(0x02, 0),                           //POWER OFF
+    EPD_BUSY,
+    EPD_END
+};
+
+static const UBYTE EPD_7IN5_V2_PowerOn_Script[] = {
+    EPD_CMD(0x04, 0),                           //POWER ON
+    EPD_DELAY(100),
+    EPD_BUSY,
+    EPD_END
+};
+
+const EPD_PANEL EPD_7IN5_V2_Panel = {
+    "EPD_7IN5_V2", EPD_7IN5_V2_WIDTH, EPD_7IN5_V2_HEIGHT,
+    2, {
+        { 0x10, EPD_PLANE_IMAGE0, 0, 0xFF, 0 },   //old data
+        { 0x13, EPD_PLANE_IMAGE0, 1, 0x00, 0 },
+    },
+    0, 0, 1, 0, 5,
+    EPD_7IN5_V2_Init_Script, EPD_7IN5_V2_Refresh_Script, EPD_7IN5_V2_Sleep_Script,
+    EPD_CAP_PARTIAL | EPD_CAP_FAST | EPD_CAP_4GRAY,
+    EPD_7IN5_V2_PowerOff_Script, EPD_7IN5_V2_PowerOn_Script,
+    NULL,
+};
+
 /******************************************************************************
 function :	Initialize the e-Paper register
 parameter:
 ******************************************************************************/
 UBYTE EPD_7IN5_V2_Init(void)
 {
-    EPD_Reset();
-    EPD_SendCommand(0x01);			//POWER SETTING
-	EPD_SendData(0x07);
-	EPD_SendData(0x07);    //VGH=20V,VGL=-20V
-	EPD_SendData(0x3f);		//VDH=15V
-	EPD_SendData(0x3f);		//VDL=-15V
-
-	//Enhanced display drive(Add 0x06 command)
-	EPD_SendCommand(0x06);			//Booster Soft Start 
-	EPD_SendData(0x17);
-	EPD_SendData(0x17);   
-	EPD_SendData(0x28);		
-	EPD_SendData(0x17);	
-
-	EPD_SendCommand(0x04); //POWER ON
-	DEV_Delay_ms(100); 
-	EPD_WaitUntilIdle();        //waiting for the electronic paper IC to release the idle signal
-
-	EPD_SendCommand(0X00);			//PANNEL SETTING
-	EPD_SendData(0x1F);   //KW-3f   KWR-2F	BWROTP 0f	BWOTP 1f
-
-	EPD_SendCommand(0x61);        	//tres			
-	EPD_SendData(0x03);		//source 800
-	EPD_SendData(0x20);
-	EPD_SendData(0x01);		//gate 480
-	EPD_SendData(0xE0);  
-
-	EPD_SendCommand(0X15);		
-	EPD_SendData(0x00);		
-
-	/*
-        If the screen appears gray, use the annotated initialization command
-    */
-    EPD_SendCommand(0X50);			
-	EPD_SendData(0x10);
-	EPD_SendData(0x07);
-	// EPD_SendCommand(0X50);			
-	// EPD_SendData(0x10);
-	// EPD_SendData(0x17);
-    // EPD_SendCommand(0X52);			
-	// EPD_SendData(0x03);
-
-	EPD_SendCommand(0X60);			//TCON SETTING
-	EPD_SendData(0x22);
-	
-    return 0;
+    return EPD_Panel_Init(&EPD_7IN5_V2_Panel);
 }
 
 UBYTE EPD_7IN5_V2_Init_Fast(void)
@@ -251,58 +249,20 @@ parameter:
 ******************************************************************************/
 void EPD_7IN5_V2_Clear(void)
 {
-    UWORD Width, Height;
-    Width =(EPD_7IN5_V2_WIDTH % 8 == 0)?(EPD_7IN5_V2_WIDTH / 8 ):(EPD_7IN5_V2_WIDTH / 8 + 1);
-    Height = EPD_7IN5_V2_HEIGHT;
-    UBYTE image[EPD_7IN5_V2_WIDTH / 8] = {0x00};
-
-    UWORD i;
-    EPD_SendCommand(0x10);
-    for(i=0; i<Width; i++) {
-        image[i] = 0xFF;
-    }
-    for(i=0; i<Height; i++)
-    {
-        EPD_SendData2(image, Width);
-    }
-
-    EPD_SendCommand(0x13);
-    for(i=0; i<Width; i++) {
-        image[i] = 0x00;
-    }
-    for(i=0; i<Height; i++)
-    {
-        EPD_SendData2(image, Width);
-    }
-    
-    EPD_7IN5_V2_TurnOnDisplay();
+    EPD_Panel_Clear(&EPD_7IN5_V2_Panel);
 }
 
 void EPD_7IN5_V2_ClearBlack(void)
 {
-    UWORD Width, Height;
+    UDOUBLE Width, Height;
     Width =(EPD_7IN5_V2_WIDTH % 8 == 0)?(EPD_7IN5_V2_WIDTH / 8 ):(EPD_7IN5_V2_WIDTH / 8 + 1);
     Height = EPD_7IN5_V2_HEIGHT;
-    UBYTE image[EPD_7IN5_V2_WIDTH / 8] = {0x00};
 
-    UWORD i;
     EPD_SendCommand(0x10);
-    for(i=0; i<Width; i++) {
-        image[i] = 0x00;
-    }
-    for(i=0; i<Height; i++)
-    {
-        EPD_SendData2(image, Width);
-    }
+    EPD_Common_SendDataRepeat(0x00, Width * Height);
 
     EPD_SendCommand(0x13);
-    for(i=0; i<Width; i++) {
-        image[i] = 0xFF;
-    }
-    for(i=0; i<Height; i++)
-    {
-        EPD_SendData2(image, Width);
-    }
+    EPD_Common_SendDataRepeat(0xFF, Width * Height);
     
     EPD_7IN5_V2_TurnOnDisplay();
 }
@@ -310,46 +270,26 @@ void EPD_7IN5_V2_ClearBlack(void)
 /******************************************************************************
 function :	Sends the image buffer in RAM to e-Paper and displays
 parameter:
+Info:
+    The new data plane goes out inverted on the fly, blackimage is left as
+    it is and can be drawn on and sent in parts afterwards.
 ******************************************************************************/
-void EPD_7IN5_V2_Display(UBYTE *blackimage)
+void EPD_7IN5_V2_Display(const UBYTE *blackimage)
 {
-    UDOUBLE Width, Height;
-    Width =(EPD_7IN5_V2_WIDTH % 8 == 0)?(EPD_7IN5_V2_WIDTH / 8 ):(EPD_7IN5_V2_WIDTH / 8 + 1);
-    Height = EPD_7IN5_V2_HEIGHT;
-	
-    EPD_SendCommand(0x10);
-    for (UDOUBLE j = 0; j < Height; j++) {
-        EPD_SendData2((UBYTE *)(blackimage+j*Width), Width);
-    }
-
-    EPD_SendCommand(0x13);
-    for (UDOUBLE j = 0; j < Height; j++) {
-        for (UDOUBLE i = 0; i < Width; i++) {
-            blackimage[i + j * Width] = ~blackimage[i + j * Width];
-        }
-    }
-    for (UDOUBLE j = 0; j < Height; j++) {
-        EPD_SendData2((UBYTE *)(blackimage+j*Width), Width);
-    }
-    EPD_7IN5_V2_TurnOnDisplay();
+    EPD_Panel_Display(&EPD_7IN5_V2_Panel, blackimage, NULL);
 }
 
-void EPD_7IN5_V2_Display_Part(UBYTE *blackimage,UDOUBLE x_start, UDOUBLE y_start, UDOUBLE x_end, UDOUBLE y_end)
+/******************************************************************************
+function :	Enter partial mode for a window
+parameter:
+    x_start : first byte column
+    y_start : first row
+    x_end   : byte column after the window
+    y_end   : row after the window
+******************************************************************************/
+static void EPD_7IN5_V2_Part_Window(UDOUBLE x_start, UDOUBLE y_start, UDOUBLE x_end, UDOUBLE y_end)
 {
-    if(((x_start % 8 + x_end % 8 == 8) && (x_start % 8 > x_end % 8)) || (x_start % 8 + x_end % 8 == 0) || ((x_end - x_start)%8 == 0))
-    {
-        x_start = x_start / 8 ;
-        x_end = x_end / 8;
-    }
-    else
-    {
-        x_start = x_start / 8 ;
-        x_end = x_end % 8 == 0 ? x_end / 8 : x_end / 8 + 1;
-    }
-    UWORD i, Width;
-	Width = x_end -  x_start;
-	UWORD IMAGE_COUNTER = Width * (y_end-y_start);
-
+    EPD_State_Invalidate();     //0x50 and partial mode differ from EPD_7IN5_V2_Init()
     x_end -= 1;
 	y_end -= 1;	
 
@@ -374,196 +314,116 @@ void EPD_7IN5_V2_Display_Part(UBYTE *blackimage,UDOUBLE x_start, UDOUBLE y_start
 	EPD_SendData(y_end/256);		
 	EPD_SendData(y_end%256);  //y-end
 	EPD_SendData(0x01);
+}
+
+void EPD_7IN5_V2_Display_Part(UBYTE *blackimage,UDOUBLE x_start, UDOUBLE y_start, UDOUBLE x_end, UDOUBLE y_end)
+{
+    if(((x_start % 8 + x_end % 8 == 8) && (x_start % 8 > x_end % 8)) || (x_start % 8 + x_end % 8 == 0) || ((x_end - x_start)%8 == 0))
+    {
+        x_start = x_start / 8 ;
+        x_end = x_end / 8;
+    }
+    else
+    {
+        x_start = x_start / 8 ;
+        x_end = x_end % 8 == 0 ? x_end / 8 : x_end / 8 + 1;
+    }
+    UWORD Width;
+	Width = x_end -  x_start;
+	UWORD IMAGE_COUNTER = Width * (y_end-y_start);
+
+    EPD_7IN5_V2_Part_Window(x_start, y_start, x_end, y_end);
     
     EPD_SendCommand(0x13);
-    for (UDOUBLE j = 0; j < IMAGE_COUNTER; j++) {
-        EPD_SendData(blackimage[j]);
+    EPD_Common_SendDataBuffer(blackimage, IMAGE_COUNTER);
+    EPD_7IN5_V2_TurnOnDisplay();
+}
+
+/******************************************************************************
+function :	Partial refresh of a window, taken from the full frame
+parameter:
+    Image   : full frame image, EPD_7IN5_V2_WIDTH x EPD_7IN5_V2_HEIGHT
+    x_start : x starting point, rounded down to 8
+    y_start : y starting point
+    x_end   : x end point, exclusive, rounded up to 8
+    y_end   : y end point, exclusive
+Info:
+    Only the window is sent, row by row from the frame, e.g. the
+    rectangle from Paint_GetDirty(Rect, 1, 8). The frame is the same one
+    EPD_7IN5_V2_Display() takes, neither inverts it.
+******************************************************************************/
+void EPD_7IN5_V2_Display_Part_Frame(const UBYTE *Image, UDOUBLE x_start, UDOUBLE y_start, UDOUBLE x_end, UDOUBLE y_end)
+{
+    UDOUBLE Width = (EPD_7IN5_V2_WIDTH % 8 == 0)?(EPD_7IN5_V2_WIDTH / 8 ):(EPD_7IN5_V2_WIDTH / 8 + 1);
+
+    x_start = x_start / 8;
+    x_end = (x_end + 7) / 8;
+    if(x_end > Width)
+        x_end = Width;
+    if(y_end > EPD_7IN5_V2_HEIGHT)
+        y_end = EPD_7IN5_V2_HEIGHT;
+    if(x_start >= x_end || y_start >= y_end)
+        return;
+
+    EPD_7IN5_V2_Part_Window(x_start, y_start, x_end, y_end);
+
+    EPD_SendCommand(0x13);
+    for (UDOUBLE j = y_start; j < y_end; j++) {
+        EPD_Common_SendDataBuffer(Image + j * Width + x_start, x_end - x_start);
     }
     EPD_7IN5_V2_TurnOnDisplay();
 }
 
 void EPD_7IN5_V2_Display_4Gray(const UBYTE *Image)
 {
-    UDOUBLE i,j,k;
-    UBYTE temp1,temp2,temp3;
-
     // old  data
     EPD_SendCommand(0x10);
-    for(i=0; i<48000; i++) {
-        temp3=0;
-        for(j=0; j<2; j++) {
-            temp1 = Image[i*2+j];
-            for(k=0; k<2; k++) {
-                temp2 = temp1&0xC0;
-                if(temp2 == 0xC0)
-                    temp3 |= 0x00;
-                else if(temp2 == 0x00)
-                    temp3 |= 0x01; 
-                else if(temp2 == 0x80)
-                    temp3 |= 0x01; 
-                else //0x40
-                    temp3 |= 0x00; 
-                temp3 <<= 1;
-
-                temp1 <<= 2;
-                temp2 = temp1&0xC0 ;
-                if(temp2 == 0xC0) 
-                    temp3 |= 0x00;
-                else if(temp2 == 0x00) 
-                    temp3 |= 0x01;
-                else if(temp2 == 0x80)
-                    temp3 |= 0x01; 
-                else    //0x40
-                    temp3 |= 0x00;	
-                if(j!=1 || k!=1)
-                    temp3 <<= 1;
-
-                temp1 <<= 2;
-            }
-
-        }
-        EPD_SendData(temp3);
-        // printf("%x",temp3);
-    }
+    EPD_Common_SendGrayPlane(Image, 96000, EPD_7IN5_V2_GRAY, 0);
 
     EPD_SendCommand(0x13);   //write RAM for black(0)/white (1)
-    for(i=0; i<48000; i++) {             //5808*4  46464
-        temp3=0;
-        for(j=0; j<2; j++) {
-            temp1 = Image[i*2+j];
-            for(k=0; k<2; k++) {
-                temp2 = temp1&0xC0 ;
-                if(temp2 == 0xC0)
-                    temp3 |= 0x00;//white
-                else if(temp2 == 0x00)
-                    temp3 |= 0x01;  //black
-                else if(temp2 == 0x80)
-                    temp3 |= 0x00;  //gray1
-                else //0x40
-                    temp3 |= 0x01; //gray2
-                temp3 <<= 1;
-
-                temp1 <<= 2;
-                temp2 = temp1&0xC0 ;
-                if(temp2 == 0xC0)  //white
-                    temp3 |= 0x00;
-                else if(temp2 == 0x00) //black
-                    temp3 |= 0x01;
-                else if(temp2 == 0x80)
-                    temp3 |= 0x00; //gray1
-                else    //0x40
-                    temp3 |= 0x01;	//gray2
-                if(j!=1 || k!=1)
-                    temp3 <<= 1;
-
-                temp1 <<= 2;
-            }
-        }
-        EPD_SendData(temp3);
-        // printf("%x",temp3);
-    }
+    EPD_Common_SendGrayPlane(Image, 96000, EPD_7IN5_V2_GRAY, 1);
 
     EPD_7IN5_V2_TurnOnDisplay();
 }
 
-void EPD_7IN5_V2_WritePicture_4Gray(const UBYTE *Image)
+/******************************************************************************
+function :	Sends a planar 4 gray image to e-Paper and displays
+parameter:
+    Image : the 0x10 plane then the 0x13 plane, drawn with
+            Paint_SetGrayPlanes(Ctx, EPD_7IN5_V2_GRAY)
+******************************************************************************/
+void EPD_7IN5_V2_Display_4Gray_Planes(const UBYTE *Image)
 {
-    UDOUBLE i,j,k,o;
-    UBYTE temp1,temp2,temp3;
-    UWORD Width, Height;
-	Width = (EPD_7IN5_V2_WIDTH % 8 == 0)? (EPD_7IN5_V2_WIDTH / 8 ): (EPD_7IN5_V2_WIDTH / 8 + 1);
-	Height = EPD_7IN5_V2_HEIGHT;
+    UDOUBLE Plane = (UDOUBLE)EPD_7IN5_V2_WIDTH / 8 * EPD_7IN5_V2_HEIGHT;
 
     EPD_SendCommand(0x10);
-    for(i=0; i<Height; i++) {
-        for(o=0; o<Width; o++) {
-            if((o < Width/2)&&(i < Height))
-            {
-                temp3=0;
-                for(j=0; j<2; j++) {
-                    temp1 = Image[(i*Width/2+o)*2+j];
-                    for(k=0; k<2; k++) {
-                        temp2 = temp1&0xC0;
-                        if(temp2 == 0xC0)
-                            temp3 |= 0x00;
-                        else if(temp2 == 0x00)
-                            temp3 |= 0x01; 
-                        else if(temp2 == 0x80)
-                            temp3 |= 0x01; 
-                        else //0x40
-                            temp3 |= 0x00; 
-                        temp3 <<= 1;
-
-                        temp1 <<= 2;
-                        temp2 = temp1&0xC0 ;
-                        if(temp2 == 0xC0) 
-                            temp3 |= 0x00;
-                        else if(temp2 == 0x00) 
-                            temp3 |= 0x01;
-                        else if(temp2 == 0x80)
-                            temp3 |= 0x01; 
-                        else    //0x40
-                            temp3 |= 0x00;	
-                        if(j!=1 || k!=1)
-                            temp3 <<= 1;
-
-                        temp1 <<= 2;
-                    }
-
-                }
-                EPD_SendData(temp3);
-                // printf("%x",temp3);
-            }
-            else
-            {
-                EPD_SendData(0x00);
-            }
-        }
-    }
+    EPD_Common_SendDataBuffer(Image, Plane);
+    EPD_SendCommand(0x13);
+    EPD_Common_SendDataBuffer(Image + Plane, Plane);
+    EPD_7IN5_V2_TurnOnDisplay();
+}
 
+/******************************************************************************
+function :	Sends a packed 4 gray picture of half the panel width, the right
+            half is left white
+parameter:
+    Image : 400 x 480 pixels, 4 per byte
+******************************************************************************/
+void EPD_7IN5_V2_WritePicture_4Gray(const UBYTE *Image)
+{
+    UWORD i, Width, Height;
+    UBYTE Lut[256], Row[EPD_7IN5_V2_WIDTH / 8];
+	Width = (EPD_7IN5_V2_WIDTH % 8 == 0)? (EPD_7IN5_V2_WIDTH / 8 ): (EPD_7IN5_V2_WIDTH / 8 + 1);
+	Height = EPD_7IN5_V2_HEIGHT;
 
-    EPD_SendCommand(0x13);
-    for(i=0; i<Height; i++) {
-        for(o=0; o<Width; o++) {
-            if((o < Width/2)&&(i < Height))
-            {
-                for(j=0; j<2; j++) {
-                    temp1 = Image[(i*Width/2+o)*2+j];
-                    for(k=0; k<2; k++) {
-                        temp2 = temp1&0xC0 ;
-                        if(temp2 == 0xC0)
-                            temp3 |= 0x00;//white
-                        else if(temp2 == 0x00)
-                            temp3 |= 0x01;  //black
-                        else if(temp2 == 0x80)
-                            temp3 |= 0x00;  //gray1
-                        else //0x40
-                            temp3 |= 0x01; //gray2
-                        temp3 <<= 1;
-
-                        temp1 <<= 2;
-                        temp2 = temp1&0xC0 ;
-                        if(temp2 == 0xC0)  //white
-                            temp3 |= 0x00;
-                        else if(temp2 == 0x00) //black
-                            temp3 |= 0x01;
-                        else if(temp2 == 0x80)
-                            temp3 |= 0x00; //gray1
-                        else    //0x40
-                            temp3 |= 0x01;	//gray2
-                        if(j!=1 || k!=1)
-                            temp3 <<= 1;
-
-                        temp1 <<= 2;
-                    }
-                }
-                EPD_SendData(temp3);
-                // printf("%x",temp3);
-            }
-            else
-            {
-                EPD_SendData(0x00);
-            }
+    for(i=Width/2; i<Width; i++)
+        Row[i] = 0x00;
+    for(UBYTE Plane = 0; Plane < 2; Plane++) {
+        EPD_SendCommand(Plane == 0 ? 0x10 : 0x13);
+        EPD_Common_GrayLut(EPD_7IN5_V2_GRAY, Plane, Lut);
+        for(i=0; i<Height; i++) {
+            EPD_Common_GrayPlane(Image + i * Width, Width, Lut, Row);
+            EPD_Common_SendDataBuffer(Row, Width);
         }
     }
     EPD_7IN5_V2_TurnOnDisplay();
@@ -575,10 +435,5 @@ parameter:
 ******************************************************************************/
 void EPD_7IN5_V2_Sleep(void)
 {
-    EPD_SendCommand(0x50);  	
-    EPD_SendData(0XF7);
-    EPD_SendCommand(0X02);  	//power off
-    EPD_WaitUntilIdle();
-    EPD_SendCommand(0X07);  	//deep sleep
-    EPD_SendData(0xA5);
+    EPD_Panel_Sleep(&EPD_7IN5_V2_Panel);
 }
@@ -34,11 +34,17 @@
 #define _EPD_7IN5_V2_H_
 
 #include "DEV_Config.h"
+#include "EPD_Common.h"
+#include "EPD_Model.h"
+#include "EPD_Panel.h"
 
 
 // Display resolution
 #define EPD_7IN5_V2_WIDTH       800
 #define EPD_7IN5_V2_HEIGHT      480
+#define EPD_7IN5_V2_GRAY        EPD_Gray_Invert     //4 gray planes, see Paint_SetGrayPlanes()
+
+extern const EPD_PANEL EPD_7IN5_V2_Panel;
 
 UBYTE EPD_7IN5_V2_Init(void);
 UBYTE EPD_7IN5_V2_Init_Fast(void);
@@ -46,10 +52,14 @@ UBYTE EPD_7IN5_V2_Init_Part(void);
 UBYTE EPD_7IN5_V2_Init_4Gray(void);
 void EPD_7IN5_V2_Clear(void);
 void EPD_7IN5_V2_ClearBlack(void);
-void EPD_7IN5_V2_Display(UBYTE *blackimage);
+void EPD_7IN5_V2_Display(const UBYTE *blackimage);
 void EPD_7IN5_V2_Display_Part(UBYTE *blackimage,UDOUBLE x_start, UDOUBLE y_start, UDOUBLE x_end, UDOUBLE y_end);
+void EPD_7IN5_V2_Display_Part_Frame(const UBYTE *Image, UDOUBLE x_start, UDOUBLE y_start, UDOUBLE x_end, UDOUBLE y_end);
 void EPD_7IN5_V2_Display_4Gray(const UBYTE *Image);
+void EPD_7IN5_V2_Display_4Gray_Planes(const UBYTE *Image);
 void EPD_7IN5_V2_WritePicture_4Gray(const UBYTE *Image);
 void EPD_7IN5_V2_Sleep(void);
 
+EPD_MODEL(EPD_7IN5_V2, 1, 1);
+
 #endif
@@ -29,6 +29,7 @@
 #
 ******************************************************************************/
 #include "EPD_7in5_V2_old.h"
+#include "EPD_Common.h"
 #include "Debug.h"
 
 
@@ -196,6 +197,7 @@ parameter:
 ******************************************************************************/
 static void EPD_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(20);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -211,10 +213,7 @@ parameter:
 ******************************************************************************/
 static void EPD_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -224,18 +223,7 @@ parameter:
 ******************************************************************************/
 static void EPD_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
-}
-
-static void EPD_SendData2(UBYTE *pData, UDOUBLE len)
-{
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_Write_nByte(pData, len);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -245,36 +233,28 @@ parameter:
 static void EPD_WaitUntilIdle(void)
 {
     Debug("e-Paper busy\r\n");
-	do{
-		DEV_Delay_ms(5);  
-	}while(!(DEV_Digital_Read(EPD_BUSY_PIN)));   
+	DEV_Wait_Busy(1, EPD_BUSY_TIMEOUT_MS);   
 	DEV_Delay_ms(5);      
     Debug("e-Paper busy release\r\n");
 }
 
 static void EPD_7IN5_V2_LUT(UBYTE* lut_vcom,  UBYTE* lut_ww, UBYTE* lut_bw, UBYTE* lut_wb, UBYTE* lut_bb)
 {
-	UBYTE count;
 
 	EPD_SendCommand(0x20); //VCOM	
-	for(count=0; count<42; count++)
-		EPD_SendData(lut_vcom[count]);
+	EPD_Common_SendDataBuffer(lut_vcom, 42);
 
 	EPD_SendCommand(0x21); //LUTBW
-	for(count=0; count<42; count++)
-		EPD_SendData(lut_ww[count]);
+	EPD_Common_SendDataBuffer(lut_ww, 42);
 
 	EPD_SendCommand(0x22); //LUTBW
-	for(count=0; count<42; count++)
-		EPD_SendData(lut_bw[count]);
+	EPD_Common_SendDataBuffer(lut_bw, 42);
 
 	EPD_SendCommand(0x23); //LUTWB
-	for(count=0; count<42; count++)
-		EPD_SendData(lut_wb[count]);
+	EPD_Common_SendDataBuffer(lut_wb, 42);
 
 	EPD_SendCommand(0x24); //LUTBB
-	for(count=0; count<42; count++)
-		EPD_SendData(lut_bb[count]);
+	EPD_Common_SendDataBuffer(lut_bb, 42);
 }
 
 /******************************************************************************
@@ -469,58 +449,30 @@ parameter:
 ******************************************************************************/
 void EPD_7IN5_V2_Clear_old(void)
 {
-    UWORD Width, Height;
+    UDOUBLE Width, Height;
     Width =(EPD_7IN5_V2_WIDTH_OLD % 8 == 0)?(EPD_7IN5_V2_WIDTH_OLD / 8 ):(EPD_7IN5_V2_WIDTH_OLD / 8 + 1);
     Height = EPD_7IN5_V2_HEIGHT_OLD;
-    UBYTE image[EPD_7IN5_V2_WIDTH_OLD / 8] = {0x00};
 
-    UWORD i;
     EPD_SendCommand(0x10);
-    for(i=0; i<Width; i++) {
-        image[i] = 0xFF;
-    }
-    for(i=0; i<Height; i++)
-    {
-        EPD_SendData2(image, Width);
-    }
+    EPD_Common_SendDataRepeat(0xFF, Width * Height);
 
     EPD_SendCommand(0x13);
-    for(i=0; i<Width; i++) {
-        image[i] = 0x00;
-    }
-    for(i=0; i<Height; i++)
-    {
-        EPD_SendData2(image, Width);
-    }
+    EPD_Common_SendDataRepeat(0x00, Width * Height);
     
     EPD_7IN5_V2_TurnOnDisplay();
 }
 
 void EPD_7IN5_V2_ClearBlack_old(void)
 {
-    UWORD Width, Height;
+    UDOUBLE Width, Height;
     Width =(EPD_7IN5_V2_WIDTH_OLD % 8 == 0)?(EPD_7IN5_V2_WIDTH_OLD / 8 ):(EPD_7IN5_V2_WIDTH_OLD / 8 + 1);
     Height = EPD_7IN5_V2_HEIGHT_OLD;
-    UBYTE image[EPD_7IN5_V2_WIDTH_OLD / 8] = {0x00};
 
-    UWORD i;
     EPD_SendCommand(0x10);
-    for(i=0; i<Width; i++) {
-        image[i] = 0x00;
-    }
-    for(i=0; i<Height; i++)
-    {
-        EPD_SendData2(image, Width);
-    }
+    EPD_Common_SendDataRepeat(0x00, Width * Height);
 
     EPD_SendCommand(0x13);
-    for(i=0; i<Width; i++) {
-        image[i] = 0xFF;
-    }
-    for(i=0; i<Height; i++)
-    {
-        EPD_SendData2(image, Width);
-    }
+    EPD_Common_SendDataRepeat(0xFF, Width * Height);
     
     EPD_7IN5_V2_TurnOnDisplay();
 }
@@ -535,16 +487,10 @@ void EPD_7IN5_V2_Display_old(const UBYTE *blackimage)
     Height = EPD_7IN5_V2_HEIGHT_OLD;
 	
     EPD_SendCommand(0x10);
-    for (UDOUBLE j = 0; j < Height; j++) {
-        EPD_SendData2((UBYTE *)(blackimage+j*Width), Width);
-    }
+    EPD_Common_SendDataBuffer(blackimage, Width * Height);
 
     EPD_SendCommand(0x13);
-    for (UDOUBLE j = 0; j < Height; j++) {
-        for (UDOUBLE i = 0; i < Width; i++) {
-            EPD_SendData(~blackimage[i + j * Width]) ;
-        }
-    }
+    EPD_Common_SendDataInvert(blackimage, Width * Height);
     EPD_7IN5_V2_TurnOnDisplay();
 }
 
@@ -560,28 +506,12 @@ void EPD_7IN5_V2_SendHalfImage_old(const UBYTE *Image)
 
 
     EPD_SendCommand(0x10);
-    for (UDOUBLE j = 0; j < Height / 2; j++) {
-        for (UDOUBLE i = 0; i < Width; i++) {
-            EPD_SendData(Image[i + j * Width]);
-        }
-    }
-    for (UDOUBLE j = 0; j < Height / 2; j++) {
-        for (UDOUBLE i = 0; i < Width; i++) {
-            EPD_SendData(0xFF);
-        }
-    }
+    EPD_Common_SendDataBuffer(Image, Width * (Height / 2));
+    EPD_Common_SendDataRepeat(0xFF, Width * (Height / 2));
 
     EPD_SendCommand(0x13);
-    for (UDOUBLE j = 0; j < Height / 2; j++) {
-        for (UDOUBLE i = 0; i < Width; i++) {
-            EPD_SendData(~Image[i + j * Width]);
-        }
-    }
-    for (UDOUBLE j = 0; j < Height / 2; j++) {
-        for (UDOUBLE i = 0; i < Width; i++) {
-            EPD_SendData(0x00);
-        }
-    }
+    EPD_Common_SendDataInvert(Image, Width * (Height / 2));
+    EPD_Common_SendDataRepeat(0x00, Width * (Height / 2));
 
     EPD_7IN5_V2_TurnOnDisplay();
 }
@@ -595,33 +525,17 @@ void EPD_7IN5_V2_WritePicture_old(const UBYTE *Image)
 	
     EPD_SendCommand(0x10);
     for (UDOUBLE j = 0; j < Height / 2; j++) {
-        for (UDOUBLE i = 0; i < Width/2; i++) {
-            EPD_SendData(Image[i + j * Width/2]);
-        }
-        for (UDOUBLE i = 0; i < Width/2; i++) {
-            EPD_SendData(0xff);
-        }
-    }
-    for (UDOUBLE j = 0; j < Height / 2; j++) {
-        for (UDOUBLE i = 0; i < Width; i++) {
-            EPD_SendData(0xFF);
-        }
+        EPD_Common_SendDataBuffer(Image + j * (Width/2), Width/2);
+        EPD_Common_SendDataRepeat(0xff, Width/2);
     }
+    EPD_Common_SendDataRepeat(0xFF, Width * (Height / 2));
 
     EPD_SendCommand(0x13);
     for (UDOUBLE j = 0; j < Height / 2; j++) {
-        for (UDOUBLE i = 0; i < Width/2; i++) {
-            EPD_SendData(~Image[i + j * Width/2]);
-        }
-        for (UDOUBLE i = 0; i < Width/2; i++) {
-            EPD_SendData(0x00);
-        }
-    }
-    for (UDOUBLE j = 0; j < Height / 2; j++) {
-        for (UDOUBLE i = 0; i < Width; i++) {
-            EPD_SendData(0x00);
-        }
+        EPD_Common_SendDataInvert(Image + j * (Width/2), Width/2);
+        EPD_Common_SendDataRepeat(0x00, Width/2);
     }
+    EPD_Common_SendDataRepeat(0x00, Width * (Height / 2));
 
     EPD_7IN5_V2_TurnOnDisplay();
 }
@@ -630,18 +544,23 @@ void EPD_7IN5_V2_DisplayPart_old(const UBYTE *Image, UWORD xstart, UWORD ystart,
 {
 	unsigned long i, j;
 	UWORD Width, Height;
+	UBYTE Row[EPD_7IN5_V2_WIDTH_OLD / 8];
 	Width = (EPD_7IN5_V2_WIDTH_OLD % 8 == 0)? (EPD_7IN5_V2_WIDTH_OLD / 8 ): (EPD_7IN5_V2_WIDTH_OLD / 8 + 1);
 	Height = EPD_7IN5_V2_HEIGHT_OLD;
 	
 	EPD_SendCommand(0x10);
 	for(i=0; i<Height; i++) {
-		for(j=0; j<Width; j++) {
-			if(i<image_heigh+ystart && i>=ystart && j<(image_width+xstart)/2 && j>=xstart/2) {
-				EPD_SendData(Image[(j-xstart/2) + (image_width/2*(i-ystart))]);
-			}
-			else {
-				EPD_SendData(0xff);
+		if(i<image_heigh+ystart && i>=ystart) {
+			for(j=0; j<Width; j++) {
+				if(j<(image_width+xstart)/2 && j>=xstart/2)
+					Row[j] = Image[(j-xstart/2) + (image_width/2*(i-ystart))];
+				else
+					Row[j] = 0xff;
 			}
+			EPD_Common_SendDataBuffer(Row, Width);
+		}
+		else {
+			EPD_Common_SendDataRepeat(0xff, Width);
 		}
 	}
 	EPD_7IN5_V2_TurnOnDisplay();
@@ -676,9 +595,7 @@ void EPD_7IN5_V2_Display_Partial_old(UBYTE *blackimage,UDOUBLE x_start, UDOUBLE
     // }
     
     EPD_SendCommand(0x13);
-    for (UDOUBLE j = 0; j < Height; j++) {
-        EPD_SendData2((UBYTE *)(blackimage+j*Width), Width);
-    }
+    EPD_Common_SendDataBuffer(blackimage, Width * Height);
 
     EPD_7IN5_V2_TurnOnDisplay();
     EPD_SendCommand(0x92);
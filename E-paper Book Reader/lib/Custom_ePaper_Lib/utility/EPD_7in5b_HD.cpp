@@ -1,4 +1,5 @@
 #include "EPD_7in5b_HD.h"
+#include "EPD_Common.h"
 #include "Debug.h"
 
 
@@ -9,6 +10,7 @@ parameter:
 ******************************************************************************/
 static void EPD_7IN5B_HD_Reset(void)
 {
+EPD_State_Invalidate();
 
 //    DEV_Digital_Write(EPD_RST_PIN, 1);
 //    DEV_Delay_ms(200);
@@ -25,10 +27,7 @@ parameter:
 ******************************************************************************/
 static void EPD_7IN5B_HD_SendCommand(UBYTE Reg)
 {
-	DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -38,10 +37,7 @@ parameter:
 ******************************************************************************/
 static void EPD_7IN5B_HD_SendData(UBYTE Data)
 {
-	DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -50,11 +46,8 @@ parameter:
 ******************************************************************************/
 void EPD_7IN5B_HD_ReadBusy(void)
 {
-    UBYTE busy;
     printf("e-Paper busy\r\n");
-    do {
-        busy = DEV_Digital_Read(EPD_BUSY_PIN);
-    } while(busy);
+    DEV_Wait_Busy(0, EPD_BUSY_TIMEOUT_MS);
     printf("e-Paper busy release\r\n");
 	DEV_Delay_ms(200);
 }
@@ -130,7 +123,7 @@ parameter:
 ******************************************************************************/
 void EPD_7IN5B_HD_Clear(void)
 {
-	UDOUBLE i, j, width, height;
+	UDOUBLE width, height;
     width = (EPD_7IN5B_HD_WIDTH % 8 == 0)? (EPD_7IN5B_HD_WIDTH / 8 ): (EPD_7IN5B_HD_WIDTH / 8 + 1);
     height = EPD_7IN5B_HD_HEIGHT;
 	//EPD_7IN5B_HD_ReadBusy();
@@ -138,22 +131,14 @@ void EPD_7IN5B_HD_Clear(void)
     EPD_7IN5B_HD_SendData(0xAf);
     EPD_7IN5B_HD_SendData(0x02);
 	EPD_7IN5B_HD_SendCommand(0x24);			//BLOCK
-	for (j = 0; j < height; j++) {
-        for (i = 0; i < width; i++){
-			EPD_7IN5B_HD_SendData(0XFF);
-		}
-	}
+	EPD_Common_SendDataRepeat(0XFF, width * height);
 	//EPD_7IN5B_HD_ReadBusy();
 	DEV_Delay_ms(400);
 	EPD_7IN5B_HD_SendCommand(0x4F); 
     EPD_7IN5B_HD_SendData(0xAf);
     EPD_7IN5B_HD_SendData(0x02);
 	EPD_7IN5B_HD_SendCommand(0x26);			//RED
-	for (j = 0; j < height; j++) {
-        for (i = 0; i < width; i++){
-			EPD_7IN5B_HD_SendData(0X00);
-		}
-	}
+	EPD_Common_SendDataRepeat(0X00, width * height);
 	EPD_7IN5B_HD_SendCommand(0x22);
 	EPD_7IN5B_HD_SendData(0xC7);
 	EPD_7IN5B_HD_SendCommand(0x20);
@@ -164,7 +149,7 @@ void EPD_7IN5B_HD_Clear(void)
 
 void EPD_7IN5B_HD_ClearRed(void)
 {
-	UDOUBLE i, j, width, height;
+	UDOUBLE width, height;
     width = (EPD_7IN5B_HD_WIDTH % 8 == 0)? (EPD_7IN5B_HD_WIDTH / 8 ): (EPD_7IN5B_HD_WIDTH / 8 + 1);
     height = EPD_7IN5B_HD_HEIGHT;
 	EPD_7IN5B_HD_ReadBusy();
@@ -172,11 +157,7 @@ void EPD_7IN5B_HD_ClearRed(void)
     EPD_7IN5B_HD_SendData(0xAf);
     EPD_7IN5B_HD_SendData(0x02);
 	EPD_7IN5B_HD_SendCommand(0x26);			//RED
-	for (j = 0; j < height; j++) {
-        for (i = 0; i < width; i++){
-			EPD_7IN5B_HD_SendData(0X00);
-		}
-	}
+	EPD_Common_SendDataRepeat(0X00, width * height);
 	EPD_7IN5B_HD_SendCommand(0x22);
 	EPD_7IN5B_HD_SendData(0xC7);
 	EPD_7IN5B_HD_SendCommand(0x20);
@@ -187,7 +168,7 @@ void EPD_7IN5B_HD_ClearRed(void)
 
 void EPD_7IN5B_HD_ClearBlack(void)
 {
-	UDOUBLE i, j, width, height;
+	UDOUBLE width, height;
     width = (EPD_7IN5B_HD_WIDTH % 8 == 0)? (EPD_7IN5B_HD_WIDTH / 8 ): (EPD_7IN5B_HD_WIDTH / 8 + 1);
     height = EPD_7IN5B_HD_HEIGHT;
 	//EPD_7IN5B_HD_ReadBusy();
@@ -195,11 +176,7 @@ void EPD_7IN5B_HD_ClearBlack(void)
     EPD_7IN5B_HD_SendData(0xAf);
     EPD_7IN5B_HD_SendData(0x02);
 	EPD_7IN5B_HD_SendCommand(0x24);			//BLOCK
-	for (j = 0; j < height; j++) {
-        for (i = 0; i < width; i++){
-			EPD_7IN5B_HD_SendData(0XFF);
-		}
-	}
+	EPD_Common_SendDataRepeat(0XFF, width * height);
 	EPD_7IN5B_HD_ReadBusy();
 }
 
@@ -209,7 +186,7 @@ parameter:
 ******************************************************************************/
 void EPD_7IN5B_HD_Display(const UBYTE *blackimage, const UBYTE *ryimage)
 {
-    UDOUBLE i, j, width, height;
+    UDOUBLE width, height;
     width = (EPD_7IN5B_HD_WIDTH % 8 == 0)? (EPD_7IN5B_HD_WIDTH / 8 ): (EPD_7IN5B_HD_WIDTH / 8 + 1);
     height = EPD_7IN5B_HD_HEIGHT;
 	
@@ -217,21 +194,13 @@ void EPD_7IN5B_HD_Display(const UBYTE *blackimage, const UBYTE *ryimage)
     EPD_7IN5B_HD_SendData(0xAf);
     EPD_7IN5B_HD_SendData(0x02);
 	EPD_7IN5B_HD_SendCommand(0x24);			//BLOCK
-	for (j = 0; j < height; j++) {
-        for (i = 0; i < width; i++){
-			EPD_7IN5B_HD_SendData(blackimage[i + j * width]);
-		}
-	}
+	EPD_Common_SendDataBuffer(blackimage, width * height);
 	// EPD_7IN5B_HD_ReadBusy();
 	// EPD_7IN5B_HD_SendCommand(0x4F); 
     // EPD_7IN5B_HD_SendData(0xAf);
     // EPD_7IN5B_HD_SendData(0x02);
 	EPD_7IN5B_HD_SendCommand(0x26);			//RED
-	for (j = 0; j < height; j++) {
-        for (i = 0; i < width; i++){
-			EPD_7IN5B_HD_SendData(~ryimage[i + j * width]);
-		}
-	}
+	EPD_Common_SendDataInvert(ryimage, width * height);
 	EPD_7IN5B_HD_SendCommand(0x22);
 	EPD_7IN5B_HD_SendData(0xC7);
 	EPD_7IN5B_HD_SendCommand(0x20);
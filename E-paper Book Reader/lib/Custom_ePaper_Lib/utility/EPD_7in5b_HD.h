@@ -2,6 +2,7 @@
 #define EPD7IN5B_HD_H
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_7IN5B_HD_WIDTH       880
@@ -15,7 +16,7 @@ void EPD_7IN5B_HD_ClearBlack(void);
 void EPD_7IN5B_HD_Display(const UBYTE *blackimage, const UBYTE *ryimage);
 void EPD_7IN5B_HD_Sleep(void);
 
-
+EPD_MODEL(EPD_7IN5B_HD, 2, 1);
 
 #endif /* EPD7IN5B_H */
 
@@ -28,6 +28,7 @@
 #
 ******************************************************************************/
 #include "EPD_7in5b_V2.h"
+#include "EPD_Common.h"
 #include "Debug.h"
 
 /******************************************************************************
@@ -36,6 +37,7 @@ parameter:
 ******************************************************************************/
 static void EPD_7IN5B_V2_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(200);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -51,10 +53,7 @@ parameter:
 ******************************************************************************/
 static void EPD_7IN5B_V2_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -64,10 +63,7 @@ parameter:
 ******************************************************************************/
 static void EPD_7IN5B_V2_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -77,12 +73,8 @@ parameter:
 void EPD_7IN5B_V2_WaitUntilIdle(void)
 {
     Debug("e-Paper busy\r\n");
-    unsigned char busy;
-	do	{
-		EPD_7IN5B_V2_SendCommand(0x71);
-		busy = DEV_Digital_Read(EPD_BUSY_PIN);
-		busy =!(busy & 0x01);        
-	}while(busy);
+	EPD_7IN5B_V2_SendCommand(0x71);
+	DEV_Wait_Busy(1, EPD_BUSY_TIMEOUT_MS);
 	DEV_Delay_ms(200);      
 		
 		
@@ -215,17 +207,10 @@ void EPD_7IN5B_V2_Clear(void)
     Width =(EPD_7IN5B_V2_WIDTH % 8 == 0)?(EPD_7IN5B_V2_WIDTH / 8 ):(EPD_7IN5B_V2_WIDTH / 8 + 1);
     Height = EPD_7IN5B_V2_HEIGHT;
 
-    UWORD i;
     EPD_7IN5B_V2_SendCommand(0x10);
-    for(i=0; i<Width*Height; i++) {
-        EPD_7IN5B_V2_SendData(0xff);
-
-    }
+    EPD_Common_SendDataRepeat(0xff, Width*Height);
     EPD_7IN5B_V2_SendCommand(0x13);
-    for(i=0; i<Width*Height; i++)	{
-        EPD_7IN5B_V2_SendData(0x00);
-
-    }
+    EPD_Common_SendDataRepeat(0x00, Width*Height);
     EPD_7IN5B_V2_TurnOnDisplay();
 }
 
@@ -235,17 +220,10 @@ void EPD_7IN5B_V2_ClearRed(void)
     Width =(EPD_7IN5B_V2_WIDTH % 8 == 0)?(EPD_7IN5B_V2_WIDTH / 8 ):(EPD_7IN5B_V2_WIDTH / 8 + 1);
     Height = EPD_7IN5B_V2_HEIGHT;
 
-    UWORD i;
     EPD_7IN5B_V2_SendCommand(0x10);
-    for(i=0; i<Width*Height; i++) {
-        EPD_7IN5B_V2_SendData(0xff);
-
-    }
+    EPD_Common_SendDataRepeat(0xff, Width*Height);
     EPD_7IN5B_V2_SendCommand(0x13);
-    for(i=0; i<Width*Height; i++)	{
-        EPD_7IN5B_V2_SendData(0xff);
-
-    }
+    EPD_Common_SendDataRepeat(0xff, Width*Height);
     EPD_7IN5B_V2_TurnOnDisplay();
 }
 
@@ -255,17 +233,10 @@ void EPD_7IN5B_V2_ClearBlack(void)
     Width =(EPD_7IN5B_V2_WIDTH % 8 == 0)?(EPD_7IN5B_V2_WIDTH / 8 ):(EPD_7IN5B_V2_WIDTH / 8 + 1);
     Height = EPD_7IN5B_V2_HEIGHT;
 
-    UWORD i;
     EPD_7IN5B_V2_SendCommand(0x10);
-    for(i=0; i<Width*Height; i++) {
-        EPD_7IN5B_V2_SendData(0x00);
-
-    }
+    EPD_Common_SendDataRepeat(0x00, Width*Height);
     EPD_7IN5B_V2_SendCommand(0x13);
-    for(i=0; i<Width*Height; i++)	{
-        EPD_7IN5B_V2_SendData(0x00);
-
-    }
+    EPD_Common_SendDataRepeat(0x00, Width*Height);
     EPD_7IN5B_V2_TurnOnDisplay();
 }
 
@@ -281,20 +252,33 @@ void EPD_7IN5B_V2_Display(const UBYTE *blackimage, const UBYTE *ryimage)
 
  //send black data
     EPD_7IN5B_V2_SendCommand(0x10);
-    for (UDOUBLE j = 0; j < Height; j++) {
-        for (UDOUBLE i = 0; i < Width; i++) {
-            EPD_7IN5B_V2_SendData(blackimage[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(blackimage, Width * Height);
     EPD_7IN5B_V2_SendCommand(0x92); 
 
     //send red data
     EPD_7IN5B_V2_SendCommand(0x13);
-    for (UDOUBLE j = 0; j < Height; j++) {
-        for (UDOUBLE i = 0; i < Width; i++) {
-            EPD_7IN5B_V2_SendData(~ryimage[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataInvert(ryimage, Width * Height);
+    EPD_7IN5B_V2_TurnOnDisplay();
+}
+
+/******************************************************************************
+function :	Sends a 3 color picture to e-Paper and displays
+parameter:
+    Image : the black plane then the red plane, drawn with
+            Paint_SetColorPlanes(Ctx, EPD_7IN5B_V2_COLOR)
+Info:
+    Same refresh as EPD_7IN5B_V2_Display(), both planes go out as they are.
+******************************************************************************/
+void EPD_7IN5B_V2_Display_Planes(const UBYTE *Image)
+{
+    UDOUBLE Plane = (UDOUBLE)EPD_7IN5B_V2_WIDTH / 8 * EPD_7IN5B_V2_HEIGHT;
+
+    EPD_7IN5B_V2_SendCommand(0x10);
+    EPD_Common_SendDataBuffer(Image, Plane);
+    EPD_7IN5B_V2_SendCommand(0x92);
+
+    EPD_7IN5B_V2_SendCommand(0x13);
+    EPD_Common_SendDataBuffer(Image + Plane, Plane);
     EPD_7IN5B_V2_TurnOnDisplay();
 }
 
@@ -305,17 +289,9 @@ void EPD_7IN5B_V2_Display_Base_color(UBYTE color)
     Height = EPD_7IN5B_V2_HEIGHT;
 
 	EPD_7IN5B_V2_SendCommand(0x10);   //Write Black and White image to RAM
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_7IN5B_V2_SendData(~color);
-        }
-    }
+    EPD_Common_SendDataRepeat(~color, Width * Height);
 	EPD_7IN5B_V2_SendCommand(0x13);   //Write Black and White image to RAM
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_7IN5B_V2_SendData(color);
-        }
-    }
+    EPD_Common_SendDataRepeat(color, Width * Height);
 	// EPD_7IN5B_V2_TurnOnDisplay();	
 }
 
@@ -347,18 +323,10 @@ void EPD_7IN5B_V2_Display_Partial(const UBYTE *Image, UWORD Xstart, UWORD Ystart
 	EPD_7IN5B_V2_SendData(0x01);		
 
     EPD_7IN5B_V2_SendCommand(0x10);   //Write Black and White image to RAM
-    for (UDOUBLE j = 0; j < Height; j++) {
-        for (UDOUBLE i = 0; i < Width; i++) {
-            EPD_7IN5B_V2_SendData(0xff);
-        }
-    }
+    EPD_Common_SendDataRepeat(0xff, Width * Height);
 
     EPD_7IN5B_V2_SendCommand(0x13);   //Write Black and White image to RAM
-    for (UDOUBLE j = 0; j < Height; j++) {
-        for (UDOUBLE i = 0; i < Width; i++) {
-            EPD_7IN5B_V2_SendData(Image[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(Image, Width * Height);
 	EPD_7IN5B_V2_TurnOnDisplay();
     EPD_7IN5B_V2_SendCommand(0x92);
 }
@@ -34,11 +34,14 @@
 #define _EPD_7IN5B_V2_H_
 
 #include "DEV_Config.h"
+#include "EPD_Common.h"
+#include "EPD_Model.h"
 
 
 // Display resolution
 #define EPD_7IN5B_V2_WIDTH       800
 #define EPD_7IN5B_V2_HEIGHT      480
+#define EPD_7IN5B_V2_COLOR       EPD_Color_RedHigh    //3 color planes, see Paint_SetColorPlanes()
 
 UBYTE EPD_7IN5B_V2_Init(void);
 UBYTE EPD_7IN5B_V2_Init_Fast(void);
@@ -47,9 +50,12 @@ void EPD_7IN5B_V2_Clear(void);
 void EPD_7IN5B_V2_ClearRed(void);
 void EPD_7IN5B_V2_ClearBlack(void);
 void EPD_7IN5B_V2_Display(const UBYTE *blackimage, const UBYTE *ryimage);
+void EPD_7IN5B_V2_Display_Planes(const UBYTE *Image);
 void EPD_7IN5B_V2_Display_Fast(const UBYTE *blackimage);
 void EPD_7IN5B_V2_Display_Base_color(UBYTE color);
 void EPD_7IN5B_V2_Display_Partial(const UBYTE *Image, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend);
 void EPD_7IN5B_V2_Sleep(void);
 
+EPD_MODEL(EPD_7IN5B_V2, 2, 1);
+
 #endif
@@ -28,6 +28,7 @@
 #
 ******************************************************************************/
 #include "EPD_7in5b_V2_old.h"
+#include "EPD_Common.h"
 #include "Debug.h"
 
 /******************************************************************************
@@ -36,6 +37,7 @@ parameter:
 ******************************************************************************/
 static void EPD_7IN5B_V2_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(200);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -51,10 +53,7 @@ parameter:
 ******************************************************************************/
 static void EPD_7IN5B_V2_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -64,10 +63,7 @@ parameter:
 ******************************************************************************/
 static void EPD_7IN5B_V2_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -77,12 +73,8 @@ parameter:
 static void EPD_7IN5B_V2_WaitUntilIdle(void)
 {
     Debug("e-Paper busy\r\n");
-    unsigned char busy;
-	do	{
-		EPD_7IN5B_V2_SendCommand(0x71);
-		busy = DEV_Digital_Read(EPD_BUSY_PIN);
-		busy =!(busy & 0x01);        
-	}while(busy);
+	EPD_7IN5B_V2_SendCommand(0x71);
+	DEV_Wait_Busy(1, EPD_BUSY_TIMEOUT_MS);
 	DEV_Delay_ms(200);      
 		
 		
@@ -164,17 +156,10 @@ void EPD_7IN5B_V2_Clear_old(void)
     Width =(EPD_7IN5B_V2_WIDTH_OLD % 8 == 0)?(EPD_7IN5B_V2_WIDTH_OLD / 8 ):(EPD_7IN5B_V2_WIDTH_OLD / 8 + 1);
     Height = EPD_7IN5B_V2_HEIGHT_OLD;
 
-    UWORD i;
     EPD_7IN5B_V2_SendCommand(0x10);
-    for(i=0; i<Width*Height; i++) {
-        EPD_7IN5B_V2_SendData(0xff);
-
-    }
+    EPD_Common_SendDataRepeat(0xff, Width*Height);
     EPD_7IN5B_V2_SendCommand(0x13);
-    for(i=0; i<Width*Height; i++)	{
-        EPD_7IN5B_V2_SendData(0x00);
-
-    }
+    EPD_Common_SendDataRepeat(0x00, Width*Height);
     EPD_7IN5B_V2_TurnOnDisplay();
 }
 
@@ -184,17 +169,10 @@ void EPD_7IN5B_V2_ClearRed_old(void)
     Width =(EPD_7IN5B_V2_WIDTH_OLD % 8 == 0)?(EPD_7IN5B_V2_WIDTH_OLD / 8 ):(EPD_7IN5B_V2_WIDTH_OLD / 8 + 1);
     Height = EPD_7IN5B_V2_HEIGHT_OLD;
 
-    UWORD i;
     EPD_7IN5B_V2_SendCommand(0x10);
-    for(i=0; i<Width*Height; i++) {
-        EPD_7IN5B_V2_SendData(0xff);
-
-    }
+    EPD_Common_SendDataRepeat(0xff, Width*Height);
     EPD_7IN5B_V2_SendCommand(0x13);
-    for(i=0; i<Width*Height; i++)	{
-        EPD_7IN5B_V2_SendData(0xff);
-
-    }
+    EPD_Common_SendDataRepeat(0xff, Width*Height);
     EPD_7IN5B_V2_TurnOnDisplay();
 }
 
@@ -204,17 +182,10 @@ void EPD_7IN5B_V2_ClearBlack_old(void)
     Width =(EPD_7IN5B_V2_WIDTH_OLD % 8 == 0)?(EPD_7IN5B_V2_WIDTH_OLD / 8 ):(EPD_7IN5B_V2_WIDTH_OLD / 8 + 1);
     Height = EPD_7IN5B_V2_HEIGHT_OLD;
 
-    UWORD i;
     EPD_7IN5B_V2_SendCommand(0x10);
-    for(i=0; i<Width*Height; i++) {
-        EPD_7IN5B_V2_SendData(0x00);
-
-    }
+    EPD_Common_SendDataRepeat(0x00, Width*Height);
     EPD_7IN5B_V2_SendCommand(0x13);
-    for(i=0; i<Width*Height; i++)	{
-        EPD_7IN5B_V2_SendData(0x00);
-
-    }
+    EPD_Common_SendDataRepeat(0x00, Width*Height);
     EPD_7IN5B_V2_TurnOnDisplay();
 }
 
@@ -230,20 +201,12 @@ void EPD_7IN5B_V2_Display_old(const UBYTE *blackimage, const UBYTE *ryimage)
 
  //send black data
     EPD_7IN5B_V2_SendCommand(0x10);
-    for (UDOUBLE j = 0; j < Height; j++) {
-        for (UDOUBLE i = 0; i < Width; i++) {
-            EPD_7IN5B_V2_SendData(blackimage[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataBuffer(blackimage, Width * Height);
     EPD_7IN5B_V2_SendCommand(0x92); 
 
     //send red data
     EPD_7IN5B_V2_SendCommand(0x13);
-    for (UDOUBLE j = 0; j < Height; j++) {
-        for (UDOUBLE i = 0; i < Width; i++) {
-            EPD_7IN5B_V2_SendData(~ryimage[i + j * Width]);
-        }
-    }
+    EPD_Common_SendDataInvert(ryimage, Width * Height);
     EPD_7IN5B_V2_TurnOnDisplay();
 }
 
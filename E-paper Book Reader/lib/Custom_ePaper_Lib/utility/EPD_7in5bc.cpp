@@ -83,6 +83,7 @@
 #
 ******************************************************************************/
 #include "EPD_7in5bc.h"
+#include "EPD_Common.h"
 #include "Debug.h"
 
 /******************************************************************************
@@ -91,6 +92,7 @@ parameter:
 ******************************************************************************/
 static void EPD_7IN5BC_Reset(void)
 {
+    EPD_State_Invalidate();
     DEV_Digital_Write(EPD_RST_PIN, 1);
     DEV_Delay_ms(200);
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -106,10 +108,7 @@ parameter:
 ******************************************************************************/
 static void EPD_7IN5BC_SendCommand(UBYTE Reg)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendCommand(Reg);
 }
 
 /******************************************************************************
@@ -119,10 +118,7 @@ parameter:
 ******************************************************************************/
 static void EPD_7IN5BC_SendData(UBYTE Data)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    EPD_Common_SendData(Data);
 }
 
 /******************************************************************************
@@ -131,13 +127,9 @@ parameter:
 ******************************************************************************/
 void EPD_7IN5BC_ReadBusy(void)
 {
-    UBYTE busy;
     Debug("e-Paper busy\r\n");
-    do {
-        EPD_7IN5BC_SendCommand(0x71);
-        busy = DEV_Digital_Read(EPD_BUSY_PIN);
-        busy =!(busy & 0x01);
-    } while(busy);
+    EPD_7IN5BC_SendCommand(0x71);
+    DEV_Wait_Busy(1, EPD_BUSY_TIMEOUT_MS);
     Debug("e-Paper busy release\r\n");
 }
 
@@ -211,13 +203,7 @@ void EPD_7IN5BC_Clear(void)
     Height = EPD_7IN5BC_HEIGHT;
 
     EPD_7IN5BC_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            for(UBYTE k = 0; k < 4; k++) {
-                EPD_7IN5BC_SendData(0x33);
-            }
-        }
-    }
+    EPD_Common_SendDataRepeat(0x33, 4 * Width * Height);
 
     EPD_7IN5BC_TurnOnDisplay();
 }
@@ -307,13 +293,7 @@ void EPD_7IN5BC_DisplayHalfScreen(const UBYTE *blackimage, const UBYTE *ryimage)
         }
     }
 		
-		for (j = 0; j < Height / 2; j++) {
-        for (i = 0; i < Width; i++) {
-           for(UBYTE k = 0; k < 4; k++) {
-                EPD_7IN5BC_SendData(Data);
-            } 
-        }
-    }
+		EPD_Common_SendDataRepeat(Data, 4 * Width * (Height / 2));
 
     EPD_7IN5BC_TurnOnDisplay();
 }
@@ -86,6 +86,7 @@
 #define __EPD_7IN5BC_H_
 
 #include "DEV_Config.h"
+#include "EPD_Model.h"
 
 // Display resolution
 #define EPD_7IN5BC_WIDTH       640
@@ -97,4 +98,6 @@ void EPD_7IN5BC_Display(const UBYTE *blackimage, const UBYTE *ryimage);
 void EPD_7IN5BC_DisplayHalfScreen(const UBYTE *blackimage, const UBYTE *ryimage);
 void EPD_7IN5BC_Sleep(void);
 
+EPD_MODEL(EPD_7IN5BC, 2, 1);
+
 #endif
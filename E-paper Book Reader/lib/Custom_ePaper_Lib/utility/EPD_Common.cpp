@@ -0,0 +1,401 @@
+/*****************************************************************************
+* | File      	:	EPD_Common.cpp
+* | Function    :   Command / data transport shared by all e-Paper drivers
+* | Info        :
+*----------------
+* |	This version:   V1.0
+* | Date        :   2026-10-17
+* | Info        :
+******************************************************************************/
+#include "EPD_Common.h"
+#include "Debug.h"
+#include <string.h>
+
+static EPD_STATE State;
+static UDOUBLE State_Timeouts = 0;    //DEV_BUSY_STAT.Timeouts when the state was set
+
+/******************************************************************************
+function :	send command
+parameter:
+     Reg : Command register
+Info:
+    If an asynchronous refresh is still running it is waited for first, the
+    controller ignores the bus while BUSY is asserted.
+******************************************************************************/
+void EPD_Common_SendCommand(UBYTE Reg)
+{
+    if(DEV_Busy_Pending())
+        DEV_Busy_Await();
+    DEV_Digital_Write(EPD_DC_PIN, 0);
+    DEV_Digital_Write(EPD_CS_PIN, 0);
+    DEV_SPI_WriteByte(Reg);
+    DEV_Digital_Write(EPD_CS_PIN, 1);
+}
+
+/******************************************************************************
+function :	send data
+parameter:
+    Data : Write data
+******************************************************************************/
+void EPD_Common_SendData(UBYTE Data)
+{
+    DEV_Digital_Write(EPD_DC_PIN, 1);
+    DEV_Digital_Write(EPD_CS_PIN, 0);
+    DEV_SPI_WriteByte(Data);
+    DEV_Digital_Write(EPD_CS_PIN, 1);
+}
+
+/******************************************************************************
+function :	send a block of data in one transaction
+parameter:
+    pData : Data to write, RAM or flash
+    Len   : Number of bytes
+******************************************************************************/
+void EPD_Common_SendDataBuffer(const UBYTE *pData, UDOUBLE Len)
+{
+    if(Len == 0)
+        return;
+    DEV_Digital_Write(EPD_DC_PIN, 1);
+    DEV_SPI_Write_nByte(pData, Len);
+}
+
+/******************************************************************************
+function :	send a block of data, every byte inverted
+parameter:
+    pData : Data to write, it is left untouched
+    Len   : Number of bytes
+******************************************************************************/
+void EPD_Common_SendDataInvert(const UBYTE *pData, UDOUBLE Len)
+{
+    UBYTE Chunk[EPD_COMMON_CHUNK];
+    DEV_Digital_Write(EPD_DC_PIN, 1);
+    while(Len > 0) {
+        UDOUBLE n = Len > EPD_COMMON_CHUNK ? EPD_COMMON_CHUNK : Len;
+        for(UDOUBLE i = 0; i < n; i++)
+            Chunk[i] = ~pData[i];
+        DEV_SPI_Write_nByte(Chunk, n);
+        pData += n;
+        Len -= n;
+    }
+}
+
+/******************************************************************************
+function :	send the same data byte Len times, e.g. to clear a plane
+parameter:
+    Data : Fill byte
+    Len  : Number of bytes
+******************************************************************************/
+void EPD_Common_SendDataRepeat(UBYTE Data, UDOUBLE Len)
+{
+    UBYTE Chunk[EPD_COMMON_CHUNK];
+    UDOUBLE n = Len > EPD_COMMON_CHUNK ? EPD_COMMON_CHUNK : Len;
+    for(UDOUBLE i = 0; i < n; i++)
+        Chunk[i] = Data;
+    DEV_Digital_Write(EPD_DC_PIN, 1);
+    while(Len > 0) {
+        n = Len > EPD_COMMON_CHUNK ? EPD_COMMON_CHUNK : Len;
+        DEV_SPI_Write_nByte(Chunk, n);
+        Len -= n;
+    }
+}
+
+//Plane bits of the 4 gray levels, bit 0: first plane sent, bit 1: second
+const UBYTE EPD_Gray_Invert[4] = {3, 2, 1, 0};
+const UBYTE EPD_Gray_Swap[4] = {0, 2, 1, 3};
+const UBYTE EPD_Gray_Direct[4] = {0, 1, 2, 3};
+
+//Plane bits of BLACK, COLOR_RED, unused (white), WHITE, bit 0: black plane, bit 1: red
+const UBYTE EPD_Color_RedHigh[4] = {0, 3, 1, 1};
+const UBYTE EPD_Color_RedLow[4] = {2, 1, 3, 3};
+
+/******************************************************************************
+function :	Table from a packed 4 gray byte to the bits of its 4 pixels in
+            one plane
+parameter:
+    Map   : plane bits of each gray level, e.g. EPD_Gray_Invert
+    Plane : 0 or 1
+    Lut   : 256 bytes, receives the bits in the low nibble, first pixel high
+******************************************************************************/
+void EPD_Common_GrayLut(const UBYTE *Map, UBYTE Plane, UBYTE *Lut)
+{
+    for(UWORD v = 0; v < 256; v++) {
+        UBYTE Bits = 0;
+        for(UBYTE k = 0; k < 4; k++)
+            Bits = (Bits << 1) | ((Map[(v >> (6 - 2 * k)) & 0x03] >> Plane) & 0x01);
+        Lut[v] = Bits;
+    }
+}
+
+/******************************************************************************
+function :	Convert packed 4 gray pixels, as Paint_SetScale(4) draws them,
+            to one plane of the controller
+parameter:
+    Image : packed pixels, 4 per byte, first pixel in the top bits
+    Len   : bytes of Image
+    Lut   : from EPD_Common_GrayLut()
+    Out   : receives (Len + 1) / 2 bytes
+Info:
+    Two table lookups per output byte instead of a branch per pixel. An odd
+    Len leaves the low nibble of the last byte clear.
+******************************************************************************/
+void EPD_Common_GrayPlane(const UBYTE *Image, UDOUBLE Len, const UBYTE *Lut, UBYTE *Out)
+{
+    UDOUBLE i;
+    for(i = 0; i + 1 < Len; i += 2)
+        *Out++ = (Lut[Image[i]] << 4) | Lut[Image[i + 1]];
+    if(i < Len)
+        *Out = Lut[Image[i]] << 4;
+}
+
+/******************************************************************************
+function :	send one plane of a packed 4 gray image
+parameter:
+    Image : packed pixels, 4 per byte
+    Len   : bytes of Image, even
+    Map   : plane bits of each gray level, e.g. EPD_Gray_Invert
+    Plane : 0 or 1
+Info:
+    For the legacy packed images. A picture drawn in planar gray, see
+    Paint_SetGrayPlanes(), goes out with EPD_Common_SendDataBuffer()
+    without any conversion.
+******************************************************************************/
+void EPD_Common_SendGrayPlane(const UBYTE *Image, UDOUBLE Len, const UBYTE *Map, UBYTE Plane)
+{
+    UBYTE Lut[256], Chunk[EPD_COMMON_CHUNK];
+    EPD_Common_GrayLut(Map, Plane, Lut);
+    DEV_Digital_Write(EPD_DC_PIN, 1);
+    while(Len > 0) {
+        UDOUBLE n = Len > 2 * EPD_COMMON_CHUNK ? 2 * EPD_COMMON_CHUNK : Len;
+        EPD_Common_GrayPlane(Image, n, Lut, Chunk);
+        DEV_SPI_Write_nByte(Chunk, (n + 1) / 2);
+        Image += n;
+        Len -= n;
+    }
+}
+
+/******************************************************************************
+function :	send a plane rendered band by band into a small buffer
+parameter:
+    Plane     : passed to Render
+    Line      : bytes per row
+    Height    : rows of the plane
+    Band      : band buffer
+    Band_Size : size of Band, at least one row
+    Render    : fills Band with the next rows
+    arg       : passed to Render
+    Invert    : send the bands inverted
+Info:
+    The plane goes out as one data stream, the caller sends the RAM write
+    command before. Only Band_Size bytes of RAM are needed instead of the
+    whole plane.
+    Band is split in two halves: while one is on the bus (DMA on the
+    hardware backend) the next rows are rendered into the other, so render
+    and transfer time overlap instead of adding up. With room for a single
+    row they take turns.
+******************************************************************************/
+void EPD_Common_SendBands(UBYTE Plane, UWORD Line, UWORD Height, UBYTE *Band, UDOUBLE Band_Size,
+                          EPD_BAND_RENDER Render, void *arg, UBYTE Invert)
+{
+    UDOUBLE Rows = Band_Size / Line, Len;
+    UBYTE *Half[2] = {Band, Band};
+    UBYTE Cur = 0;
+    UWORD n;
+
+    if(Rows == 0) {
+        Debug("EPD_Common_SendBands band smaller than a row\r\n");
+        return;
+    }
+    if(Rows >= 2) {
+        Rows /= 2;
+        Half[1] = Band + Rows * Line;
+    }
+    DEV_Digital_Write(EPD_DC_PIN, 1);
+    for(UWORD y = 0; y < Height; y += n) {
+        n = ((UDOUBLE)(Height - y) > Rows)? Rows : Height - y;
+        Len = (UDOUBLE)n * Line;
+        if(Half[0] == Half[1])
+            DEV_SPI_Write_Wait();   //the only buffer is still on the bus
+        Render(arg, Plane, y, n, Half[Cur]);
+        if(Invert) {
+            for(UDOUBLE i = 0; i < Len; i++)
+                Half[Cur][i] = ~Half[Cur][i];
+        }
+        DEV_SPI_Write_Wait();
+        DEV_SPI_Write_Start(Half[Cur], Len);
+        Cur ^= 1;
+    }
+    DEV_SPI_Write_Wait();
+}
+
+/******************************************************************************
+function :	Add bytes to the signature of a plane
+parameter:
+    Sum    : signature so far, EPD_SUM_INIT for the first bytes
+    pData  : bytes
+    Len    : Number of bytes
+    Invert : the bytes go out inverted
+******************************************************************************/
+UDOUBLE EPD_Common_Sum(UDOUBLE Sum, const UBYTE *pData, UDOUBLE Len, UBYTE Invert)
+{
+    UBYTE Mask = Invert? 0xFF : 0x00;
+    for(UDOUBLE i = 0; i < Len; i++)
+        Sum = (Sum ^ (UBYTE)(pData[i] ^ Mask)) * 16777619UL;
+    return Sum;
+}
+
+UDOUBLE EPD_Common_SumRepeat(UDOUBLE Sum, UBYTE Data, UDOUBLE Len)
+{
+    for(UDOUBLE i = 0; i < Len; i++)
+        Sum = (Sum ^ Data) * 16777619UL;
+    return Sum;
+}
+
+/******************************************************************************
+function :	Signature of a plane rendered band by band, nothing is sent
+parameter:
+    as EPD_Common_SendBands()
+Info:
+    Renders the whole plane once, for deciding whether it has to be sent.
+******************************************************************************/
+UDOUBLE EPD_Common_SumBands(UBYTE Plane, UWORD Line, UWORD Height, UBYTE *Band, UDOUBLE Band_Size,
+                            EPD_BAND_RENDER Render, void *arg, UBYTE Invert)
+{
+    UDOUBLE Rows = Band_Size / Line, Sum = EPD_SUM_INIT;
+    UWORD n;
+
+    if(Rows == 0)
+        return Sum;
+    for(UWORD y = 0; y < Height; y += n) {
+        n = ((UDOUBLE)(Height - y) > Rows)? Rows : Height - y;
+        Render(arg, Plane, y, n, Band);
+        Sum = EPD_Common_Sum(Sum, Band, (UDOUBLE)n * Line, Invert);
+    }
+    return Sum;
+}
+
+/******************************************************************************
+function :	Is the controller already initialized by this driver in this mode
+parameter:
+    Name : driver name, e.g. "EPD_4IN2"
+    Mode : driver specific init mode
+Info:
+    Returns 1 if the init can be skipped. A BUSY timeout since the state was
+    set means the controller can not be trusted, the state is dropped.
+******************************************************************************/
+UBYTE EPD_State_Check(const char *Name, UBYTE Mode)
+{
+    DEV_BUSY_STAT busy;
+    DEV_Busy_GetStat(&busy);
+    if(busy.Timeouts != State_Timeouts)
+        EPD_State_Invalidate();
+    if(State.Name == NULL || State.Mode != Mode || strcmp(State.Name, Name) != 0)
+        return 0;
+    State.Skipped_Init++;
+    return 1;
+}
+
+/******************************************************************************
+function :	Record a completed init
+parameter:
+    Name : driver name
+    Mode : driver specific init mode
+Info:
+    The LUT and window recorded during the init are kept.
+******************************************************************************/
+void EPD_State_Set(const char *Name, UBYTE Mode)
+{
+    DEV_BUSY_STAT busy;
+    DEV_Busy_GetStat(&busy);
+    State_Timeouts = busy.Timeouts;
+    State.Name = Name;
+    State.Mode = Mode;
+}
+
+/******************************************************************************
+function :	Is this LUT table already loaded
+parameter:
+    Lut : table about to be uploaded
+Info:
+    Returns 1 if the upload can be skipped, otherwise the table is recorded
+    as loaded and the caller sends it.
+******************************************************************************/
+UBYTE EPD_State_Lut(const void *Lut)
+{
+    if(Lut != NULL && State.Lut == Lut) {
+        State.Skipped_Lut++;
+        return 1;
+    }
+    State.Lut = Lut;
+    return 0;
+}
+
+/******************************************************************************
+function :	Is this RAM window already set
+parameter:
+    Xstart, Ystart, Xend, Yend : window as passed to the driver's SetWindows
+Info:
+    Returns 1 if the window commands can be skipped, otherwise the window is
+    recorded and the caller sends it. The RAM address counters move with
+    every write, the cursor always has to be set.
+******************************************************************************/
+UBYTE EPD_State_Window(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
+{
+    if(State.Window_Valid && State.Window[0] == Xstart && State.Window[1] == Ystart
+            && State.Window[2] == Xend && State.Window[3] == Yend) {
+        State.Skipped_Window++;
+        return 1;
+    }
+    State.Window[0] = Xstart;
+    State.Window[1] = Ystart;
+    State.Window[2] = Xend;
+    State.Window[3] = Yend;
+    State.Window_Valid = 1;
+    return 0;
+}
+
+/******************************************************************************
+function :	Does the RAM of a plane already hold these bytes
+parameter:
+    Cmd : RAM write command of the plane
+    Sum : EPD_Common_Sum() of the bytes about to be sent
+Info:
+    Returns 1 if the upload can be skipped, otherwise the content is
+    recorded and the caller sends it. For planes the controller keeps
+    across refreshes, e.g. the red plane of the 3 color panels. Only one
+    plane is tracked, a write to another one is not recorded. Nothing is
+    skipped after a BUSY timeout until the next init.
+******************************************************************************/
+UBYTE EPD_State_Plane(UBYTE Cmd, UDOUBLE Sum)
+{
+    DEV_BUSY_STAT busy;
+    DEV_Busy_GetStat(&busy);
+    if(busy.Timeouts != State_Timeouts)
+        EPD_State_Invalidate();
+    if(State.Name != NULL && State.Plane_Cmd == Cmd && State.Plane_Sum == Sum) {
+        State.Skipped_Plane++;
+        return 1;
+    }
+    State.Plane_Cmd = Cmd;
+    State.Plane_Sum = Sum;
+    return 0;
+}
+
+/******************************************************************************
+function :	Forget the controller state, the counters are kept
+Info:
+    Called on hardware reset and deep sleep. Call it too if the panel was
+    power cycled behind the driver's back.
+******************************************************************************/
+void EPD_State_Invalidate(void)
+{
+    State.Name = NULL;
+    State.Mode = 0;
+    State.Lut = NULL;
+    State.Window_Valid = 0;
+    State.Plane_Cmd = 0;
+}
+
+void EPD_State_Get(EPD_STATE *state)
+{
+    *state = State;
+}
@@ -0,0 +1,100 @@
+/*****************************************************************************
+* | File      	:	EPD_Common.h
+* | Function    :   Command / data transport shared by all e-Paper drivers
+* | Info        :
+*   Every driver talks to its controller the same way: DC low for a command
+*   byte, DC high for its parameters and RAM data. The bulk calls below send
+*   a whole row or plane under one CS assertion through DEV_SPI_Write_nByte,
+*   so frame upload is bounded by the SPI clock and not by GPIO toggling.
+*----------------
+* |	This version:   V1.0
+* | Date        :   2026-10-17
+* | Info        :
+******************************************************************************/
+#ifndef _EPD_COMMON_H_
+#define _EPD_COMMON_H_
+
+#include "DEV_Config.h"
+
+//Size of the stack buffer used for generated data (repeat / invert)
+#define EPD_COMMON_CHUNK 512
+
+void EPD_Common_SendCommand(UBYTE Reg);
+void EPD_Common_SendData(UBYTE Data);
+void EPD_Common_SendDataBuffer(const UBYTE *pData, UDOUBLE Len);
+void EPD_Common_SendDataInvert(const UBYTE *pData, UDOUBLE Len);
+void EPD_Common_SendDataRepeat(UBYTE Data, UDOUBLE Len);
+
+/**
+ * 4 gray levels as two bit planes. Map[v] holds the bits pixel value v
+ * (0..3, as Paint_SetScale(4) packs it) takes in the plane sent first
+ * (bit 0) and the one sent second (bit 1). The controllers differ:
+ *   EPD_Gray_Invert : both bits inverted, 7.5" V2, 4.26", 13.3"K, 2.9" V2, 2.7" V2
+ *   EPD_Gray_Swap   : high bit first, 4.2", 2.7"
+ *   EPD_Gray_Direct : low bit first, 3.7", 4.2" V2
+**/
+extern const UBYTE EPD_Gray_Invert[4];
+extern const UBYTE EPD_Gray_Swap[4];
+extern const UBYTE EPD_Gray_Direct[4];
+
+/**
+ * White, black and red as two bit planes. Map[c] holds the bits color c
+ * (Color % 4 of WHITE, BLACK and COLOR_RED) takes in the black plane (bit 0)
+ * and the red plane (bit 1), as the controller reads them:
+ *   EPD_Color_RedHigh : red plane 1 = red, 5.83" B V2, 7.5" B V2, 4.2" B V2
+ *   EPD_Color_RedLow  : red plane 0 = red, 2.13" B V3 / V4, 2.9" B V3
+**/
+extern const UBYTE EPD_Color_RedHigh[4];
+extern const UBYTE EPD_Color_RedLow[4];
+
+void EPD_Common_GrayLut(const UBYTE *Map, UBYTE Plane, UBYTE *Lut);
+void EPD_Common_GrayPlane(const UBYTE *Image, UDOUBLE Len, const UBYTE *Lut, UBYTE *Out);
+void EPD_Common_SendGrayPlane(const UBYTE *Image, UDOUBLE Len, const UBYTE *Map, UBYTE Plane);
+
+/**
+ * Renders rows Ystart .. Ystart + Rows - 1 of a plane into Band, e.g.
+ * Paint_RenderBand() of GUI_Paint
+**/
+typedef void (*EPD_BAND_RENDER)(void *arg, UBYTE Plane, UWORD Ystart, UWORD Rows, UBYTE *Band);
+
+void EPD_Common_SendBands(UBYTE Plane, UWORD Line, UWORD Height, UBYTE *Band, UDOUBLE Band_Size,
+                          EPD_BAND_RENDER Render, void *arg, UBYTE Invert);
+
+/**
+ * Signature of the bytes of a plane as they go on the bus, FNV-1a. Start
+ * from EPD_SUM_INIT, the same bytes give the same sum however they are cut.
+**/
+#define EPD_SUM_INIT 2166136261UL
+
+UDOUBLE EPD_Common_Sum(UDOUBLE Sum, const UBYTE *pData, UDOUBLE Len, UBYTE Invert);
+UDOUBLE EPD_Common_SumRepeat(UDOUBLE Sum, UBYTE Data, UDOUBLE Len);
+UDOUBLE EPD_Common_SumBands(UBYTE Plane, UWORD Line, UWORD Height, UBYTE *Band, UDOUBLE Band_Size,
+                            EPD_BAND_RENDER Render, void *arg, UBYTE Invert);
+
+/**
+ * Controller state as last set by a driver. A hardware reset, deep sleep or
+ * a BUSY timeout forgets it, then the next init runs in full.
+**/
+typedef struct {
+    const char *Name;       //driver that initialized the controller, NULL: unknown
+    UBYTE Mode;             //driver specific init mode
+    const void *Lut;        //LUT table last uploaded, NULL: OTP / unknown
+    UBYTE Window_Valid;
+    UWORD Window[4];        //RAM window: Xstart, Ystart, Xend, Yend
+    UBYTE Plane_Cmd;        //RAM write command of the plane whose content is known, 0: none
+    UDOUBLE Plane_Sum;      //EPD_Common_Sum() of that content
+    UDOUBLE Skipped_Init;
+    UDOUBLE Skipped_Lut;
+    UDOUBLE Skipped_Window;
+    UDOUBLE Skipped_Plane;
+} EPD_STATE;
+
+UBYTE EPD_State_Check(const char *Name, UBYTE Mode);
+void EPD_State_Set(const char *Name, UBYTE Mode);
+UBYTE EPD_State_Lut(const void *Lut);
+UBYTE EPD_State_Window(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend);
+UBYTE EPD_State_Plane(UBYTE Cmd, UDOUBLE Sum);
+void EPD_State_Invalidate(void);
+void EPD_State_Get(EPD_STATE *state);
+
+#endif
@@ -0,0 +1,63 @@
+/*****************************************************************************
+* | File      	:	EPD_Model.h
+* | Function    :   Compile-time panel models
+* | Info        :
+*   Each panel header ends with EPD_MODEL(prefix, planes, bits), which
+*   declares a model struct carrying the resolution, the number of image
+*   planes and the bits per pixel as constants, plus Init / Clear / Display /
+*   Sleep forwarding to the driver. Panel<Model> derives the byte geometry at
+*   compile time, so buffers can be sized statically:
+*
+*       typedef Panel<EPD_5IN83B_V2_Model> EPD_Reader;
+*       static UBYTE BlackImage[EPD_Reader::PlaneSize];
+*       EPD_Reader::Init();
+*       EPD_Reader::Display(BlackImage, RYImage);
+*
+*   Swapping the panel is then a matter of changing the typedef and the
+*   EPD_PANEL_HEADER build flag, see EPD.h.
+*----------------
+* |	This version:   V1.0
+* | Date        :   2026-10-17
+* | Info        :
+******************************************************************************/
+#ifndef _EPD_MODEL_H_
+#define _EPD_MODEL_H_
+
+#include "DEV_Config.h"
+
+/**
+ * Declares <prefix>_Model from <prefix>_WIDTH / <prefix>_HEIGHT and the
+ * <prefix>_Init / _Clear / _Display / _Sleep functions. The forwarders take
+ * whatever the driver takes, e.g. EPD_2IN13_V2_Init(Mode), and are only
+ * instantiated when they are called.
+**/
+#define EPD_MODEL(_prefix, _planes, _bits) \
+struct _prefix##_Model { \
+    static constexpr UWORD Width = _prefix##_WIDTH; \
+    static constexpr UWORD Height = _prefix##_HEIGHT; \
+    static constexpr UBYTE Planes = _planes; \
+    static constexpr UBYTE Bits = _bits; \
+    template<class... A> static auto Init(A... a) -> decltype(_prefix##_Init(a...)) \
+        { return _prefix##_Init(a...); } \
+    template<class... A> static void Clear(A... a) { _prefix##_Clear(a...); } \
+    template<class... A> static void Display(A... a) { _prefix##_Display(a...); } \
+    template<class... A> static void Sleep(A... a) { _prefix##_Sleep(a...); } \
+}
+
+/**
+ * Byte geometry of a model, all compile-time constants
+**/
+template<class Model>
+struct Panel : Model {
+    static_assert(Model::Width > 0 && Model::Height > 0, "panel without resolution");
+    static_assert(Model::Planes == 1 || Model::Planes == 2, "1 or 2 image planes");
+    static_assert(Model::Bits == 1 || Model::Bits == 2 || Model::Bits == 4, "1, 2 or 4 bits per pixel");
+
+    static constexpr UWORD Line = ((UDOUBLE)Model::Width * Model::Bits + 7) / 8;    //bytes per row
+    static constexpr UDOUBLE PlaneSize = (UDOUBLE)Line * Model::Height;
+    static constexpr UDOUBLE BufferSize = PlaneSize * Model::Planes;
+
+    typedef UBYTE PlaneBuffer[PlaneSize];
+};
+
+#endif
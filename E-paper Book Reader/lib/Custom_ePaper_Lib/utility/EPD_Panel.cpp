@@ -0,0 +1,310 @@
+/*****************************************************************************
+* | File      	:	EPD_Panel.cpp
+* | Function    :   Generic e-Paper driver driven by panel descriptors
+* | Info        :
+*----------------
+* |	This version:   V1.0
+* | Date        :   2026-10-17
+* | Info        :
+******************************************************************************/
+#include "EPD_Panel.h"
+#include "EPD_Common.h"
+#include "Debug.h"
+
+/******************************************************************************
+function :	Wait until the panel releases BUSY
+parameter:
+    Panel : panel descriptor
+******************************************************************************/
+void EPD_Panel_WaitBusy(const EPD_PANEL *Panel)
+{
+    Debug("e-Paper busy\r\n");
+    if(Panel->Busy_Cmd != 0)
+        EPD_Common_SendCommand(Panel->Busy_Cmd);
+    DEV_Wait_Busy(Panel->Busy_Idle, EPD_BUSY_TIMEOUT_MS);
+    if(Panel->Busy_Settle_ms != 0)
+        DEV_Delay_ms(Panel->Busy_Settle_ms);
+    Debug("e-Paper busy release\r\n");
+}
+
+/******************************************************************************
+function :	Set the SSD16xx RAM window to the whole panel
+parameter:
+    Panel : panel descriptor
+    Dir   : EPD_RAM_YINC or EPD_RAM_YDEC
+Info:
+    Skipped when a driver already set the same window, see
+    EPD_State_Window().
+******************************************************************************/
+static void EPD_Panel_Window(const EPD_PANEL *Panel, UBYTE Dir)
+{
+    UWORD Yfirst = (Dir == EPD_RAM_YDEC)? Panel->Height - 1 : 0;
+    UWORD Ylast = Panel->Height - 1 - Yfirst;
+    if(EPD_State_Window(0, Yfirst, Panel->Width - 1, Ylast))
+        return;
+    UBYTE X[2] = {0x00, (UBYTE)((Panel->Width - 1) >> 3)};
+    UBYTE Y[4] = {(UBYTE)Yfirst, (UBYTE)(Yfirst >> 8), (UBYTE)Ylast, (UBYTE)(Ylast >> 8)};
+    EPD_Common_SendCommand(0x44);   //SET_RAM_X_ADDRESS_START_END_POSITION
+    EPD_Common_SendDataBuffer(X, 2);
+    EPD_Common_SendCommand(0x45);   //SET_RAM_Y_ADDRESS_START_END_POSITION
+    EPD_Common_SendDataBuffer(Y, 4);
+}
+
+/******************************************************************************
+function :	Set the SSD16xx RAM address counter to the first pixel
+parameter:
+    Panel : panel descriptor
+    Dir   : EPD_RAM_YINC or EPD_RAM_YDEC
+******************************************************************************/
+static void EPD_Panel_Cursor(const EPD_PANEL *Panel, UBYTE Dir)
+{
+    UWORD Yfirst = (Dir == EPD_RAM_YDEC)? Panel->Height - 1 : 0;
+    UBYTE Y[2] = {(UBYTE)Yfirst, (UBYTE)(Yfirst >> 8)};
+    EPD_Common_SendCommand(0x4E);   //SET_RAM_X_ADDRESS_COUNTER
+    EPD_Common_SendData(0x00);
+    EPD_Common_SendCommand(0x4F);   //SET_RAM_Y_ADDRESS_COUNTER
+    EPD_Common_SendDataBuffer(Y, 2);
+}
+
+/******************************************************************************
+function :	Run a script up to EPD_END, or up to its last EPD_BUSY
+parameter:
+    Panel  : panel descriptor
+    Script : byte table, see EPD_Panel.h
+    Async  : stop before a final EPD_BUSY and return 1 if there was one
+******************************************************************************/
+static UBYTE EPD_Panel_Run(const EPD_PANEL *Panel, const UBYTE *Script, UBYTE Async)
+{
+    if(Script == NULL)
+        return 0;
+    while(*Script != EPD_OP_END) {
+        UBYTE op = *Script++;
+        if(op < EPD_OP_DELAY) {
+            EPD_Common_SendCommand(Script[0]);
+            if(op == 1)
+                EPD_Common_SendData(Script[1]);
+            else if(op > 1)
+                EPD_Common_SendDataBuffer(Script + 1, op);
+            Script += 1 + op;
+        } else if(op == EPD_OP_DELAY) {
+            DEV_Delay_ms(((UWORD)Script[0] << 8) | Script[1]);
+            Script += 2;
+        } else if(op == EPD_OP_BUSY) {
+            if(Async && *Script == EPD_OP_END)
+                return 1;
+            EPD_Panel_WaitBusy(Panel);
+        } else if(op == EPD_OP_RST_HIGH) {
+            DEV_Digital_Write(EPD_RST_PIN, 1);
+        } else if(op == EPD_OP_RST_LOW) {
+            EPD_State_Invalidate();
+            DEV_Digital_Write(EPD_RST_PIN, 0);
+        } else if(op == EPD_OP_LUT) {
+            EPD_Common_SendCommand(Script[0]);
+            if(Script[1] == 0)
+                EPD_State_Lut(Panel->Lut);  //the table now in the controller
+            EPD_Common_SendDataBuffer(Panel->Lut + Script[1], Script[2]);
+            Script += 3;
+        } else if(op == EPD_OP_WINDOW) {
+            EPD_Panel_Window(Panel, *Script++);
+        } else if(op == EPD_OP_CURSOR) {
+            EPD_Panel_Cursor(Panel, *Script++);
+        } else {
+            Debug("EPD_Panel: bad script op\r\n");
+            return 0;
+        }
+    }
+    return 0;
+}
+
+void EPD_Panel_RunScript(const EPD_PANEL *Panel, const UBYTE *Script)
+{
+    EPD_Panel_Run(Panel, Script, 0);
+}
+
+/******************************************************************************
+function :	Reset and initialize the e-Paper register
+parameter:
+    Panel : panel descriptor
+Info:
+    Skipped if the controller is still initialized for this panel, e.g. on
+    every page turn after the first. Sleep or a BUSY timeout clears that.
+******************************************************************************/
+UBYTE EPD_Panel_Init(const EPD_PANEL *Panel)
+{
+    if(EPD_State_Check(Panel->Name, 0))
+        return 0;
+    EPD_Panel_RunScript(Panel, Panel->Init);
+    EPD_State_Set(Panel->Name, 0);
+    return 0;
+}
+
+/******************************************************************************
+function :	Write every plane, from an image or its fill byte
+parameter:
+    Panel  : panel descriptor
+    Image0 : first image, NULL to send the fill bytes (Clear)
+    Image1 : second image, NULL to send the fill bytes
+    Native : the images are in controller polarity, Invert is not applied
+    Stop   : send Plane_Stop after each plane
+    Clear  : also write the EPD_PLANE_CLEAR planes
+Info:
+    A Keep plane is skipped when the controller already holds the same
+    bytes, e.g. the blank red plane of a text page. Checking costs a pass
+    over the plane, a fraction of sending it.
+******************************************************************************/
+static void EPD_Panel_SendPlanes(const EPD_PANEL *Panel, const UBYTE *Image0, const UBYTE *Image1,
+                                 UBYTE Native, UBYTE Stop, UBYTE Clear)
+{
+    UDOUBLE Len = EPD_PANEL_PLANE_SIZE(Panel);
+    for(UBYTE i = 0; i < Panel->Planes; i++) {
+        const EPD_PLANE *Plane = &Panel->Plane[i];
+        const UBYTE *Image = NULL;
+        UBYTE Invert = Plane->Invert && !Native;
+        if(Plane->Source == EPD_PLANE_CLEAR && !Clear)
+            continue;
+        if(Plane->Source == EPD_PLANE_IMAGE0)
+            Image = Image0;
+        else if(Plane->Source == EPD_PLANE_IMAGE1)
+            Image = Image1;
+
+        if(Plane->Keep) {
+            UDOUBLE Sum = (Image == NULL)? EPD_Common_SumRepeat(EPD_SUM_INIT, Plane->Clear, Len)
+                                         : EPD_Common_Sum(EPD_SUM_INIT, Image, Len, Invert);
+            if(EPD_State_Plane(Plane->Cmd, Sum))
+                continue;
+        }
+        EPD_Common_SendCommand(Plane->Cmd);
+        if(Image == NULL)
+            EPD_Common_SendDataRepeat(Plane->Clear, Len);
+        else if(Invert)
+            EPD_Common_SendDataInvert(Image, Len);
+        else
+            EPD_Common_SendDataBuffer(Image, Len);
+        if(Stop && Panel->Plane_Stop != 0)
+            EPD_Common_SendCommand(Panel->Plane_Stop);
+    }
+}
+
+/******************************************************************************
+function :	Clear screen
+parameter:
+    Panel : panel descriptor
+******************************************************************************/
+void EPD_Panel_Clear(const EPD_PANEL *Panel)
+{
+    EPD_Panel_SendPlanes(Panel, NULL, NULL, 0, Panel->Plane_Stop_Clear, 1);
+    EPD_Panel_RunScript(Panel, Panel->Refresh);
+}
+
+/******************************************************************************
+function :	Sends the image buffers to e-Paper and displays
+parameter:
+    Panel  : panel descriptor
+    Image0 : black plane
+    Image1 : red / yellow plane, ignored on single plane panels
+Info:
+    A NULL image sends the fill byte of its plane, e.g. to leave the red
+    plane empty.
+******************************************************************************/
+void EPD_Panel_Display(const EPD_PANEL *Panel, const UBYTE *Image0, const UBYTE *Image1)
+{
+    EPD_Panel_SendPlanes(Panel, Image0, Image1, 0, 1, 0);
+    EPD_Panel_RunScript(Panel, Panel->Refresh);
+}
+
+/******************************************************************************
+function :	Sends a 3 color picture to e-Paper and displays
+parameter:
+    Panel : panel descriptor
+    Image : the black plane then the red / yellow plane, each
+            EPD_PANEL_PLANE_SIZE bytes, drawn with Paint_SetColorPlanes()
+Info:
+    The planes are already in the polarity of the controller and go out as
+    they are, Invert of the descriptor is not applied.
+******************************************************************************/
+void EPD_Panel_Display_Planes(const EPD_PANEL *Panel, const UBYTE *Image)
+{
+    EPD_Panel_SendPlanes(Panel, Image, Image + EPD_PANEL_PLANE_SIZE(Panel), 1, 1, 0);
+    EPD_Panel_RunScript(Panel, Panel->Refresh);
+}
+
+/******************************************************************************
+function :	Sends the image buffers to e-Paper and starts the refresh without
+            waiting for it
+parameter:
+    Panel    : panel descriptor
+    Image0   : black plane
+    Image1   : red / yellow plane
+    callback : called from DEV_Busy_Poll()/DEV_Busy_Await() when the
+               refresh is done, may be NULL
+    arg      : passed to callback
+Info:
+    The final EPD_BUSY of the refresh script is armed with DEV_Busy_Async()
+    instead of waited for. The settle delay of the panel is skipped, the
+    next command goes out once DEV_Busy_Await() returns.
+******************************************************************************/
+void EPD_Panel_Display_Async(const EPD_PANEL *Panel, const UBYTE *Image0, const UBYTE *Image1,
+                             DEV_BUSY_CALLBACK callback, void *arg)
+{
+    EPD_Panel_SendPlanes(Panel, Image0, Image1, 0, 1, 0);
+    if(EPD_Panel_Run(Panel, Panel->Refresh, 1)) {
+        if(Panel->Busy_Cmd != 0)
+            EPD_Common_SendCommand(Panel->Busy_Cmd);
+        DEV_Busy_Async(Panel->Busy_Idle, EPD_BUSY_TIMEOUT_MS, callback, arg);
+    } else if(callback != NULL) {
+        callback(arg, 0);
+    }
+}
+
+/******************************************************************************
+function :	Renders the planes band by band while sending them and displays
+parameter:
+    Panel     : panel descriptor
+    Band      : band buffer, a fraction of a plane
+    Band_Size : size of Band, at least one row
+    Render    : fills a band of a plane, Plane is 0 for the black plane
+                and 1 for the red / yellow one, e.g. Paint_RenderBand
+    arg       : passed to Render
+Info:
+    Same bytes on the bus as EPD_Panel_Display(), but no plane is ever held
+    in RAM. A plane without an image source sends its fill byte. A Keep
+    plane is rendered once to check it against the controller RAM and once
+    more only if it has to be sent.
+******************************************************************************/
+void EPD_Panel_Display_Bands(const EPD_PANEL *Panel, UBYTE *Band, UDOUBLE Band_Size,
+                             EPD_BAND_RENDER Render, void *arg)
+{
+    for(UBYTE i = 0; i < Panel->Planes; i++) {
+        const EPD_PLANE *Plane = &Panel->Plane[i];
+        if(Plane->Source == EPD_PLANE_CLEAR)
+            continue;
+        if(Plane->Keep) {
+            UDOUBLE Sum = (Plane->Source == EPD_PLANE_FILL)
+                ? EPD_Common_SumRepeat(EPD_SUM_INIT, Plane->Clear, EPD_PANEL_PLANE_SIZE(Panel))
+                : EPD_Common_SumBands(Plane->Source, EPD_PANEL_LINE(Panel), Panel->Height,
+                                      Band, Band_Size, Render, arg, Plane->Invert);
+            if(EPD_State_Plane(Plane->Cmd, Sum))
+                continue;
+        }
+        EPD_Common_SendCommand(Plane->Cmd);
+        if(Plane->Source == EPD_PLANE_FILL)
+            EPD_Common_SendDataRepeat(Plane->Clear, EPD_PANEL_PLANE_SIZE(Panel));
+        else
+            EPD_Common_SendBands(Plane->Source, EPD_PANEL_LINE(Panel), Panel->Height,
+                                 Band, Band_Size, Render, arg, Plane->Invert);
+        if(Panel->Plane_Stop != 0)
+            EPD_Common_SendCommand(Panel->Plane_Stop);
+    }
+    EPD_Panel_RunScript(Panel, Panel->Refresh);
+}
+
+/******************************************************************************
+function :	Enter sleep mode
+parameter:
+    Panel : panel descriptor
+******************************************************************************/
+void EPD_Panel_Sleep(const EPD_PANEL *Panel)
+{
+    EPD_Panel_RunScript(Panel, Panel->Sleep);
+    EPD_State_Invalidate();
+}
@@ -0,0 +1,120 @@
+/*****************************************************************************
+* | File      	:	EPD_Panel.h
+* | Function    :   Generic e-Paper driver driven by panel descriptors
+* | Info        :
+*   Most panels only differ in their init byte sequence, the RAM write
+*   commands of their planes, the BUSY polarity and the resolution. A panel
+*   is described by a constant EPD_PANEL and the engine below does the
+*   reset / init / upload / refresh / sleep for all of them, so transport and
+*   BUSY handling live in one place.
+*
+*   Scripts are byte tables: a command with its data, or one of the EPD_OP_
+*   operations, terminated by EPD_END, e.g.
+*       EPD_RESET(200, 5, 200),
+*       EPD_CMD(0x01, 4), 0x07, 0x07, 0x3f, 0x3f,
+*       EPD_CMD(0x04, 0), EPD_DELAY(100), EPD_BUSY,
+*       EPD_END
+*   Waveform tables too long for EPD_CMD are sent from EPD_PANEL.Lut with
+*   EPD_LUT, and the SSD16xx RAM window and address counter of the whole
+*   panel with EPD_WINDOW and EPD_CURSOR, e.g.
+*       EPD_CMD(0x11, 1), 0x03, EPD_WINDOW(EPD_RAM_YINC), EPD_CURSOR(EPD_RAM_YINC),
+*       EPD_LUT(0x32, 0, 153), EPD_BUSY, EPD_LUT(0x3F, 153, 1),
+*----------------
+* |	This version:   V1.0
+* | Date        :   2026-10-17
+* | Info        :
+******************************************************************************/
+#ifndef _EPD_PANEL_H_
+#define _EPD_PANEL_H_
+
+#include "DEV_Config.h"
+#include "EPD_Common.h"
+
+/**
+ * Script encoding
+**/
+#define EPD_OP_DELAY    0x40    //followed by ms, 16 bit big endian
+#define EPD_OP_BUSY     0x41    //wait for BUSY, see EPD_PANEL.Busy_xxx
+#define EPD_OP_RST_HIGH 0x42
+#define EPD_OP_RST_LOW  0x43
+#define EPD_OP_LUT      0x44    //followed by command, offset and length in EPD_PANEL.Lut
+#define EPD_OP_WINDOW   0x45    //followed by EPD_RAM_xxx, 0x44 / 0x45 of the whole panel
+#define EPD_OP_CURSOR   0x46    //followed by EPD_RAM_xxx, 0x4E / 0x4F of the first pixel
+#define EPD_OP_END      0xFF
+
+#define EPD_CMD(_cmd, _n)   (_n), (_cmd)    //_n < 0x40 data bytes follow
+#define EPD_DELAY(_ms)      EPD_OP_DELAY, (UBYTE)((_ms) >> 8), (UBYTE)(_ms)
+#define EPD_BUSY            EPD_OP_BUSY
+#define EPD_RESET(_t1, _t2, _t3) \
+    EPD_OP_RST_HIGH, EPD_DELAY(_t1), EPD_OP_RST_LOW, EPD_DELAY(_t2), EPD_OP_RST_HIGH, EPD_DELAY(_t3)
+#define EPD_LUT(_cmd, _off, _n) EPD_OP_LUT, (_cmd), (_off), (_n)  //_off, _n < 256
+#define EPD_WINDOW(_dir)    EPD_OP_WINDOW, (_dir)
+#define EPD_CURSOR(_dir)    EPD_OP_CURSOR, (_dir)
+#define EPD_END             EPD_OP_END
+
+/**
+ * Y direction of the RAM address, as set by the data entry mode (0x11)
+**/
+#define EPD_RAM_YINC    0       //0x03: first row at Y 0
+#define EPD_RAM_YDEC    1       //0x01: first row at Y Height - 1
+
+/**
+ * Plane source
+**/
+#define EPD_PLANE_IMAGE0 0      //first image passed to EPD_Panel_Display
+#define EPD_PLANE_IMAGE1 1      //second image, the red/yellow plane
+#define EPD_PLANE_FILL   2      //no image, Clear byte on every Display
+#define EPD_PLANE_CLEAR  3      //no image, Clear byte on Clear only, skipped by Display
+
+typedef struct {
+    UBYTE Cmd;          //RAM write command
+    UBYTE Source;       //EPD_PLANE_xxx
+    UBYTE Invert;       //send the image inverted
+    UBYTE Clear;        //fill byte for Clear and EPD_PLANE_FILL
+    UBYTE Keep;         //RAM kept across refreshes, sent only when it changed, see EPD_State_Plane()
+} EPD_PLANE;
+
+/**
+ * Capabilities, for the application to pick a render path
+**/
+#define EPD_CAP_RED     0x0001  //second colour plane
+#define EPD_CAP_PARTIAL 0x0002
+#define EPD_CAP_FAST    0x0004
+#define EPD_CAP_4GRAY   0x0008
+
+typedef struct {
+    const char *Name;
+    UWORD Width;
+    UWORD Height;
+    UBYTE Planes;
+    EPD_PLANE Plane[2];
+    UBYTE Plane_Stop;       //command after each plane, 0: none (0x92 DATA STOP)
+    UBYTE Plane_Stop_Clear; //Plane_Stop also after the fill bytes of Clear
+    UBYTE Busy_Idle;        //BUSY level when idle, 1 on UC81xx, 0 on SSD16xx
+    UBYTE Busy_Cmd;         //command before each wait, 0: none (0x71 GET STATUS)
+    UWORD Busy_Settle_ms;   //delay after BUSY released
+    const UBYTE *Init;
+    const UBYTE *Refresh;   //starts the refresh, ends with EPD_BUSY
+    const UBYTE *Sleep;
+    UWORD Caps;
+    const UBYTE *PowerOff;  //drop the panel voltages, registers kept, NULL: not supported
+    const UBYTE *PowerOn;   //undo PowerOff
+    const UBYTE *Lut;       //waveform table of EPD_LUT, NULL: none
+} EPD_PANEL;
+
+#define EPD_PANEL_LINE(_panel) (((_panel)->Width + 7) / 8)
+#define EPD_PANEL_PLANE_SIZE(_panel) ((UDOUBLE)EPD_PANEL_LINE(_panel) * (_panel)->Height)
+
+void EPD_Panel_RunScript(const EPD_PANEL *Panel, const UBYTE *Script);
+void EPD_Panel_WaitBusy(const EPD_PANEL *Panel);
+UBYTE EPD_Panel_Init(const EPD_PANEL *Panel);
+void EPD_Panel_Clear(const EPD_PANEL *Panel);
+void EPD_Panel_Display(const EPD_PANEL *Panel, const UBYTE *Image0, const UBYTE *Image1);
+void EPD_Panel_Display_Planes(const EPD_PANEL *Panel, const UBYTE *Image);
+void EPD_Panel_Display_Async(const EPD_PANEL *Panel, const UBYTE *Image0, const UBYTE *Image1,
+                             DEV_BUSY_CALLBACK callback, void *arg);
+void EPD_Panel_Display_Bands(const EPD_PANEL *Panel, UBYTE *Band, UDOUBLE Band_Size,
+                             EPD_BAND_RENDER Render, void *arg);
+void EPD_Panel_Sleep(const EPD_PANEL *Panel);
+
+#endif
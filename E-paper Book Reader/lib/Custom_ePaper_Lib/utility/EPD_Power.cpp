@@ -0,0 +1,152 @@
+/*****************************************************************************
+* | File      	:	EPD_Power.cpp
+* | Function    :   Idle driven power states for a descriptor panel
+* | Info        :
+*----------------
+* |	This version:   V1.0
+* | Date        :   2026-10-17
+* | Info        :
+******************************************************************************/
+#include "EPD_Power.h"
+#include "EPD_Common.h"
+#include "Debug.h"
+#include <string.h>
+
+static const EPD_PANEL *Power_Panel = NULL;
+static EPD_POWER_STATE Power_State = EPD_POWER_SLEEP;
+static UDOUBLE Power_Off_ms = EPD_POWER_OFF_MS;
+static UDOUBLE Power_Sleep_ms = EPD_POWER_SLEEP_MS;
+static UDOUBLE Power_Last_Use = 0;
+static EPD_POWER_STAT Power_Stat[EPD_POWER_TRANSITIONS];
+
+static void EPD_Power_Account(EPD_POWER_TRANSITION transition, UDOUBLE start)
+{
+    EPD_POWER_STAT *stat = &Power_Stat[transition];
+    UDOUBLE ms = DEV_Millis() - start;
+    stat->Count++;
+    stat->Last_ms = ms;
+    stat->Total_ms += ms;
+    if(ms > stat->Max_ms)
+        stat->Max_ms = ms;
+}
+
+/******************************************************************************
+function :	Take over the power states of a panel
+parameter:
+    Panel       : panel descriptor
+    PowerOff_ms : idle time before STANDBY, 0: no STANDBY
+    Sleep_ms    : idle time before SLEEP, 0: never sleeps
+Info:
+    The panel state is unknown at this point, the first EPD_Power_Wake()
+    runs the full init. Panels without PowerOff / PowerOn scripts skip
+    STANDBY and stay AWAKE until Sleep_ms.
+******************************************************************************/
+void EPD_Power_Begin(const EPD_PANEL *Panel, UDOUBLE PowerOff_ms, UDOUBLE Sleep_ms)
+{
+    Power_Panel = Panel;
+    Power_State = EPD_POWER_SLEEP;
+    Power_Off_ms = PowerOff_ms;
+    Power_Sleep_ms = Sleep_ms;
+    Power_Last_Use = DEV_Millis();
+}
+
+/******************************************************************************
+function :	Make the panel ready for an update
+parameter:
+Info:
+    From SLEEP this is a reset + init, from STANDBY only the power on
+    sequence, AWAKE costs nothing. Restarts the idle timer; call it before
+    every update.
+******************************************************************************/
+void EPD_Power_Wake(void)
+{
+    UDOUBLE start = DEV_Millis();
+    if(Power_Panel == NULL)
+        return;
+
+    if(Power_State == EPD_POWER_SLEEP) {
+        Debug("e-Paper wake\r\n");
+        EPD_State_Invalidate();
+        EPD_Panel_Init(Power_Panel);
+        EPD_Power_Account(EPD_POWER_INIT, start);
+    } else if(Power_State == EPD_POWER_STANDBY) {
+        Debug("e-Paper power on\r\n");
+        EPD_Panel_RunScript(Power_Panel, Power_Panel->PowerOn);
+        EPD_State_Set(Power_Panel->Name, 0);
+        EPD_Power_Account(EPD_POWER_ON, start);
+    }
+    Power_State = EPD_POWER_AWAKE;
+    Power_Last_Use = DEV_Millis();
+}
+
+/******************************************************************************
+function :	Apply the idle timeouts, call it from the main loop
+parameter:
+Info:
+    An asynchronous refresh still running counts as use. Returns the state
+    after the check.
+******************************************************************************/
+EPD_POWER_STATE EPD_Power_Poll(void)
+{
+    UDOUBLE idle, start;
+    if(Power_Panel == NULL || Power_State == EPD_POWER_SLEEP)
+        return Power_State;
+    if(DEV_Busy_Pending() && !DEV_Busy_Poll()) {
+        Power_Last_Use = DEV_Millis();
+        return Power_State;
+    }
+
+    idle = DEV_Millis() - Power_Last_Use;
+    if(Power_Sleep_ms != 0 && idle >= Power_Sleep_ms) {
+        EPD_Power_Sleep();
+    } else if(Power_State == EPD_POWER_AWAKE && Power_Off_ms != 0 && idle >= Power_Off_ms
+              && Power_Panel->PowerOff != NULL && Power_Panel->PowerOn != NULL) {
+        Debug("e-Paper power off\r\n");
+        start = DEV_Millis();
+        EPD_Panel_RunScript(Power_Panel, Power_Panel->PowerOff);
+        EPD_State_Invalidate();    //no skipped init on a powered down panel
+        Power_State = EPD_POWER_STANDBY;
+        EPD_Power_Account(EPD_POWER_OFF, start);
+    }
+    return Power_State;
+}
+
+/******************************************************************************
+function :	Deep sleep now, e.g. before the MCU itself sleeps
+parameter:
+******************************************************************************/
+void EPD_Power_Sleep(void)
+{
+    UDOUBLE start = DEV_Millis();
+    if(Power_Panel == NULL || Power_State == EPD_POWER_SLEEP)
+        return;
+    Debug("e-Paper deep sleep\r\n");
+    EPD_Panel_Sleep(Power_Panel);
+    Power_State = EPD_POWER_SLEEP;
+    EPD_Power_Account(EPD_POWER_DEEP_SLEEP, start);
+}
+
+EPD_POWER_STATE EPD_Power_GetState(void)
+{
+    return Power_State;
+}
+
+/******************************************************************************
+function :	Latency of one kind of transition
+parameter:
+    transition : EPD_POWER_INIT, EPD_POWER_ON, EPD_POWER_OFF or
+                 EPD_POWER_DEEP_SLEEP
+    stat       : receives count, last, max and total time in ms
+******************************************************************************/
+void EPD_Power_GetStat(EPD_POWER_TRANSITION transition, EPD_POWER_STAT *stat)
+{
+    if(transition < EPD_POWER_TRANSITIONS)
+        *stat = Power_Stat[transition];
+    else
+        memset(stat, 0, sizeof(EPD_POWER_STAT));
+}
+
+void EPD_Power_ClearStat(void)
+{
+    memset(Power_Stat, 0, sizeof(Power_Stat));
+}
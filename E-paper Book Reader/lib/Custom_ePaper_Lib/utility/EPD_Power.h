@@ -0,0 +1,67 @@
+/*****************************************************************************
+* | File      	:	EPD_Power.h
+* | Function    :   Idle driven power states for a descriptor panel
+* | Info        :
+*   A burst of page turns should not pay reset + init every time, and a panel
+*   left powered for hours wears and drains the battery. The manager keeps
+*   the panel AWAKE while it is used, drops the panel voltages (STANDBY)
+*   after PowerOff_ms without an update and deep-sleeps it (SLEEP) after
+*   Sleep_ms. EPD_Power_Wake() brings it back from whichever state it is in:
+*       EPD_Power_Begin(&EPD_5IN83B_V2_Panel, 10000, 120000);
+*       EPD_Power_Wake();
+*       EPD_Panel_Display(&EPD_5IN83B_V2_Panel, BlackImage, RYImage);
+*       ...
+*       loop: EPD_Power_Poll();
+*----------------
+* |	This version:   V1.0
+* | Date        :   2026-10-17
+* | Info        :
+******************************************************************************/
+#ifndef _EPD_POWER_H_
+#define _EPD_POWER_H_
+
+#include "EPD_Panel.h"
+
+#ifndef EPD_POWER_OFF_MS
+#define EPD_POWER_OFF_MS    10000   //idle time before STANDBY
+#endif
+#ifndef EPD_POWER_SLEEP_MS
+#define EPD_POWER_SLEEP_MS  120000  //idle time before SLEEP
+#endif
+
+/**
+ * Power states
+**/
+typedef enum {
+    EPD_POWER_SLEEP = 0,    //deep sleep or unknown, needs reset + init
+    EPD_POWER_STANDBY,      //registers kept, voltages off
+    EPD_POWER_AWAKE,        //ready for an update
+} EPD_POWER_STATE;
+
+/**
+ * Transitions, for the latency statistics
+**/
+typedef enum {
+    EPD_POWER_INIT = 0,     //SLEEP   -> AWAKE
+    EPD_POWER_ON,           //STANDBY -> AWAKE
+    EPD_POWER_OFF,          //AWAKE   -> STANDBY
+    EPD_POWER_DEEP_SLEEP,   //AWAKE / STANDBY -> SLEEP
+    EPD_POWER_TRANSITIONS,
+} EPD_POWER_TRANSITION;
+
+typedef struct {
+    UDOUBLE Count;
+    UDOUBLE Last_ms;
+    UDOUBLE Max_ms;
+    UDOUBLE Total_ms;
+} EPD_POWER_STAT;
+
+void EPD_Power_Begin(const EPD_PANEL *Panel, UDOUBLE PowerOff_ms, UDOUBLE Sleep_ms);
+void EPD_Power_Wake(void);
+EPD_POWER_STATE EPD_Power_Poll(void);
+void EPD_Power_Sleep(void);
+EPD_POWER_STATE EPD_Power_GetState(void);
+void EPD_Power_GetStat(EPD_POWER_TRANSITION transition, EPD_POWER_STAT *stat);
+void EPD_Power_ClearStat(void);
+
+#endif
@@ -0,0 +1,257 @@
+/*****************************************************************************
+* | File      	:	EPD_Shadow.cpp
+* | Function    :   Keep the frame on the panel and refresh only what changed
+* | Info        :
+*----------------
+* |	This version:   V1.0
+* | Date        :   2026-10-17
+* | Info        :
+******************************************************************************/
+#include "EPD_Shadow.h"
+#include "Debug.h"
+#include <string.h>
+
+#define SHADOW_LINE(_shadow) (((_shadow)->Width + 7) / 8)
+
+/******************************************************************************
+function :	First byte of a row that differs, Len if none
+parameter:
+Info:
+    Compares a word at a time, unchanged rows are the common case.
+******************************************************************************/
+static UWORD Shadow_First(const UBYTE *New, const UBYTE *Old, UWORD Len)
+{
+    UWORD i = 0;
+    UDOUBLE a, b;
+    for(; i + 4 <= Len; i += 4) {
+        memcpy(&a, New + i, 4);
+        memcpy(&b, Old + i, 4);
+        if(a != b)
+            break;
+    }
+    while(i < Len && New[i] == Old[i])
+        i++;
+    return i;
+}
+
+/******************************************************************************
+function :	Byte after the last one of a row that differs
+parameter:
+    First : first byte that differs
+******************************************************************************/
+static UWORD Shadow_End(const UBYTE *New, const UBYTE *Old, UWORD Len, UWORD First)
+{
+    UWORD i = Len;
+    UDOUBLE a, b;
+    for(; i >= First + 4; i -= 4) {
+        memcpy(&a, New + i - 4, 4);
+        memcpy(&b, Old + i - 4, 4);
+        if(a != b)
+            break;
+    }
+    while(i > First && New[i - 1] == Old[i - 1])
+        i--;
+    return i;
+}
+
+static UDOUBLE Shadow_Bus_us(const EPD_SHADOW *Shadow, UDOUBLE Bytes)
+{
+    return (UDOUBLE)((uint64_t)Bytes * 8 * 1000000 / Shadow->Cost.SPI_Hz);
+}
+
+//Rect in bytes
+static UDOUBLE Shadow_Window_Cost(const EPD_SHADOW *Shadow, const EPD_SHADOW_RECT *Rect)
+{
+    UDOUBLE Bytes = (UDOUBLE)(Rect->Xend - Rect->Xstart) * (Rect->Yend - Rect->Ystart);
+    return Shadow_Bus_us(Shadow, Bytes + Shadow->Cost.Window_Bytes) + Shadow->Cost.Part_ms * 1000;
+}
+
+static void Shadow_Union(EPD_SHADOW_RECT *Rect, const EPD_SHADOW_RECT *Other)
+{
+    if(Other->Xstart < Rect->Xstart) Rect->Xstart = Other->Xstart;
+    if(Other->Ystart < Rect->Ystart) Rect->Ystart = Other->Ystart;
+    if(Other->Xend > Rect->Xend) Rect->Xend = Other->Xend;
+    if(Other->Yend > Rect->Yend) Rect->Yend = Other->Yend;
+}
+
+/******************************************************************************
+function :	Set up a shadow for a panel
+parameter:
+    Width  : panel width in pixels
+    Height : panel height in pixels
+    Last   : buffer for the frame on the panel, (Width + 7) / 8 * Height bytes
+    Full   : full refresh, e.g. EPD_7IN5_V2_Display, must leave the frame as it is
+    Part   : partial update of a window of the full frame, NULL: none
+Info:
+    The panel content is unknown, the first EPD_Shadow_Display() is full.
+    Shadow->Cost starts from the EPD_SHADOW_ defaults and the SPI clock,
+    adjust it to the measured waveform times of the panel.
+******************************************************************************/
+void EPD_Shadow_Init(EPD_SHADOW *Shadow, UWORD Width, UWORD Height, UBYTE *Last,
+                     EPD_SHADOW_DISPLAY Full, EPD_SHADOW_WINDOW Part)
+{
+    memset(Shadow, 0, sizeof(EPD_SHADOW));
+    Shadow->Width = Width;
+    Shadow->Height = Height;
+    Shadow->Last = Last;
+    Shadow->Full = Full;
+    Shadow->Part = Part;
+    Shadow->Cost.SPI_Hz = EPD_SPI_CLOCK_HZ;
+    Shadow->Cost.Full_ms = EPD_SHADOW_FULL_MS;
+    Shadow->Cost.Part_ms = EPD_SHADOW_PART_MS;
+    Shadow->Cost.Window_Bytes = EPD_SHADOW_WINDOW_BYTES;
+    Shadow->Cost.Full_Planes = 1;
+}
+
+/******************************************************************************
+function :	Forget the panel content, e.g. after a Clear or a reset
+parameter:
+******************************************************************************/
+void EPD_Shadow_Invalidate(EPD_SHADOW *Shadow)
+{
+    Shadow->Valid = 0;
+}
+
+/******************************************************************************
+function :	Windows that changed between the panel and a new frame
+parameter:
+    Image : new frame
+    Rect  : receives up to Max windows, top to bottom
+    Max   : size of Rect
+Info:
+    Runs of changed rows form bands as wide as their widest change. Adjacent
+    bands are merged while one window costs less than two, then until at
+    most Max are left. Returns the number of windows, 0: nothing changed.
+******************************************************************************/
+UBYTE EPD_Shadow_Diff(const EPD_SHADOW *Shadow, const UBYTE *Image, EPD_SHADOW_RECT *Rect, UBYTE Max)
+{
+    EPD_SHADOW_RECT Band[EPD_SHADOW_BANDS];
+    UWORD Line = SHADOW_LINE(Shadow);
+    UBYTE Count = 0, Open = 0;
+    UWORD y, First, End;
+    UBYTE i, Best;
+    long Gain, Best_Gain;
+
+    if(Max == 0)
+        return 0;
+    for(y = 0; y < Shadow->Height; y++) {
+        const UBYTE *New = Image + (UDOUBLE)y * Line;
+        const UBYTE *Old = Shadow->Last + (UDOUBLE)y * Line;
+        First = Shadow_First(New, Old, Line);
+        if(First == Line) {
+            Open = 0;
+            continue;
+        }
+        End = Shadow_End(New, Old, Line, First);
+        EPD_SHADOW_RECT Row = {First, y, End, (UWORD)(y + 1)};
+        if(Open || Count == EPD_SHADOW_BANDS) {
+            Shadow_Union(&Band[Count - 1], &Row);    //out of bands: the gap goes with it
+        } else {
+            Band[Count++] = Row;
+        }
+        Open = 1;
+    }
+
+    while(Count > 1) {
+        Best = 0;
+        Best_Gain = 0;
+        for(i = 0; i + 1 < Count; i++) {
+            EPD_SHADOW_RECT Merged = Band[i];
+            Shadow_Union(&Merged, &Band[i + 1]);
+            Gain = (long)(Shadow_Window_Cost(Shadow, &Band[i]) + Shadow_Window_Cost(Shadow, &Band[i + 1]))
+                 - (long)Shadow_Window_Cost(Shadow, &Merged);
+            if(i == 0 || Gain > Best_Gain) {
+                Best = i;
+                Best_Gain = Gain;
+            }
+        }
+        if(Count <= Max && Best_Gain <= 0)
+            break;
+        Shadow_Union(&Band[Best], &Band[Best + 1]);
+        Count--;
+        for(i = Best + 1; i < Count; i++)
+            Band[i] = Band[i + 1];
+    }
+
+    for(i = 0; i < Count; i++) {
+        Rect[i] = Band[i];
+        Rect[i].Xstart *= 8;
+        Rect[i].Xend *= 8;
+    }
+    return Count;
+}
+
+/******************************************************************************
+function :	Cost in us of updating windows partially, or of a full refresh
+parameter:
+    Rect  : windows from EPD_Shadow_Diff()
+    Count : number of windows
+Info:
+    Bus time of the data and the window setup plus the waveform. Each
+    partial update runs its own waveform.
+******************************************************************************/
+UDOUBLE EPD_Shadow_PartCost(const EPD_SHADOW *Shadow, const EPD_SHADOW_RECT *Rect, UBYTE Count)
+{
+    UDOUBLE Cost = 0;
+    for(UBYTE i = 0; i < Count; i++) {
+        EPD_SHADOW_RECT Bytes = Rect[i];
+        Bytes.Xstart /= 8;
+        Bytes.Xend /= 8;
+        Cost += Shadow_Window_Cost(Shadow, &Bytes);
+    }
+    return Cost;
+}
+
+UDOUBLE EPD_Shadow_FullCost(const EPD_SHADOW *Shadow)
+{
+    UDOUBLE Bytes = (UDOUBLE)SHADOW_LINE(Shadow) * Shadow->Height * Shadow->Cost.Full_Planes;
+    return Shadow_Bus_us(Shadow, Bytes) + Shadow->Cost.Full_ms * 1000;
+}
+
+/******************************************************************************
+function :	Show a frame, sending only what changed
+parameter:
+    Image : new frame, same size as the panel
+Info:
+    Full refresh when the panel content is unknown, there is no partial
+    update, Full_Every partial updates ran in a row or the cost model says
+    so. Otherwise one partial update per changed window. The shadow copy is
+    taken from Image, before it is sent.
+******************************************************************************/
+EPD_SHADOW_UPDATE EPD_Shadow_Display(EPD_SHADOW *Shadow, const UBYTE *Image)
+{
+    EPD_SHADOW_RECT Rect[EPD_SHADOW_MAX];
+    UWORD Line = SHADOW_LINE(Shadow);
+    UBYTE Count = 0;
+
+    if(Shadow->Valid && Shadow->Part != NULL
+       && (Shadow->Full_Every == 0 || Shadow->Part_Run < Shadow->Full_Every)) {
+        Count = EPD_Shadow_Diff(Shadow, Image, Rect, EPD_SHADOW_MAX);
+        if(Count == 0) {
+            Shadow->None_Count++;
+            return EPD_SHADOW_NONE;
+        }
+        if(EPD_Shadow_PartCost(Shadow, Rect, Count) < EPD_Shadow_FullCost(Shadow)) {
+            Debug("e-Paper partial update\r\n");
+            for(UBYTE i = 0; i < Count; i++) {
+                UWORD Xstart = Rect[i].Xstart / 8, Xend = Rect[i].Xend / 8;
+                for(UWORD y = Rect[i].Ystart; y < Rect[i].Yend; y++)
+                    memcpy(Shadow->Last + (UDOUBLE)y * Line + Xstart, Image + (UDOUBLE)y * Line + Xstart, Xend - Xstart);
+                Shadow->Part(Image, Rect[i].Xstart, Rect[i].Ystart, Rect[i].Xend, Rect[i].Yend);
+                Shadow->Bytes_Sent += (UDOUBLE)(Xend - Xstart) * (Rect[i].Yend - Rect[i].Ystart);
+            }
+            Shadow->Part_Run++;
+            Shadow->Part_Count++;
+            return EPD_SHADOW_PART;
+        }
+    }
+
+    Debug("e-Paper full refresh\r\n");
+    memcpy(Shadow->Last, Image, (UDOUBLE)Line * Shadow->Height);
+    Shadow->Full(Image);
+    Shadow->Bytes_Sent += (UDOUBLE)Line * Shadow->Height * Shadow->Cost.Full_Planes;
+    Shadow->Valid = 1;
+    Shadow->Part_Run = 0;
+    Shadow->Full_Count++;
+    return EPD_SHADOW_FULL;
+}
@@ -0,0 +1,99 @@
+/*****************************************************************************
+* | File      	:	EPD_Shadow.h
+* | Function    :   Keep the frame on the panel and refresh only what changed
+* | Info        :
+*   Menus and status bars change a few rows of a frame, yet re-sending it
+*   costs the whole plane and a full waveform. The shadow keeps a copy of
+*   the frame last sent, diffs the next one against it and either sends the
+*   changed windows through the panel's partial update or, when that would
+*   cost more, does a full refresh:
+*       static UBYTE Last[EPD_7IN5_V2_WIDTH / 8 * EPD_7IN5_V2_HEIGHT];
+*       EPD_SHADOW Shadow;
+*       EPD_Shadow_Init(&Shadow, EPD_7IN5_V2_WIDTH, EPD_7IN5_V2_HEIGHT, Last,
+*                       EPD_7IN5_V2_Display, Reader_Part);
+*       ...
+*       EPD_Shadow_Display(&Shadow, Image);
+*   The partial callback gets the full frame and a window in pixels, x
+*   aligned to 8, ends exclusive, e.g. EPD_7IN5_V2_Display_Part_Frame().
+*   Both callbacks only read the frame, the caller keeps drawing on it.
+*----------------
+* |	This version:   V1.0
+* | Date        :   2026-10-17
+* | Info        :
+******************************************************************************/
+#ifndef _EPD_SHADOW_H_
+#define _EPD_SHADOW_H_
+
+#include "DEV_Config.h"
+
+#ifndef EPD_SHADOW_FULL_MS
+#define EPD_SHADOW_FULL_MS      3000    //full refresh waveform
+#endif
+#ifndef EPD_SHADOW_PART_MS
+#define EPD_SHADOW_PART_MS      500     //partial refresh waveform, per window
+#endif
+#ifndef EPD_SHADOW_WINDOW_BYTES
+#define EPD_SHADOW_WINDOW_BYTES 16      //commands and window setup of one partial update
+#endif
+#define EPD_SHADOW_MAX          4       //windows per update
+#define EPD_SHADOW_BANDS        32      //row bands the diff tracks before merging
+
+typedef void (*EPD_SHADOW_DISPLAY)(const UBYTE *Image);
+typedef void (*EPD_SHADOW_WINDOW)(const UBYTE *Image, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend);
+
+/**
+ * Changed window, pixels, x aligned to 8, ends exclusive
+**/
+typedef struct {
+    UWORD Xstart;
+    UWORD Ystart;
+    UWORD Xend;
+    UWORD Yend;
+} EPD_SHADOW_RECT;
+
+/**
+ * Cost of an update in us: bytes on the bus plus the waveform
+**/
+typedef struct {
+    UDOUBLE SPI_Hz;
+    UDOUBLE Full_ms;
+    UDOUBLE Part_ms;
+    UWORD Window_Bytes;
+    UBYTE Full_Planes;      //planes a full refresh sends, 2 with old + new data
+} EPD_SHADOW_COST;
+
+/**
+ * Result of EPD_Shadow_Display
+**/
+typedef enum {
+    EPD_SHADOW_NONE = 0,    //frame unchanged, nothing sent
+    EPD_SHADOW_PART,
+    EPD_SHADOW_FULL,
+} EPD_SHADOW_UPDATE;
+
+typedef struct {
+    UWORD Width;
+    UWORD Height;
+    UBYTE *Last;            //frame on the panel, (Width + 7) / 8 * Height bytes
+    UBYTE Valid;            //0: panel content unknown, next update is full
+    EPD_SHADOW_DISPLAY Full;
+    EPD_SHADOW_WINDOW Part; //NULL: always full
+    EPD_SHADOW_COST Cost;
+    UWORD Full_Every;       //partial updates before a full one clears the ghosting, 0: never
+    UWORD Part_Run;         //partial updates since the last full one
+
+    UDOUBLE Full_Count;
+    UDOUBLE Part_Count;
+    UDOUBLE None_Count;
+    UDOUBLE Bytes_Sent;
+} EPD_SHADOW;
+
+void EPD_Shadow_Init(EPD_SHADOW *Shadow, UWORD Width, UWORD Height, UBYTE *Last,
+                     EPD_SHADOW_DISPLAY Full, EPD_SHADOW_WINDOW Part);
+void EPD_Shadow_Invalidate(EPD_SHADOW *Shadow);
+UBYTE EPD_Shadow_Diff(const EPD_SHADOW *Shadow, const UBYTE *Image, EPD_SHADOW_RECT *Rect, UBYTE Max);
+UDOUBLE EPD_Shadow_PartCost(const EPD_SHADOW *Shadow, const EPD_SHADOW_RECT *Rect, UBYTE Count);
+UDOUBLE EPD_Shadow_FullCost(const EPD_SHADOW *Shadow);
+EPD_SHADOW_UPDATE EPD_Shadow_Display(EPD_SHADOW *Shadow, const UBYTE *Image);
+
+#endif
@@ -0,0 +1,416 @@
+/*****************************************************************************
+* | File      	:   bench.cpp
+* | Function    :   Host benchmark on the simulated panel
+* | Info        :
+*   pio run -e native && .pio/build/native/program [dump | check]
+*   Prints the bus traffic and simulated time of every driver step, and the
+*   CPU time of the drawing routines. "dump" also writes the recorded
+*   command stream of the last step. "check" only runs the stream checks
+*   of check.cpp and exits non-zero if one fails.
+*----------------
+* |	This version:   V1.0
+* | Date        :   2026-10-17
+* | Info        :
+******************************************************************************/
+#include "DEV_Config.h"
+#include "DEV_Host.h"
+#include "EPD.h"
+#include "EPD_Common.h"
+#include "EPD_Panel.h"
+#include "EPD_Power.h"
+#include "GUI_Dither.h"
+#include "GUI_Paint.h"
+#include "GUI_Palette.h"
+#include "GUI_Text.h"
+#include "check.h"
+#include <string.h>
+#include <time.h>
+
+typedef Panel<EPD_5IN83B_V2_Model> Bench_Panel;
+
+#define BENCH_WIDTH  Bench_Panel::Width
+#define BENCH_HEIGHT Bench_Panel::Height
+#define BENCH_RUNS   20
+
+static Bench_Panel::PlaneBuffer BlackImage;
+static Bench_Panel::PlaneBuffer RYImage;
+
+static double Now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+#define BENCH_DRIVER(_name, _call) do { \
+    DEV_Host_Reset(); \
+    _call; \
+    DEV_Host_PrintStat(_name); \
+} while(0)
+
+static const EPD_PANEL *Bench_Panels[] = {
+    &EPD_5IN83B_V2_Panel,
+    &EPD_5IN83_V2_Panel,
+    &EPD_2IN9B_V3_Panel,
+    &EPD_2IN13B_V3_Panel,
+    &EPD_2IN13B_V4_Panel,
+    &EPD_2IN9BC_Panel,
+    &EPD_1IN54C_Panel,
+    &EPD_1IN54B_V2_Panel,
+    &EPD_2IN13BC_Panel,
+    &EPD_4IN2BC_Panel,
+    &EPD_2IN66B_Panel,
+    &EPD_2IN7B_V2_Panel,
+    &EPD_2IN7B_Panel,
+    &EPD_1IN54_V2_Panel,
+    &EPD_2IN13_V2_Panel,
+    &EPD_2in13_V3_Panel,
+    &EPD_2in13_V4_Panel,
+    &EPD_2IN7_V2_Panel,
+    &EPD_2IN9_V2_Panel,
+    &EPD_4IN2_V2_Panel,
+    &EPD_7IN5_V2_Panel,
+};
+
+#define BENCH_PAINT(_name, _call) do { \
+    double t0 = Now_us(); \
+    for(int r = 0; r < BENCH_RUNS; r++) { _call; } \
+    printf("%-28s %10.1f us\r\n", _name, (Now_us() - t0) / BENCH_RUNS); \
+} while(0)
+
+static void Bench_Part(const UBYTE *Image, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
+{
+    EPD_7IN5_V2_Display_Part_Frame(Image, Xstart, Ystart, Xend, Yend);
+}
+
+static void Bench_Menu_Item(UWORD Item, UBYTE Selected)
+{
+    static const char *Items[8] = {"Continue reading", "Library", "Bookmarks", "Table of contents",
+                                   "Font size", "Margins", "Wi-Fi", "Settings"};
+    UWORD Y = 60 + Item * 40;
+    Paint_ClearWindows(40, Y, 400, Y + 32, Selected ? BLACK : WHITE);
+    Paint_DrawString_EN(48, Y + 8, Items[Item], &Font16, Selected ? WHITE : BLACK, Selected ? BLACK : WHITE);
+}
+
+//a cover image as it would come out of a decoder, a row at a time
+static void Bench_Cover_Row(void *arg, UWORD Y, UBYTE *Row)
+{
+    UWORD Width = *(UWORD *)arg;
+    for(UWORD x = 0; x < Width; x++)
+        Row[x] = (UBYTE)((x * 255 / Width + Y) / 2 + ((x ^ Y) & 0x3F));
+}
+
+//the same cover in color
+static void Bench_Color_Row(void *arg, UWORD Y, UBYTE *Row)
+{
+    UWORD Width = *(UWORD *)arg;
+    for(UWORD x = 0; x < Width; x++) {
+        Row[x * 3] = (UBYTE)(x * 255 / Width);
+        Row[x * 3 + 1] = (UBYTE)(Y / 2 + ((x ^ Y) & 0x3F));
+        Row[x * 3 + 2] = (UBYTE)(255 - Y / 2);
+    }
+}
+
+//the conversion EPD_7IN5_V2_Display_4Gray() does on the fly, both planes
+static void Bench_Gray_Split(const UBYTE *Image)
+{
+    static UBYTE Planes[EPD_7IN5_V2_WIDTH / 8 * EPD_7IN5_V2_HEIGHT * 2];
+    UBYTE Lut[256];
+    for(UBYTE p = 0; p < 2; p++) {
+        EPD_Common_GrayLut(EPD_7IN5_V2_GRAY, p, Lut);
+        EPD_Common_GrayPlane(Image, sizeof(Planes), Lut, Planes + p * sizeof(Planes) / 2);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    DEV_Module_Init();
+    if(argc > 1 && strcmp(argv[1], "check") == 0)
+        return Check_Run() == 0 ? 0 : 1;
+    DEV_Host_SetBusyLevel(0);   //UC8179: BUSY low while busy
+
+    printf("--- driver, EPD_5IN83B_V2 ---\r\n");
+    BENCH_DRIVER("Init", EPD_5IN83B_V2_Init());
+    BENCH_DRIVER("Clear", EPD_5IN83B_V2_Clear());
+    BENCH_DRIVER("Display", EPD_5IN83B_V2_Display(BlackImage, RYImage));
+    BlackImage[0] ^= 0xFF;     //next page, the red plane stays
+    BENCH_DRIVER("Display, red unchanged", EPD_5IN83B_V2_Display(BlackImage, RYImage));
+    BlackImage[0] ^= 0xFF;
+    BENCH_DRIVER("Display_Async + Await", EPD_5IN83B_V2_Display_Async(BlackImage, RYImage, NULL, NULL); DEV_Busy_Await());
+    BENCH_DRIVER("Init, next page", EPD_5IN83B_V2_Init());
+    BENCH_DRIVER("Sleep", EPD_5IN83B_V2_Sleep());
+    if(argc > 1 && strcmp(argv[1], "dump") == 0)
+        DEV_Host_Dump(stdout);
+
+    EPD_STATE state;
+    EPD_State_Get(&state);
+    printf("state skipped init:%lu lut:%lu window:%lu plane:%lu\r\n", (unsigned long)state.Skipped_Init,
+           (unsigned long)state.Skipped_Lut, (unsigned long)state.Skipped_Window, (unsigned long)state.Skipped_Plane);
+
+    static UBYTE Panel_Image[EPD_7IN5_V2_WIDTH / 8 * EPD_7IN5_V2_HEIGHT];   //the largest panel of the list
+    memcpy(Panel_Image, BlackImage, sizeof(BlackImage));
+    for(UBYTE i = 0; i < sizeof(Bench_Panels) / sizeof(Bench_Panels[0]); i++) {
+        const EPD_PANEL *Panel = Bench_Panels[i];
+        //UC81xx: BUSY low while busy, 0x12 refreshes. SSD16xx: high, 0x12 is a soft reset
+        DEV_Host_SetBusyLevel(!Panel->Busy_Idle);
+        DEV_Host_SetBusyTime(0x12, Panel->Busy_Idle ? EPD_HOST_REFRESH_MS : 10);
+        printf("--- panel descriptor, %s ---\r\n", Panel->Name);
+        BENCH_DRIVER("EPD_Panel_Init", EPD_Panel_Init(Panel));
+        BENCH_DRIVER("EPD_Panel_Display", EPD_Panel_Display(Panel, Panel_Image, RYImage));
+        BENCH_DRIVER("EPD_Panel_Sleep", EPD_Panel_Sleep(Panel));
+    }
+    DEV_Host_SetBusyLevel(0);
+    DEV_Host_SetBusyTime(0x12, EPD_HOST_REFRESH_MS);
+
+    //a reading session: page turns, a pause, a long pause
+    printf("--- power states, EPD_5IN83B_V2 ---\r\n");
+    EPD_Power_Begin(&EPD_5IN83B_V2_Panel, 10000, 120000);
+    BENCH_DRIVER("Wake, cold", EPD_Power_Wake());
+    BENCH_DRIVER("Wake, awake", EPD_Power_Wake());
+    DEV_Delay_ms(15000);
+    BENCH_DRIVER("Poll after 15 s", EPD_Power_Poll());
+    BENCH_DRIVER("Wake, standby", EPD_Power_Wake());
+    DEV_Delay_ms(150000);
+    BENCH_DRIVER("Poll after 150 s", EPD_Power_Poll());
+    for(UBYTE t = 0; t < EPD_POWER_TRANSITIONS; t++) {
+        static const char *Names[EPD_POWER_TRANSITIONS] = {"init", "power on", "power off", "deep sleep"};
+        EPD_POWER_STAT stat;
+        EPD_Power_GetStat((EPD_POWER_TRANSITION)t, &stat);
+        printf("%-12s count:%lu last:%lums max:%lums\r\n", Names[t], (unsigned long)stat.Count,
+               (unsigned long)stat.Last_ms, (unsigned long)stat.Max_ms);
+    }
+
+    printf("--- paint, %dx%d, mean of %d runs ---\r\n", BENCH_WIDTH, BENCH_HEIGHT, BENCH_RUNS);
+    Paint_NewImage(BlackImage, BENCH_WIDTH, BENCH_HEIGHT, 0, WHITE);
+    Paint_SelectImage(BlackImage);
+    BENCH_PAINT("Paint_Clear", Paint_Clear(WHITE));
+    BENCH_PAINT("Paint_ClearWindows 200x200", Paint_ClearWindows(10, 10, 210, 210, BLACK));
+    BENCH_PAINT("Paint_DrawRectangle fill", Paint_DrawRectangle(20, 20, 320, 240, BLACK, DOT_PIXEL_1X1, DRAW_FILL_FULL));
+    BENCH_PAINT("Paint_DrawCircle fill", Paint_DrawCircle(320, 240, 100, BLACK, DOT_PIXEL_1X1, DRAW_FILL_FULL));
+    BENCH_PAINT("Paint_DrawLine", Paint_DrawLine(0, 0, BENCH_WIDTH - 1, BENCH_HEIGHT - 1, BLACK, DOT_PIXEL_2X2, LINE_STYLE_SOLID));
+    BENCH_PAINT("Paint_DrawString_EN Font16", Paint_DrawString_EN(10, 10, "The quick brown fox jumps over the lazy dog", &Font16, BLACK, WHITE));
+    BENCH_PAINT("Paint_DrawNum Font24", Paint_DrawNum(10, 100, 987654321, &Font24, BLACK, WHITE));
+    static char Page_Text[(BENCH_WIDTH / 11) * (BENCH_HEIGHT / 16) + 1];    //a full page of Font16
+    for(UDOUBLE i = 0; i + 1 < sizeof(Page_Text); i++)
+        Page_Text[i] = '!' + i % 94;
+    BENCH_PAINT("Paint_DrawString_EN page", Paint_DrawString_EN(0, 0, Page_Text, &Font16, BLACK, WHITE));
+    Paint_SetRotate(ROTATE_90);
+    BENCH_PAINT("Paint_DrawString_EN rot 90", Paint_DrawString_EN(10, 10, "The quick brown fox", &Font16, BLACK, WHITE));
+    BENCH_PAINT("Paint_DrawString_EN page 90", Paint_DrawString_EN(0, 0, Page_Text, &Font16, BLACK, WHITE));
+
+    //a page number change: only the changed window goes over the bus
+    printf("--- changed area, EPD_7IN5_V2 ---\r\n");
+    static UBYTE Frame[EPD_7IN5_V2_WIDTH / 8 * EPD_7IN5_V2_HEIGHT];
+    PAINT_RECT Rect;
+    Paint_NewImage(Frame, EPD_7IN5_V2_WIDTH, EPD_7IN5_V2_HEIGHT, 0, WHITE);
+    Paint_SelectImage(Frame);
+    Paint_Clear(WHITE);
+    Paint_DrawString_EN(0, 0, Page_Text, &Font16, BLACK, WHITE);
+    BENCH_DRIVER("Display, full page", EPD_7IN5_V2_Display(Frame));
+    Paint_ClearDirty();
+    Paint_ClearWindows(360, 456, 440, 472, WHITE);
+    Paint_DrawNum(360, 456, 124, &Font16, BLACK, WHITE);
+    Paint_GetDirty(&Rect, 1, 8);
+    printf("changed %d,%d - %d,%d\r\n", Rect.Xstart, Rect.Ystart, Rect.Xend, Rect.Yend);
+    BENCH_DRIVER("Display_Part_Frame, page no", EPD_7IN5_V2_Display_Part_Frame(Frame, Rect.Xstart, Rect.Ystart, Rect.Xend, Rect.Yend));
+    printf("partial window %s the frame rows\r\n",
+           Check_Stream_Window(0x13, Frame, EPD_7IN5_V2_WIDTH / 8, Rect.Xstart, Rect.Ystart, Rect.Xend, Rect.Yend)
+           ? "matches" : "DIFFERS FROM");
+
+    //menu navigation: the highlight moves down, the status bar changes
+    printf("--- shadow frame, EPD_7IN5_V2 ---\r\n");
+    static UBYTE Last[sizeof(Frame)];
+    EPD_SHADOW Shadow;
+    EPD_Shadow_Init(&Shadow, EPD_7IN5_V2_WIDTH, EPD_7IN5_V2_HEIGHT, Last, EPD_7IN5_V2_Display, Bench_Part);
+    Shadow.Cost.Full_Planes = 2;     //old and new data
+    Paint_Clear(WHITE);
+    for(UWORD i = 0; i < 8; i++)
+        Bench_Menu_Item(i, i == 0);
+    BENCH_DRIVER("Shadow, first frame", EPD_Shadow_Display(&Shadow, Frame));
+    Bench_Menu_Item(0, 0);
+    Bench_Menu_Item(1, 1);
+    BENCH_DRIVER("Shadow, menu down", EPD_Shadow_Display(&Shadow, Frame));
+    Paint_ClearWindows(700, 4, 796, 20, WHITE);
+    Paint_DrawString_EN(700, 4, "87%", &Font16, BLACK, WHITE);
+    BENCH_DRIVER("Shadow, status bar", EPD_Shadow_Display(&Shadow, Frame));
+    BENCH_DRIVER("Shadow, unchanged", EPD_Shadow_Display(&Shadow, Frame));
+    printf("shadow full:%lu partial:%lu unchanged:%lu bytes:%lu\r\n", (unsigned long)Shadow.Full_Count,
+           (unsigned long)Shadow.Part_Count, (unsigned long)Shadow.None_Count, (unsigned long)Shadow.Bytes_Sent);
+
+    //no frame buffer: record the page, render 1/8 of the frame at a time while sending
+    printf("--- banded frame, EPD_13IN3K ---\r\n");
+    static UBYTE List_Data[8192];
+    static UBYTE Band[EPD_13IN3K_WIDTH / 8 * (EPD_13IN3K_HEIGHT / 8)];
+    PAINT Page, Title;
+    PAINT_LIST List, Title_List;
+    PAINT *Pages[2] = {&Page, &Title};
+    Paint_NewImage(&Page, NULL, EPD_13IN3K_WIDTH, EPD_13IN3K_HEIGHT, 0, WHITE);
+    Paint_Record(&Page, &List, List_Data, sizeof(List_Data));
+    Paint_DrawString_EN(&Page, 0, 0, Page_Text, &Font16, BLACK, WHITE);
+    Paint_DrawRectangle(&Page, 0, 650, EPD_13IN3K_WIDTH - 1, EPD_13IN3K_HEIGHT - 1, BLACK, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+    Paint_DrawNum(&Page, 460, 657, 124, &Font16, WHITE, BLACK);
+    printf("display list %lu bytes, band %lu bytes, frame %lu bytes\r\n", (unsigned long)List.Used,
+           (unsigned long)sizeof(Band), (unsigned long)(EPD_13IN3K_WIDTH / 8 * EPD_13IN3K_HEIGHT));
+    BENCH_PAINT("Paint_RenderBand, 8 bands", for(UWORD y = 0; y < EPD_13IN3K_HEIGHT; y += EPD_13IN3K_HEIGHT / 8)
+                                                 Paint_RenderBand(Pages, 0, y, EPD_13IN3K_HEIGHT / 8, Band));
+    DEV_Host_SetBusyLevel(1);   //SSD1677: BUSY high while busy
+    BENCH_DRIVER("Display_Bands", EPD_13IN3K_Display_Bands(Band, sizeof(Band), Paint_RenderBand, Pages));
+    DEV_Host_SetBusyLevel(0);
+
+    //render while the previous half band is on the bus: the refresh starts after the
+    //slower of the two plus the first half band, not after their sum
+    DEV_HOST_STAT Stat;
+    double t0 = Now_us();
+    for(int r = 0; r < BENCH_RUNS; r++)
+        for(UWORD y = 0; y < EPD_13IN3K_HEIGHT; y += EPD_13IN3K_HEIGHT / 16)
+            Paint_RenderBand(Pages, 0, y, EPD_13IN3K_HEIGHT / 16, Band);
+    double Render_us = (Now_us() - t0) / BENCH_RUNS;
+    DEV_Host_GetStat(&Stat);
+    printf("refresh start: render + bus %.0f us, overlapped %.0f us\r\n", Render_us + Stat.SPI_us,
+           (Render_us > Stat.SPI_us ? Render_us : Stat.SPI_us) + Render_us / 16);
+
+    //both planes of the reader panel through the same band
+    printf("--- banded planes, EPD_5IN83B_V2 ---\r\n");
+    Paint_NewImage(&Page, NULL, BENCH_WIDTH, BENCH_HEIGHT, 0, WHITE);
+    Paint_NewImage(&Title, NULL, BENCH_WIDTH, BENCH_HEIGHT, 0, WHITE);
+    Paint_Record(&Page, &List, List_Data, 6144);
+    Paint_Record(&Title, &Title_List, List_Data + 6144, sizeof(List_Data) - 6144);
+    Paint_DrawString_EN(&Page, 0, 40, Page_Text, &Font16, BLACK, WHITE);
+    Paint_DrawString_EN(&Title, 10, 10, "Chapter 3", &Font24, BLACK, WHITE);
+    printf("display lists %lu + %lu bytes\r\n", (unsigned long)List.Used, (unsigned long)Title_List.Used);
+    BENCH_DRIVER("EPD_Panel_Display_Bands", EPD_Panel_Display_Bands(&EPD_5IN83B_V2_Panel, Band,
+                                                                    EPD_PANEL_LINE(&EPD_5IN83B_V2_Panel) * 60,
+                                                                    Paint_RenderBand, Pages));
+
+    //the same page as text runs, no display list and no frame
+    printf("--- text page, EPD_5IN83B_V2 ---\r\n");
+    static TEXT_RUN Runs[40];
+    TEXT_PAGE Text, Blank;
+    TEXT_PAGE *Text_Pages[2] = {&Text, &Blank};
+    UWORD Text_Band = EPD_PANEL_LINE(&EPD_5IN83B_V2_Panel) * 8;
+    TextPage_Init(&Text, BENCH_WIDTH, BENCH_HEIGHT, Runs, 40);
+    TextPage_Init(&Blank, BENCH_WIDTH, BENCH_HEIGHT, NULL, 0);
+    UDOUBLE Next = TextPage_Layout(&Text, 10, 10, BENCH_WIDTH - 20, BENCH_HEIGHT - 20, Page_Text, &Font16, BLACK, WHITE);
+    printf("%u runs, %lu of %lu chars, runs %lu bytes + band %u bytes, frame %lu bytes\r\n", Text.Count,
+           (unsigned long)Next, (unsigned long)strlen(Page_Text), (unsigned long)sizeof(Runs), Text_Band,
+           (unsigned long)sizeof(BlackImage) * 2);
+    BENCH_PAINT("TextPage_RenderRow, page", for(UWORD y = 0; y < BENCH_HEIGHT; y++)
+                                                TextPage_RenderRow(&Text, y, Band));
+    EPD_Panel_Init(&EPD_5IN83B_V2_Panel);
+    BENCH_DRIVER("EPD_Panel_Display_Bands", EPD_Panel_Display_Bands(&EPD_5IN83B_V2_Panel, Band, Text_Band,
+                                                                    TextPage_RenderBand, Text_Pages));
+    //the red plane stays blank, the controller still holds it
+    TextPage_Clear(&Text, WHITE);
+    TextPage_Layout(&Text, 10, 10, BENCH_WIDTH - 20, BENCH_HEIGHT - 20, Page_Text + Next, &Font16, BLACK, WHITE);
+    BENCH_DRIVER("Display_Bands, next page", EPD_Panel_Display_Bands(&EPD_5IN83B_V2_Panel, Band, Text_Band,
+                                                                     TextPage_RenderBand, Text_Pages));
+
+    //4 gray: the packed image is split into the planes while it is sent,
+    //the planar one goes out as it is
+    printf("--- 4 gray, EPD_7IN5_V2 ---\r\n");
+    static UBYTE Gray_Image[EPD_7IN5_V2_WIDTH / 4 * EPD_7IN5_V2_HEIGHT];
+    PAINT Gray;
+    Paint_NewImage(&Gray, Gray_Image, EPD_7IN5_V2_WIDTH, EPD_7IN5_V2_HEIGHT, 0, WHITE);
+    Paint_SetScale(&Gray, 4);
+    Paint_Clear(&Gray, GRAY4);
+    Paint_DrawString_EN(&Gray, 0, 0, Page_Text, &Font16, GRAY4, GRAY1);
+    BENCH_PAINT("packed to planes", Bench_Gray_Split(Gray_Image));
+    BENCH_DRIVER("Display_4Gray", EPD_7IN5_V2_Display_4Gray(Gray_Image));
+    Paint_SetGrayPlanes(&Gray, EPD_7IN5_V2_GRAY);
+    Paint_Clear(&Gray, GRAY4);
+    Paint_DrawString_EN(&Gray, 0, 0, Page_Text, &Font16, GRAY4, GRAY1);
+    BENCH_DRIVER("Display_4Gray_Planes", EPD_7IN5_V2_Display_4Gray_Planes(Gray_Image));
+
+    //3 color: a black and a red picture drawn apart, the red one inverted
+    //on the way out, against one picture writing both planes natively
+    printf("--- 3 color, EPD_5IN83B_V2 ---\r\n");
+    static UBYTE Color3_Image[Bench_Panel::BufferSize];
+    PAINT Black, Red, Color3;
+    Paint_NewImage(&Black, BlackImage, BENCH_WIDTH, BENCH_HEIGHT, 0, WHITE);
+    Paint_NewImage(&Red, RYImage, BENCH_WIDTH, BENCH_HEIGHT, 0, WHITE);
+    BENCH_PAINT("page, two pictures", Paint_Clear(&Black, WHITE); Paint_Clear(&Red, WHITE);
+                Paint_DrawString_EN(&Red, 10, 10, "Chapter 2", &Font24, WHITE, BLACK);
+                Paint_DrawLine(&Red, 10, 40, 630, 40, BLACK, DOT_PIXEL_2X2, LINE_STYLE_SOLID);
+                Paint_DrawString_EN(&Black, 10, 50, Page_Text, &Font16, WHITE, BLACK));
+    BENCH_DRIVER("Display", EPD_5IN83B_V2_Display(BlackImage, RYImage));
+    Paint_NewImage(&Color3, Color3_Image, BENCH_WIDTH, BENCH_HEIGHT, 0, WHITE);
+    Paint_SetColorPlanes(&Color3, EPD_5IN83B_V2_COLOR);
+    BENCH_PAINT("page, 3 color", Paint_Clear(&Color3, WHITE);
+                Paint_DrawString_EN(&Color3, 10, 10, "Chapter 2", &Font24, WHITE, COLOR_RED);
+                Paint_DrawLine(&Color3, 10, 40, 630, 40, COLOR_RED, DOT_PIXEL_2X2, LINE_STYLE_SOLID);
+                Paint_DrawString_EN(&Color3, 10, 50, Page_Text, &Font16, WHITE, BLACK));
+    BENCH_DRIVER("Display_Planes", EPD_5IN83B_V2_Display_Planes(Color3_Image));
+
+    //a full page of 1 bit text against the anti-aliased gray fonts
+    printf("--- gray text, EPD_7IN5_V2 ---\r\n");
+    static char Book_Text[(EPD_7IN5_V2_WIDTH / 6) * (EPD_7IN5_V2_HEIGHT / 8) + 1];  //a full page of Font8Gray
+    for(UDOUBLE i = 0; i + 1 < sizeof(Book_Text); i++)
+        Book_Text[i] = '!' + i % 94;
+    UDOUBLE Chars_12 = (EPD_7IN5_V2_WIDTH / 7) * (EPD_7IN5_V2_HEIGHT / 12);
+    UDOUBLE Chars_8 = (EPD_7IN5_V2_WIDTH / 6) * (EPD_7IN5_V2_HEIGHT / 8);
+    Book_Text[Chars_12] = '\0';
+    Paint_NewImage(&Gray, Gray_Image, EPD_7IN5_V2_WIDTH, EPD_7IN5_V2_HEIGHT, 0, WHITE);
+    BENCH_PAINT("Font12 page, 1 bit", Paint_DrawString_EN(&Gray, 0, 0, Book_Text, &Font12, WHITE, BLACK));
+    Paint_SetScale(&Gray, 4);
+    BENCH_PAINT("Font12 page, 4 gray", Paint_DrawString_EN(&Gray, 0, 0, Book_Text, &Font12, WHITE, BLACK));
+    Book_Text[Chars_12] = '!' + Chars_12 % 94;
+    BENCH_PAINT("Font8Gray page, packed", Paint_DrawString_Gray(&Gray, 0, 0, Book_Text, &Font8Gray, WHITE, BLACK));
+    Paint_SetGrayPlanes(&Gray, EPD_7IN5_V2_GRAY);
+    BENCH_PAINT("Font8Gray page, planes", Paint_DrawString_Gray(&Gray, 0, 0, Book_Text, &Font8Gray, WHITE, BLACK));
+    printf("%-28s %10u\r\n", "chars, Font12 page", (unsigned)Chars_12);
+    printf("%-28s %10u\r\n", "chars, Font8Gray page", (unsigned)Chars_8);
+
+    //a cover dithered row by row: one source row and one error row in RAM
+    printf("--- dithered cover ---\r\n");
+    static int16_t Error[EPD_13IN3K_WIDTH + 2];
+    static UBYTE Cover_Row[EPD_13IN3K_WIDTH];
+    UWORD Cover_Width = EPD_7IN5_V2_WIDTH;
+    DITHER Dither;
+    Dither_Init(&Dither, Cover_Width, 4, DITHER_DIFFUSE, Error);
+    Dither_SetSource(&Dither, Bench_Cover_Row, &Cover_Width, Cover_Row, NULL);
+    BENCH_PAINT("7.5\" diffuse, planes", Dither_Paint(&Dither, &Gray, 0, 0, EPD_7IN5_V2_HEIGHT));
+    Paint_SetScale(&Gray, 4);
+    BENCH_PAINT("7.5\" diffuse, packed", Dither_Paint(&Dither, &Gray, 0, 0, EPD_7IN5_V2_HEIGHT));
+    Dither_Init(&Dither, Cover_Width, 4, DITHER_ORDERED, NULL);
+    Dither_SetSource(&Dither, Bench_Cover_Row, &Cover_Width, Cover_Row, NULL);
+    BENCH_PAINT("7.5\" ordered, packed", Dither_Paint(&Dither, &Gray, 0, 0, EPD_7IN5_V2_HEIGHT));
+    Cover_Width = EPD_13IN3K_WIDTH;
+    Dither_Init(&Dither, Cover_Width, 2, DITHER_DIFFUSE, Error);
+    Dither_SetSource(&Dither, Bench_Cover_Row, &Cover_Width, Cover_Row, NULL);
+    printf("source row %lu bytes, error row %lu bytes, band %lu bytes\r\n", (unsigned long)sizeof(Cover_Row),
+           (unsigned long)sizeof(Error), (unsigned long)sizeof(Band));
+    DEV_Host_SetBusyLevel(1);
+    BENCH_DRIVER("13.3\"K diffuse, Display_Bands", EPD_13IN3K_Display_Bands(Band, sizeof(Band), Dither_RenderBand, &Dither));
+    DEV_Host_SetBusyLevel(0);
+
+    //a color cover straight into the native pixels of the 7.3" f and g panels
+    printf("--- color cover, 800x480 ---\r\n");
+    static UBYTE Cube[PALETTE_CUBE];
+    static int16_t Color_Error[(EPD_7IN3F_WIDTH + 2) * 3];
+    static UBYTE Color_Row[EPD_7IN3F_WIDTH * 3];
+    static UBYTE Color_Image[EPD_7IN3F_WIDTH / 2 * EPD_7IN3F_HEIGHT];
+    UWORD Color_Width = EPD_7IN3F_WIDTH;
+    PAINT Color;
+    QUANT Quant;
+    BENCH_PAINT("Palette_BuildCube, 7 color", Palette_BuildCube(&Palette_7Color, Cube));
+    Paint_NewImage(&Color, Color_Image, EPD_7IN3F_WIDTH, EPD_7IN3F_HEIGHT, 0, WHITE);
+    Paint_SetScale(&Color, 7);
+    Quant_Init(&Quant, &Palette_7Color, Color_Width, Cube, NULL);
+    Quant_SetSource(&Quant, Bench_Color_Row, &Color_Width, Color_Row);
+    BENCH_PAINT("7 color, nearest", Quant_Paint(&Quant, &Color, 0, 0, EPD_7IN3F_HEIGHT));
+    Quant_Init(&Quant, &Palette_7Color, Color_Width, Cube, Color_Error);
+    Quant_SetSource(&Quant, Bench_Color_Row, &Color_Width, Color_Row);
+    BENCH_PAINT("7 color, diffuse", Quant_Paint(&Quant, &Color, 0, 0, EPD_7IN3F_HEIGHT));
+    BENCH_PAINT("7 color, SetPixel", for(UWORD y = 0; y < EPD_7IN3F_HEIGHT; y++) {
+                                         Bench_Color_Row(&Color_Width, y, Color_Row);
+                                         Quant_Row(&Quant, Color_Row);
+                                         for(UWORD x = 0; x < EPD_7IN3F_WIDTH; x++)
+                                             Paint_SetPixel(&Color, x, y, Color_Row[x]);
+                                     });
+    Palette_BuildCube(&Palette_4Color, Cube);
+    Paint_SetScale(&Color, 4);
+    Quant_Init(&Quant, &Palette_4Color, Color_Width, Cube, Color_Error);
+    Quant_SetSource(&Quant, Bench_Color_Row, &Color_Width, Color_Row);
+    BENCH_PAINT("4 color, diffuse", Quant_Paint(&Quant, &Color, 0, 0, EPD_7IN3F_HEIGHT));
+    return 0;
+}
@@ -0,0 +1,261 @@
+/*****************************************************************************
+* | File      	:   check.cpp
+* | Function    :   Host checks of the recorded bus traffic
+* | Info        :
+*   .pio/build/native/program check
+*   Compares the recorded command stream against known byte streams and
+*   counts, prints one line per check and exits non-zero if one fails:
+*   - every descriptor panel sends the same bytes as its hand-written
+*     driver did before the port
+*   - the kept red plane is skipped only while the controller holds it
+*   - a partial window carries exactly the window rows of the frame
+*   - the shadow frame picks full, partial and no update
+*----------------
+* |	This version:   V1.0
+* | Date        :   2026-10-17
+* | Info        :
+******************************************************************************/
+#include "check.h"
+#include "DEV_Host.h"
+#include "EPD.h"
+#include "EPD_Common.h"
+#include "EPD_Panel.h"
+#include "EPD_Shadow.h"
+#include "GUI_Paint.h"
+
+/**
+ * Init, Clear, Display and Sleep of each panel with Check_Image0/1, as
+ * recorded from the hand-written drivers
+**/
+typedef struct {
+    const EPD_PANEL *Panel;
+    UDOUBLE Len;
+    UDOUBLE Hash;
+} CHECK_STREAM;
+
+static const CHECK_STREAM Check_Streams[] = {
+    { &EPD_5IN83B_V2_Panel, 155553, 0x52034f6e },
+    { &EPD_5IN83_V2_Panel,  155553, 0x63dd0dbb },
+    { &EPD_2IN9B_V3_Panel,   18969, 0x5d0ab4ec },
+    { &EPD_2IN13B_V3_Panel,  11045, 0x36fc1890 },
+    { &EPD_2IN13B_V4_Panel,  16035, 0x1018bb36 },
+    { &EPD_2IN9BC_Panel,     18970, 0x38d18636 },
+    { &EPD_1IN54C_Panel,     11579, 0xacec0ed4 },
+    { &EPD_1IN54B_V2_Panel,  20036, 0x8f6bc3e4 },
+    { &EPD_2IN13BC_Panel,    11050, 0x87141310 },
+    { &EPD_4IN2BC_Panel,     60016, 0x1e1b9a03 },
+    { &EPD_2IN66B_Panel,     22523, 0xe0e92845 },
+    { &EPD_2IN7B_V2_Panel,   23260, 0xea3cc865 },
+    { &EPD_2IN7B_Panel,      23500, 0x08172ca3 },
+    { &EPD_1IN54_V2_Panel,   15202, 0x676cff8f },
+    { &EPD_2IN13_V2_Panel,    8122, 0x0637ca07 },
+    { &EPD_2in13_V3_Panel,   12202, 0x054f16eb },
+    { &EPD_2in13_V4_Panel,    8037, 0x251d8952 },
+    { &EPD_2IN7_V2_Panel,    11637, 0x63cd2642 },
+    { &EPD_2IN9_V2_Panel,    14406, 0x87a29a42 },
+    { &EPD_4IN2_V2_Panel,    60033, 0x1ebce6a1 },
+    { &EPD_7IN5_V2_Panel,   192036, 0xdc53c7c0 },
+};
+
+#define CHECK_IMAGE_SIZE (EPD_7IN5_V2_WIDTH / 8 * EPD_7IN5_V2_HEIGHT)  //the largest panel
+
+static UBYTE Check_Image0[CHECK_IMAGE_SIZE];
+static UBYTE Check_Image1[CHECK_IMAGE_SIZE];
+static UDOUBLE Check_Failed;
+
+static void Check(const char *Name, UBYTE Ok)
+{
+    printf("%-40s %s\r\n", Name, Ok ? "ok" : "FAILED");
+    if(!Ok)
+        Check_Failed++;
+}
+
+//FNV-1a over the DC level and value of every recorded byte
+static UDOUBLE Check_Hash(UDOUBLE *Len)
+{
+    UDOUBLE Hash = 2166136261u;
+    const DEV_HOST_BYTE *Stream = DEV_Host_GetStream(Len);
+    for(UDOUBLE i = 0; i < *Len; i++)
+        Hash = (Hash ^ ((UDOUBLE)Stream[i].DC << 8 | Stream[i].Value)) * 16777619u;
+    return Hash;
+}
+
+static UDOUBLE Check_Cmd_Data(UBYTE Cmd)
+{
+    DEV_HOST_STAT stat;
+    DEV_Host_GetStat(&stat);
+    return stat.Cmd_Data[Cmd];
+}
+
+/******************************************************************************
+function :	Compare the data of the last Cmd in the recorded stream with a
+            window of the frame
+parameter:
+    Cmd    : RAM write command
+    Frame  : full frame
+    Line   : bytes per row of Frame
+    Xstart : x starting point, rounded down to 8
+    Ystart : y starting point
+    Xend   : x end point, exclusive, rounded up to 8
+    Yend   : y end point, exclusive
+Info:
+    Returns 1 if Cmd carries exactly the window rows, and nothing more.
+******************************************************************************/
+UBYTE Check_Stream_Window(UBYTE Cmd, const UBYTE *Frame, UWORD Line, UWORD Xstart, UWORD Ystart,
+                          UWORD Xend, UWORD Yend)
+{
+    UDOUBLE Len, i, At = 0;
+    const DEV_HOST_BYTE *Stream = DEV_Host_GetStream(&Len);
+    for(i = 0; i < Len; i++)
+        if(Stream[i].DC == 0 && Stream[i].Value == Cmd)
+            At = i + 1;
+    if(At == 0)
+        return 0;
+    for(UWORD y = Ystart; y < Yend; y++)
+        for(UWORD x = Xstart / 8; x < (Xend + 7) / 8; x++, At++)
+            if(At >= Len || Stream[At].DC != 1 || Stream[At].Value != Frame[y * Line + x])
+                return 0;
+    return At == Len || Stream[At].DC == 0;
+}
+
+static void Check_Busy(const EPD_PANEL *Panel)
+{
+    //UC81xx: BUSY low while busy, 0x12 refreshes. SSD16xx: high, 0x12 is a soft reset
+    DEV_Host_SetBusyLevel(!Panel->Busy_Idle);
+    DEV_Host_SetBusyTime(0x12, Panel->Busy_Idle ? EPD_HOST_REFRESH_MS : 10);
+}
+
+static void Check_Panels(void)
+{
+    char Name[48];
+    for(UBYTE i = 0; i < sizeof(Check_Streams) / sizeof(Check_Streams[0]); i++) {
+        const CHECK_STREAM *Expect = &Check_Streams[i];
+        UDOUBLE Len, Hash;
+        Check_Busy(Expect->Panel);
+        DEV_Host_Reset();
+        EPD_Panel_Init(Expect->Panel);
+        EPD_Panel_Clear(Expect->Panel);
+        EPD_Panel_Display(Expect->Panel, Check_Image0, Check_Image1);
+        EPD_Panel_Sleep(Expect->Panel);
+        Hash = Check_Hash(&Len);
+        snprintf(Name, sizeof(Name), "%s stream", Expect->Panel->Name);
+        Check(Name, Len == Expect->Len && Hash == Expect->Hash);
+    }
+}
+
+//EPD_State_Plane: the red plane goes out when it changed or the controller lost it
+static void Check_Red_Plane(void)
+{
+    const EPD_PANEL *Panel = &EPD_5IN83B_V2_Panel;
+    UDOUBLE Size = EPD_PANEL_PLANE_SIZE(Panel);
+    Check_Busy(Panel);
+    EPD_Panel_Init(Panel);
+
+    DEV_Host_Reset();
+    EPD_Panel_Display(Panel, Check_Image0, Check_Image1);
+    Check("red plane, first page", Check_Cmd_Data(0x10) == Size && Check_Cmd_Data(0x13) == Size);
+
+    Check_Image0[0] ^= 0xFF;
+    DEV_Host_Reset();
+    EPD_Panel_Display(Panel, Check_Image0, Check_Image1);
+    Check("red plane, black changed", Check_Cmd_Data(0x10) == Size && Check_Cmd_Data(0x13) == 0);
+
+    Check_Image1[Size - 1] ^= 0xFF;
+    DEV_Host_Reset();
+    EPD_Panel_Display(Panel, Check_Image0, Check_Image1);
+    Check("red plane, red changed", Check_Cmd_Data(0x13) == Size);
+
+    EPD_Panel_Sleep(Panel);
+    EPD_Panel_Init(Panel);
+    DEV_Host_Reset();
+    EPD_Panel_Display(Panel, Check_Image0, Check_Image1);
+    Check("red plane, after sleep", Check_Cmd_Data(0x13) == Size);
+    EPD_Panel_Sleep(Panel);
+
+    Check_Image0[0] ^= 0xFF;
+    Check_Image1[Size - 1] ^= 0xFF;
+}
+
+static EPD_SHADOW_RECT Check_Part_Rect;
+
+static void Check_Part(const UBYTE *Image, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
+{
+    Check_Part_Rect.Xstart = Xstart;
+    Check_Part_Rect.Ystart = Ystart;
+    Check_Part_Rect.Xend = Xend;
+    Check_Part_Rect.Yend = Yend;
+    EPD_7IN5_V2_Display_Part_Frame(Image, Xstart, Ystart, Xend, Yend);
+}
+
+//EPD_7IN5_V2_Display_Part_Frame and EPD_Shadow_Display on the 7.5" V2
+static void Check_Window(void)
+{
+    static UBYTE Frame[EPD_7IN5_V2_WIDTH / 8 * EPD_7IN5_V2_HEIGHT];
+    static UBYTE Last[sizeof(Frame)];
+    const UWORD Line = EPD_7IN5_V2_WIDTH / 8;
+    const EPD_SHADOW_RECT *R = &Check_Part_Rect;
+    EPD_SHADOW Shadow;
+    EPD_SHADOW_UPDATE Update;
+
+    Check_Busy(&EPD_7IN5_V2_Panel);
+    EPD_7IN5_V2_Init();
+    Paint_NewImage(Frame, EPD_7IN5_V2_WIDTH, EPD_7IN5_V2_HEIGHT, 0, WHITE);
+    Paint_SelectImage(Frame);
+    Paint_Clear(WHITE);
+    Paint_DrawString_EN(8, 8, "The quick brown fox jumps over the lazy dog", &Font16, BLACK, WHITE);
+
+    DEV_Host_Reset();
+    EPD_7IN5_V2_Display_Part_Frame(Frame, 13, 5, 91, 30);
+    Check("part frame, window rows", Check_Stream_Window(0x13, Frame, Line, 13, 5, 91, 30)
+                                     && Check_Cmd_Data(0x13) == (96 - 8) / 8 * (30 - 5));
+
+    EPD_7IN5_V2_Init();
+    EPD_Shadow_Init(&Shadow, EPD_7IN5_V2_WIDTH, EPD_7IN5_V2_HEIGHT, Last, EPD_7IN5_V2_Display, Check_Part);
+    Shadow.Cost.Full_Planes = 2;
+    DEV_Host_Reset();
+    Update = EPD_Shadow_Display(&Shadow, Frame);
+    Check("shadow, first frame is full", Update == EPD_SHADOW_FULL
+                                         && Check_Stream_Window(0x10, Frame, Line, 0, 0,
+                                                                EPD_7IN5_V2_WIDTH, EPD_7IN5_V2_HEIGHT)
+                                         && Check_Cmd_Data(0x13) == sizeof(Frame));
+
+    Paint_ClearWindows(360, 456, 440, 472, WHITE);
+    Paint_DrawNum(360, 456, 124, &Font16, BLACK, WHITE);
+    DEV_Host_Reset();
+    Update = EPD_Shadow_Display(&Shadow, Frame);
+    Check("shadow, page number is partial", Update == EPD_SHADOW_PART && Check_Cmd_Data(0x10) == 0
+                                            && R->Xstart >= 360 && R->Ystart >= 456
+                                            && R->Xend <= 440 && R->Yend <= 472 && R->Xstart < R->Xend
+                                            && Check_Stream_Window(0x13, Frame, Line, R->Xstart, R->Ystart,
+                                                                   R->Xend, R->Yend));
+
+    DEV_Host_Reset();
+    Update = EPD_Shadow_Display(&Shadow, Frame);
+    UDOUBLE Len;
+    DEV_Host_GetStream(&Len);
+    Check("shadow, unchanged sends nothing", Update == EPD_SHADOW_NONE && Len == 0);
+    Check("shadow, counts", Shadow.Full_Count == 1 && Shadow.Part_Count == 1 && Shadow.None_Count == 1);
+    EPD_7IN5_V2_Sleep();
+}
+
+/******************************************************************************
+function :	Run every check
+Info:
+    Returns the number of failed checks.
+******************************************************************************/
+UDOUBLE Check_Run(void)
+{
+    for(UDOUBLE i = 0; i < CHECK_IMAGE_SIZE; i++) {
+        Check_Image0[i] = (UBYTE)(i * 7 + (i >> 8));
+        Check_Image1[i] = (UBYTE)(i * 13 + 0x5A);
+    }
+    Check_Failed = 0;
+    DEV_Host_Record(1);
+    Check_Panels();
+    Check_Red_Plane();
+    Check_Window();
+    DEV_Host_SetBusyLevel(0);
+    DEV_Host_SetBusyTime(0x12, EPD_HOST_REFRESH_MS);
+    printf("%lu checks failed\r\n", (unsigned long)Check_Failed);
+    return Check_Failed;
+}
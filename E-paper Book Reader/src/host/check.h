@@ -0,0 +1,19 @@
+/*****************************************************************************
+* | File      	:   check.h
+* | Function    :   Host checks of the recorded bus traffic
+* | Info        :
+*----------------
+* |	This version:   V1.0
+* | Date        :   2026-10-17
+* | Info        :
+******************************************************************************/
+#ifndef _CHECK_H_
+#define _CHECK_H_
+
+#include "DEV_Config.h"
+
+UBYTE Check_Stream_Window(UBYTE Cmd, const UBYTE *Frame, UWORD Line, UWORD Xstart, UWORD Ystart,
+                          UWORD Xend, UWORD Yend);
+UDOUBLE Check_Run(void);
+
+#endif
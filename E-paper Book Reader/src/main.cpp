@@ -2,91 +2,175 @@
 #include "DEV_Config.h"
 #include "EPD.h"
 #include "GUI_Paint.h"
+#include "GUI_Text.h"
 #include "imagedata.h"
 #include <stdlib.h>
 
+typedef Panel<EPD_5IN83B_V2_Model> EPD_Reader;
+
+//Image cache, sized at compile time: the black plane then the red plane
+static UBYTE Frame[EPD_Reader::BufferSize];
+static PAINT Page;
+
+#define DEMO_DUAL_CORE 0    // render the next page on core 0 while core 1 drives the panel
+
+#if DEMO_DUAL_CORE
+static EPD_Reader::PlaneBuffer NextImage;
+static PAINT Next;
+static TaskHandle_t Panel_Task;
+
+static void Render_Next_Page(void *arg)
+{
+  PAINT *Page = (PAINT *)arg;
+  Paint_Clear(Page, WHITE);
+  Paint_DrawString_EN(Page, 10, 10, "Chapter 2", &Font24, BLACK, WHITE);
+  Paint_DrawLine(Page, 10, 40, 300, 40, BLACK, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
+  xTaskNotifyGive(Panel_Task);
+  vTaskDelete(NULL);
+}
+#endif
+
 /* Entry point ----------------------------------------------------------------*/
 void setup()
 {
   printf("EPD_5IN83B_V2_test Demo\r\n");
   DEV_Module_Init();
 
+#if 0   // SPI transfer benchmark, one 5.83" plane per backend
+  DEV_SPI_Benchmark(EPD_Reader::PlaneSize);
+#endif
+
   printf("e-Paper Init and Clear...\r\n");
-  EPD_5IN83B_V2_Init();
-  EPD_5IN83B_V2_Clear();
+  EPD_Reader::Init();
+  EPD_Reader::Clear();
   DEV_Delay_ms(500);
 
 
 
-  //Create a new image cache named IMAGE_BW and fill it with white
-  UBYTE *BlackImage, *RYImage;
-  UWORD Imagesize = ((EPD_5IN83B_V2_WIDTH % 8 == 0) ? (EPD_5IN83B_V2_WIDTH / 8 ) : (EPD_5IN83B_V2_WIDTH / 8 + 1)) * EPD_5IN83B_V2_HEIGHT;
-  if ((BlackImage = (UBYTE *)malloc(Imagesize)) == NULL) {
-    printf("Failed to apply for black memory...\r\n");
-    while (1);
-  }
-  if ((RYImage = (UBYTE *)malloc(Imagesize)) == NULL) {
-    printf("Failed to apply for red memory...\r\n");
-    while (1);
-  }
-  printf("NewImage:BlackImage and RYImage\r\n");
-  Paint_NewImage(BlackImage, EPD_5IN83B_V2_WIDTH, EPD_5IN83B_V2_HEIGHT, 0, WHITE);
-  Paint_NewImage(RYImage, EPD_5IN83B_V2_WIDTH, EPD_5IN83B_V2_HEIGHT, 0, WHITE);
-
-  //Select Image
-  Paint_SelectImage(BlackImage);
-  Paint_Clear(WHITE);
-  Paint_SelectImage(RYImage);
-  Paint_Clear(WHITE);
+  //Fill the image cache with white, both planes drawn at once
+  printf("NewImage:Frame\r\n");
+  Paint_NewImage(&Page, Frame, EPD_Reader::Width, EPD_Reader::Height, 0, WHITE);
+  Paint_SetColorPlanes(&Page, EPD_5IN83B_V2_COLOR);
+  Paint_Clear(&Page, WHITE);
 
 #if 1   // show image for array    
   printf("show image for array\r\n");
-  EPD_5IN83B_V2_Display(gImage_5in83b_V2_b, gImage_5in83b_V2_r);
+  EPD_Reader::Display(gImage_5in83b_V2_b, gImage_5in83b_V2_r);
   DEV_Delay_ms(2000);
 #endif
 
+#if 0   // refresh in the background while the next page is prepared
+  printf("show image for array, async\r\n");
+  EPD_5IN83B_V2_Display_Async(gImage_5in83b_V2_b, gImage_5in83b_V2_r, NULL, NULL);
+  UDOUBLE idle_loops = 0;
+  while(!DEV_Busy_Poll()) {
+    idle_loops++;   // read buttons, render the next page, ...
+    DEV_Delay_ms(10);
+  }
+  printf("refresh done, %lu idle loops\r\n", (unsigned long)idle_loops);
+#endif
+
 #if 1   // Drawing on the image
   /*Horizontal screen*/
-  //1.Draw black image
-  Paint_SelectImage(BlackImage);
-  Paint_Clear(WHITE);
-  Paint_DrawPoint(10, 80, BLACK, DOT_PIXEL_1X1, DOT_STYLE_DFT);
-  Paint_DrawPoint(10, 90, BLACK, DOT_PIXEL_2X2, DOT_STYLE_DFT);
-  Paint_DrawPoint(10, 100, BLACK, DOT_PIXEL_3X3, DOT_STYLE_DFT);
-  Paint_DrawPoint(10, 110, BLACK, DOT_PIXEL_3X3, DOT_STYLE_DFT);
-  Paint_DrawLine(20, 70, 70, 120, BLACK, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
-  Paint_DrawLine(70, 70, 20, 120, BLACK, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
-  Paint_DrawRectangle(20, 70, 70, 120, BLACK, DOT_PIXEL_1X1, DRAW_FILL_EMPTY);
-  Paint_DrawRectangle(80, 70, 130, 120, BLACK, DOT_PIXEL_1X1, DRAW_FILL_FULL);
-  Paint_DrawString_EN(10, 0, "waveshare", &Font16, BLACK, WHITE);
-  Paint_DrawString_CN(130, 20, "微雪电子", &Font24CN, WHITE, BLACK);
-  Paint_DrawNum(10, 50, 987654321, &Font16, WHITE, BLACK);
-
-  //2.Draw red image
-  Paint_SelectImage(RYImage);
-  Paint_Clear(WHITE);
-  Paint_DrawCircle(160, 95, 20, BLACK, DOT_PIXEL_1X1, DRAW_FILL_EMPTY);
-  Paint_DrawCircle(210, 95, 20, BLACK, DOT_PIXEL_1X1, DRAW_FILL_FULL);
-  Paint_DrawLine(85, 95, 125, 95, BLACK, DOT_PIXEL_1X1, LINE_STYLE_DOTTED);
-  Paint_DrawLine(105, 75, + 105, 115, BLACK, DOT_PIXEL_1X1, LINE_STYLE_DOTTED);
-  Paint_DrawString_CN(130, 0, "你好abc", &Font12CN, BLACK, WHITE);
-  Paint_DrawString_EN(10, 20, "hello world", &Font12, WHITE, BLACK);
-  Paint_DrawNum(10, 33, 123456789, &Font12, BLACK, WHITE);
+  //1.Draw black
+  Paint_Clear(&Page, WHITE);
+  Paint_DrawPoint(&Page, 10, 80, BLACK, DOT_PIXEL_1X1, DOT_STYLE_DFT);
+  Paint_DrawPoint(&Page, 10, 90, BLACK, DOT_PIXEL_2X2, DOT_STYLE_DFT);
+  Paint_DrawPoint(&Page, 10, 100, BLACK, DOT_PIXEL_3X3, DOT_STYLE_DFT);
+  Paint_DrawPoint(&Page, 10, 110, BLACK, DOT_PIXEL_3X3, DOT_STYLE_DFT);
+  Paint_DrawLine(&Page, 20, 70, 70, 120, BLACK, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
+  Paint_DrawLine(&Page, 70, 70, 20, 120, BLACK, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
+  Paint_DrawRectangle(&Page, 20, 70, 70, 120, BLACK, DOT_PIXEL_1X1, DRAW_FILL_EMPTY);
+  Paint_DrawRectangle(&Page, 80, 70, 130, 120, BLACK, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+  Paint_DrawString_EN(&Page, 10, 0, "waveshare", &Font16, BLACK, WHITE);
+  Paint_DrawString_CN(&Page, 130, 20, "微雪电子", &Font24CN, WHITE, BLACK);
+  Paint_DrawNum(&Page, 10, 50, 987654321, &Font16, WHITE, BLACK);
+
+  //2.Draw red, on the same picture
+  Paint_DrawCircle(&Page, 160, 95, 20, COLOR_RED, DOT_PIXEL_1X1, DRAW_FILL_EMPTY);
+  Paint_DrawCircle(&Page, 210, 95, 20, COLOR_RED, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+  Paint_DrawLine(&Page, 85, 95, 125, 95, COLOR_RED, DOT_PIXEL_1X1, LINE_STYLE_DOTTED);
+  Paint_DrawLine(&Page, 105, 75, + 105, 115, COLOR_RED, DOT_PIXEL_1X1, LINE_STYLE_DOTTED);
+  Paint_DrawString_CN(&Page, 130, 0, "你好abc", &Font12CN, COLOR_RED, WHITE);
+  Paint_DrawString_EN(&Page, 10, 20, "hello world", &Font12, WHITE, COLOR_RED);
+  Paint_DrawNum(&Page, 10, 33, 123456789, &Font12, COLOR_RED, WHITE);
 
   printf("EPD_Display\r\n");
-  EPD_5IN83B_V2_Display(BlackImage, RYImage);
+  EPD_5IN83B_V2_Display_Planes(Frame);
+  DEV_Delay_ms(2000);
+#endif
+
+#if DEMO_DUAL_CORE
+  printf("render the next page during the refresh\r\n");
+  Paint_NewImage(&Next, NextImage, EPD_Reader::Width, EPD_Reader::Height, 0, WHITE);
+  Panel_Task = xTaskGetCurrentTaskHandle();
+  xTaskCreatePinnedToCore(Render_Next_Page, "render", 4096, &Next, 1, NULL, 0);
+  EPD_5IN83B_V2_Display_Planes(Frame);
+  ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  EPD_5IN83B_V2_Display(NextImage, NULL);
+#endif
+
+#if 0   // page turn rendered while it goes out: display lists, the bands of 1/8 plane are sent as they are done
+  static UBYTE List_Data[4096];
+  static UBYTE Band[EPD_Reader::PlaneSize / 8];
+  PAINT_LIST Black_List, Red_List;
+  PAINT Black, Red;
+  PAINT *Pages[2] = {&Black, &Red};
+  Paint_NewImage(&Black, NULL, EPD_Reader::Width, EPD_Reader::Height, 0, WHITE);
+  Paint_NewImage(&Red, NULL, EPD_Reader::Width, EPD_Reader::Height, 0, WHITE);
+  Paint_Record(&Black, &Black_List, List_Data, 3072);
+  Paint_Record(&Red, &Red_List, List_Data + 3072, 1024);
+  Paint_DrawString_EN(&Red, 10, 10, "Chapter 2", &Font24, BLACK, WHITE);
+  Paint_DrawString_EN(&Black, 10, 40, "The quick brown fox jumps over the lazy dog", &Font16, BLACK, WHITE);
+  EPD_Panel_Display_Bands(&EPD_5IN83B_V2_Panel, Band, sizeof(Band), Paint_RenderBand, Pages);
   DEV_Delay_ms(2000);
 #endif
 
+#if 0   // reading page without a frame buffer: text runs, each row is generated as it is sent
+  static const char Chapter[] = "It was a bright cold day in April, and the clocks were striking thirteen.";
+  static TEXT_RUN Runs[40];
+  static UBYTE Rows[EPD_Reader::Line * 8];
+  TEXT_PAGE Text, Blank;
+  TEXT_PAGE *Text_Pages[2] = {&Text, &Blank};
+  TextPage_Init(&Text, EPD_Reader::Width, EPD_Reader::Height, Runs, 40);
+  TextPage_Init(&Blank, EPD_Reader::Width, EPD_Reader::Height, NULL, 0);
+  UDOUBLE Next = TextPage_Layout(&Text, 10, 10, EPD_Reader::Width - 20, EPD_Reader::Height - 20,
+                                 Chapter, &Font16, BLACK, WHITE);
+  EPD_Panel_Display_Bands(&EPD_5IN83B_V2_Panel, Rows, sizeof(Rows), TextPage_RenderBand, Text_Pages);
+  printf("page shown up to %lu\r\n", (unsigned long)Next);
+  DEV_Delay_ms(2000);
+#endif
+
+#if 0   // page turns under the power manager: awake for the burst, then standby and deep sleep
+  EPD_Power_Begin(&EPD_5IN83B_V2_Panel, EPD_POWER_OFF_MS, EPD_POWER_SLEEP_MS);
+  for(UBYTE page = 0; page < 3; page++) {
+    EPD_Power_Wake();
+    EPD_5IN83B_V2_Display_Planes(Frame);
+    EPD_Power_Poll();
+  }
+  while(EPD_Power_Poll() != EPD_POWER_SLEEP)
+    DEV_Delay_ms(100);
+  EPD_POWER_STAT power;
+  EPD_Power_GetStat(EPD_POWER_INIT, &power);
+  printf("wake from sleep: %lums, ", (unsigned long)power.Max_ms);
+  EPD_Power_GetStat(EPD_POWER_OFF, &power);
+  printf("power off: %lums\r\n", (unsigned long)power.Max_ms);
+  EPD_Power_Wake();
+#endif
+
   printf("Clear...\r\n");
-  EPD_5IN83B_V2_Clear();
+  EPD_Reader::Clear();
+
+#if 1   // BUSY wait statistics
+  DEV_BUSY_STAT busy;
+  DEV_Busy_GetStat(&busy);
+  printf("busy waits:%lu timeouts:%lu last:%lums max:%lums total:%lums\r\n",
+         (unsigned long)busy.Count, (unsigned long)busy.Timeouts, (unsigned long)busy.Last_ms,
+         (unsigned long)busy.Max_ms, (unsigned long)busy.Total_ms);
+#endif
 
   printf("Goto Sleep...\r\n");
-  EPD_5IN83B_V2_Sleep();
-  free(BlackImage);
-  free(RYImage);
-  BlackImage = NULL;
-  RYImage = NULL;
+  EPD_Reader::Sleep();
 }
 
 /* The main loop -------------------------------------------------------------*/